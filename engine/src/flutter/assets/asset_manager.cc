@@ -4,20 +4,44 @@
 
 #include "flutter/assets/asset_manager.h"
 
+#include <utility>
+
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+namespace {
+
+// Reads one byte of every page of |mapping|, so that a file mapping is paged
+// in on the prefetching thread rather than on first use.
+void TouchPages(const fml::Mapping& mapping) {
+  constexpr size_t kPageSize = 4096;
+  const volatile uint8_t* data = mapping.GetMapping();
+  if (data == nullptr) {
+    return;
+  }
+  uint8_t sum = 0;
+  for (size_t offset = 0; offset < mapping.GetSize(); offset += kPageSize) {
+    sum += data[offset];
+  }
+  (void)sum;
+}
+
+}  // namespace
+
 AssetManager::AssetManager() = default;
 
-AssetManager::~AssetManager() = default;
+AssetManager::~AssetManager() {
+  CancelPrefetches();
+}
 
 bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
   if (resolver == nullptr || !resolver->IsValid()) {
     return false;
   }
 
+  CancelPrefetches();
   resolvers_.push_front(std::move(resolver));
   return true;
 }
@@ -27,6 +51,7 @@ bool AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
     return false;
   }
 
+  CancelPrefetches();
   resolvers_.push_back(std::move(resolver));
   return true;
 }
@@ -37,6 +62,7 @@ void AssetManager::UpdateResolverByType(
   if (updated_asset_resolver == nullptr) {
     return;
   }
+  CancelPrefetches();
   bool updated = false;
   std::deque<std::unique_ptr<AssetResolver>> new_resolvers;
   for (auto& old_resolver : resolvers_) {
@@ -56,9 +82,129 @@ void AssetManager::UpdateResolverByType(
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  CancelPrefetches();
   return std::move(resolvers_);
 }
 
+void AssetManager::PrefetchAssets(
+    std::vector<std::string> asset_names,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+    const fml::closure& on_done) {
+  if (asset_names.empty()) {
+    if (on_done) {
+      task_runner->PostTask(on_done);
+    }
+    return;
+  }
+  TRACE_EVENT0("flutter", "AssetManager::PrefetchAssets");
+
+  uint64_t generation;
+  {
+    std::scoped_lock lock(prefetch_state_->mutex);
+    generation = prefetch_state_->generation;
+  }
+
+  auto remaining = std::make_shared<std::atomic<size_t>>(asset_names.size());
+  for (auto& name : asset_names) {
+    task_runner->PostTask([manager = this, state = prefetch_state_, generation,
+                           remaining, on_done,
+                           asset_name = std::move(name)]() {
+      // The manager may only be used while this task is counted as running,
+      // which keeps it and its resolvers alive and unchanged.
+      bool skip;
+      {
+        std::scoped_lock lock(state->mutex);
+        skip = state->generation != generation ||
+               state->mappings.count(asset_name) > 0;
+        if (!skip) {
+          state->running++;
+        }
+      }
+
+      if (!skip) {
+        TRACE_EVENT1("flutter", "AssetManager::PrefetchAsset", "name",
+                     asset_name.c_str());
+        manager->BuildIndex();
+        std::unique_ptr<fml::Mapping> mapping =
+            manager->ResolveAsMapping(asset_name);
+        if (mapping) {
+          TouchPages(*mapping);
+        }
+        {
+          std::scoped_lock lock(state->mutex);
+          state->running--;
+          if (mapping && state->generation == generation) {
+            state->mappings.emplace(asset_name, std::move(mapping));
+          }
+        }
+        state->idle.notify_all();
+      }
+
+      if (remaining->fetch_sub(1) == 1 && on_done) {
+        on_done();
+      }
+    });
+  }
+}
+
+void AssetManager::CancelPrefetches() {
+  {
+    std::unique_lock lock(prefetch_state_->mutex);
+    prefetch_state_->generation++;
+    prefetch_state_->mappings.clear();
+    prefetch_state_->idle.wait(
+        lock, [this]() { return prefetch_state_->running == 0; });
+  }
+  std::scoped_lock lock(index_mutex_);
+  index_ready_ = false;
+  index_.clear();
+}
+
+void AssetManager::BuildIndex() const {
+  if (index_ready_) {
+    return;
+  }
+  std::scoped_lock lock(index_mutex_);
+  if (index_ready_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "AssetManager::BuildIndex");
+  for (size_t i = 0; i < resolvers_.size(); i++) {
+    std::optional<std::vector<std::string>> asset_names =
+        resolvers_[i]->ListAssets();
+    if (!asset_names.has_value()) {
+      break;
+    }
+    for (auto& asset_name : asset_names.value()) {
+      // Earlier resolvers take precedence.
+      index_.emplace(std::move(asset_name), i);
+    }
+  }
+  index_ready_ = true;
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::ResolveAsMapping(
+    const std::string& asset_name) const {
+  if (index_ready_) {
+    auto found = index_.find(asset_name);
+    if (found != index_.end()) {
+      auto mapping = resolvers_[found->second]->GetAsMapping(asset_name);
+      if (mapping != nullptr) {
+        return mapping;
+      }
+    }
+  }
+  // Fall back to asking every resolver, which also finds assets that were
+  // added after the index was built.
+  for (const auto& resolver : resolvers_) {
+    auto mapping = resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      return mapping;
+    }
+  }
+  return nullptr;
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,12 +213,19 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
-  for (const auto& resolver : resolvers_) {
-    auto mapping = resolver->GetAsMapping(asset_name);
-    if (mapping != nullptr) {
+  {
+    std::scoped_lock lock(prefetch_state_->mutex);
+    auto found = prefetch_state_->mappings.find(asset_name);
+    if (found != prefetch_state_->mappings.end()) {
+      auto mapping = std::move(found->second);
+      prefetch_state_->mappings.erase(found);
       return mapping;
     }
   }
+  auto mapping = ResolveAsMapping(asset_name);
+  if (mapping != nullptr) {
+    return mapping;
+  }
   FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
   return nullptr;
 }
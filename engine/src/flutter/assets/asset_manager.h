@@ -5,14 +5,20 @@
 #ifndef FLUTTER_ASSETS_ASSET_MANAGER_H_
 #define FLUTTER_ASSETS_ASSET_MANAGER_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
@@ -70,6 +76,34 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Maps the given assets on `task_runner` ahead of time. A later
+  ///             call to GetAsMapping() for one of them hands over the
+  ///             prefetched mapping instead of opening the asset on the
+  ///             calling thread. Each prefetched mapping is handed over once;
+  ///             later requests for the same asset load it again.
+  ///
+  ///             The first prefetch also builds an index of the assets of
+  ///             every resolver that can list them, which routes later
+  ///             lookups straight to the resolver holding the asset.
+  ///
+  ///             Adding, replacing or taking resolvers cancels outstanding
+  ///             prefetches and drops prefetched mappings and the index.
+  ///
+  /// @param[in]  asset_names  The assets that will be requested soon.
+  ///
+  /// @param[in]  task_runner  The task runner to load the assets on, usually
+  ///                          the concurrent worker task runner. Assets are
+  ///                          loaded in parallel if it has several threads.
+  ///
+  /// @param[in]  on_done  Called on `task_runner` after every asset has been
+  ///                      prefetched, or skipped because the prefetch was
+  ///                      cancelled. Optional.
+  ///
+  void PrefetchAssets(std::vector<std::string> asset_names,
+                      const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                      const fml::closure& on_done = nullptr);
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -95,7 +129,37 @@ class AssetManager final : public AssetResolver {
   const AssetManager* as_asset_manager() const override { return this; }
 
  private:
+  // State shared with the prefetch tasks, which may outlive this manager.
+  struct PrefetchState {
+    std::mutex mutex;
+    std::condition_variable idle;
+    // Incremented to cancel all outstanding prefetches.
+    uint64_t generation = 0;
+    // The number of prefetch tasks that are currently using the resolvers.
+    size_t running = 0;
+    std::unordered_map<std::string, std::unique_ptr<fml::Mapping>> mappings;
+  };
+
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
+  std::shared_ptr<PrefetchState> prefetch_state_ =
+      std::make_shared<PrefetchState>();
+
+  // Maps asset names to the position of the first resolver that holds them.
+  // Only resolvers before the first one that cannot list its assets are
+  // indexed, so that a routed lookup returns the same asset as a walk over
+  // all resolvers. Immutable once |index_ready_| is set.
+  mutable std::mutex index_mutex_;
+  mutable std::atomic<bool> index_ready_{false};
+  mutable std::unordered_map<std::string, size_t> index_;
+
+  // Cancels outstanding prefetches and waits for running ones to finish, so
+  // that the resolvers can be changed.
+  void CancelPrefetches();
+
+  void BuildIndex() const;
+
+  std::unique_ptr<fml::Mapping> ResolveAsMapping(
+      const std::string& asset_name) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
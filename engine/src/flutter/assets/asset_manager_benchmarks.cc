@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kAssetSize = 16 * 1024;
+constexpr size_t kDirectoryCount = 32;
+
+// A directory asset bundle with |asset_count| assets spread over
+// |kDirectoryCount| subdirectories, like the fonts, shaders and images of an
+// app.
+class AssetDirectory {
+ public:
+  explicit AssetDirectory(size_t asset_count) {
+    const fml::DataMapping contents(std::vector<uint8_t>(kAssetSize, 0xAB));
+    std::vector<fml::UniqueFD> directories;
+    for (size_t i = 0; i < kDirectoryCount; i++) {
+      directories.push_back(fml::CreateDirectory(
+          directory_.fd(), {"dir" + std::to_string(i)},
+          fml::FilePermission::kReadWrite));
+    }
+    for (size_t i = 0; i < asset_count; i++) {
+      const size_t directory = i % kDirectoryCount;
+      const std::string name = "asset" + std::to_string(i) + ".bin";
+      FML_CHECK(
+          fml::WriteAtomically(directories[directory], name.c_str(), contents));
+      asset_names_.push_back("dir" + std::to_string(directory) + "/" + name);
+    }
+  }
+
+  const std::vector<std::string>& asset_names() const { return asset_names_; }
+
+  // Creates an asset manager as the shell does at startup, with an empty
+  // devFS-like directory in front of the app's asset directory.
+  std::unique_ptr<AssetManager> CreateAssetManager() const {
+    auto asset_manager = std::make_unique<AssetManager>();
+    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+        fml::OpenDirectory(empty_directory_.path().c_str(), false,
+                           fml::FilePermission::kRead),
+        false));
+    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+        fml::OpenDirectory(directory_.path().c_str(), false,
+                           fml::FilePermission::kRead),
+        true));
+    return asset_manager;
+  }
+
+ private:
+  fml::ScopedTemporaryDirectory directory_;
+  fml::ScopedTemporaryDirectory empty_directory_;
+  std::vector<std::string> asset_names_;
+};
+
+size_t ReadAsset(const fml::Mapping& mapping) {
+  size_t sum = 0;
+  for (size_t offset = 0; offset < mapping.GetSize(); offset += 4096) {
+    sum += mapping.GetMapping()[offset];
+  }
+  return sum;
+}
+
+}  // namespace
+
+// Loads every asset on the calling thread, as happens without prefetching.
+static void BM_AssetManagerLoadAssets(benchmark::State& state) {
+  AssetDirectory directory(state.range(0));
+  for (auto _ : state) {
+    auto asset_manager = directory.CreateAssetManager();
+    size_t sum = 0;
+    for (const auto& asset_name : directory.asset_names()) {
+      sum += ReadAsset(*asset_manager->GetAsMapping(asset_name));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AssetManagerLoadAssets)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Unit(benchmark::kMillisecond);
+
+// Prefetches every asset on the worker threads and then loads them on the
+// calling thread.
+static void BM_AssetManagerLoadPrefetchedAssets(benchmark::State& state) {
+  AssetDirectory directory(state.range(0));
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  for (auto _ : state) {
+    auto asset_manager = directory.CreateAssetManager();
+    fml::AutoResetWaitableEvent prefetched;
+    asset_manager->PrefetchAssets(directory.asset_names(),
+                                  loop->GetTaskRunner(),
+                                  [&prefetched]() { prefetched.Signal(); });
+    prefetched.Wait();
+    size_t sum = 0;
+    for (const auto& asset_name : directory.asset_names()) {
+      sum += ReadAsset(*asset_manager->GetAsMapping(asset_name));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AssetManagerLoadPrefetchedAssets)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace flutter
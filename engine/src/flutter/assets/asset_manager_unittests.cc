@@ -0,0 +1,237 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Runs posted tasks only when asked to.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  void RunPendingTasks() {
+    std::vector<fml::closure> tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+void WriteAsset(const fml::UniqueFD& directory,
+                const std::string& name,
+                const std::string& contents) {
+  fml::DataMapping mapping(contents);
+  ASSERT_TRUE(fml::WriteAtomically(directory, name.c_str(), mapping));
+}
+
+// Serves assets from memory and counts how often it is asked for one.
+class TestAssetResolver : public AssetResolver {
+ public:
+  explicit TestAssetResolver(std::map<std::string, std::string> assets,
+                             bool can_list_assets = true)
+      : assets_(std::move(assets)), can_list_assets_(can_list_assets) {}
+
+  void AddAsset(const std::string& name, const std::string& contents) {
+    assets_[name] = contents;
+  }
+
+  size_t lookups() const { return lookups_; }
+
+  // |AssetResolver|
+  bool IsValid() const override { return true; }
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override { return false; }
+
+  // |AssetResolver|
+  AssetResolverType GetType() const override {
+    return AssetResolverType::kDirectoryAssetBundle;
+  }
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookups_++;
+    auto found = assets_.find(asset_name);
+    if (found == assets_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(found->second);
+  }
+
+  // |AssetResolver|
+  std::optional<std::vector<std::string>> ListAssets() const override {
+    if (!can_list_assets_) {
+      return std::nullopt;
+    }
+    std::vector<std::string> asset_names;
+    for (const auto& asset : assets_) {
+      asset_names.push_back(asset.first);
+    }
+    return asset_names;
+  }
+
+  // |AssetResolver|
+  bool operator==(const AssetResolver& other) const override {
+    return this == &other;
+  }
+
+ private:
+  std::map<std::string, std::string> assets_;
+  const bool can_list_assets_;
+  mutable size_t lookups_ = 0;
+};
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  if (!mapping) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+std::unique_ptr<DirectoryAssetBundle> OpenBundle(
+    const fml::ScopedTemporaryDirectory& directory) {
+  return std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(directory.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false);
+}
+
+}  // namespace
+
+TEST(AssetManagerTest, DirectoryAssetBundleListsNestedAssets) {
+  fml::ScopedTemporaryDirectory directory;
+  auto fonts = fml::CreateDirectory(directory.fd(), {"fonts"},
+                                    fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(fonts.is_valid());
+  WriteAsset(fonts, "Roboto.ttf", "font");
+  WriteAsset(directory.fd(), "AssetManifest.bin", "manifest");
+
+  std::unique_ptr<AssetResolver> bundle = OpenBundle(directory);
+  auto asset_names = bundle->ListAssets();
+  ASSERT_TRUE(asset_names.has_value());
+  std::sort(asset_names->begin(), asset_names->end());
+  std::vector<std::string> expected = {"AssetManifest.bin",
+                                       "fonts/Roboto.ttf"};
+  EXPECT_EQ(asset_names.value(), expected);
+}
+
+TEST(AssetManagerTest, PrefetchedAssetsAreHandedOverOnce) {
+  auto resolver = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"shader.frag", "shader"}});
+  TestAssetResolver* test_resolver = resolver.get();
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(resolver)));
+
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  bool done = false;
+  asset_manager.PrefetchAssets({"shader.frag", "missing.frag"}, task_runner,
+                               [&done]() { done = true; });
+  EXPECT_FALSE(done);
+  EXPECT_EQ(test_resolver->lookups(), 0u);
+  task_runner->RunPendingTasks();
+  EXPECT_TRUE(done);
+  EXPECT_EQ(test_resolver->lookups(), 2u);
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("shader.frag")), "shader");
+  EXPECT_EQ(test_resolver->lookups(), 2u);
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("shader.frag")), "shader");
+  EXPECT_EQ(test_resolver->lookups(), 3u);
+  EXPECT_EQ(asset_manager.GetAsMapping("missing.frag"), nullptr);
+}
+
+TEST(AssetManagerTest, IndexedLookupsGoToTheFirstResolverWithTheAsset) {
+  auto first = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"image.png", "first"}});
+  auto second = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"image.png", "second"},
+                                         {"font.ttf", "font"}});
+  TestAssetResolver* first_resolver = first.get();
+  TestAssetResolver* second_resolver = second.get();
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(first)));
+  ASSERT_TRUE(asset_manager.PushBack(std::move(second)));
+
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  asset_manager.PrefetchAssets({"font.ttf"}, task_runner);
+  task_runner->RunPendingTasks();
+  EXPECT_EQ(first_resolver->lookups(), 0u);
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("font.ttf")), "font");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("font.ttf")), "font");
+  EXPECT_EQ(first_resolver->lookups(), 0u);
+  EXPECT_EQ(second_resolver->lookups(), 2u);
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("image.png")), "first");
+  EXPECT_EQ(second_resolver->lookups(), 2u);
+
+  // Assets added after the index was built are still found.
+  second_resolver->AddAsset("late.txt", "late");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("late.txt")), "late");
+}
+
+TEST(AssetManagerTest, ResolversThatCannotListAssetsAreNotSkipped) {
+  auto first = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"image.png", "first"}},
+      /*can_list_assets=*/false);
+  auto second = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"image.png", "second"}});
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(first)));
+  ASSERT_TRUE(asset_manager.PushBack(std::move(second)));
+
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  asset_manager.PrefetchAssets({"other.png"}, task_runner);
+  task_runner->RunPendingTasks();
+
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("image.png")), "first");
+}
+
+TEST(AssetManagerTest, ChangingResolversCancelsPrefetches) {
+  auto resolver = std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a.txt", "a"}, {"b.txt", "b"}});
+  TestAssetResolver* test_resolver = resolver.get();
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(resolver)));
+
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  asset_manager.PrefetchAssets({"a.txt"}, task_runner);
+  task_runner->RunPendingTasks();
+  bool done = false;
+  asset_manager.PrefetchAssets({"b.txt"}, task_runner,
+                               [&done]() { done = true; });
+
+  ASSERT_TRUE(asset_manager.PushBack(std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{})));
+  task_runner->RunPendingTasks();
+  EXPECT_TRUE(done);
+  EXPECT_EQ(test_resolver->lookups(), 1u);
+
+  // Neither asset is served from a prefetch.
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("a.txt")), "a");
+  EXPECT_EQ(ToString(asset_manager.GetAsMapping("b.txt")), "b");
+  EXPECT_EQ(test_resolver->lookups(), 3u);
+}
+
+}  // namespace testing
+}  // namespace flutter
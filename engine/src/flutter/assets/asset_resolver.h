@@ -93,6 +93,20 @@ class AssetResolver {
     return {};
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief      Lists the names of all assets that GetAsMapping() can
+  ///             return, so that an AssetManager can route lookups directly
+  ///             to this resolver. May be called on a worker thread while
+  ///             assets are looked up on other threads.
+  ///
+  /// @return     Returns the asset names, or std::nullopt if this resolver
+  ///             cannot enumerate its assets.
+  ///
+  [[nodiscard]] virtual std::optional<std::vector<std::string>> ListAssets()
+      const {
+    return std::nullopt;
+  }
+
   virtual bool operator==(const AssetResolver& other) const = 0;
 
   bool operator!=(const AssetResolver& other) const {
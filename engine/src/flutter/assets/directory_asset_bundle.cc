@@ -110,6 +110,48 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+std::optional<std::vector<std::string>> DirectoryAssetBundle::ListAssets()
+    const {
+  if (!is_valid_) {
+    return std::nullopt;
+  }
+  TRACE_EVENT0("flutter", "DirectoryAssetBundle::ListAssets");
+
+  // Assets may be listed on a worker thread. Walk a freshly opened
+  // descriptor, as duplicates of |descriptor_| share its position in the
+  // directory with walks on other threads, such as GetAsMappings.
+  fml::UniqueFD bundle_directory =
+      fml::OpenDirectoryReadOnly(descriptor_, ".");
+  if (!bundle_directory.is_valid()) {
+    return std::nullopt;
+  }
+
+  // Asset names are paths relative to the bundle directory, so keep track of
+  // the subdirectories that lead to each file.
+  std::vector<std::string> asset_names;
+  std::string prefix;
+  fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
+                                 const std::string& filename) {
+    if (!fml::IsDirectory(directory, filename.c_str())) {
+      asset_names.push_back(prefix + filename);
+      return true;
+    }
+    fml::UniqueFD subdir_fd =
+        fml::OpenDirectoryReadOnly(directory, filename.c_str());
+    if (!subdir_fd.is_valid()) {
+      return true;
+    }
+    const size_t prefix_size = prefix.size();
+    prefix.append(filename).push_back('/');
+    fml::VisitFiles(subdir_fd, visitor);
+    prefix.resize(prefix_size);
+    return true;
+  };
+  fml::VisitFiles(bundle_directory, visitor);
+  return asset_names;
+}
+
 bool DirectoryAssetBundle::operator==(const AssetResolver& other) const {
   auto other_bundle = other.as_directory_asset_bundle();
   if (!other_bundle) {
@@ -43,6 +43,9 @@ class DirectoryAssetBundle : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  std::optional<std::vector<std::string>> ListAssets() const override;
+
   // |AssetResolver|
   bool operator==(const AssetResolver& other) const override;
 
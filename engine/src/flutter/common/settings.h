@@ -241,6 +241,17 @@ struct Settings {
   // An experimental mode that antialiases lines.
   bool impeller_antialiased_lines = false;
 
+  // The maximum size in bytes of each Impeller glyph atlas. Once an atlas
+  // reaches this size, the space of its least recently used glyphs is reused
+  // instead of growing the atlas. Zero means the atlas may grow up to the
+  // maximum texture size supported by the device.
+  size_t impeller_glyph_atlas_max_bytes = 0;
+
+  // The maximum number of pages in each Impeller glyph atlas. A paged atlas
+  // grows by adding pages instead of reallocating and copying a single larger
+  // texture. Zero disables paging.
+  size_t impeller_glyph_atlas_max_pages = 0;
+
   // Log a warning during shell initialization if Impeller is not enabled.
   bool warn_on_impeller_opt_out = false;
 
@@ -359,6 +370,33 @@ struct Settings {
   /// This is currently only used by iOS.
   bool enable_embedder_api = false;
 
+  /// Batch the pointer data packets received between two vsyncs, and merge
+  /// consecutive move and hover events of each pointer before dispatching them
+  /// to the framework.
+  ///
+  /// This reduces the cost of dispatching input from high rate devices, whose
+  /// intermediate positions the framework would otherwise resample away.
+  bool coalesce_pointer_moves = false;
+
+  /// Record the layer trees of multiple views concurrently on the worker
+  /// threads before drawing them on the raster thread.
+  ///
+  /// See |Rasterizer::SetConcurrentViewRasterization| for the surfaces and
+  /// layer trees this applies to.
+  bool enable_concurrent_view_rasterization = false;
+
+  /// The maximum size in bytes of the images in the raster cache of each
+  /// view, or 0 for unlimited.
+  ///
+  /// See |RasterCache::SetByteBudget| for how entries are chosen within the
+  /// budget.
+  size_t raster_cache_byte_budget = 0;
+
+  /// Rasterize new display list entries of the raster cache on the worker
+  /// threads instead of the raster thread. Only software surfaces are
+  /// supported.
+  bool enable_concurrent_raster_cache_rasterization = false;
+
   /// Enable support for isolates that run on the platform thread.
   ///
   /// This is used by the runOnPlatformThread API.
@@ -310,6 +310,28 @@ static void BM_DisplayListDispatchByVectorCull(
   }
 }
 
+// Builds one display list per "frame" while the display list of the previous
+// frame is still alive, as the framework does, and reports how much of the
+// storage was recycled from the display lists of earlier frames.
+static void BM_DisplayListBuilderFrameLoop(benchmark::State& state) {
+  DisplayListStoragePool& pool = DisplayListStoragePool::Instance();
+  pool.Purge();
+  DisplayListStoragePool::Stats start_stats = pool.GetStats();
+  sk_sp<DisplayList> previous_frame;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder;
+    InvokeAllOps(builder);
+    previous_frame = builder.Build();
+  }
+  DisplayListStoragePool::Stats stats = pool.GetStats();
+  state.counters["ReusedBytes"] = benchmark::Counter(
+      stats.reused_bytes - start_stats.reused_bytes,
+      benchmark::Counter::kAvgIterations);
+  state.counters["AllocatedBytes"] = benchmark::Counter(
+      stats.allocated_bytes - start_stats.allocated_bytes,
+      benchmark::Counter::kAvgIterations);
+}
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -464,4 +486,6 @@ BENCHMARK_CAPTURE(BM_DisplayListDispatchByVectorCull,
                   DisplayListDispatchBenchmarkType::kCulledWithRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_DisplayListBuilderFrameLoop)->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <random>
+
+namespace {
+
+using DlRect = flutter::DlRect;
+using DlRTree = flutter::DlRTree;
+
+/// Generate |count| rects laid out roughly from top to bottom, as the ops of
+/// a long scrolling display list would be.
+std::vector<DlRect> GenerateScrollingRects(int count) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  std::uniform_real_distribution<float> x(0, 1000);
+  std::uniform_real_distribution<float> jitter(-50, 50);
+  std::uniform_real_distribution<float> size(5, 200);
+
+  std::vector<DlRect> rects;
+  rects.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    float y = i * 2.0f + jitter(rng);
+    rects.push_back(DlRect::MakeXYWH(x(rng), y, size(rng), size(rng)));
+  }
+  return rects;
+}
+
+/// Generate |count| query rects the size of a viewport, or of one of
+/// |count| horizontal slices of a viewport, scrolled into the middle of
+/// the rects generated by |GenerateScrollingRects|.
+std::vector<DlRect> GenerateQueries(int rect_count, int count, bool slices) {
+  std::vector<DlRect> queries;
+  float viewport_top = rect_count * 0.5f;
+  float slice_height = slices ? 2000.0f / count : 2000.0f;
+  for (int i = 0; i < count; ++i) {
+    float top = viewport_top + (slices ? i * slice_height : i * 10.0f);
+    queries.push_back(DlRect::MakeXYWH(0, top, 1000, slice_height));
+  }
+  return queries;
+}
+
+}  // namespace
+
+namespace flutter {
+
+static void BM_DlRTree_Search(benchmark::State& state,
+                              int query_count,
+                              bool slices) {
+  int rect_count = state.range(0);
+  auto rects = GenerateScrollingRects(rect_count);
+  DlRTree tree(rects.data(), rects.size());
+  auto queries = GenerateQueries(rect_count, query_count, slices);
+
+  std::vector<int> results;
+  size_t result_count = 0u;
+  while (state.KeepRunning()) {
+    for (const DlRect& query : queries) {
+      results.clear();
+      tree.search(query, &results);
+      result_count += results.size();
+    }
+  }
+  benchmark::DoNotOptimize(result_count);
+  state.SetItemsProcessed(state.iterations() * query_count);
+}
+
+static void BM_DlRTree_BatchSearch(benchmark::State& state,
+                                   int query_count,
+                                   bool slices) {
+  int rect_count = state.range(0);
+  auto rects = GenerateScrollingRects(rect_count);
+  DlRTree tree(rects.data(), rects.size());
+  auto queries = GenerateQueries(rect_count, query_count, slices);
+
+  std::vector<std::vector<int>> results(query_count);
+  size_t result_count = 0u;
+  while (state.KeepRunning()) {
+    for (std::vector<int>& query_results : results) {
+      query_results.clear();
+    }
+    tree.search(queries.data(), query_count, results.data());
+    for (const std::vector<int>& query_results : results) {
+      result_count += query_results.size();
+    }
+  }
+  benchmark::DoNotOptimize(result_count);
+  state.SetItemsProcessed(state.iterations() * query_count);
+}
+
+BENCHMARK_CAPTURE(BM_DlRTree_Search, SingleViewport, 1, false)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, FourSlices, 4, true)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_BatchSearch, FourSlices, 4, true)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, SixteenSlices, 16, true)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_BatchSearch, SixteenSlices, 16, true)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, SixtyFourViewports, 64, false)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_BatchSearch, SixtyFourViewports, 64, false)
+    ->RangeMultiplier(4)
+    ->Range(256, 65536)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
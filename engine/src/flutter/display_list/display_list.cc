@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
@@ -59,8 +60,11 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       root_has_backdrop_filter_(root_has_backdrop_filter),
       root_is_unbounded_(root_is_unbounded),
       max_root_blend_mode_(max_root_blend_mode),
-      rtree_(std::move(rtree)) {
-  FML_DCHECK(storage_.capacity() == storage_.size());
+      rtree_(std::move(rtree)),
+      op_fingerprints_(rtree_ ? ComputeOpFingerprints(storage_, offsets_)
+                              : std::vector<uint64_t>()) {
+  FML_DCHECK(storage_.capacity() - storage_.size() <
+             DisplayListStorage::kDLPageSize);
 }
 
 DisplayList::~DisplayList() {
@@ -382,6 +386,25 @@ std::vector<DlIndex> DisplayList::GetCulledIndices(
   return indices;
 }
 
+std::vector<std::vector<DlIndex>> DisplayList::GetCulledIndices(
+    const std::vector<DlRect>& cull_rects) const {
+  std::vector<std::vector<DlIndex>> indices(cull_rects.size());
+  if (rtree_) {
+    std::vector<std::vector<int>> rect_indices(cull_rects.size());
+    rtree_->search(cull_rects.data(), cull_rects.size(), rect_indices.data());
+    for (size_t i = 0; i < cull_rects.size(); i++) {
+      RTreeResultsToIndexVector(indices[i], rect_indices[i]);
+    }
+  } else {
+    for (size_t i = 0; i < cull_rects.size(); i++) {
+      if (!cull_rects[i].IsEmpty()) {
+        FillAllIndices(indices[i], offsets_.size());
+      }
+    }
+  }
+  return indices;
+}
+
 bool DisplayList::Dispatch(DlOpReceiver& receiver, DlIndex index) const {
   // Assert unsigned type so we can eliminate >= 0 comparison
   static_assert(std::is_unsigned_v<DlIndex>);
@@ -398,6 +421,24 @@ bool DisplayList::Dispatch(DlOpReceiver& receiver, DlIndex index) const {
   return true;
 }
 
+static DisplayListCompare CompareOp(const DLOp* opA, const DLOp* opB) {
+  FML_DCHECK(opA->type == opB->type);
+  switch (opA->type) {
+#define DL_OP_EQUALS(name)                            \
+  case DisplayListOpType::k##name:                    \
+    return static_cast<const name##Op*>(opA)->equals( \
+        static_cast<const name##Op*>(opB));
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+
+#undef DL_OP_EQUALS
+
+    default:
+      FML_DCHECK(false);
+      return DisplayListCompare::kNotEqual;
+  }
+}
+
 static bool CompareOps(const DisplayListStorage& storageA,
                        const std::vector<size_t>& offsetsA,
                        const DisplayListStorage& storageB,
@@ -416,23 +457,7 @@ static bool CompareOps(const DisplayListStorage& storageA,
     if (opA->type != opB->type) {
       return false;
     }
-    DisplayListCompare result;
-    switch (opA->type) {
-#define DL_OP_EQUALS(name)                              \
-  case DisplayListOpType::k##name:                      \
-    result = static_cast<const name##Op*>(opA)->equals( \
-        static_cast<const name##Op*>(opB));             \
-    break;
-
-      FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
-
-#undef DL_OP_EQUALS
-
-      default:
-        FML_DCHECK(false);
-        return false;
-    }
-    switch (result) {
+    switch (CompareOp(opA, opB)) {
       case DisplayListCompare::kNotEqual:
         return false;
       case DisplayListCompare::kUseBulkCompare:
@@ -478,4 +503,232 @@ bool DisplayList::Equals(const DisplayList* other) const {
   return CompareOps(storage_, offsets_, other->storage_, other->offsets_);
 }
 
+// Ops that do not override |DLOp::equals| are compared byte for byte.
+template <typename T>
+static constexpr bool kOpUsesBulkCompare =
+    std::is_same_v<decltype(&T::equals), decltype(&DLOp::equals)>;
+
+static bool OpUsesBulkCompare(DisplayListOpType type) {
+  switch (type) {
+#define DL_OP_USES_BULK_COMPARE(name) \
+  case DisplayListOpType::k##name:    \
+    return kOpUsesBulkCompare<name##Op>;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_USES_BULK_COMPARE)
+
+#undef DL_OP_USES_BULK_COMPARE
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+}
+
+// A variant of 64-bit FNV-1a that consumes 4 bytes at a time. Ops are
+// always padded with zeroes to a multiple of (at least) 4 bytes.
+static uint64_t HashOpBytes(uint64_t hash,
+                            const uint8_t* start,
+                            const uint8_t* end) {
+  static constexpr uint64_t kPrime = 0x100000001b3u;
+  for (; start + sizeof(uint32_t) <= end; start += sizeof(uint32_t)) {
+    uint32_t word;
+    memcpy(&word, start, sizeof(word));
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; start < end; start++) {
+    hash = (hash ^ *start) * kPrime;
+  }
+  return hash;
+}
+
+std::vector<uint64_t> DisplayList::ComputeOpFingerprints(
+    const DisplayListStorage& storage,
+    const std::vector<size_t>& offsets) {
+  static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325u;
+  std::vector<uint64_t> fingerprints;
+  fingerprints.reserve(offsets.size());
+  const uint8_t* base = storage.base();
+  for (size_t i = 0; i < offsets.size(); i++) {
+    const uint8_t* start = base + offsets[i];
+    const uint8_t* end =
+        base + (i + 1 < offsets.size() ? offsets[i + 1] : storage.size());
+    auto op = reinterpret_cast<const DLOp*>(start);
+    uint64_t fingerprint;
+    switch (op->type) {
+      case DisplayListOpType::kSaveLayerBackdrop:
+        // A change to the ops rendered before a backdrop filter changes
+        // what it reads back, well beyond the RTree bounds of those ops.
+        return {};
+      case DisplayListOpType::kSave:
+      case DisplayListOpType::kSaveLayer: {
+        auto save_op = static_cast<const SaveOpBase*>(op);
+        if (save_op->options.contains_backdrop_filter()) {
+          return {};
+        }
+        // The restore index and content depth of a save change whenever
+        // ops are added to or removed from its content, which does not
+        // change how the save itself renders, so they are left out.
+        auto skip_start =
+            reinterpret_cast<const uint8_t*>(&save_op->restore_index);
+        auto skip_end =
+            reinterpret_cast<const uint8_t*>(&save_op->total_content_depth + 1);
+        fingerprint = HashOpBytes(kOffsetBasis, start, skip_start);
+        fingerprint = HashOpBytes(fingerprint, skip_end, end);
+        break;
+      }
+      default:
+        if (OpUsesBulkCompare(op->type)) {
+          fingerprint = HashOpBytes(kOffsetBasis, start, end);
+        } else {
+          // Ops with their own equals method hold references that can
+          // differ between equal ops, so only their type is fingerprinted
+          // and ops with matching fingerprints are compared by |OpMatches|.
+          fingerprint = HashOpBytes(kOffsetBasis, start, start + sizeof(DLOp));
+        }
+        break;
+    }
+    fingerprints.push_back(fingerprint);
+  }
+  return fingerprints;
+}
+
+bool DisplayList::OpMatches(DlIndex index,
+                            const DisplayList& other,
+                            DlIndex other_index) const {
+  if (op_fingerprints_[index] != other.op_fingerprints_[other_index]) {
+    return false;
+  }
+  auto op = reinterpret_cast<const DLOp*>(storage_.base() + offsets_[index]);
+  auto other_op = reinterpret_cast<const DLOp*>(other.storage_.base() +
+                                                other.offsets_[other_index]);
+  if (op->type != other_op->type) {
+    return false;
+  }
+  switch (CompareOp(op, other_op)) {
+    case DisplayListCompare::kNotEqual:
+      return false;
+    case DisplayListCompare::kEqual:
+      return true;
+    case DisplayListCompare::kUseBulkCompare:
+      break;
+  }
+  // Matching fingerprints are not proof of equal bytes, and a collision
+  // would drop real damage, so the bytes are compared as in |Equals|.
+  auto start = reinterpret_cast<const uint8_t*>(op);
+  auto other_start = reinterpret_cast<const uint8_t*>(other_op);
+  const size_t size = GetOpSize(index);
+  if (size != other.GetOpSize(other_index)) {
+    return false;
+  }
+  if (op->type == DisplayListOpType::kSave ||
+      op->type == DisplayListOpType::kSaveLayer) {
+    // As in the fingerprint, the restore index and content depth are left
+    // out of the comparison.
+    auto save_op = static_cast<const SaveOpBase*>(op);
+    const size_t skip_start =
+        reinterpret_cast<const uint8_t*>(&save_op->restore_index) - start;
+    const size_t skip_end =
+        reinterpret_cast<const uint8_t*>(&save_op->total_content_depth + 1) -
+        start;
+    return memcmp(start, other_start, skip_start) == 0 &&
+           memcmp(start + skip_end, other_start + skip_end,
+                  size - skip_end) == 0;
+  }
+  return memcmp(start, other_start, size) == 0;
+}
+
+size_t DisplayList::GetOpSize(DlIndex index) const {
+  const size_t end =
+      index + 1 < offsets_.size() ? offsets_[index + 1] : storage_.size();
+  return end - offsets_[index];
+}
+
+void DisplayList::AccumulateOpBounds(const std::vector<bool>& ops,
+                                     DlRect& bounds) const {
+  FML_DCHECK(rtree_);
+  for (int i = 0; i < rtree_->leaf_count(); i++) {
+    int id = rtree_->id(i);
+    FML_DCHECK(id >= 0 && static_cast<size_t>(id) < ops.size());
+    if (ops[id]) {
+      bounds = bounds.Union(rtree_->bounds(i));
+    }
+  }
+}
+
+static bool IsRenderingOp(DisplayListOpCategory category) {
+  return category == DisplayListOpCategory::kRendering ||
+         category == DisplayListOpCategory::kSubDisplayList;
+}
+
+std::optional<DlRect> DisplayList::GetChangedBounds(
+    const DisplayList& other) const {
+  if (this == &other) {
+    return DlRect();
+  }
+  if (!has_op_fingerprints() || !other.has_op_fingerprints() ||
+      root_has_backdrop_filter_ || other.root_has_backdrop_filter_) {
+    return std::nullopt;
+  }
+  const DlIndex count = offsets_.size();
+  const DlIndex other_count = other.offsets_.size();
+
+  // Skip the ops that match at the start and at the end of both lists.
+  DlIndex prefix = 0u;
+  while (prefix < count && prefix < other_count &&
+         OpMatches(prefix, other, prefix)) {
+    prefix++;
+  }
+  DlIndex suffix = 0u;
+  while (prefix + suffix < count && prefix + suffix < other_count &&
+         OpMatches(count - 1 - suffix, other, other_count - 1 - suffix)) {
+    suffix++;
+  }
+  const DlIndex end = count - suffix;
+  const DlIndex other_end = other_count - suffix;
+
+  // Rendering ops only affect the pixels within their RTree bounds, but
+  // any other op affects how all of the ops that follow it render.
+  std::vector<bool> changed(count, false);
+  std::vector<bool> other_changed(other_count, false);
+  auto change_all_ops_from = [&changed, &other_changed](DlIndex index) {
+    std::fill(changed.begin() + index, changed.end(), true);
+    std::fill(other_changed.begin() + index, other_changed.end(), true);
+  };
+  if (end == other_end) {
+    // The same number of ops differ in both lists, as when the values of
+    // some of the ops are animated, so they can be compared in pairs.
+    for (DlIndex i = prefix; i < end; i++) {
+      if (OpMatches(i, other, i)) {
+        continue;
+      }
+      if (!IsRenderingOp(GetOpCategory(i)) ||
+          !IsRenderingOp(other.GetOpCategory(i))) {
+        change_all_ops_from(i);
+        break;
+      }
+      changed[i] = other_changed[i] = true;
+    }
+  } else {
+    bool only_rendering_ops = true;
+    for (DlIndex i = prefix; i < end && only_rendering_ops; i++) {
+      only_rendering_ops = IsRenderingOp(GetOpCategory(i));
+    }
+    for (DlIndex i = prefix; i < other_end && only_rendering_ops; i++) {
+      only_rendering_ops = IsRenderingOp(other.GetOpCategory(i));
+    }
+    if (only_rendering_ops) {
+      std::fill(changed.begin() + prefix, changed.begin() + end, true);
+      std::fill(other_changed.begin() + prefix,
+                other_changed.begin() + other_end, true);
+    } else {
+      change_all_ops_from(prefix);
+    }
+  }
+
+  DlRect bounds;
+  AccumulateOpBounds(changed, bounds);
+  other.AccumulateOpBounds(other_changed, bounds);
+  return bounds;
+}
+
 }  // namespace flutter
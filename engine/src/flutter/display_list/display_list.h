@@ -300,6 +300,22 @@ class DisplayList : public SkRefCnt {
     return Equals(other.get());
   }
 
+  /// @brief   Return the bounds, in the coordinate space of the DisplayList,
+  ///          of the area in which rendering this DisplayList might produce
+  ///          different pixels than rendering |other|.
+  ///
+  /// The ops of the two DisplayLists are matched using fingerprints that
+  /// are computed when they are built, and only the RTree bounds of the
+  /// rendering ops that do not match contribute to the result. An attribute,
+  /// transform, clip or save layer op that does not match affects all of
+  /// the rendering ops that follow it.
+  ///
+  /// Returns |std::nullopt| if the difference cannot be narrowed down to
+  /// less than the bounds of both DisplayLists, which is the case unless
+  /// both of them were built with an RTree, or if either of them uses a
+  /// backdrop filter.
+  std::optional<DlRect> GetChangedBounds(const DisplayList& other) const;
+
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
   bool isUIThreadSafe() const { return is_ui_thread_safe_; }
 
@@ -500,6 +516,18 @@ class DisplayList : public SkRefCnt {
   /// @see |Dispatch(receiver, index)|
   std::vector<DlIndex> GetCulledIndices(const DlRect& cull_rect) const;
 
+  /// @brief   Return, for each of the indicated cull_rects, the vector of
+  ///          indices that |GetCulledIndices| would return for it.
+  ///
+  /// The RTree is traversed once for a whole batch of cull rects rather
+  /// than once per cull rect, which is cheaper when the same DisplayList
+  /// is rendered in several regions, such as the slices between platform
+  /// views.
+  ///
+  /// @see |GetCulledIndices(cull_rect)|
+  std::vector<std::vector<DlIndex>> GetCulledIndices(
+      const std::vector<DlRect>& cull_rects) const;
+
  private:
   DisplayList(DisplayListStorage&& ptr,
               std::vector<size_t>&& offsets,
@@ -542,6 +570,27 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
+  // A hash of each op used by |GetChangedBounds| to match the ops of two
+  // DisplayLists. They are only computed when there is an RTree, and are
+  // left empty if the ops cannot be matched.
+  const std::vector<uint64_t> op_fingerprints_;
+
+  static std::vector<uint64_t> ComputeOpFingerprints(
+      const DisplayListStorage& storage,
+      const std::vector<size_t>& offsets);
+
+  bool has_op_fingerprints() const {
+    return rtree_ && op_fingerprints_.size() == offsets_.size();
+  }
+
+  bool OpMatches(DlIndex index,
+                 const DisplayList& other,
+                 DlIndex other_index) const;
+
+  size_t GetOpSize(DlIndex index) const;
+
+  void AccumulateOpBounds(const std::vector<bool>& ops, DlRect& bounds) const;
+
   void DispatchOneOp(DlOpReceiver& receiver, const uint8_t* ptr) const;
 
   void RTreeResultsToIndexVector(std::vector<DlIndex>& indices,
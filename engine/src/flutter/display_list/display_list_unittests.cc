@@ -3316,6 +3316,25 @@ TEST_F(DisplayListTest, RTreeRenderCulling) {
           << "using culled indices on cull rect " << cull_rectf  //
           << " where " << label;
     }
+
+    {  // Test using batched vectors of culled indices
+      auto batched_indices = main->GetCulledIndices(
+          std::vector<DlRect>{DlRect(), cull_rectf, cull_rectf});
+      ASSERT_EQ(batched_indices.size(), 3u);
+      EXPECT_TRUE(batched_indices[0].empty());
+      EXPECT_EQ(batched_indices[1], main->GetCulledIndices(cull_rectf));
+      EXPECT_EQ(batched_indices[2], batched_indices[1]);
+
+      DisplayListBuilder culling_builder;
+      DlOpReceiver& receiver = ToReceiver(culling_builder);
+      for (DlIndex i : batched_indices[1]) {
+        EXPECT_TRUE(main->Dispatch(receiver, i));
+      }
+
+      EXPECT_TRUE(DisplayListsEQ_Verbose(culling_builder.Build(), expected))
+          << "using batched culled indices on cull rect " << cull_rectf  //
+          << " where " << label;
+    }
   };
 
   {  // No rects
@@ -5939,5 +5958,108 @@ TEST_F(DisplayListTest, DisplayListDetectsRuntimeEffect) {
   }
 }
 
+TEST_F(DisplayListTest, ChangedBoundsRequireRTree) {
+  DisplayListBuilder builder1(/*prepare_rtree=*/false);
+  builder1.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto dl1 = builder1.Build();
+  DisplayListBuilder builder2(/*prepare_rtree=*/true);
+  builder2.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto dl2 = builder2.Build();
+
+  EXPECT_FALSE(dl1->GetChangedBounds(*dl2).has_value());
+  EXPECT_FALSE(dl2->GetChangedBounds(*dl1).has_value());
+  EXPECT_EQ(dl2->GetChangedBounds(*dl2), DlRect());
+}
+
+TEST_F(DisplayListTest, ChangedBoundsOfEqualDisplayLists) {
+  auto build = []() {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+    DlPathBuilder path_builder;
+    path_builder.MoveTo({30, 30});
+    path_builder.LineTo({40, 30});
+    path_builder.LineTo({35, 40});
+    path_builder.Close();
+    builder.DrawPath(path_builder.TakePath(), DlPaint());
+    return builder.Build();
+  };
+  auto dl1 = build();
+  auto dl2 = build();
+
+  // The paths are distinct objects, but equal.
+  EXPECT_EQ(dl1->GetChangedBounds(*dl2), DlRect());
+}
+
+TEST_F(DisplayListTest, ChangedBoundsOfChangedRenderingOp) {
+  auto build = [](DlScalar offset) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+    builder.DrawRect(DlRect::MakeLTRB(50, 50, 60, 60).Shift(offset, 0),
+                     DlPaint());
+    builder.DrawRect(DlRect::MakeLTRB(90, 90, 100, 100), DlPaint());
+    return builder.Build();
+  };
+  auto dl1 = build(0);
+  auto dl2 = build(5);
+
+  EXPECT_EQ(dl1->GetChangedBounds(*dl2), DlRect::MakeLTRB(50, 50, 65, 60));
+  EXPECT_EQ(dl2->GetChangedBounds(*dl1), DlRect::MakeLTRB(50, 50, 65, 60));
+}
+
+TEST_F(DisplayListTest, ChangedBoundsOfInsertedRenderingOp) {
+  auto build = [](bool insert) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.Save();
+    builder.Translate(100, 100);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+    if (insert) {
+      builder.DrawRect(DlRect::MakeLTRB(50, 50, 60, 60), DlPaint());
+    }
+    builder.DrawRect(DlRect::MakeLTRB(90, 90, 100, 100), DlPaint());
+    builder.Restore();
+    return builder.Build();
+  };
+  auto dl1 = build(false);
+  auto dl2 = build(true);
+
+  // The inserted op is in the content of the save, which changes how many
+  // ops the save is restored after, but not how it renders.
+  EXPECT_EQ(dl1->GetChangedBounds(*dl2), DlRect::MakeLTRB(150, 150, 160, 160));
+  EXPECT_EQ(dl2->GetChangedBounds(*dl1), DlRect::MakeLTRB(150, 150, 160, 160));
+}
+
+TEST_F(DisplayListTest, ChangedBoundsOfChangedAttribute) {
+  auto build = [](DlColor color) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+    builder.DrawRect(DlRect::MakeLTRB(50, 50, 60, 60), DlPaint(color));
+    builder.DrawRect(DlRect::MakeLTRB(90, 90, 100, 100), DlPaint());
+    return builder.Build();
+  };
+  auto dl1 = build(DlColor::kBlack());
+  auto dl2 = build(DlColor::kRed());
+
+  // The ops that set the color affect every op that follows them.
+  EXPECT_EQ(dl1->GetChangedBounds(*dl2), DlRect::MakeLTRB(50, 50, 100, 100));
+  EXPECT_EQ(dl2->GetChangedBounds(*dl1), DlRect::MakeLTRB(50, 50, 100, 100));
+}
+
+TEST_F(DisplayListTest, ChangedBoundsWithBackdropFilter) {
+  auto build = [](DlScalar offset) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20).Shift(offset, 0),
+                     DlPaint());
+    auto filter = DlImageFilter::MakeBlur(5, 5, DlTileMode::kClamp);
+    builder.SaveLayer(DlRect::MakeLTRB(0, 0, 100, 100), nullptr,
+                      filter.get());
+    builder.Restore();
+    return builder.Build();
+  };
+  auto dl1 = build(0);
+  auto dl2 = build(5);
+
+  EXPECT_FALSE(dl1->GetChangedBounds(*dl2).has_value());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,10 @@
 
 #include "flutter/display_list/dl_storage.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
 namespace flutter {
 
 static constexpr inline bool is_power_of_two(int value) {
@@ -30,53 +34,180 @@ size_t DisplayListStorage::NextPowerOfTwoSize(size_t x) {
   return x + 1;
 }
 
-void DisplayListStorage::realloc(size_t count) {
-  ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-  FML_CHECK(ptr_);
-  allocated_ = count;
+static constexpr size_t RoundUpToPage(size_t size) {
+  constexpr size_t kPageMask = DisplayListStoragePool::kPageSize - 1;
+  return (size + kPageMask) & ~kPageMask;
+}
+
+// static
+DisplayListStoragePool& DisplayListStoragePool::Instance() {
+  // DisplayLists may be released during shutdown, so the pool is never
+  // destroyed.
+  static DisplayListStoragePool* instance = new DisplayListStoragePool();
+  return *instance;
+}
+
+DisplayListStoragePool::DisplayListStoragePool() = default;
+
+DisplayListStoragePool::~DisplayListStoragePool() {
+  Purge();
+}
+
+// static
+size_t DisplayListStoragePool::SizeClassOf(size_t size) {
+  FML_DCHECK(size >= kPageSize);
+  size_t size_class = 0u;
+  for (size_t pages = size / kPageSize; pages > 1u; pages >>= 1) {
+    size_class++;
+  }
+  return size_class;
+}
+
+uint8_t* DisplayListStoragePool::Acquire(size_t min_size, size_t* size) {
+  FML_DCHECK(size != nullptr);
+  static_assert(is_power_of_two(kPageSize),
+                "This math needs updating for non-pow2.");
+  min_size = std::max(RoundUpToPage(min_size), kPageSize);
+
+  // Every block in the smallest size class whose minimum is at least
+  // |min_size| is big enough.
+  size_t size_class = SizeClassOf(min_size);
+  if ((kPageSize << size_class) < min_size) {
+    size_class++;
+  }
+  if (size_class < kSizeClassCount) {
+    // Fresh blocks are rounded up to the minimum size of their class so that
+    // they can serve the same request once they are released.
+    min_size = kPageSize << size_class;
+    std::scoped_lock lock(mutex_);
+    auto& blocks = free_blocks_[size_class];
+    if (!blocks.empty()) {
+      auto [block, block_size] = blocks.back();
+      blocks.pop_back();
+      pooled_bytes_ -= block_size;
+      reused_bytes_.fetch_add(block_size, std::memory_order_relaxed);
+      *size = block_size;
+      return block;
+    }
+  }
+
+  uint8_t* block = static_cast<uint8_t*>(std::malloc(min_size));
+  FML_CHECK(block);
+  allocated_bytes_.fetch_add(min_size, std::memory_order_relaxed);
+  *size = min_size;
+  return block;
+}
+
+void DisplayListStoragePool::Release(uint8_t* block, size_t size) {
+  if (!block) {
+    return;
+  }
+  if (size >= kPageSize && SizeClassOf(size) < kSizeClassCount) {
+    std::scoped_lock lock(mutex_);
+    if (pooled_bytes_ + size <= kMaxPooledBytes) {
+      free_blocks_[SizeClassOf(size)].emplace_back(block, size);
+      pooled_bytes_ += size;
+      return;
+    }
+  }
+  std::free(block);
+}
+
+uint8_t* DisplayListStoragePool::Resize(uint8_t* block, size_t size) {
+  uint8_t* resized = static_cast<uint8_t*>(std::realloc(block, size));
+  FML_CHECK(resized);
+  return resized;
+}
+
+void DisplayListStoragePool::Purge() {
+  std::scoped_lock lock(mutex_);
+  for (auto& blocks : free_blocks_) {
+    for (auto& [block, block_size] : blocks) {
+      std::free(block);
+    }
+    blocks.clear();
+  }
+  pooled_bytes_ = 0u;
+}
+
+DisplayListStoragePool::Stats DisplayListStoragePool::GetStats() const {
+  Stats stats;
+  stats.reused_bytes = reused_bytes_.load(std::memory_order_relaxed);
+  stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+  {
+    std::scoped_lock lock(mutex_);
+    stats.pooled_bytes = pooled_bytes_;
+  }
+  return stats;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  reset();
 }
 
 uint8_t* DisplayListStorage::allocate(size_t needed) {
   if (used_ + needed > allocated_) {
-    static_assert(is_power_of_two(kDLPageSize),
-                  "This math needs updating for non-pow2.");
-
     // NPOT, with minimum size of kDLPageSize.
     size_t new_size = std::max(NextPowerOfTwoSize(used_ + needed), kDLPageSize);
     size_t old_size = allocated_;
-    realloc(new_size);
-    FML_CHECK(ptr_.get());
-    FML_CHECK(allocated_ == new_size);
-    FML_CHECK(allocated_ >= old_size);
+    uint8_t* old_ptr = ptr_;
+    DisplayListStoragePool& pool = DisplayListStoragePool::Instance();
+    ptr_ = pool.Acquire(new_size, &allocated_);
+    FML_CHECK(ptr_);
+    FML_CHECK(allocated_ >= new_size);
     FML_CHECK(used_ + needed <= allocated_);
-    memset(ptr_.get() + used_, 0, allocated_ - old_size);
+    if (old_ptr) {
+      memcpy(ptr_, old_ptr, used_);
+      pool.Release(old_ptr, old_size);
+    }
   }
-  uint8_t* ret = ptr_.get() + used_;
+  uint8_t* ret = ptr_ + used_;
+  // Recycled blocks hold the contents of previous display lists, and the
+  // ops are compared bytewise, including their padding.
+  memset(ret, 0, needed);
   used_ += needed;
   FML_CHECK(used_ <= allocated_);
   return ret;
 }
 
+void DisplayListStorage::trim() {
+  if (used_ == 0u) {
+    reset();
+    return;
+  }
+  size_t trimmed_size = RoundUpToPage(used_);
+  if (trimmed_size < allocated_) {
+    ptr_ = DisplayListStoragePool::Instance().Resize(ptr_, trimmed_size);
+    allocated_ = trimmed_size;
+  }
+}
+
 DisplayListStorage::DisplayListStorage(DisplayListStorage&& source) {
-  ptr_ = std::move(source.ptr_);
+  ptr_ = source.ptr_;
   used_ = source.used_;
   allocated_ = source.allocated_;
+  source.ptr_ = nullptr;
   source.used_ = 0u;
   source.allocated_ = 0u;
 }
 
 void DisplayListStorage::reset() {
-  ptr_.reset();
+  DisplayListStoragePool::Instance().Release(ptr_, allocated_);
+  ptr_ = nullptr;
   used_ = 0u;
   allocated_ = 0u;
 }
 
 DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& source) {
-  ptr_ = std::move(source.ptr_);
-  used_ = source.used_;
-  allocated_ = source.allocated_;
-  source.used_ = 0u;
-  source.allocated_ = 0u;
+  if (this != &source) {
+    reset();
+    ptr_ = source.ptr_;
+    used_ = source.used_;
+    allocated_ = source.allocated_;
+    source.ptr_ = nullptr;
+    source.used_ = 0u;
+    source.allocated_ = 0u;
+  }
   return *this;
 }
 
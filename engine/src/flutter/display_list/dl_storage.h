@@ -5,23 +5,97 @@
 #ifndef FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
 #define FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 
 namespace flutter {
 
-// Manages a buffer allocated with malloc.
+// A process wide pool of the blocks of memory used by DisplayListStorage.
+//
+// Building a DisplayList grows its storage one power of two at a time, and
+// every frame builds new DisplayLists while releasing those of the previous
+// frame. Instead of returning the memory of released DisplayLists to malloc,
+// their blocks are kept in free lists keyed by size class so that the next
+// builders (on any thread, for any isolate) can reuse them.
+class DisplayListStoragePool {
+ public:
+  // All blocks are a multiple of this size.
+  static const constexpr size_t kPageSize = 4096u;
+
+  // Blocks in size class N hold at least (kPageSize << N) bytes and less
+  // than twice that.
+  static const constexpr size_t kSizeClassCount = 12u;
+
+  // The maximum number of bytes held by the pool. Blocks released while the
+  // pool is full are freed instead.
+  static const constexpr size_t kMaxPooledBytes = 16u * 1024u * 1024u;
+
+  struct Stats {
+    // The number of bytes handed out from blocks that were reused.
+    size_t reused_bytes = 0u;
+    // The number of bytes handed out from freshly malloc'd blocks.
+    size_t allocated_bytes = 0u;
+    // The number of bytes currently held by the pool.
+    size_t pooled_bytes = 0u;
+  };
+
+  static DisplayListStoragePool& Instance();
+
+  DisplayListStoragePool();
+
+  ~DisplayListStoragePool();
+
+  /// Returns a block of at least |min_size| bytes, preferring a block that
+  /// was previously released to the pool, and stores its actual size in
+  /// |size|.
+  uint8_t* Acquire(size_t min_size, size_t* size);
+
+  /// Returns a block of |size| bytes obtained from |Acquire| (or resized by
+  /// |Resize|) to the pool, or frees it if the pool is full.
+  void Release(uint8_t* block, size_t size);
+
+  /// Resizes |block| in place if possible and returns the resized block.
+  /// The contents up to the smaller of the two sizes are preserved.
+  uint8_t* Resize(uint8_t* block, size_t size);
+
+  /// Frees all of the blocks held by the pool.
+  void Purge();
+
+  Stats GetStats() const;
+
+  /// Returns the size class of a block of |size| bytes.
+  static size_t SizeClassOf(size_t size);
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<std::vector<std::pair<uint8_t*, size_t>>, kSizeClassCount>
+      free_blocks_;
+  size_t pooled_bytes_ = 0u;
+  std::atomic<size_t> reused_bytes_ = 0u;
+  std::atomic<size_t> allocated_bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStoragePool);
+};
+
+// Manages a buffer allocated from the DisplayListStoragePool.
 class DisplayListStorage {
  public:
-  static const constexpr size_t kDLPageSize = 4096u;
+  static const constexpr size_t kDLPageSize = DisplayListStoragePool::kPageSize;
 
   DisplayListStorage() = default;
   DisplayListStorage(DisplayListStorage&&);
 
+  ~DisplayListStorage();
+
   /// Returns a pointer to the base of the storage.
-  uint8_t* base() { return ptr_.get(); }
-  const uint8_t* base() const { return ptr_.get(); }
+  uint8_t* base() { return ptr_; }
+  const uint8_t* base() const { return ptr_; }
 
   /// Returns the currently allocated size
   size_t size() const { return used_; }
@@ -31,14 +105,17 @@ class DisplayListStorage {
 
   /// Ensures the indicated number of bytes are available and returns
   /// a pointer to that memory within the storage while also invalidating
-  /// any other outstanding pointers into the storage.
+  /// any other outstanding pointers into the storage. The returned memory
+  /// is zero filled.
   uint8_t* allocate(size_t needed);
 
-  /// Trims the storage to the currently allocated size and invalidates
-  /// any outstanding pointers into the storage.
-  void trim() { realloc(used_); }
+  /// Trims the storage to the smallest whole number of pages that holds
+  /// the currently allocated size and invalidates any outstanding pointers
+  /// into the storage.
+  void trim();
 
-  /// Resets the storage and allocation of the object to an empty state
+  /// Resets the storage and allocation of the object to an empty state,
+  /// returning its memory to the pool.
   void reset();
 
   DisplayListStorage& operator=(DisplayListStorage&& other);
@@ -47,12 +124,7 @@ class DisplayListStorage {
   static size_t NextPowerOfTwoSize(size_t x);
 
  private:
-  void realloc(size_t count);
-
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  uint8_t* ptr_ = nullptr;
 
   size_t used_ = 0u;
   size_t allocated_ = 0u;
@@ -4,6 +4,9 @@
 
 #include "flutter/display_list/dl_storage.h"
 
+#include <cstring>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 
 namespace flutter {
@@ -69,5 +72,93 @@ TEST(DisplayListStorage, NextPowerOfTwoSize) {
   // It probably works...
 }
 
+TEST(DisplayListStorage, TrimRoundsUpToWholePages) {
+  DisplayListStoragePool::Instance().Purge();
+  DisplayListStorage storage;
+  EXPECT_NE(storage.allocate(DisplayListStorage::kDLPageSize * 4 + 10u),
+            nullptr);
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize * 8);
+
+  storage.trim();
+  EXPECT_EQ(storage.size(), DisplayListStorage::kDLPageSize * 4 + 10u);
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLPageSize * 5);
+}
+
+TEST(DisplayListStorage, RecycledMemoryIsZeroFilled) {
+  DisplayListStoragePool::Instance().Purge();
+  {
+    DisplayListStorage storage;
+    uint8_t* data = storage.allocate(100u);
+    memset(data, 0xff, 100u);
+  }
+  EXPECT_EQ(DisplayListStoragePool::Instance().GetStats().pooled_bytes,
+            DisplayListStorage::kDLPageSize);
+
+  DisplayListStorage storage;
+  uint8_t* data = storage.allocate(100u);
+  for (size_t i = 0; i < 100u; i++) {
+    EXPECT_EQ(data[i], 0u);
+  }
+}
+
+TEST(DisplayListStoragePool, ReusesReleasedBlocksOfTheSameSizeClass) {
+  DisplayListStoragePool pool;
+  size_t size = 0u;
+  uint8_t* block = pool.Acquire(DisplayListStoragePool::kPageSize * 3, &size);
+  EXPECT_NE(block, nullptr);
+  EXPECT_EQ(size, DisplayListStoragePool::kPageSize * 4);
+  EXPECT_EQ(pool.GetStats().allocated_bytes, size);
+  EXPECT_EQ(pool.GetStats().reused_bytes, 0u);
+
+  pool.Release(block, size);
+  EXPECT_EQ(pool.GetStats().pooled_bytes, size);
+
+  // A request from a different size class is not served by the block.
+  size_t small_size = 0u;
+  uint8_t* small_block = pool.Acquire(10u, &small_size);
+  EXPECT_EQ(small_size, DisplayListStoragePool::kPageSize);
+  EXPECT_EQ(pool.GetStats().allocated_bytes, size + small_size);
+  pool.Release(small_block, small_size);
+
+  size_t reused_size = 0u;
+  uint8_t* reused_block =
+      pool.Acquire(DisplayListStoragePool::kPageSize * 4, &reused_size);
+  EXPECT_EQ(reused_block, block);
+  EXPECT_EQ(reused_size, size);
+  EXPECT_EQ(pool.GetStats().reused_bytes, size);
+  EXPECT_EQ(pool.GetStats().pooled_bytes, small_size);
+  pool.Release(reused_block, reused_size);
+
+  pool.Purge();
+  EXPECT_EQ(pool.GetStats().pooled_bytes, 0u);
+}
+
+TEST(DisplayListStoragePool, SizeClasses) {
+  constexpr size_t kPage = DisplayListStoragePool::kPageSize;
+  EXPECT_EQ(DisplayListStoragePool::SizeClassOf(kPage), 0u);
+  EXPECT_EQ(DisplayListStoragePool::SizeClassOf(kPage * 2), 1u);
+  EXPECT_EQ(DisplayListStoragePool::SizeClassOf(kPage * 3), 1u);
+  EXPECT_EQ(DisplayListStoragePool::SizeClassOf(kPage * 4), 2u);
+  EXPECT_EQ(DisplayListStoragePool::SizeClassOf(kPage * 7), 2u);
+  EXPECT_EQ(DisplayListStoragePool::SizeClassOf(kPage * 8), 3u);
+}
+
+TEST(DisplayListStoragePool, FreesBlocksBeyondTheLimit) {
+  DisplayListStoragePool pool;
+  constexpr size_t kBlockSize = DisplayListStoragePool::kMaxPooledBytes / 2;
+  std::vector<uint8_t*> blocks;
+  for (int i = 0; i < 3; i++) {
+    size_t size = 0u;
+    blocks.push_back(pool.Acquire(kBlockSize, &size));
+    EXPECT_EQ(size, kBlockSize);
+  }
+  for (uint8_t* block : blocks) {
+    pool.Release(block, kBlockSize);
+  }
+  EXPECT_EQ(pool.GetStats().pooled_bytes,
+            DisplayListStoragePool::kMaxPooledBytes);
+  pool.Purge();
+}
+
 }  // namespace testing
 }  // namespace flutter
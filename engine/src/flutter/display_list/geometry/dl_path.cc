@@ -114,6 +114,9 @@ DlPath DlPath::MakeArc(const DlRect& bounds,
 }
 
 const SkPath& DlPath::GetSkPath() const {
+  if (data_->render_count.load(std::memory_order_relaxed) > kMaxVolatileUses) {
+    return data_->non_volatile_sk_path;
+  }
   return data_->sk_path;
 }
 
@@ -172,12 +175,11 @@ void DlPath::Dispatch(DlPathReceiver& receiver) const {
 }
 
 void DlPath::WillRenderSkPath() const {
-  uint32_t count = data_->render_count;
-  if (count <= kMaxVolatileUses) {
-    if (count == kMaxVolatileUses) {
-      data_->sk_path.setIsVolatile(false);
-    }
-    data_->render_count = ++count;
+  uint32_t count = data_->render_count.load(std::memory_order_relaxed);
+  // The count stops just past the limit, so that it can't wrap around.
+  while (count <= kMaxVolatileUses &&
+         !data_->render_count.compare_exchange_weak(
+             count, count + 1, std::memory_order_relaxed)) {
   }
 }
 
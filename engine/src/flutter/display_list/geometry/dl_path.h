@@ -5,6 +5,7 @@
 #ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PATH_H_
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PATH_H_
 
+#include <atomic>
 #include <functional>
 
 #include "flutter/display_list/geometry/dl_geometry_types.h"
@@ -72,7 +73,8 @@ class DlPath : public impeller::PathSource {
   /// Intent to render an SkPath multiple times will make the path
   /// non-volatile to enable caching in Skia. Calling this method
   /// before every rendering call that uses the SkPath will count
-  /// down the uses and eventually reset the volatile flag.
+  /// down the uses, after which |GetSkPath| returns a non-volatile
+  /// copy of the path.
   ///
   /// @see |kMaxVolatileUses|
   void WillRenderSkPath() const;
@@ -96,16 +98,27 @@ class DlPath : public impeller::PathSource {
   bool IsVolatile() const;
   bool IsConvex() const override;
 
+  /// An identifier that is shared by this path and all of its copies, and by
+  /// no other path that is alive at the same time.
+  const void* GetSharedDataIdentifier() const { return data_.get(); }
+
   DlPath operator+(const DlPath& other) const;
 
  private:
   struct Data {
-    explicit Data(const SkPath& path) : sk_path(path) {
+    explicit Data(const SkPath& path)
+        : sk_path(path), non_volatile_sk_path(path) {
       FML_DCHECK(!SkPathFillType_IsInverse(path.getFillType()));
+      non_volatile_sk_path.setIsVolatile(false);
     }
 
+    // Neither path is modified after construction, because paths may be
+    // rendered from several raster threads at once. The non-volatile copy
+    // shares its points with |sk_path|, and is used in its place once the
+    // path has been rendered often enough.
     SkPath sk_path;
-    uint32_t render_count = 0u;
+    SkPath non_volatile_sk_path;
+    std::atomic<uint32_t> render_count = 0u;
   };
 
   std::shared_ptr<Data> data_;
@@ -3,6 +3,12 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+
 #include "flutter/display_list/geometry/dl_region.h"
 
 #include "flutter/fml/logging.h"
@@ -137,6 +143,50 @@ DlRTree::DlRTree(const DlRect rects[],
     gen_count = family_count;
   }
   FML_DCHECK(gen_start + gen_count == total_node_count);
+
+  // The arrays are padded with |kMaxChildren| entries that intersect
+  // nothing so that every family can be tested with a fixed size loop.
+  constexpr DlScalar kInf = std::numeric_limits<DlScalar>::infinity();
+  lefts_.resize(total_node_count + kMaxChildren, kInf);
+  tops_.resize(total_node_count + kMaxChildren, kInf);
+  rights_.resize(total_node_count + kMaxChildren, -kInf);
+  bottoms_.resize(total_node_count + kMaxChildren, -kInf);
+  for (uint32_t i = 0; i < total_node_count; i++) {
+    const DlRect& bounds = nodes_[i].bounds;
+    lefts_[i] = bounds.GetLeft();
+    tops_[i] = bounds.GetTop();
+    rights_[i] = bounds.GetRight();
+    bottoms_[i] = bounds.GetBottom();
+  }
+}
+
+uint32_t DlRTree::intersectingChildren(uint32_t start,
+                                       uint32_t count,
+                                       const DlRect& query) const {
+  static_assert(kMaxChildren <= 32);
+  FML_DCHECK(count <= static_cast<uint32_t>(kMaxChildren));
+  FML_DCHECK(start + count <= nodes_.size());
+  // All stored bounds and the query are non-empty, so the intersection
+  // test reduces to 4 comparisons. They are combined without branching,
+  // over a fixed number of (possibly padding) entries, so that the loop
+  // can be unrolled and vectorized.
+  const DlScalar* lefts = lefts_.data() + start;
+  const DlScalar* tops = tops_.data() + start;
+  const DlScalar* rights = rights_.data() + start;
+  const DlScalar* bottoms = bottoms_.data() + start;
+  const DlScalar query_left = query.GetLeft();
+  const DlScalar query_top = query.GetTop();
+  const DlScalar query_right = query.GetRight();
+  const DlScalar query_bottom = query.GetBottom();
+  uint32_t mask = 0u;
+  for (uint32_t i = 0; i < kMaxChildren; i++) {
+    uint32_t hit = static_cast<uint32_t>(lefts[i] < query_right) &
+                   static_cast<uint32_t>(query_left < rights[i]) &
+                   static_cast<uint32_t>(tops[i] < query_bottom) &
+                   static_cast<uint32_t>(query_top < bottoms[i]);
+    mask |= hit << i;
+  }
+  return mask & ((1u << count) - 1u);
 }
 
 void DlRTree::search(const DlRect& query, std::vector<int>* results) const {
@@ -182,6 +232,43 @@ std::list<DlRect> DlRTree::searchAndConsolidateRects(const DlRect& query,
   return final_results;
 }
 
+void DlRTree::search(const DlRect queries[],
+                     int query_count,
+                     std::vector<int> results[]) const {
+  FML_DCHECK(query_count <= 0 || (queries != nullptr && results != nullptr));
+  if (nodes_.empty()) {
+    FML_DCHECK(leaf_count_ == 0);
+    return;
+  }
+  const Node& root = nodes_.back();
+  for (int batch_start = 0; batch_start < query_count;
+       batch_start += kMaxBatchQueries) {
+    int batch_count = std::min(query_count - batch_start, kMaxBatchQueries);
+    const DlRect* batch_queries = queries + batch_start;
+    std::vector<int>* batch_results = results + batch_start;
+
+    uint64_t query_mask = 0u;
+    for (int q = 0; q < batch_count; q++) {
+      if (!batch_queries[q].IsEmpty() &&
+          root.bounds.IntersectsWithRect(batch_queries[q])) {
+        query_mask |= uint64_t{1} << q;
+      }
+    }
+    if (query_mask == 0u) {
+      continue;
+    }
+    if (nodes_.size() == 1) {
+      FML_DCHECK(leaf_count_ == 1);
+      // The root node is the only node and it is a leaf node
+      for (; query_mask != 0u; query_mask &= query_mask - 1) {
+        batch_results[std::countr_zero(query_mask)].push_back(0);
+      }
+    } else {
+      search(root, query_mask, batch_queries, batch_results);
+    }
+  }
+}
+
 void DlRTree::search(const Node& parent,
                      const DlRect& query,
                      std::vector<int>* results) const {
@@ -200,6 +287,46 @@ void DlRTree::search(const Node& parent,
   }
 }
 
+void DlRTree::search(const Node& parent,
+                     uint64_t query_mask,
+                     const DlRect queries[],
+                     std::vector<int> results[]) const {
+  // Caller protects against empty queries
+  uint32_t start = parent.child.index;
+  uint32_t count = parent.child.count;
+
+  // All children of a node belong to the same generation, so either all or
+  // none of them are leaves.
+  if (static_cast<int>(start) < leaf_count_) {
+    for (; query_mask != 0u; query_mask &= query_mask - 1) {
+      int q = std::countr_zero(query_mask);
+      for (uint32_t hits = intersectingChildren(start, count, queries[q]);
+           hits != 0u; hits &= hits - 1) {
+        results[q].push_back(start + std::countr_zero(hits));
+      }
+    }
+    return;
+  }
+
+  // Transpose the per-query hit masks of the children into the set of
+  // queries that each child intersects.
+  std::array<uint64_t, kMaxChildren> child_query_masks = {};
+  for (uint64_t queries_left = query_mask; queries_left != 0u;
+       queries_left &= queries_left - 1) {
+    int q = std::countr_zero(queries_left);
+    for (uint32_t hits = intersectingChildren(start, count, queries[q]);
+         hits != 0u; hits &= hits - 1) {
+      child_query_masks[std::countr_zero(hits)] |= uint64_t{1} << q;
+    }
+  }
+
+  for (uint32_t c = 0; c < count; c++) {
+    if (child_query_masks[c] != 0u) {
+      search(nodes_[start + c], child_query_masks[c], queries, results);
+    }
+  }
+}
+
 const DlRegion& DlRTree::region() const {
   if (!region_) {
     std::vector<DlIRect> rects;
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 
+#include <cstdint>
 #include <list>
 #include <optional>
 #include <vector>
@@ -78,6 +79,21 @@ class DlRTree : public SkRefCnt {
   /// |DlRTree::id| and |DlRTree::bounds| methods.
   void search(const DlRect& query, std::vector<int>* results) const;
 
+  /// Search the rectangles for several queries at once and store the
+  /// leaf node indices of the rectangles that intersect |queries[i]|
+  /// in |results[i]|.
+  ///
+  /// The results for each query are identical to, and in the same order
+  /// as, those of calling |search| with that query, but the tree is only
+  /// traversed once for every |kMaxBatchQueries| queries.
+  void search(const DlRect queries[],
+              int query_count,
+              std::vector<int> results[]) const;
+
+  /// The maximum number of queries answered by a single traversal of the
+  /// tree in the batched |search|. Larger batches are split.
+  static constexpr int kMaxBatchQueries = 64;
+
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
@@ -100,7 +116,8 @@ class DlRTree : public SkRefCnt {
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) + sizeof(Node) * nodes_.size() +
+           sizeof(DlScalar) * 4 * lefts_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -142,7 +159,25 @@ class DlRTree : public SkRefCnt {
               const DlRect& query,
               std::vector<int>* results) const;
 
+  void search(const Node& parent,
+              uint64_t query_mask,
+              const DlRect queries[],
+              std::vector<int> results[]) const;
+
+  /// Returns a mask with bit N set if the node at |start + N| intersects the
+  /// (non-empty) query, for the |count| <= 32 nodes starting at |start|.
+  uint32_t intersectingChildren(uint32_t start,
+                                uint32_t count,
+                                const DlRect& query) const;
+
   std::vector<Node> nodes_;
+  // The bounds of |nodes_| in structure-of-arrays form, used by the batched
+  // search. The children of a node are contiguous, so they can all be tested
+  // against a query with a single (vectorizable) loop over these arrays.
+  std::vector<DlScalar> lefts_;
+  std::vector<DlScalar> tops_;
+  std::vector<DlScalar> rights_;
+  std::vector<DlScalar> bottoms_;
   int leaf_count_ = 0;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
@@ -299,6 +299,54 @@ TEST(DisplayListRTree, OverlappingRects) {
   EXPECT_EQ(list.front(), DlRect::MakeLTRB(0, 0, 70, 70));
 }
 
+TEST(DisplayListRTree, BatchSearchMatchesSingleSearch) {
+  // A 50x50 grid of 10x10 rectangles spaced 15 pixels apart.
+  const int kGridSize = 50;
+  std::vector<DlRect> rects;
+  for (int r = 0; r < kGridSize; r++) {
+    for (int c = 0; c < kGridSize; c++) {
+      rects.push_back(DlRect::MakeXYWH(c * 15, r * 15, 10, 10));
+    }
+  }
+  DlRTree tree(rects.data(), rects.size());
+
+  // More queries than a single batch, including empty queries and queries
+  // that miss the tree entirely.
+  std::vector<DlRect> queries;
+  for (int i = 0; i < DlRTree::kMaxBatchQueries + 13; i++) {
+    DlScalar x = (i * 37) % 800 - 20;
+    DlScalar y = (i * 53) % 800 - 20;
+    DlScalar size = (i % 7) * 25;
+    queries.push_back(DlRect::MakeXYWH(x, y, size, size / 2));
+  }
+  queries.push_back(DlRect::MakeLTRB(-100, -100, -50, -50));
+  queries.push_back(DlRect::MakeLTRB(0, 0, 750, 750));
+
+  std::vector<std::vector<int>> batch_results(queries.size());
+  tree.search(queries.data(), queries.size(), batch_results.data());
+  for (size_t i = 0; i < queries.size(); i++) {
+    std::vector<int> results;
+    tree.search(queries[i], &results);
+    EXPECT_EQ(batch_results[i], results) << "query " << i;
+  }
+  EXPECT_EQ(batch_results.back().size(), rects.size());
+}
+
+TEST(DisplayListRTree, BatchSearchSingleNode) {
+  DlRect rect = DlRect::MakeLTRB(10, 10, 20, 20);
+  DlRTree tree(&rect, 1);
+  DlRect queries[] = {
+      DlRect::MakeLTRB(15, 15, 25, 25),
+      DlRect::MakeLTRB(25, 25, 35, 35),
+      DlRect(),
+  };
+  std::vector<int> results[3];
+  tree.search(queries, 3, results);
+  EXPECT_EQ(results[0], std::vector<int>{0});
+  EXPECT_TRUE(results[1].empty());
+  EXPECT_TRUE(results[2].empty());
+}
+
 TEST(DisplayListRTree, Region) {
   DlRect rect[9];
   for (int i = 0; i < 9; i++) {
@@ -169,19 +169,27 @@ void DiffContext::MarkSubtreeDirty(const DlRect& previous_paint_region) {
   state_.dirty = true;
 }
 
-void DiffContext::AddLayerBounds(const DlRect& rect) {
+bool DiffContext::MapLayerRect(const DlRect& rect, DlRect& transformed_rect) {
   // During painting we cull based on non-overriden transform and then
   // override the transform right before paint. Do the same thing here to get
   // identical paint rect.
-  auto transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-  if (transformed_rect.IntersectsWithRect(
+  transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
+  if (!transformed_rect.IntersectsWithRect(
           state_.matrix_clip.GetDeviceCullCoverage())) {
-    if (state_.integral_transform) {
-      DisplayListMatrixClipState temp_state = state_.matrix_clip;
-      MakeTransformIntegral(temp_state);
-      temp_state.mapRect(rect, &transformed_rect);
-      transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
-    }
+    return false;
+  }
+  if (state_.integral_transform) {
+    DisplayListMatrixClipState temp_state = state_.matrix_clip;
+    MakeTransformIntegral(temp_state);
+    temp_state.mapRect(rect, &transformed_rect);
+    transformed_rect = ApplyFilterBoundsAdjustment(transformed_rect);
+  }
+  return true;
+}
+
+void DiffContext::AddLayerBounds(const DlRect& rect) {
+  DlRect transformed_rect;
+  if (MapLayerRect(rect, transformed_rect)) {
     rects_->push_back(transformed_rect);
     if (IsSubtreeDirty()) {
       AddDamage(transformed_rect);
@@ -189,6 +197,13 @@ void DiffContext::AddLayerBounds(const DlRect& rect) {
   }
 }
 
+void DiffContext::AddLayerDamage(const DlRect& rect) {
+  DlRect transformed_rect;
+  if (MapLayerRect(rect, transformed_rect)) {
+    AddDamage(transformed_rect);
+  }
+}
+
 void DiffContext::MarkSubtreeHasTextureLayer() {
   // Set the has_texture flag on current state and all parent states. That
   // way we'll know that we can't skip diff for retained layers because
@@ -262,7 +277,8 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_,
+                    "PartiallyChangedPictures", partially_changed_pictures_);
 #endif  // !FLUTTER_RELEASE
 }
 
@@ -111,6 +111,11 @@ class DiffContext {
   // coordinates.
   void AddLayerBounds(const DlRect& rect);
 
+  // Add rect to the damage; rect is in "local" (layer) coordinates and is
+  // transformed and clipped the same way as the layer bounds. Used by layers
+  // that know which parts of their previous paint region changed.
+  void AddLayerDamage(const DlRect& rect);
+
   // Add entire paint region of retained layer for current subtree. This can
   // only be used in subtrees that are not dirty, otherwise ancestor transforms
   // or clips may result in different paint region.
@@ -185,6 +190,10 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Picture replaced by different picture where only the parts that
+    // changed were damaged
+    void AddPartiallyChangedPicture() { ++partially_changed_pictures_; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -194,6 +203,7 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int partially_changed_pictures_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -232,6 +242,10 @@ class DiffContext {
 
   void MakeTransformIntegral(DisplayListMatrixClipState& matrix_clip);
 
+  // Maps rect from local (layer) coordinates to device coordinates the way
+  // the layer will be painted. Returns false if the result is culled.
+  bool MapLayerRect(const DlRect& rect, DlRect& transformed_rect);
+
   std::shared_ptr<std::vector<DlRect>> rects_;
   State state_;
   DlISize frame_size_;
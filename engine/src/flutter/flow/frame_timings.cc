@@ -200,24 +200,32 @@ fml::Status FrameTimingsRecorder::RecordRasterStartImpl(
 }
 
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
+  std::vector<const RasterCache*> caches;
+  if (cache) {
+    caches.push_back(cache);
+  }
+  return RecordRasterEnd(caches);
+}
+
+FrameTiming FrameTimingsRecorder::RecordRasterEnd(
+    const std::vector<const RasterCache*>& caches) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
   state_ = State::kRasterEnd;
   raster_end_ = fml::TimePoint::Now();
   raster_end_wall_time_ = fml::TimePoint::CurrentWallTime();
-  if (cache) {
+  layer_cache_count_ = layer_cache_bytes_ = picture_cache_count_ =
+      picture_cache_bytes_ = 0;
 #if !SLIMPELLER
+  for (const RasterCache* cache : caches) {
     const RasterCacheMetrics& layer_metrics = cache->layer_metrics();
     const RasterCacheMetrics& picture_metrics = cache->picture_metrics();
-    layer_cache_count_ = layer_metrics.total_count();
-    layer_cache_bytes_ = layer_metrics.total_bytes();
-    picture_cache_count_ = picture_metrics.total_count();
-    picture_cache_bytes_ = picture_metrics.total_bytes();
-#endif  //  !SLIMPELLER
-  } else {
-    layer_cache_count_ = layer_cache_bytes_ = picture_cache_count_ =
-        picture_cache_bytes_ = 0;
+    layer_cache_count_ += layer_metrics.total_count();
+    layer_cache_bytes_ += layer_metrics.total_bytes();
+    picture_cache_count_ += picture_metrics.total_count();
+    picture_cache_bytes_ += picture_metrics.total_bytes();
   }
+#endif  //  !SLIMPELLER
   timing_.Set(FrameTiming::kVsyncStart, vsync_start_);
   timing_.Set(FrameTiming::kBuildStart, build_start_);
   timing_.Set(FrameTiming::kBuildFinish, build_end_);
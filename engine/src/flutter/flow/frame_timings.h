@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
 #include <mutex>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/flow/raster_cache.h"
@@ -106,6 +107,10 @@ class FrameTimingsRecorder {
   /// the events. This summary is sent to the framework.
   FrameTiming RecordRasterEnd(const RasterCache* cache = nullptr);
 
+  /// Records a raster end event like `RecordRasterEnd`, with the statistics
+  /// of all of the given raster caches, such as those of several views.
+  FrameTiming RecordRasterEnd(const std::vector<const RasterCache*>& caches);
+
   /// Returns the frame number. Frame number is unique per frame and a frame
   /// built earlier will have a frame number less than a frame that has been
   /// built at a later point of time.
@@ -64,10 +64,17 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     --old_children_bottom;
   }
 
+  // If the same number of layers changed, each new layer takes the place of
+  // the old layer at the same position and may be able to diff with it
+  bool replaced_in_place = new_children_bottom - new_children_top ==
+                           old_children_bottom - old_children_top;
+
   // old layers that don't match
-  for (int i = old_children_top; i <= old_children_bottom; ++i) {
-    auto layer = prev_layers[i];
-    context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+  if (!replaced_in_place) {
+    for (int i = old_children_top; i <= old_children_bottom; ++i) {
+      auto layer = prev_layers[i];
+      context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+    }
   }
 
   for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
@@ -95,9 +102,16 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         layer->Diff(context, prev_layer.get());
       }
     } else {
+      auto layer = layers_[i];
+      if (replaced_in_place) {
+        auto prev_layer = prev_layers[i - new_children_top + old_children_top];
+        if (layer->DiffReplacedLayer(context, prev_layer.get())) {
+          continue;
+        }
+        context->AddDamage(context->GetOldLayerPaintRegion(prev_layer.get()));
+      }
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
-      auto layer = layers_[i];
       layer->Diff(context, nullptr);
     }
   }
@@ -58,6 +58,33 @@ void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+bool DisplayListLayer::DiffReplacedLayer(DiffContext* context,
+                                         const Layer* old_layer) {
+  FML_DCHECK(!context->IsSubtreeDirty());
+  auto prev = old_layer->as_display_list_layer();
+  if (prev == nullptr || prev->offset_ != offset_) {
+    return false;
+  }
+  // Only the ops that differ between the display lists need to be repainted,
+  // everything else renders identically to the previous frame.
+  std::optional<DlRect> changed_bounds =
+      display_list_->GetChangedBounds(*prev->display_list_);
+  if (!changed_bounds.has_value()) {
+    return false;
+  }
+  context->statistics().AddPartiallyChangedPicture();
+
+  DiffContext::AutoSubtreeRestore subtree(context);
+  context->PushTransform(DlMatrix::MakeTranslation(offset_));
+  if (context->has_raster_cache()) {
+    context->WillPaintWithIntegralTransform();
+  }
+  context->AddLayerBounds(display_list()->GetBounds());
+  context->AddLayerDamage(changed_bounds.value());
+  context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
+  return true;
+}
+
 bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
                                const DisplayListLayer* l1,
                                const DisplayListLayer* l2) {
@@ -30,6 +30,8 @@ class DisplayListLayer : public Layer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool DiffReplacedLayer(DiffContext* context, const Layer* old_layer) override;
+
   const DisplayListLayer* as_display_list_layer() const override {
     return this;
   }
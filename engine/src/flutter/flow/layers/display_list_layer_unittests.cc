@@ -427,6 +427,52 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(DisplayListLayerDiffTest, DisplayListChangedOps) {
+  auto create_display_list = [](DlScalar offset) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.DrawRect(DlRect::MakeLTRB(10, 10, 60, 60), DlPaint());
+    builder.DrawRect(DlRect::MakeLTRB(100, 100, 110, 110).Shift(offset, 0),
+                     DlPaint());
+    builder.DrawRect(DlRect::MakeLTRB(150, 150, 200, 200), DlPaint());
+    return builder.Build();
+  };
+  auto static_display_list =
+      CreateDisplayList(DlRect::MakeLTRB(300, 300, 350, 350));
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(static_display_list));
+  tree1.root()->Add(CreateDisplayListLayer(create_display_list(0)));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(10, 10, 350, 350));
+
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(static_display_list));
+  tree2.root()->Add(CreateDisplayListLayer(create_display_list(5)));
+
+  // only the moved op is damaged
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(100, 100, 115, 110));
+
+  MockLayerTree tree3;
+  tree3.root()->Add(CreateDisplayListLayer(static_display_list));
+  tree3.root()->Add(
+      CreateDisplayListLayer(create_display_list(10), DlPoint(10, 10)));
+
+  // the whole layer moved
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(10, 10, 210, 210));
+
+  MockLayerTree tree4;
+  tree4.root()->Add(CreateDisplayListLayer(static_display_list));
+  tree4.root()->Add(
+      CreateDisplayListLayer(create_display_list(0), DlPoint(10, 10)));
+
+  // only the moved op is damaged, at the offset of the layer
+  damage = DiffLayerTree(tree4, tree3);
+  EXPECT_EQ(damage.frame_damage, DlIRect::MakeLTRB(110, 110, 130, 120));
+}
+
 TEST_F(DisplayListLayerTest, DisplayListAccessCountDependsOnVisibility) {
   const DlPoint layer_offset = DlPoint(1.5f, -0.5f);
   const DlRect picture_bounds = DlRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
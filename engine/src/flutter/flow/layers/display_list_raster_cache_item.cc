@@ -25,7 +25,10 @@ static bool IsDisplayListWorthRasterizing(
     const DisplayList* display_list,
     bool will_change,
     bool is_complex,
-    DisplayListComplexityCalculator* complexity_calculator) {
+    DisplayListComplexityCalculator* complexity_calculator,
+    unsigned int* complexity_score) {
+  *complexity_score = 0;
+
   if (will_change) {
     // If the display list is going to change in the future, there is no point
     // in doing to extra work to rasterize.
@@ -45,8 +48,8 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
-  unsigned int complexity_score = complexity_calculator->Compute(display_list);
-  return complexity_calculator->ShouldBeCached(complexity_score);
+  *complexity_score = complexity_calculator->Compute(display_list);
+  return complexity_calculator->ShouldBeCached(*complexity_score);
 }
 
 DisplayListRasterCacheItem::DisplayListRasterCacheItem(
@@ -80,7 +83,8 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                           : DisplayListComplexityCalculator::GetForSoftware();
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
-                                     complexity_calculator)) {
+                                     complexity_calculator,
+                                     &complexity_score_)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
@@ -110,7 +114,8 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   DlRect bounds = display_list_->GetBounds().Shift(offset_.x(), offset_.y());
   bool visible = !context->state_stack.content_culled(bounds);
   RasterCache::CacheInfo cache_info =
-      raster_cache->MarkSeen(key_id_, ToSkMatrix(matrix), visible);
+      raster_cache->MarkSeen(key_id_, ToSkMatrix(matrix), visible,
+                             complexity_score_);
   if (!visible ||
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
@@ -57,6 +57,8 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // The complexity score of the display list, or zero if it was not computed.
+  unsigned int complexity_score_ = 0;
 };
 
 }  // namespace flutter
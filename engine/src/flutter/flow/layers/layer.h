@@ -34,6 +34,7 @@ class MockLayer;
 class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
+class PlatformViewLayer;
 class TextureLayer;
 class RasterCacheItem;
 
@@ -143,6 +144,15 @@ class Layer {
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
+  // Used when this layer takes the place of |old_layer| in the tree, but
+  // IsReplacing returned false for it. A layer that can tell which parts of
+  // |old_layer| changed adds just those parts to the damage, associates its
+  // paint region with the context and returns true. Otherwise the caller
+  // damages the whole paint region of both layers.
+  virtual bool DiffReplacedLayer(DiffContext* context, const Layer* old_layer) {
+    return false;
+  }
+
   // Used when diffing retained layer; In case the layer is identical, it
   // doesn't need to be diffed, but the paint region needs to be stored in diff
   // context so that it can be used in next frame
@@ -246,6 +256,9 @@ class Layer {
     return nullptr;
   }
   virtual const TextureLayer* as_texture_layer() const { return nullptr; }
+  virtual const PlatformViewLayer* as_platform_view_layer() const {
+    return nullptr;
+  }
   virtual const PerformanceOverlayLayer* as_performance_overlay_layer() const {
     return nullptr;
   }
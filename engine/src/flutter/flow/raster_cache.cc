@@ -6,6 +6,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -75,6 +77,11 @@ RasterCache::RasterCache(size_t access_threshold,
     : access_threshold_(access_threshold),
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
 
+RasterCache::~RasterCache() {
+  // The pending tasks refer to this cache.
+  FinishConcurrentRasterization();
+}
+
 /// @note Procedure doesn't copy all closures.
 std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
     const RasterCache::Context& context,
@@ -115,6 +122,15 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
       image, context.logical_rect, context.flow_type, std::move(rtree));
 }
 
+// The size of the N32 image that |RasterCache::Rasterize| would create.
+static size_t EstimateImageBytes(const RasterCache::Context& context) {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  return static_cast<size_t>(dest_rect.width()) *
+         static_cast<size_t>(dest_rect.height()) * sizeof(uint32_t);
+}
+
 bool RasterCache::UpdateCacheEntry(
     const RasterCacheKeyID& id,
     const Context& raster_cache_context,
@@ -122,7 +138,28 @@ bool RasterCache::UpdateCacheEntry(
     sk_sp<const DlRTree> rtree) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
+  if (entry.rasterization_pending) {
+    return true;
+  }
   if (!entry.image) {
+    size_t estimated_bytes = 0;
+    if (byte_budget_ > 0) {
+      estimated_bytes = EstimateImageBytes(raster_cache_context);
+      if (!AdmitEntry(entry, estimated_bytes)) {
+        return false;
+      }
+    }
+    if (CanRasterizeConcurrently(id, raster_cache_context)) {
+      RasterizeConcurrently(key, raster_cache_context, std::move(rtree),
+                            render_function);
+      entry.rasterization_pending = true;
+      entry.pending_bytes = estimated_bytes;
+      display_list_cached_this_frame_++;
+      return true;
+    }
+    // The entries being rasterized concurrently may share content, such as
+    // display lists or paths, with this entry.
+    FinishConcurrentRasterization();
     void (*func)(DlCanvas*, const DlRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
@@ -141,13 +178,172 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+bool RasterCache::CanRasterizeConcurrently(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context) const {
+  // Only software surfaces can be rendered to off the raster thread, and layer
+  // entries are painted through the cache itself.
+  if (!concurrent_task_runner_ || raster_cache_context.gr_context ||
+      id.type() != RasterCacheKeyType::kDisplayList ||
+      concurrent_rasterized_this_frame_ >=
+          concurrent_rasterization_limit_per_frame_) {
+    return false;
+  }
+  // A display list may be cached with several matrices, but it must not be
+  // rendered by multiple threads at once.
+  for (const auto& pending : pending_rasterizations_) {
+    if (pending->key.id() == id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RasterCache::RasterizeConcurrently(
+    const RasterCacheKey& key,
+    const Context& raster_cache_context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& render_function) const {
+  auto pending = std::make_shared<PendingRasterization>(key);
+  pending_rasterizations_.push_back(pending);
+  concurrent_rasterized_this_frame_++;
+  // The context refers to the matrix and bounds of the caller, so copy them.
+  concurrent_task_runner_->PostTask(
+      [this, pending, rtree = std::move(rtree), render_function,
+       dst_color_space = raster_cache_context.dst_color_space,
+       matrix = raster_cache_context.matrix,
+       logical_rect = raster_cache_context.logical_rect,
+       flow_type = raster_cache_context.flow_type]() mutable {
+        TRACE_EVENT0("flutter", "RasterCache::RasterizeConcurrently");
+        RasterCache::Context context = {
+            // clang-format off
+            .gr_context         = nullptr,
+            .dst_color_space    = dst_color_space,
+            .matrix             = matrix,
+            .logical_rect       = logical_rect,
+            .flow_type          = flow_type,
+            // clang-format on
+        };
+        void (*func)(DlCanvas*, const DlRect& rect) = DrawCheckerboard;
+        pending->image =
+            Rasterize(context, std::move(rtree), render_function, func);
+        pending->done.Signal();
+      });
+}
+
+void RasterCache::FinishConcurrentRasterization() const {
+  if (pending_rasterizations_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "RasterCache::FinishConcurrentRasterization");
+  const fml::TimePoint start = fml::TimePoint::Now();
+  for (const auto& pending : pending_rasterizations_) {
+    pending->done.Wait();
+    auto it = cache_.find(pending->key);
+    if (it != cache_.end()) {
+      Entry& entry = it->second;
+      entry.rasterization_pending = false;
+      entry.pending_bytes = 0;
+      entry.image = std::move(pending->image);
+    }
+  }
+  pending_rasterizations_.clear();
+  concurrent_rasterization_wait_time_ =
+      concurrent_rasterization_wait_time_ + (fml::TimePoint::Now() - start);
+}
+
+void RasterCache::SetConcurrentRasterization(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t limit_per_frame) {
+  FinishConcurrentRasterization();
+  concurrent_task_runner_ = std::move(task_runner);
+  concurrent_rasterization_limit_per_frame_ = limit_per_frame;
+}
+
+void RasterCache::SetByteBudget(size_t byte_budget) {
+  byte_budget_ = byte_budget;
+}
+
+// The raster cost of an entry whose cost is not known, such as a layer or a
+// display list that is marked as complex, is estimated from the size of its
+// image. In the units of the GL and Metal complexity calculators, this makes a
+// full screen image on a phone cost about 1ms to render.
+static constexpr double kUnknownRasterCostPerByte = 1.0 / 64.0;
+
+RasterCache::EntryValue RasterCache::GetEntryValue(const Entry& entry,
+                                                   size_t bytes) {
+  // An entry that has not been cached yet is assumed to be drawn every frame.
+  double hit_rate = (entry.hits + 1.0) / (entry.frames_cached + 1.0);
+  double raster_cost = entry.raster_cost;
+  if (raster_cost == 0) {
+    raster_cost = bytes * kUnknownRasterCostPerByte;
+  }
+  return hit_rate * raster_cost / std::max<size_t>(bytes, 1);
+}
+
+bool RasterCache::AdmitEntry(const Entry& entry, size_t bytes) const {
+  if (bytes > byte_budget_) {
+    return false;
+  }
+  const EntryValue value = GetEntryValue(entry, bytes);
+  size_t cached_bytes = 0;
+  std::vector<std::pair<EntryValue, RasterCacheKey::Map<Entry>::iterator>>
+      candidates;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    const Entry& other = it->second;
+    if (other.rasterization_pending) {
+      cached_bytes += other.pending_bytes;
+    } else if (other.image) {
+      size_t other_bytes = other.image->image_bytes();
+      cached_bytes += other_bytes;
+      EntryValue other_value = GetEntryValue(other, other_bytes);
+      if (other_value < value) {
+        candidates.emplace_back(other_value, it);
+      }
+    }
+  }
+  if (cached_bytes + bytes <= byte_budget_) {
+    return true;
+  }
+
+  // Only evict anything if that makes enough room for the new entry.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  size_t evicted_bytes = 0;
+  size_t evicted_count = 0;
+  while (evicted_count < candidates.size() &&
+         cached_bytes - evicted_bytes + bytes > byte_budget_) {
+    evicted_bytes +=
+        candidates[evicted_count++].second->second.image->image_bytes();
+  }
+  if (cached_bytes - evicted_bytes + bytes > byte_budget_) {
+    return false;
+  }
+  for (size_t i = 0; i < evicted_count; i++) {
+    EvictImage(candidates[i].second);
+  }
+  return true;
+}
+
+void RasterCache::EvictImage(RasterCacheKey::Map<Entry>::iterator it) const {
+  Entry& entry = it->second;
+  RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+  metrics.eviction_count++;
+  metrics.eviction_bytes += entry.image->image_bytes();
+  entry.image.reset();
+  entry.hits = 0;
+  entry.frames_cached = 0;
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
-                                             bool visible) const {
+                                             bool visible,
+                                             unsigned int raster_cost) const {
   RasterCacheKey key = RasterCacheKey(id, matrix);
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
+  entry.raster_cost = raster_cost;
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
@@ -186,6 +382,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    entry.hits++;
     return true;
   }
 
@@ -194,11 +391,17 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
+  concurrent_rasterized_this_frame_ = 0;
+  concurrent_rasterization_wait_time_ = fml::TimeDelta::Zero();
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
 
 void RasterCache::UpdateMetrics() {
+  picture_metrics_.concurrent_rasterization_count =
+      concurrent_rasterized_this_frame_;
+  picture_metrics_.concurrent_rasterization_wait_time =
+      concurrent_rasterization_wait_time_;
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
     FML_DCHECK(entry.encountered_this_frame);
@@ -206,6 +409,7 @@ void RasterCache::UpdateMetrics() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.in_use_count++;
       metrics.in_use_bytes += entry.image->image_bytes();
+      entry.frames_cached++;
     }
     entry.encountered_this_frame = false;
   }
@@ -229,14 +433,46 @@ void RasterCache::EvictUnusedCacheEntries() {
     }
     cache_.erase(it);
   }
+
+  if (byte_budget_ == 0) {
+    return;
+  }
+
+  // Keep the entries that save the most raster time per byte within the
+  // budget. The entries themselves are kept so that they can be cached again
+  // once they are worth more than the others.
+  size_t cached_bytes = 0;
+  std::vector<std::pair<EntryValue, RasterCacheKey::Map<Entry>::iterator>>
+      cached;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (it->second.image) {
+      size_t bytes = it->second.image->image_bytes();
+      cached_bytes += bytes;
+      cached.emplace_back(GetEntryValue(it->second, bytes), it);
+    }
+  }
+  if (cached_bytes <= byte_budget_) {
+    return;
+  }
+  std::sort(cached.begin(), cached.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  for (const auto& [value, it] : cached) {
+    if (cached_bytes <= byte_budget_) {
+      break;
+    }
+    cached_bytes -= it->second.image->image_bytes();
+    EvictImage(it);
+  }
 }
 
 void RasterCache::EndFrame() {
+  FinishConcurrentRasterization();
   UpdateMetrics();
   TraceStatsToTimeline();
 }
 
 void RasterCache::Clear() {
+  FinishConcurrentRasterization();
   cache_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
@@ -301,7 +537,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -9,6 +9,8 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/display_list/geometry/dl_geometry_conversions.h"
@@ -16,6 +18,9 @@
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -81,6 +86,17 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries rasterized concurrently in this frame.
+   */
+  size_t concurrent_rasterization_count = 0;
+
+  /**
+   * The time spent waiting for the cache entries rasterized concurrently in
+   * this frame.
+   */
+  fml::TimeDelta concurrent_rasterization_wait_time;
+
   /**
    * The total cache entries that had images during this frame.
    */
@@ -110,6 +126,8 @@ struct RasterCacheMetrics {
  *       Evict cached images that are no longer used.
  *   - LayerTree::TryToPrepareRasterCache
  *       Create cache image for each cache entry if it does not exist.
+ *   - RasterCache::FinishConcurrentRasterization
+ *       Wait for the cache images being created concurrently, if any.
  *   - LayerTree::Paint - for each layer in the tree:
  *       If layers or display lists are cached as cached images, the method
  *       `RasterCache::Draw` will be used to draw those cache images.
@@ -142,7 +160,7 @@ class RasterCache {
       size_t picture_and_display_list_cache_limit_per_frame =
           RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
 
-  virtual ~RasterCache() = default;
+  virtual ~RasterCache();
 
   // Draws this item if it should be rendered from the cache and returns
   // true iff it was successfully drawn. Typically this should only fail
@@ -169,6 +187,45 @@ class RasterCache {
 
   void Clear();
 
+  /**
+   * @brief Rasterize up to |limit_per_frame| new display list entries per
+   * frame on |task_runner| rather than on the calling thread.
+   *
+   * Only the entries that are rendered into software surfaces, i.e. without a
+   * GrDirectContext, are rasterized concurrently. Display list entries don't
+   * depend on the rest of the cache, so they can be rasterized in any order.
+   * Layer entries, and display list entries beyond the limit, are rasterized on
+   * the calling thread once the pending concurrent entries have finished.
+   *
+   * A null |task_runner| disables concurrent rasterization.
+   */
+  void SetConcurrentRasterization(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner,
+      size_t limit_per_frame);
+
+  /**
+   * @brief Wait for the entries being rasterized concurrently and add their
+   * images to the cache. Those entries are not drawn from the cache until
+   * then.
+   */
+  void FinishConcurrentRasterization() const;
+
+  /**
+   * @brief Limit the size of all of the cached images to |byte_budget| bytes.
+   * A budget of zero means that the cache is not limited.
+   *
+   * Within the budget, the entries are weighed by the raster time they are
+   * expected to save per byte of their image: the raster cost that was given
+   * to |MarkSeen|, multiplied by how often the entry was drawn per frame that
+   * it has been cached. New entries are only admitted if they fit in the
+   * budget, possibly after evicting entries that are worth less, and
+   * |EvictUnusedCacheEntries| evicts the entries that are worth the least
+   * until the rest fit in the budget.
+   */
+  void SetByteBudget(size_t byte_budget);
+
+  size_t byte_budget() const { return byte_budget_; }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -229,12 +286,18 @@ class RasterCache {
    * as visible in the current frame if the caller determines that it
    * intersects the cull rect. The access_count of the entry will be
    * increased if it is visible, or if it was ever visible.
+   *
+   * The |raster_cost| is the estimated cost of rendering the entry without
+   * the cache, such as the score of a |DisplayListComplexityCalculator|, or
+   * zero if it is not known, in which case it is estimated from the size of
+   * the cached image. It is used to weigh the entry against the byte budget.
    * @return the number of times the entry has been hit since it was created.
    * For a new entry that will be 1 if it is visible, or zero if non-visible.
    */
   CacheInfo MarkSeen(const RasterCacheKeyID& id,
                      const SkMatrix& matrix,
-                     bool visible) const;
+                     bool visible,
+                     unsigned int raster_cost = 0) const;
 
   /**
    * Returns the access count (i.e. accesses_since_visible) for the given
@@ -251,21 +314,69 @@ class RasterCache {
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
+    bool rasterization_pending = false;
     size_t accesses_since_visible = 0;
+    unsigned int raster_cost = 0;
+    // The number of times the image was drawn, and the number of frames that
+    // it has been in the cache.
+    size_t hits = 0;
+    size_t frames_cached = 0;
+    // The estimated size of an image that is being rasterized concurrently.
+    size_t pending_bytes = 0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  // How much an entry is worth keeping in the byte budget: the raster time it
+  // saves per byte of its image. The raster cost of entries whose cost is not
+  // known, such as layers, is estimated from the size of their image.
+  using EntryValue = double;
+
+  static EntryValue GetEntryValue(const Entry& entry, size_t bytes);
+
+  // Evicts entries worth less than |entry| to make room for |bytes| more bytes
+  // in the budget, and returns whether there is enough room.
+  bool AdmitEntry(const Entry& entry, size_t bytes) const;
+
+  void EvictImage(RasterCacheKey::Map<Entry>::iterator it) const;
+
+  struct PendingRasterization {
+    explicit PendingRasterization(const RasterCacheKey& key) : key(key) {}
+
+    const RasterCacheKey key;
+    std::unique_ptr<RasterCacheResult> image;
+    fml::ManualResetWaitableEvent done;
+  };
+
+  bool CanRasterizeConcurrently(const RasterCacheKeyID& id,
+                                const Context& raster_cache_context) const;
+
+  void RasterizeConcurrently(
+      const RasterCacheKey& key,
+      const Context& raster_cache_context,
+      sk_sp<const DlRTree> rtree,
+      const std::function<void(DlCanvas*)>& render_function) const;
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  // Entries may be evicted to admit new ones while the cache is being
+  // prepared for a frame.
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
+  size_t byte_budget_ = 0;
+
+  std::shared_ptr<fml::BasicTaskRunner> concurrent_task_runner_;
+  size_t concurrent_rasterization_limit_per_frame_ = 0;
+  mutable size_t concurrent_rasterized_this_frame_ = 0;
+  mutable fml::TimeDelta concurrent_rasterization_wait_time_;
+  mutable std::vector<std::shared_ptr<PendingRasterization>>
+      pending_rasterizations_;
 
   void TraceStatsToTimeline() const;
 
@@ -15,6 +15,7 @@
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -320,6 +321,244 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, ConcurrentRasterizationOfDisplayLists) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  cache.SetConcurrentRasterization(loop->GetTaskRunner(), 2u);
+
+  DlMatrix matrix;
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  auto display_list_3 = GetSampleDisplayList();
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_3(display_list_3, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_3, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_3, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  // The first two entries are rasterized concurrently, and the third one
+  // exceeds the limit so it is rasterized synchronously.
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_3, paint_context));
+  cache.FinishConcurrentRasterization();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 76872u);
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_3.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().total_count(), 3u);
+  ASSERT_EQ(cache.picture_metrics().concurrent_rasterization_count, 2u);
+
+  // Cached entries are not rasterized again.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  cache.FinishConcurrentRasterization();
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.picture_metrics().concurrent_rasterization_count, 0u);
+}
+
+TEST(RasterCache, ByteBudgetLimitsAdmissionAndEviction) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Room for exactly one of the sample display lists.
+  cache.SetByteBudget(25624u);
+
+  DlMatrix matrix;
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  // The second entry is not worth more than the first one, so it is not
+  // admitted in its place.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+
+  // Shrinking the budget evicts the image, but keeps the entry.
+  cache.SetByteBudget(1u);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 2u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+
+  // Without a budget, both entries are cached.
+  cache.SetByteBudget(0u);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+  cache.EndFrame();
+}
+
+TEST(RasterCache, ByteBudgetEstimatesTheCostOfComplexEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  DlMatrix matrix;
+
+  // The raster cost of a display list that is marked as complex is not
+  // known, so it is estimated from the size of its image.
+  auto complex_display_list = GetSampleDisplayList();
+  DisplayListBuilder builder(DlRect::MakeWH(150, 100));
+  for (int i = 0; i < 1000; i++) {
+    builder.DrawRect(DlRect::MakeXYWH(10, 10, 80, 80),
+                     DlPaint(DlColor::kRed().withAlpha(i % 255 + 1)));
+  }
+  auto costly_display_list = builder.Build();
+
+  DisplayListBuilder dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem complex_item(complex_display_list, SkPoint(),
+                                          true, false);
+  DisplayListRasterCacheItem costly_item(costly_display_list, SkPoint(),
+                                         false, false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(complex_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(complex_item, paint_context);
+    complex_item.Draw(paint_context, &dummy_canvas, &paint);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  // Room for only one of the entries.
+  cache.SetByteBudget(25624u + 25624u / 2);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(complex_item, preroll_context, matrix);
+  RasterCacheItemPreroll(costly_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(complex_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  // The entry with a high known cost per byte is worth more than the entry of
+  // unknown cost, so it replaces it.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(complex_item, preroll_context, matrix);
+  RasterCacheItemPreroll(costly_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(RasterCacheItemTryToRasterCache(costly_item, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_TRUE(costly_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(complex_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -5,19 +5,190 @@
 #include "flutter/fml/concurrent_message_loop.h"
 
 #include <algorithm>
+#include <deque>
 
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 
 namespace fml {
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
-    : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+// The queue of tasks of a worker in the |SchedulingMode::kWorkStealing| mode.
+//
+// Tasks posted by the worker itself are pushed onto and popped from the
+// bottom of a lock-free Chase-Lev deque, while other workers steal tasks
+// from its top. Tasks posted by threads that are not workers of the loop are
+// collected in an inbox guarded by a mutex, which the worker moves onto its
+// deque in bulk.
+class ConcurrentMessageLoop::WorkerQueue {
+ public:
+  WorkerQueue() : buffer_(new Buffer(kInitialCapacity)) {}
+
+  ~WorkerQueue() {
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    for (int64_t i = top; i < bottom; i++) {
+      delete buffer->Get(i);
+    }
+    delete buffer;
+    for (Buffer* retired_buffer : retired_buffers_) {
+      delete retired_buffer;
+    }
+  }
+
+  // Must only be called by the worker that owns the queue.
+  void Push(std::unique_ptr<fml::closure> task) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top >= buffer->capacity) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Put(bottom, task.release());
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Must only be called by the worker that owns the queue.
+  std::unique_ptr<fml::closure> Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    // The store to |bottom_| must be ordered before the load of |top_|, just
+    // as thieves load |top_| before |bottom_|, so both are sequentially
+    // consistent.
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      // The deque was already empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    fml::closure* task = buffer->Get(bottom);
+    if (top == bottom) {
+      // This is the last task, so race the thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        task = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return std::unique_ptr<fml::closure>(task);
+  }
+
+  // May be called by any thread.
+  std::unique_ptr<fml::closure> Steal() {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    fml::closure* task = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      // Lost the race to the owner or to another thief.
+      return nullptr;
+    }
+    return std::unique_ptr<fml::closure>(task);
+  }
+
+  // May be called by any thread.
+  void PostToInbox(const fml::closure& task) {
+    std::scoped_lock lock(inbox_mutex_);
+    inbox_.push_back(std::make_unique<fml::closure>(task));
+  }
+
+  // Must only be called by the worker that owns the queue. Moves the tasks
+  // in the inbox onto the deque, where the other workers can steal them.
+  void DrainInbox() {
+    std::deque<std::unique_ptr<fml::closure>> inbox;
+    {
+      std::scoped_lock lock(inbox_mutex_);
+      std::swap(inbox, inbox_);
+    }
+    for (auto& task : inbox) {
+      Push(std::move(task));
+    }
+  }
+
+  // May be called by any thread. Does not wait for the inbox if it is in use.
+  std::unique_ptr<fml::closure> StealFromInbox() {
+    std::unique_lock lock(inbox_mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || inbox_.empty()) {
+      return nullptr;
+    }
+    std::unique_ptr<fml::closure> task = std::move(inbox_.front());
+    inbox_.pop_front();
+    return task;
+  }
+
+ private:
+  static constexpr int64_t kInitialCapacity = 64;
+
+  // A ring buffer whose capacity is a power of two.
+  struct Buffer {
+    explicit Buffer(int64_t capacity)
+        : capacity(capacity),
+          tasks(new std::atomic<fml::closure*>[capacity]) {}
+
+    fml::closure* Get(int64_t index) const {
+      return tasks[index & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, fml::closure* task) {
+      tasks[index & (capacity - 1)].store(task, std::memory_order_relaxed);
+    }
+
+    const int64_t capacity;
+    std::unique_ptr<std::atomic<fml::closure*>[]> tasks;
+  };
+
+  Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    Buffer* grown_buffer = new Buffer(buffer->capacity * 2);
+    for (int64_t i = top; i < bottom; i++) {
+      grown_buffer->Put(i, buffer->Get(i));
+    }
+    // Thieves may still be reading from the old buffer, so it is only
+    // deleted along with the queue.
+    retired_buffers_.push_back(buffer);
+    buffer_.store(grown_buffer, std::memory_order_release);
+    return grown_buffer;
+  }
+
+  std::atomic<int64_t> top_ = 0;
+  std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Buffer*> buffer_;
+  std::vector<Buffer*> retired_buffers_;
+
+  std::mutex inbox_mutex_;
+  std::deque<std::unique_ptr<fml::closure>> inbox_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkerQueue);
+};
+
+// The loop and index of the worker running on the current thread, if any.
+static thread_local ConcurrentMessageLoop* tls_worker_loop = nullptr;
+static thread_local size_t tls_worker_index = 0;
+
+ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count,
+                                             SchedulingMode scheduling_mode)
+    : worker_count_(std::max<size_t>(worker_count, 1ul)),
+      scheduling_mode_(scheduling_mode) {
+  if (scheduling_mode_ == SchedulingMode::kWorkStealing) {
+    for (size_t i = 0; i < worker_count_; ++i) {
+      worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      if (scheduling_mode_ == SchedulingMode::kWorkStealing) {
+        WorkStealingWorkerMain(i);
+      } else {
+        WorkerMain();
+      }
     });
   }
 
@@ -38,6 +209,11 @@ size_t ConcurrentMessageLoop::GetWorkerCount() const {
   return worker_count_;
 }
 
+ConcurrentMessageLoop::SchedulingMode ConcurrentMessageLoop::GetSchedulingMode()
+    const {
+  return scheduling_mode_;
+}
+
 std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
@@ -47,6 +223,11 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
+  if (scheduling_mode_ == SchedulingMode::kWorkStealing) {
+    PostWorkStealingTask(task);
+    return;
+  }
+
   std::unique_lock lock(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
@@ -112,6 +293,125 @@ void ConcurrentMessageLoop::WorkerMain() {
   }
 }
 
+void ConcurrentMessageLoop::PostWorkStealingTask(const fml::closure& task) {
+  // Don't just drop tasks on the floor in case of shutdown.
+  if (shutdown_) {
+    FML_DLOG(WARNING)
+        << "Tried to post a task to shutdown concurrent message "
+           "loop. The task will be executed on the callers thread.";
+    ExecuteTask(task);
+    return;
+  }
+
+  // The count is incremented before the task is queued so that it never
+  // drops below zero. It must also be incremented before checking for
+  // sleeping workers, and workers check it after announcing that they are
+  // going to sleep, so that either this thread sees the sleeping worker or
+  // the worker sees the task.
+  pending_task_count_.fetch_add(1);
+
+  if (tls_worker_loop == this) {
+    worker_queues_[tls_worker_index]->Push(
+        std::make_unique<fml::closure>(task));
+  } else {
+    size_t worker_index =
+        next_worker_queue_.fetch_add(1, std::memory_order_relaxed) %
+        worker_count_;
+    worker_queues_[worker_index]->PostToInbox(task);
+  }
+
+  if (sleeping_worker_count_.load() > 0) {
+    // Acquiring the mutex ensures that a worker that is about to sleep is
+    // either still before its check for tasks or already waiting.
+    { std::scoped_lock lock(tasks_mutex_); }
+    tasks_condition_.notify_one();
+  }
+}
+
+std::unique_ptr<fml::closure> ConcurrentMessageLoop::TakeWorkStealingTask(
+    size_t worker_index,
+    uint32_t& random_state) {
+  WorkerQueue& queue = *worker_queues_[worker_index];
+  std::unique_ptr<fml::closure> task = queue.Pop();
+  if (!task) {
+    queue.DrainInbox();
+    task = queue.Pop();
+  }
+  if (!task && worker_count_ > 1) {
+    // Visit the other workers starting from a random one (xorshift32).
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    size_t victim_index = random_state % worker_count_;
+    for (size_t i = 0; i < worker_count_ && !task; ++i) {
+      if (victim_index != worker_index) {
+        WorkerQueue& victim = *worker_queues_[victim_index];
+        task = victim.Steal();
+        if (!task) {
+          task = victim.StealFromInbox();
+        }
+      }
+      victim_index = (victim_index + 1) % worker_count_;
+    }
+  }
+  if (task) {
+    pending_task_count_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+void ConcurrentMessageLoop::WorkStealingWorkerMain(size_t worker_index) {
+  tls_worker_loop = this;
+  tls_worker_index = worker_index;
+  uint32_t random_state = static_cast<uint32_t>(worker_index) + 1u;
+
+  while (true) {
+    if (std::unique_ptr<fml::closure> task =
+            TakeWorkStealingTask(worker_index, random_state)) {
+      ExecuteTask(*task);
+      if (!shutdown_.load(std::memory_order_relaxed)) {
+        continue;
+      }
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    sleeping_worker_count_.fetch_add(1);
+    tasks_condition_.wait(lock, [&]() {
+      return pending_task_count_.load() > 0 || shutdown_ ||
+             HasThreadTasksLocked();
+    });
+    sleeping_worker_count_.fetch_sub(1, std::memory_order_relaxed);
+
+    // Shutdown cannot be read with the task mutex unlocked.
+    bool shutdown_now = shutdown_;
+    std::vector<fml::closure> thread_tasks;
+    if (HasThreadTasksLocked()) {
+      thread_tasks = GetThreadTasksLocked();
+      FML_DCHECK(!HasThreadTasksLocked());
+    }
+
+    // Don't hold onto the mutex while tasks are being executed as they could
+    // themselves try to post more tasks to the message loop.
+    lock.unlock();
+
+    for (const auto& thread_task : thread_tasks) {
+      ExecuteTask(thread_task);
+    }
+
+    if (shutdown_now) {
+      break;
+    }
+
+    if (thread_tasks.empty()) {
+      // The tasks that woke this worker may be about to be taken by other
+      // workers, so give them a chance to run before trying to steal again.
+      std::this_thread::yield();
+    }
+  }
+
+  tls_worker_loop = nullptr;
+}
+
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
   task();
 }
@@ -5,8 +5,10 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
+#include <memory>
 #include <queue>
 #include <thread>
 
@@ -21,13 +23,27 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  // How the tasks posted to the loop are handed out to its workers.
+  enum class SchedulingMode {
+    // All workers take tasks from a single queue guarded by a mutex.
+    kSharedQueue,
+    // Each worker takes tasks from its own queue first and steals tasks from
+    // the queues of the other workers, picked at random, when it runs out.
+    // Tasks posted by a worker are pushed onto its own lock-free queue, and
+    // tasks posted by other threads are spread across the workers.
+    kWorkStealing,
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      SchedulingMode scheduling_mode = SchedulingMode::kSharedQueue);
 
   virtual ~ConcurrentMessageLoop();
 
   size_t GetWorkerCount() const;
 
+  SchedulingMode GetSchedulingMode() const;
+
   std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner();
 
   void Terminate();
@@ -37,25 +53,43 @@ class ConcurrentMessageLoop
   bool RunsTasksOnCurrentThread();
 
  protected:
-  explicit ConcurrentMessageLoop(size_t worker_count);
+  explicit ConcurrentMessageLoop(
+      size_t worker_count,
+      SchedulingMode scheduling_mode = SchedulingMode::kSharedQueue);
   virtual void ExecuteTask(const fml::closure& task);
 
  private:
   friend ConcurrentTaskRunner;
 
+  class WorkerQueue;
+
   size_t worker_count_ = 0;
+  SchedulingMode scheduling_mode_;
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
   std::queue<fml::closure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic<bool> shutdown_ = false;
+
+  // Only used in the |SchedulingMode::kWorkStealing| mode.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  std::atomic<size_t> pending_task_count_ = 0;
+  std::atomic<size_t> sleeping_worker_count_ = 0;
+  std::atomic<size_t> next_worker_queue_ = 0;
 
   void WorkerMain();
 
+  void WorkStealingWorkerMain(size_t worker_index);
+
   void PostTask(const fml::closure& task);
 
+  void PostWorkStealingTask(const fml::closure& task);
+
+  std::unique_ptr<fml::closure> TakeWorkStealingTask(size_t worker_index,
+                                                     uint32_t& random_state);
+
   bool HasThreadTasksLocked() const;
 
   std::vector<fml::closure> GetThreadTasksLocked();
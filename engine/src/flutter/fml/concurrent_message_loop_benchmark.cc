@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+
+namespace fml {
+namespace benchmarking {
+
+static constexpr int64_t kTaskCount = 10000;
+static constexpr int64_t kNestedTaskCount = 10;
+
+// Posts |kTaskCount| tasks from a thread that is not a worker of the loop.
+static void BM_ConcurrentMessageLoopPostTasks(
+    benchmark::State& state,
+    ConcurrentMessageLoop::SchedulingMode scheduling_mode) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0), scheduling_mode);
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    std::atomic<int64_t> remaining_tasks = kTaskCount;
+    AutoResetWaitableEvent done;
+    for (int64_t i = 0; i < kTaskCount; i++) {
+      task_runner->PostTask([&remaining_tasks, &done]() {
+        if (--remaining_tasks == 0) {
+          done.Signal();
+        }
+      });
+    }
+    done.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+// Posts |kTaskCount| tasks from a thread that is not a worker of the loop,
+// each of which posts |kNestedTaskCount| more tasks from a worker.
+static void BM_ConcurrentMessageLoopPostNestedTasks(
+    benchmark::State& state,
+    ConcurrentMessageLoop::SchedulingMode scheduling_mode) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0), scheduling_mode);
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    std::atomic<int64_t> remaining_tasks =
+        kTaskCount * (kNestedTaskCount + 1);
+    AutoResetWaitableEvent done;
+    for (int64_t i = 0; i < kTaskCount; i++) {
+      task_runner->PostTask([&task_runner, &remaining_tasks, &done]() {
+        for (int64_t j = 0; j < kNestedTaskCount; j++) {
+          task_runner->PostTask([&remaining_tasks, &done]() {
+            if (--remaining_tasks == 0) {
+              done.Signal();
+            }
+          });
+        }
+        // The outer tasks are counted as well so that the loop isn't torn
+        // down while they are still posting.
+        if (--remaining_tasks == 0) {
+          done.Signal();
+        }
+      });
+    }
+    done.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount *
+                          (kNestedTaskCount + 1));
+}
+
+BENCHMARK_CAPTURE(BM_ConcurrentMessageLoopPostTasks,
+                  SharedQueue,
+                  ConcurrentMessageLoop::SchedulingMode::kSharedQueue)
+    ->RangeMultiplier(2)
+    ->Range(2, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentMessageLoopPostTasks,
+                  WorkStealing,
+                  ConcurrentMessageLoop::SchedulingMode::kWorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(2, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentMessageLoopPostNestedTasks,
+                  SharedQueue,
+                  ConcurrentMessageLoop::SchedulingMode::kSharedQueue)
+    ->RangeMultiplier(2)
+    ->Range(2, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentMessageLoopPostNestedTasks,
+                  WorkStealing,
+                  ConcurrentMessageLoop::SchedulingMode::kWorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(2, 32)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
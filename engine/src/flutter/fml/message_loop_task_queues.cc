@@ -48,10 +48,9 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
-  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
-  ++task_queue_id_counter_;
-  queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
+  std::unique_lock lock(queue_entries_mutex_);
+  TaskQueueId loop_id = TaskQueueId(queue_entries_.size());
+  queue_entries_.push_back(std::make_unique<TaskQueueEntry>(loop_id));
   return loop_id;
 }
 
@@ -63,25 +62,26 @@ MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
+  std::unique_lock lock(queue_entries_mutex_);
+  const auto& queue_entry = GetEntryUnlocked(queue_id);
+  FML_DCHECK(queue_entry.subsumed_by == kUnmerged);
+  auto& subsumed_set = queue_entry.owner_of;
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.erase(subsumed);
+    queue_entries_[subsumed].reset();
   }
-  // Erase owner queue_id at last to avoid &subsumed_set from being invalid
-  queue_entries_.erase(queue_id);
+  // Reset owner queue_id at last to avoid &subsumed_set from being invalid
+  queue_entries_[queue_id].reset();
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
-  queue_entry->task_source->ShutDown();
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
+  const auto& queue_entry = GetEntryUnlocked(queue_id);
+  FML_DCHECK(queue_entry.subsumed_by == kUnmerged);
+  auto& subsumed_set = queue_entry.owner_of;
+  queue_entry.task_source->ShutDown();
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.at(subsumed)->task_source->ShutDown();
+    GetEntryUnlocked(subsumed).task_source->ShutDown();
   }
 }
 
@@ -94,14 +94,15 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
   size_t order = order_++;
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
+  const auto& queue_entry = GetEntryUnlocked(queue_id);
+  queue_entry.task_source->RegisterTask(
       {order, task, target_time, task_source_grade});
   TaskQueueId loop_to_wake = queue_id;
-  if (queue_entry->subsumed_by != kUnmerged) {
-    loop_to_wake = queue_entry->subsumed_by;
+  if (queue_entry.subsumed_by != kUnmerged) {
+    loop_to_wake = queue_entry.subsumed_by;
   }
 
   // This can happen when the secondary tasks are paused.
@@ -111,13 +112,15 @@ void MessageLoopTaskQueues::RegisterTask(
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
@@ -134,32 +137,50 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   }
   fml::closure invocation = top.task.GetTask();
   const auto task_source_grade = top.task.GetTaskSourceGrade();
-  queue_entries_.at(top.task_queue_id)->task_source->PopTask(task_source_grade);
+  GetEntryUnlocked(top.task_queue_id).task_source->PopTask(task_source_grade);
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
 
+TaskQueueEntry& MessageLoopTaskQueues::GetEntryUnlocked(
+    TaskQueueId queue_id) const {
+  FML_CHECK(queue_id < queue_entries_.size() && queue_entries_[queue_id])
+      << "Unknown task queue " << queue_id;
+  return *queue_entries_[queue_id];
+}
+
+std::mutex& MessageLoopTaskQueues::GetTasksMutexUnlocked(
+    TaskQueueId queue_id) const {
+  TaskQueueEntry& entry = GetEntryUnlocked(queue_id);
+  if (entry.subsumed_by != kUnmerged) {
+    return GetEntryUnlocked(entry.subsumed_by).tasks_mutex;
+  }
+  return entry.tasks_mutex;
+}
+
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+  const auto& queue_entry = GetEntryUnlocked(queue_id);
+  if (queue_entry.wakeable) {
+    queue_entry.wakeable->WakeUp(time);
   }
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  if (queue_entry->subsumed_by != kUnmerged) {
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
+  const auto& queue_entry = GetEntryUnlocked(queue_id);
+  if (queue_entry.subsumed_by != kUnmerged) {
     return 0;
   }
 
   size_t total_tasks = 0;
-  total_tasks += queue_entry->task_source->GetNumPendingTasks();
+  total_tasks += queue_entry.task_source->GetNumPendingTasks();
 
-  auto& subsumed_set = queue_entry->owner_of;
+  auto& subsumed_set = queue_entry.owner_of;
   for (auto& subsumed : subsumed_set) {
-    const auto& subsumed_entry = queue_entries_.at(subsumed);
-    total_tasks += subsumed_entry->task_source->GetNumPendingTasks();
+    const auto& subsumed_entry = GetEntryUnlocked(subsumed);
+    total_tasks += subsumed_entry.task_source->GetNumPendingTasks();
   }
   return total_tasks;
 }
@@ -167,33 +188,37 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  GetEntryUnlocked(queue_id).task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
+  GetEntryUnlocked(queue_id).task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
   std::vector<fml::closure> observers;
 
-  if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
+  const auto& queue_entry = GetEntryUnlocked(queue_id);
+  if (queue_entry.subsumed_by != kUnmerged) {
     return observers;
   }
 
-  for (const auto& observer : queue_entries_.at(queue_id)->task_observers) {
+  for (const auto& observer : queue_entry.task_observers) {
     observers.push_back(observer.second);
   }
 
-  auto& subsumed_set = queue_entries_.at(queue_id)->owner_of;
+  auto& subsumed_set = queue_entry.owner_of;
   for (auto& subsumed : subsumed_set) {
-    for (const auto& observer : queue_entries_.at(subsumed)->task_observers) {
+    for (const auto& observer : GetEntryUnlocked(subsumed).task_observers) {
       observers.push_back(observer.second);
     }
   }
@@ -203,20 +228,23 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
+  auto& queue_entry = GetEntryUnlocked(queue_id);
+  FML_CHECK(!queue_entry.wakeable) << "Wakeable can only be set once.";
+  queue_entry.wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
-  auto& owner_entry = queue_entries_.at(owner);
-  auto& subsumed_entry = queue_entries_.at(subsumed);
-  auto& subsumed_set = owner_entry->owner_of;
+  // Changing the ownership of the TaskQueues also changes the mutexes guarding
+  // their tasks, so no other operation may be in progress.
+  std::unique_lock lock(queue_entries_mutex_);
+  auto& owner_entry = GetEntryUnlocked(owner);
+  auto& subsumed_entry = GetEntryUnlocked(subsumed);
+  auto& subsumed_set = owner_entry.owner_of;
   if (subsumed_set.find(subsumed) != subsumed_set.end()) {
     return true;
   }
@@ -225,33 +253,33 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   // merged with other different queues.
 
   // Ensure owner_entry->subsumed_by being kUnmerged
-  if (owner_entry->subsumed_by != kUnmerged) {
+  if (owner_entry.subsumed_by != kUnmerged) {
     FML_LOG(WARNING) << "Thread merging failed: owner_entry was already "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed
-                     << ", owner->subsumed_by=" << owner_entry->subsumed_by;
+                     << ", owner->subsumed_by=" << owner_entry.subsumed_by;
     return false;
   }
   // Ensure subsumed_entry->owner_of being empty
-  if (!subsumed_entry->owner_of.empty()) {
+  if (!subsumed_entry.owner_of.empty()) {
     FML_LOG(WARNING)
         << "Thread merging failed: subsumed_entry already owns others, owner="
         << owner << ", subsumed=" << subsumed
-        << ", subsumed->owner_of.size()=" << subsumed_entry->owner_of.size();
+        << ", subsumed->owner_of.size()=" << subsumed_entry.owner_of.size();
     return false;
   }
   // Ensure subsumed_entry->subsumed_by being kUnmerged
-  if (subsumed_entry->subsumed_by != kUnmerged) {
+  if (subsumed_entry.subsumed_by != kUnmerged) {
     FML_LOG(WARNING) << "Thread merging failed: subsumed_entry was already "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed
                      << ", subsumed->subsumed_by="
-                     << subsumed_entry->subsumed_by;
+                     << subsumed_entry.subsumed_by;
     return false;
   }
   // All checking is OK, set merged state.
-  owner_entry->owner_of.insert(subsumed);
-  subsumed_entry->subsumed_by = owner;
+  owner_entry.owner_of.insert(subsumed);
+  subsumed_entry.subsumed_by = owner;
 
   if (HasPendingTasksUnlocked(owner)) {
     WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
@@ -261,36 +289,36 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& owner_entry = queue_entries_.at(owner);
-  if (owner_entry->owner_of.empty()) {
+  std::unique_lock lock(queue_entries_mutex_);
+  auto& owner_entry = GetEntryUnlocked(owner);
+  if (owner_entry.owner_of.empty()) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry doesn't own anyone, owner="
         << owner << ", subsumed=" << subsumed;
     return false;
   }
-  if (owner_entry->subsumed_by != kUnmerged) {
+  if (owner_entry.subsumed_by != kUnmerged) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry was subsumed by others, owner="
         << owner << ", subsumed=" << subsumed
-        << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by;
+        << ", owner_entry->subsumed_by=" << owner_entry.subsumed_by;
     return false;
   }
-  if (queue_entries_.at(subsumed)->subsumed_by == kUnmerged) {
+  if (GetEntryUnlocked(subsumed).subsumed_by == kUnmerged) {
     FML_LOG(WARNING) << "Thread unmerging failed: subsumed_entry wasn't "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed;
     return false;
   }
-  if (owner_entry->owner_of.find(subsumed) == owner_entry->owner_of.end()) {
+  if (owner_entry.owner_of.find(subsumed) == owner_entry.owner_of.end()) {
     FML_LOG(WARNING) << "Thread unmerging failed: owner_entry didn't own the "
                         "given subsumed queue id, owner="
                      << owner << ", subsumed=" << subsumed;
     return false;
   }
 
-  queue_entries_.at(subsumed)->subsumed_by = kUnmerged;
-  owner_entry->owner_of.erase(subsumed);
+  GetEntryUnlocked(subsumed).subsumed_by = kUnmerged;
+  owner_entry.owner_of.erase(subsumed);
 
   if (HasPendingTasksUnlocked(owner)) {
     WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
@@ -305,28 +333,30 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock lock(queue_entries_mutex_);
   if (owner == kUnmerged || subsumed == kUnmerged) {
     return false;
   }
-  auto& subsumed_set = queue_entries_.at(owner)->owner_of;
+  auto& subsumed_set = GetEntryUnlocked(owner).owner_of;
   return subsumed_set.find(subsumed) != subsumed_set.end();
 }
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
-  return queue_entries_.at(owner)->owner_of;
+  std::shared_lock lock(queue_entries_mutex_);
+  return GetEntryUnlocked(owner).owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
+  GetEntryUnlocked(queue_id).task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->ResumeSecondary();
+  std::shared_lock entries_lock(queue_entries_mutex_);
+  std::scoped_lock tasks_lock(GetTasksMutexUnlocked(queue_id));
+  GetEntryUnlocked(queue_id).task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
@@ -337,20 +367,20 @@ void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
 // Owning queues will consider both their and their subsumed tasks.
 bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
     TaskQueueId queue_id) const {
-  const auto& entry = queue_entries_.at(queue_id);
-  bool is_subsumed = entry->subsumed_by != kUnmerged;
+  const auto& entry = GetEntryUnlocked(queue_id);
+  bool is_subsumed = entry.subsumed_by != kUnmerged;
   if (is_subsumed) {
     return false;
   }
 
-  if (!entry->task_source->IsEmpty()) {
+  if (!entry.task_source->IsEmpty()) {
     return true;
   }
 
-  auto& subsumed_set = entry->owner_of;
+  auto& subsumed_set = entry.owner_of;
   return std::any_of(
       subsumed_set.begin(), subsumed_set.end(), [&](const auto& subsumed) {
-        return !queue_entries_.at(subsumed)->task_source->IsEmpty();
+        return !GetEntryUnlocked(subsumed).task_source->IsEmpty();
       });
 }
 
@@ -362,10 +392,10 @@ fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
 TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
     TaskQueueId owner) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
-  const auto& entry = queue_entries_.at(owner);
-  if (entry->owner_of.empty()) {
-    FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+  const auto& entry = GetEntryUnlocked(owner);
+  if (entry.owner_of.empty()) {
+    FML_CHECK(!entry.task_source->IsEmpty());
+    return entry.task_source->Top();
   }
 
   // Use optional for the memory of TopTask object.
@@ -381,11 +411,11 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
         }
       };
 
-  TaskSource* owner_tasks = entry->task_source.get();
+  TaskSource* owner_tasks = entry.task_source.get();
   top_task_updater(owner_tasks);
 
-  for (TaskQueueId subsumed : entry->owner_of) {
-    TaskSource* subsumed_tasks = queue_entries_.at(subsumed)->task_source.get();
+  for (TaskQueueId subsumed : entry.owner_of) {
+    TaskSource* subsumed_tasks = GetEntryUnlocked(subsumed).task_source.get();
     top_task_updater(subsumed_tasks);
   }
   // At least one task at the top because PeekNextTaskUnlocked() is called after
@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -45,6 +46,11 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards the wakeable, task observers and tasks of this TaskQueue and of
+  /// the TaskQueues it owns. The tasks of a subsumed TaskQueue are guarded by
+  /// the mutex of its owner instead.
+  std::mutex tasks_mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -143,6 +149,14 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  // Returns the entry of the given TaskQueue. |queue_entries_mutex_| must be
+  // held.
+  TaskQueueEntry& GetEntryUnlocked(TaskQueueId queue_id) const;
+
+  // Returns the mutex guarding the tasks of the given TaskQueue, which is the
+  // mutex of its owner if it is subsumed. |queue_entries_mutex_| must be held.
+  std::mutex& GetTasksMutexUnlocked(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
@@ -151,10 +165,15 @@ class MessageLoopTaskQueues {
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
-  std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
+  // Guards |queue_entries_| and the ownership of the entries. Operations on
+  // the tasks of a TaskQueue hold it shared, along with the |tasks_mutex| of
+  // the entry, so that operations on different TaskQueues don't contend.
+  // Creating, disposing, merging and unmerging TaskQueues hold it exclusively.
+  mutable std::shared_mutex queue_entries_mutex_;
 
-  size_t task_queue_id_counter_ = 0;
+  // Indexed by TaskQueueId. Ids are never reused, so the entries of disposed
+  // TaskQueues are left null.
+  std::vector<std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   std::atomic_int order_;
 
@@ -66,5 +66,71 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Simulates |state.range(0)| engines running concurrently, each of which posts
+// tasks to and runs tasks from its own platform, UI, raster and IO task
+// queues on its own thread.
+static void BM_RegisterAndGetTasksConcurrentEngines(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  const int num_engines = state.range(0);
+  const int num_task_queues_per_engine = 4;
+  const int num_tasks_per_queue = 100;
+
+  std::vector<std::vector<TaskQueueId>> engine_task_queues(num_engines);
+  for (auto& engine : engine_task_queues) {
+    for (int i = 0; i < num_task_queues_per_engine; i++) {
+      engine.push_back(task_queues->CreateTaskQueue());
+    }
+  }
+
+  while (state.KeepRunning()) {
+    const fml::TimePoint past = fml::TimePoint::Now();
+    std::vector<std::thread> threads;
+    CountDownLatch engines_started(num_engines);
+
+    threads.reserve(num_engines);
+    for (const auto& engine : engine_task_queues) {
+      threads.emplace_back([&engine, &task_queues, &engines_started, past]() {
+        engines_started.CountDown();
+        engines_started.Wait();
+        const auto now = fml::TimePoint::Now();
+        int num_invocations = 0;
+        for (int j = 0; j < num_tasks_per_queue; j++) {
+          for (TaskQueueId queue_id : engine) {
+            task_queues->RegisterTask(queue_id, [] {}, past);
+          }
+          for (TaskQueueId queue_id : engine) {
+            if (task_queues->GetNextTaskToRun(queue_id, now)) {
+              num_invocations++;
+            }
+          }
+        }
+        assert(num_invocations ==
+               num_tasks_per_queue * num_task_queues_per_engine);
+        (void)num_invocations;
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto& engine : engine_task_queues) {
+    for (TaskQueueId queue_id : engine) {
+      task_queues->Dispose(queue_id);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_engines *
+                          num_task_queues_per_engine * num_tasks_per_queue);
+}
+
+BENCHMARK(BM_RegisterAndGetTasksConcurrentEngines)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -442,5 +442,47 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that tasks can be added to and run from task queues concurrently
+/// while they are being merged and unmerged.
+///
+TEST(MessageLoopTaskQueue, ConcurrentTasksWhileMergingAndUnmerging) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queues->CreateTaskQueue();
+  auto raster_queue = task_queues->CreateTaskQueue();
+
+  constexpr size_t kThreadTaskCount = 1000;
+  constexpr size_t kMergeCount = 100;
+
+  std::atomic<size_t> run_tasks = 0;
+  auto thread_main = [&](TaskQueueId queue_id) {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(queue_id, []() {}, ChronoTicksSinceEpoch());
+      if (task_queues->GetNextTaskToRun(queue_id, ChronoTicksSinceEpoch())) {
+        run_tasks++;
+      }
+    }
+  };
+
+  std::thread platform_thread(thread_main, platform_queue);
+  std::thread raster_thread(thread_main, raster_queue);
+
+  for (size_t i = 0; i < kMergeCount; i++) {
+    ASSERT_TRUE(task_queues->Merge(platform_queue, raster_queue));
+    ASSERT_TRUE(task_queues->Unmerge(platform_queue, raster_queue));
+  }
+
+  platform_thread.join();
+  raster_thread.join();
+
+  // Every task has either been run or is still pending.
+  ASSERT_EQ(run_tasks + task_queues->GetNumPendingTasks(platform_queue) +
+                task_queues->GetNumPendingTasks(raster_queue),
+            2 * kThreadTaskCount);
+
+  task_queues->Dispose(platform_queue);
+  task_queues->Dispose(raster_queue);
+}
+
 }  // namespace testing
 }  // namespace fml
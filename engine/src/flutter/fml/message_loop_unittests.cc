@@ -212,3 +212,62 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsAllTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  ASSERT_EQ(loop->GetSchedulingMode(),
+            fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  const size_t kNestedCount = 10;
+  fml::CountDownLatch latch(kCount * (kNestedCount + 1));
+  std::atomic<size_t> ran_on_worker_count = 0;
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      // Tasks posted from a worker go onto its own queue, where they may be
+      // stolen by the other workers.
+      for (size_t j = 0; j < kNestedCount; ++j) {
+        task_runner->PostTask([&]() {
+          if (loop->RunsTasksOnCurrentThread()) {
+            ran_on_worker_count++;
+          }
+          latch.CountDown();
+        });
+      }
+      if (loop->RunsTasksOnCurrentThread()) {
+        ran_on_worker_count++;
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  ASSERT_EQ(ran_on_worker_count, kCount * (kNestedCount + 1));
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsTasksOnAllWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+  fml::CountDownLatch latch(loop->GetWorkerCount());
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), loop->GetWorkerCount());
+}
+
+TEST(MessageLoop, CanCreateAndShutdownWorkStealingConcurrentMessageLoops) {
+  for (size_t i = 0; i < 10; ++i) {
+    auto loop = fml::ConcurrentMessageLoop::Create(
+        i + 1, fml::ConcurrentMessageLoop::SchedulingMode::kWorkStealing);
+    for (size_t j = 0; j < 100; ++j) {
+      loop->GetTaskRunner()->PostTask([]() {});
+    }
+  }
+}
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_BASE_FLAGS_H_
 #define FLUTTER_IMPELLER_BASE_FLAGS_H_
 
+#include <cstddef>
+
 namespace impeller {
 struct Flags {
   /// Whether to defer PSO construction until first use. Usage Will introduce
@@ -12,6 +14,16 @@ struct Flags {
   bool lazy_shader_mode = false;
   /// When turned on DrawLine will use the experimental antialiased path.
   bool antialiased_lines = false;
+  /// The maximum size in bytes of each glyph atlas texture. Once an atlas
+  /// reaches this size, the space of its least recently used glyphs is
+  /// reclaimed for new glyphs. Zero means the atlas may grow up to the
+  /// maximum texture size supported by the device.
+  size_t glyph_atlas_max_bytes = 0;
+  /// The maximum number of fixed size pages in each glyph atlas. Paged atlases
+  /// grow by allocating a new page instead of copying the existing glyphs into
+  /// a larger texture, and [glyph_atlas_max_bytes] then caps each page. Zero
+  /// means each atlas is a single texture that is grown as needed.
+  size_t glyph_atlas_max_pages = 0;
 };
 }  // namespace impeller
 
@@ -0,0 +1,225 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/compilation_cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "impeller/compiler/compiler.h"
+
+namespace impeller {
+namespace compiler {
+
+namespace {
+
+// Changing the layout of entries requires changing the magic, so that entries
+// in the old layout are ignored.
+constexpr char kEntryMagic[8] = {'I', 'M', 'P', 'C', 'C', 'A', 'C', '1'};
+
+/// Describes the running compiler binary, so that keys change whenever
+/// impellerc is rebuilt.
+std::string GetCompilerIdentity() {
+  auto [found, path] = fml::paths::GetExecutablePath();
+  if (!found) {
+    return "";
+  }
+  std::error_code size_error;
+  std::error_code time_error;
+  auto size = std::filesystem::file_size(path, size_error);
+  auto write_time = std::filesystem::last_write_time(path, time_error);
+  if (size_error || time_error) {
+    return path;
+  }
+  return std::format("{}:{}:{}", path, size,
+                     write_time.time_since_epoch().count());
+}
+
+void AppendSize(std::string& data, uint64_t size) {
+  data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+}
+
+void AppendString(std::string& data, std::string_view value) {
+  AppendSize(data, value.size());
+  data.append(value);
+}
+
+class EntryReader {
+ public:
+  explicit EntryReader(const fml::Mapping& mapping)
+      : data_(mapping.GetMapping()), size_(mapping.GetSize()) {}
+
+  bool ReadSize(uint64_t& size) {
+    if (size_ - offset_ < sizeof(size)) {
+      return false;
+    }
+    std::memcpy(&size, data_ + offset_, sizeof(size));
+    offset_ += sizeof(size);
+    return true;
+  }
+
+  const uint8_t* ReadBytes(uint64_t size) {
+    if (size_ - offset_ < size) {
+      return nullptr;
+    }
+    const uint8_t* bytes = data_ + offset_;
+    offset_ += size;
+    return bytes;
+  }
+
+  bool IsAtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0u;
+};
+
+}  // namespace
+
+CompilationCacheKey::CompilationCacheKey() {
+  Add("impellerc", GetCompilerIdentity());
+}
+
+CompilationCacheKey::~CompilationCacheKey() = default;
+
+void CompilationCacheKey::Add(std::string_view name, std::string_view value) {
+  AppendString(data_, name);
+  AppendString(data_, value);
+}
+
+void CompilationCacheKey::Add(std::string_view name,
+                              const fml::Mapping& value) {
+  Add(name, std::string_view(reinterpret_cast<const char*>(value.GetMapping()),
+                             value.GetSize()));
+}
+
+bool CompilationCacheKey::AddPreprocessedSource(
+    std::string_view name,
+    const std::shared_ptr<const fml::Mapping>& source,
+    const SourceOptions& options) {
+  std::stringstream errors;
+  std::shared_ptr<fml::Mapping> preprocessed =
+      Compiler::Preprocess(source, options, errors);
+  if (!preprocessed) {
+    return false;
+  }
+  Add(name, *preprocessed);
+  return true;
+}
+
+const std::string& CompilationCacheKey::GetData() const {
+  return data_;
+}
+
+std::string CompilationCacheKey::GetDigest() const {
+  // Two differently seeded 64-bit FNV-1a hashes. Collisions only cost a miss,
+  // since entries are checked against the full key.
+  uint64_t hash_a = 0xcbf29ce484222325u;
+  uint64_t hash_b = 0x84222325cbf29ce4u;
+  for (char c : data_) {
+    const uint8_t byte = static_cast<uint8_t>(c);
+    hash_a = (hash_a ^ byte) * 0x100000001b3u;
+    hash_b = (hash_b ^ byte) * 0x100000001b3u;
+  }
+  return std::format("{:016x}{:016x}", hash_a, hash_b);
+}
+
+std::unique_ptr<CompilationCache> CompilationCache::Open(
+    const std::string& path) {
+  std::error_code error;
+  std::filesystem::create_directories(path, error);
+  fml::UniqueFD directory = fml::OpenDirectory(
+      path.c_str(), false, fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    return nullptr;
+  }
+  return std::make_unique<CompilationCache>(std::move(directory));
+}
+
+CompilationCache::CompilationCache(fml::UniqueFD directory)
+    : directory_(std::move(directory)) {}
+
+CompilationCache::~CompilationCache() = default;
+
+std::optional<CompilationCache::Outputs> CompilationCache::Get(
+    const CompilationCacheKey& key) const {
+  std::shared_ptr<fml::FileMapping> entry =
+      fml::FileMapping::CreateReadOnly(directory_, key.GetDigest());
+  if (!entry || entry->GetMapping() == nullptr) {
+    return std::nullopt;
+  }
+
+  EntryReader reader(*entry);
+  const uint8_t* magic = reader.ReadBytes(sizeof(kEntryMagic));
+  if (!magic || std::memcmp(magic, kEntryMagic, sizeof(kEntryMagic)) != 0) {
+    return std::nullopt;
+  }
+
+  const std::string& key_data = key.GetData();
+  uint64_t key_size = 0u;
+  if (!reader.ReadSize(key_size) || key_size != key_data.size()) {
+    return std::nullopt;
+  }
+  const uint8_t* stored_key = reader.ReadBytes(key_size);
+  if (!stored_key || std::memcmp(stored_key, key_data.data(), key_size) != 0) {
+    return std::nullopt;
+  }
+
+  uint64_t output_count = 0u;
+  if (!reader.ReadSize(output_count)) {
+    return std::nullopt;
+  }
+  Outputs outputs;
+  for (uint64_t i = 0; i < output_count; i++) {
+    uint64_t name_size = 0u;
+    uint64_t data_size = 0u;
+    const uint8_t* name = nullptr;
+    const uint8_t* data = nullptr;
+    if (!reader.ReadSize(name_size) ||
+        !(name = reader.ReadBytes(name_size)) ||
+        !reader.ReadSize(data_size) || !(data = reader.ReadBytes(data_size))) {
+      return std::nullopt;
+    }
+    // The outputs refer into the entry's mapping rather than copying it.
+    outputs[std::string(reinterpret_cast<const char*>(name), name_size)] =
+        std::make_shared<fml::NonOwnedMapping>(data, data_size,
+                                               [entry](auto, auto) {});
+  }
+  if (!reader.IsAtEnd()) {
+    return std::nullopt;
+  }
+  return outputs;
+}
+
+bool CompilationCache::Put(const CompilationCacheKey& key,
+                           const Outputs& outputs) const {
+  std::string entry(kEntryMagic, sizeof(kEntryMagic));
+  AppendString(entry, key.GetData());
+  AppendSize(entry, outputs.size());
+  for (const auto& [name, data] : outputs) {
+    if (!data) {
+      return false;
+    }
+    AppendString(entry, name);
+    AppendString(entry,
+                 std::string_view(reinterpret_cast<const char*>(
+                                      data->GetMapping()),
+                                  data->GetSize()));
+  }
+
+  // Entries are written atomically, so concurrent compilations of the same
+  // source at worst both write the same entry.
+  return fml::WriteAtomically(
+      directory_, key.GetDigest().c_str(),
+      fml::NonOwnedMapping(reinterpret_cast<const uint8_t*>(entry.data()),
+                           entry.size()));
+}
+
+}  // namespace compiler
+}  // namespace impeller
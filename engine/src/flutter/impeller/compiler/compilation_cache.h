@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_COMPILER_COMPILATION_CACHE_H_
+#define FLUTTER_IMPELLER_COMPILER_COMPILATION_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/compiler/source_options.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      Everything that determines the outputs of a compilation.
+///
+///             Keys are built from the preprocessed sources, so that edits to
+///             included files are noticed, and from the options of the
+///             compilation. They also include the identity of the running
+///             compiler binary, so that rebuilding impellerc invalidates
+///             everything it cached.
+///
+class CompilationCacheKey {
+ public:
+  CompilationCacheKey();
+
+  ~CompilationCacheKey();
+
+  CompilationCacheKey(const CompilationCacheKey&) = default;
+
+  CompilationCacheKey& operator=(const CompilationCacheKey&) = default;
+
+  void Add(std::string_view name, std::string_view value);
+
+  void Add(std::string_view name, const fml::Mapping& value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the source as preprocessed for the given options.
+  ///
+  /// @return     Whether the source could be preprocessed. When it can't, the
+  ///             key must not be used; compiling the source reports why.
+  ///
+  [[nodiscard]] bool AddPreprocessedSource(
+      std::string_view name,
+      const std::shared_ptr<const fml::Mapping>& source,
+      const SourceOptions& options);
+
+  const std::string& GetData() const;
+
+  /// A digest of the key data, used to address the cache entry.
+  std::string GetDigest() const;
+
+ private:
+  std::string data_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A directory of compiler outputs addressed by the keys of the
+///             compilations that produced them.
+///
+///             Entries store their full key and are only returned when it
+///             matches, so digest collisions result in misses rather than
+///             wrong outputs. The cache is never pruned; delete the directory
+///             to reclaim its space.
+///
+///             The cache is safe to use from multiple threads and processes.
+///
+class CompilationCache {
+ public:
+  /// Named outputs of a compilation, such as the contents of its output files.
+  using Outputs = std::map<std::string, std::shared_ptr<const fml::Mapping>>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the cache in the given directory, creating the
+  ///             directory if necessary.
+  ///
+  /// @return     The cache, or nullptr if the directory couldn't be opened.
+  ///
+  static std::unique_ptr<CompilationCache> Open(const std::string& path);
+
+  explicit CompilationCache(fml::UniqueFD directory);
+
+  ~CompilationCache();
+
+  std::optional<Outputs> Get(const CompilationCacheKey& key) const;
+
+  bool Put(const CompilationCacheKey& key, const Outputs& outputs) const;
+
+ private:
+  const fml::UniqueFD directory_;
+
+  CompilationCache(const CompilationCache&) = delete;
+
+  CompilationCache& operator=(const CompilationCache&) = delete;
+};
+
+}  // namespace compiler
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_COMPILER_COMPILATION_CACHE_H_
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/compiler/compilation_cache.h"
+
+namespace impeller {
+namespace compiler {
+namespace testing {
+
+static std::shared_ptr<const fml::Mapping> MakeMapping(
+    const std::string& data) {
+  return std::make_shared<fml::DataMapping>(data);
+}
+
+static std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+static SourceOptions MakeGLSLFragmentOptions() {
+  SourceOptions options;
+  options.source_language = SourceLanguage::kGLSL;
+  options.target_platform = TargetPlatform::kRuntimeStageGLES;
+  options.entry_point_name = "main";
+  options.type = SourceType::kFragmentShader;
+  return options;
+}
+
+TEST(CompilationCacheTest, CanRetrieveCachedOutputs) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto cache = CompilationCache::Open(temp_dir.path() + "/cache");
+  ASSERT_NE(cache, nullptr);
+
+  CompilationCacheKey key;
+  key.Add("source", "void main() {}");
+  ASSERT_FALSE(cache->Get(key).has_value());
+
+  ASSERT_TRUE(cache->Put(key, {{"sl", MakeMapping("shader")},
+                               {"spirv", MakeMapping("")}}));
+
+  auto outputs = cache->Get(key);
+  ASSERT_TRUE(outputs.has_value());
+  ASSERT_EQ(outputs->size(), 2u);
+  EXPECT_EQ(ToString(*outputs->at("sl")), "shader");
+  EXPECT_EQ(outputs->at("spirv")->GetSize(), 0u);
+}
+
+TEST(CompilationCacheTest, DifferentKeysMiss) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto cache = CompilationCache::Open(temp_dir.path());
+  ASSERT_NE(cache, nullptr);
+
+  CompilationCacheKey key;
+  key.Add("source", "void main() {}");
+  ASSERT_TRUE(cache->Put(key, {{"sl", MakeMapping("shader")}}));
+
+  CompilationCacheKey other_key;
+  other_key.Add("source", "void main() { }");
+  EXPECT_NE(key.GetDigest(), other_key.GetDigest());
+  EXPECT_FALSE(cache->Get(other_key).has_value());
+
+  // Splitting the same bytes differently across fields makes a different key.
+  CompilationCacheKey split_key;
+  split_key.Add("sourcevoid", " main() {}");
+  EXPECT_NE(key.GetData(), split_key.GetData());
+}
+
+TEST(CompilationCacheTest, IgnoresCorruptEntries) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto cache = CompilationCache::Open(temp_dir.path());
+  ASSERT_NE(cache, nullptr);
+
+  CompilationCacheKey key;
+  key.Add("source", "void main() {}");
+  const std::string garbage = "IMPCCAC1 but truncated";
+  ASSERT_TRUE(fml::WriteAtomically(
+      temp_dir.fd(), key.GetDigest().c_str(),
+      fml::NonOwnedMapping(reinterpret_cast<const uint8_t*>(garbage.data()),
+                           garbage.size())));
+
+  EXPECT_FALSE(cache->Get(key).has_value());
+}
+
+TEST(CompilationCacheTest, PreprocessedSourceKeysFollowDefines) {
+  auto source = MakeMapping(
+      "#ifdef RED\n"
+      "const float kRed = 1.0;\n"
+      "#endif\n"
+      "void main() {}\n");
+  SourceOptions options = MakeGLSLFragmentOptions();
+
+  CompilationCacheKey key;
+  ASSERT_TRUE(key.AddPreprocessedSource("source", source, options));
+
+  options.defines.push_back("RED");
+  CompilationCacheKey red_key;
+  ASSERT_TRUE(red_key.AddPreprocessedSource("source", source, options));
+  EXPECT_NE(key.GetDigest(), red_key.GetDigest());
+}
+
+}  // namespace testing
+}  // namespace compiler
+}  // namespace impeller
@@ -275,22 +275,15 @@ uint32_t CalculateUBOSize(const spirv_cross::Compiler* compiler) {
   return result;
 }
 
-}  // namespace
-
-Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
-                   const SourceOptions& source_options,
-                   Reflector::Options reflector_options)
-    : options_(source_options) {
-  if (!source_mapping || source_mapping->GetMapping() == nullptr) {
-    COMPILER_ERROR(error_stream_)
-        << "Could not read shader source or shader source was empty.";
-    return;
-  }
-
-  if (source_options.target_platform == TargetPlatform::kUnknown) {
-    COMPILER_ERROR(error_stream_) << "Target platform not specified.";
-    return;
-  }
+/// Creates the options used to compile the source to SPIRV, or returns
+/// std::nullopt if the source language or target platform are invalid.
+static std::optional<SPIRVCompilerOptions> CreateSPIRVCompilerOptions(
+    const SourceOptions& source_options,
+    std::stringstream& error_stream) {
+  // Used by COMPILER_ERROR.
+  auto GetSourcePrefix = [&source_options]() {
+    return source_options.file_name + ": ";
+  };
 
   SPIRVCompilerOptions spirv_options;
 
@@ -298,7 +291,7 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
   // will be processed later by backend specific compilers.
   spirv_options.generate_debug_info = true;
 
-  switch (options_.source_language) {
+  switch (source_options.source_language) {
     case SourceLanguage::kGLSL:
       // Expects GLSL 4.60 (Core Profile).
       // https://www.khronos.org/registry/OpenGL/specs/gl/GLSLangSpec.4.60.pdf
@@ -314,8 +307,8 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
           shaderc_source_language::shaderc_source_language_hlsl;
       break;
     case SourceLanguage::kUnknown:
-      COMPILER_ERROR(error_stream_) << "Source language invalid.";
-      return;
+      COMPILER_ERROR(error_stream) << "Source language invalid.";
+      return std::nullopt;
   }
 
   switch (source_options.target_platform) {
@@ -386,8 +379,8 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
       spirv_options.macro_definitions.push_back("SKIA_GRAPHICS_BACKEND");
     } break;
     case TargetPlatform::kUnknown:
-      COMPILER_ERROR(error_stream_) << "Target platform invalid.";
-      return;
+      COMPILER_ERROR(error_stream) << "Target platform invalid.";
+      return std::nullopt;
   }
 
   // Implicit definition that indicates that this compilation is for the device
@@ -397,6 +390,33 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
     spirv_options.macro_definitions.push_back(define);
   }
 
+  return spirv_options;
+}
+
+}  // namespace
+
+Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
+                   const SourceOptions& source_options,
+                   Reflector::Options reflector_options)
+    : options_(source_options) {
+  if (!source_mapping || source_mapping->GetMapping() == nullptr) {
+    COMPILER_ERROR(error_stream_)
+        << "Could not read shader source or shader source was empty.";
+    return;
+  }
+
+  if (source_options.target_platform == TargetPlatform::kUnknown) {
+    COMPILER_ERROR(error_stream_) << "Target platform not specified.";
+    return;
+  }
+
+  std::optional<SPIRVCompilerOptions> maybe_spirv_options =
+      CreateSPIRVCompilerOptions(source_options, error_stream_);
+  if (!maybe_spirv_options.has_value()) {
+    return;
+  }
+  SPIRVCompilerOptions spirv_options = std::move(maybe_spirv_options.value());
+
   std::vector<std::string> included_file_names;
   spirv_options.includer = std::make_shared<Includer>(
       options_.working_directory, options_.include_dirs,
@@ -483,6 +503,24 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
 
 Compiler::~Compiler() = default;
 
+std::shared_ptr<fml::Mapping> Compiler::Preprocess(
+    const std::shared_ptr<const fml::Mapping>& source_mapping,
+    const SourceOptions& options,
+    std::stringstream& error_stream) {
+  std::optional<SPIRVCompilerOptions> spirv_options =
+      CreateSPIRVCompilerOptions(options, error_stream);
+  if (!spirv_options.has_value()) {
+    return nullptr;
+  }
+  spirv_options->includer =
+      std::make_shared<Includer>(options.working_directory,
+                                 options.include_dirs, [](auto) {});
+
+  SPIRVCompiler spv_compiler(options, source_mapping);
+  return spv_compiler.Preprocess(error_stream,
+                                 spirv_options->BuildShadercOptions());
+}
+
 std::shared_ptr<fml::Mapping> Compiler::GetSPIRVAssembly() const {
   return spirv_assembly_;
 }
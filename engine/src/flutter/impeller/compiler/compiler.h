@@ -29,6 +29,23 @@ class Compiler {
 
   ~Compiler();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs only the preprocessor on the source, with the same
+  ///             macro definitions and include directories as compiling it
+  ///             with the given options would.
+  ///
+  ///             Two sources with the same preprocessed source compile to the
+  ///             same result for the same options, which makes it suitable
+  ///             for keying a cache of compiler outputs.
+  ///
+  /// @return     The preprocessed source, or nullptr if preprocessing failed,
+  ///             in which case the errors are written to `error_stream`.
+  ///
+  static std::shared_ptr<fml::Mapping> Preprocess(
+      const std::shared_ptr<const fml::Mapping>& source_mapping,
+      const SourceOptions& options,
+      std::stringstream& error_stream);
+
   bool IsValid() const;
 
   std::shared_ptr<fml::Mapping> GetSPIRVAssembly() const;
@@ -2,13 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <filesystem>
+#include <optional>
 #include <system_error>
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
+#include "impeller/compiler/compilation_cache.h"
 #include "impeller/compiler/compiler.h"
 #include "impeller/compiler/runtime_stage_data.h"
 #include "impeller/compiler/shader_bundle.h"
@@ -32,61 +35,68 @@ static Reflector::Options CreateReflectorOptions(const SourceOptions& options,
   return reflector_options;
 }
 
-/// Run the shader compiler to geneate SkSL reflection data.
-/// If there is an error, prints error text and returns `nullptr`.
-static std::shared_ptr<RuntimeStageData::Shader> CompileSkSL(
-    std::shared_ptr<fml::Mapping> source_file_mapping,
+/// The platforms to compile the source for. In IPLR mode, these are all the
+/// runtime stages, with SkSL first if the stages bundle it. The default target
+/// platform is always included.
+static std::vector<TargetPlatform> GetPlatformsToCompile(
     const Switches& switches) {
-  auto options = switches.CreateSourceOptions(TargetPlatform::kSkSL);
-
-  Reflector::Options sksl_reflector_options =
-      CreateReflectorOptions(options, switches);
-  sksl_reflector_options.target_platform = TargetPlatform::kSkSL;
+  const TargetPlatform default_platform =
+      switches.SelectDefaultTargetPlatform();
+  std::vector<TargetPlatform> platforms;
+  if (switches.iplr) {
+    if (TargetPlatformBundlesSkSL(default_platform)) {
+      platforms.push_back(TargetPlatform::kSkSL);
+    }
+    for (const auto& platform : switches.PlatformsToCompile()) {
+      if (platform != TargetPlatform::kSkSL) {
+        platforms.push_back(platform);
+      }
+    }
+  }
+  if (std::find(platforms.begin(), platforms.end(), default_platform) ==
+      platforms.end()) {
+    platforms.push_back(default_platform);
+  }
+  return platforms;
+}
 
-  Compiler sksl_compiler =
-      Compiler(std::move(source_file_mapping), options, sksl_reflector_options);
-  if (!sksl_compiler.IsValid()) {
-    std::cerr << "Compilation to SkSL failed." << std::endl;
-    std::cerr << sksl_compiler.GetErrorMessages() << std::endl;
-    return nullptr;
+/// Compiles the source for all the platforms at once.
+/// If any compilation fails, prints error text and returns an empty vector.
+static std::vector<std::unique_ptr<Compiler>> CompileForPlatforms(
+    const std::shared_ptr<fml::Mapping>& source_file_mapping,
+    const Switches& switches,
+    const std::vector<TargetPlatform>& platforms) {
+  std::vector<std::unique_ptr<Compiler>> compilers(platforms.size());
+  ParallelFor(platforms.size(), [&](size_t index) {
+    SourceOptions options = switches.CreateSourceOptions(platforms[index]);
+    compilers[index] = std::make_unique<Compiler>(
+        source_file_mapping, options,
+        CreateReflectorOptions(options, switches));
+  });
+
+  // Report errors in a stable order, regardless of which compilation finished
+  // first.
+  for (size_t i = 0; i < platforms.size(); i++) {
+    if (!compilers[i]->IsValid()) {
+      std::cerr << (platforms[i] == TargetPlatform::kSkSL
+                        ? "Compilation to SkSL failed."
+                        : "Compilation failed.")
+                << std::endl;
+      std::cerr << compilers[i]->GetErrorMessages() << std::endl;
+      return {};
+    }
   }
-  return sksl_compiler.GetReflector()->GetRuntimeStageShaderData();
+  return compilers;
 }
 
 static bool OutputIPLR(
     const Switches& switches,
-    const std::shared_ptr<fml::Mapping>& source_file_mapping) {
+    const std::vector<std::unique_ptr<Compiler>>& compilers) {
   FML_DCHECK(switches.iplr);
 
   RuntimeStageData stages;
-  std::shared_ptr<RuntimeStageData::Shader> sksl_shader;
-  if (TargetPlatformBundlesSkSL(switches.SelectDefaultTargetPlatform())) {
-    sksl_shader = CompileSkSL(source_file_mapping, switches);
-    if (!sksl_shader) {
-      return false;
-    }
-    stages.AddShader(sksl_shader);
-  }
-
-  for (const auto& platform : switches.PlatformsToCompile()) {
-    if (platform == TargetPlatform::kSkSL) {
-      // Already handled above.
-      continue;
-    }
-    SourceOptions options = switches.CreateSourceOptions(platform);
-
-    // Invoke the compiler and generate reflection data for a single shader.
-
-    Reflector::Options reflector_options =
-        CreateReflectorOptions(options, switches);
-    Compiler compiler(source_file_mapping, options, reflector_options);
-    if (!compiler.IsValid()) {
-      std::cerr << "Compilation failed." << std::endl;
-      std::cerr << compiler.GetErrorMessages() << std::endl;
-      return false;
-    }
-
-    auto reflector = compiler.GetReflector();
+  for (const auto& compiler : compilers) {
+    auto reflector = compiler->GetReflector();
     if (reflector == nullptr) {
       std::cerr << "Could not create reflector." << std::endl;
       return false;
@@ -231,6 +241,103 @@ static bool OutputDepfile(const Compiler& compiler, const Switches& switches) {
   return true;
 }
 
+/// The files written by a compilation with the given switches, which are the
+/// outputs stored in the compilation cache.
+static std::vector<std::string> GetOutputFileNames(const Switches& switches) {
+  std::vector<std::string> file_names = {switches.sl_file_name,
+                                         switches.spirv_file_name};
+  if (TargetPlatformNeedsReflection(switches.SelectDefaultTargetPlatform())) {
+    for (const std::string& file_name :
+         {switches.reflection_json_name, switches.reflection_header_name,
+          switches.reflection_cc_name}) {
+      if (!file_name.empty()) {
+        file_names.push_back(file_name);
+      }
+    }
+  }
+  if (!switches.depfile_path.empty()) {
+    file_names.push_back(switches.depfile_path);
+  }
+  return file_names;
+}
+
+static std::filesystem::path GetOutputPath(const std::string& file_name) {
+  return std::filesystem::absolute(std::filesystem::current_path() /
+                                   file_name);
+}
+
+static std::optional<CompilationCacheKey> CreateCacheKey(
+    const fml::CommandLine& command_line,
+    const Switches& switches,
+    const std::shared_ptr<fml::Mapping>& source_file_mapping,
+    const std::vector<TargetPlatform>& platforms) {
+  CompilationCacheKey key;
+  // The command line holds every option that affects the outputs, including
+  // output file names, which appear in depfiles and reflection data. Relative
+  // names are resolved against the working directory.
+  key.Add("cwd", Utf8FromPath(std::filesystem::current_path()));
+  for (const auto& option : command_line.options()) {
+    if (option.name != "cache-dir") {
+      key.Add(option.name, option.value);
+    }
+  }
+  for (const auto& arg : command_line.positional_args()) {
+    key.Add("arg", arg);
+  }
+  for (TargetPlatform platform : platforms) {
+    if (!key.AddPreprocessedSource(TargetPlatformToString(platform),
+                                   source_file_mapping,
+                                   switches.CreateSourceOptions(platform))) {
+      return std::nullopt;
+    }
+  }
+  return key;
+}
+
+/// Writes the outputs of a previous compilation with the same key.
+/// Returns false without writing anything if an output is missing.
+static bool OutputCachedFiles(const Switches& switches,
+                              const CompilationCache::Outputs& outputs) {
+  std::vector<std::string> file_names = GetOutputFileNames(switches);
+  for (const std::string& file_name : file_names) {
+    if (outputs.find(file_name) == outputs.end()) {
+      return false;
+    }
+  }
+  for (const std::string& file_name : file_names) {
+    if (!fml::WriteAtomically(*switches.working_directory,
+                              Utf8FromPath(GetOutputPath(file_name)).c_str(),
+                              *outputs.at(file_name))) {
+      std::cerr << "Could not write file to " << file_name << std::endl;
+      return false;
+    }
+  }
+  if (switches.iplr && !SetPermissiveAccess(switches.sl_file_name)) {
+    return false;
+  }
+  return true;
+}
+
+/// Stores the files written by a successful compilation in the cache.
+/// Failing to do so doesn't fail the compilation.
+static void CacheOutputFiles(const CompilationCache& cache,
+                             const CompilationCacheKey& key,
+                             const Switches& switches) {
+  CompilationCache::Outputs outputs;
+  for (const std::string& file_name : GetOutputFileNames(switches)) {
+    std::shared_ptr<fml::FileMapping> mapping =
+        fml::FileMapping::CreateReadOnly(
+            Utf8FromPath(GetOutputPath(file_name)));
+    if (!mapping) {
+      return;
+    }
+    outputs[file_name] = std::move(mapping);
+  }
+  if (!cache.Put(key, outputs)) {
+    std::cerr << "Warning: Could not cache the compiler outputs." << std::endl;
+  }
+}
+
 bool Main(const fml::CommandLine& command_line) {
   fml::InstallCrashHandler();
   if (command_line.HasOption("help")) {
@@ -258,27 +365,46 @@ bool Main(const fml::CommandLine& command_line) {
     return false;
   }
 
-  if (switches.iplr && !OutputIPLR(switches, source_file_mapping)) {
-    return false;
+  std::vector<TargetPlatform> platforms = GetPlatformsToCompile(switches);
+
+  std::unique_ptr<CompilationCache> cache;
+  std::optional<CompilationCacheKey> cache_key;
+  if (!switches.cache_directory.empty()) {
+    cache = CompilationCache::Open(switches.cache_directory);
+    if (!cache) {
+      std::cerr << "Warning: Could not open the cache directory "
+                << switches.cache_directory << "." << std::endl;
+    } else {
+      cache_key = CreateCacheKey(command_line, switches, source_file_mapping,
+                                 platforms);
+    }
+  }
+  if (cache_key.has_value()) {
+    std::optional<CompilationCache::Outputs> outputs =
+        cache->Get(cache_key.value());
+    if (outputs.has_value() && OutputCachedFiles(switches, outputs.value())) {
+      return true;
+    }
   }
 
-  // Create at least one compiler to output the SL file, reflection data, and a
-  // depfile.
-
-  SourceOptions options = switches.CreateSourceOptions();
-
-  // Invoke the compiler and generate reflection data for a single shader.
-
-  Reflector::Options reflector_options =
-      CreateReflectorOptions(options, switches);
+  std::vector<std::unique_ptr<Compiler>> compilers =
+      CompileForPlatforms(source_file_mapping, switches, platforms);
+  if (compilers.empty()) {
+    return false;
+  }
 
-  Compiler compiler(source_file_mapping, options, reflector_options);
-  if (!compiler.IsValid()) {
-    std::cerr << "Compilation failed." << std::endl;
-    std::cerr << compiler.GetErrorMessages() << std::endl;
+  if (switches.iplr && !OutputIPLR(switches, compilers)) {
     return false;
   }
 
+  // Output the SL file, reflection data, and a depfile using the compiler for
+  // the default target platform.
+
+  SourceOptions options = switches.CreateSourceOptions();
+  const Compiler& compiler = *compilers[std::distance(
+      platforms.begin(),
+      std::find(platforms.begin(), platforms.end(), options.target_platform))];
+
   auto spriv_file_name = std::filesystem::absolute(
       std::filesystem::current_path() / switches.spirv_file_name);
   if (!fml::WriteAtomically(*switches.working_directory,
@@ -301,6 +427,10 @@ bool Main(const fml::CommandLine& command_line) {
     return false;
   }
 
+  if (cache_key.has_value()) {
+    CacheOutputFiles(*cache, cache_key.value(), switches);
+  }
+
   return true;
 }
 
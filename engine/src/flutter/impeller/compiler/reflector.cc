@@ -6,7 +6,6 @@
 
 #include "impeller/compiler/reflector.h"
 
-#include <atomic>
 #include <format>
 #include <optional>
 #include <set>
@@ -1335,9 +1334,8 @@ std::string Reflector::GetMemberNameAtIndex(
       name.has_value()) {
     return name.value();
   }
-  static std::atomic_size_t sUnnamedMembersID;
   std::stringstream stream;
-  stream << "unnamed_" << sUnnamedMembersID++ << suffix;
+  stream << "unnamed_" << unnamed_member_count_++ << suffix;
   return stream.str();
 }
 
@@ -198,6 +198,10 @@ class Reflector {
   std::shared_ptr<fml::Mapping> reflection_cc_;
   std::shared_ptr<RuntimeStageData::Shader> runtime_stage_shader_;
   std::shared_ptr<ShaderBundleData> shader_bundle_data_;
+  // Numbers the names given to unnamed struct members. This is per reflector
+  // so that the names don't depend on what else the process compiles, or in
+  // which order.
+  mutable size_t unnamed_member_count_ = 0u;
   bool is_valid_ = false;
 
   std::optional<nlohmann::json> GenerateTemplateArguments() const;
@@ -3,6 +3,13 @@
 // found in the LICENSE file.
 
 #include "impeller/compiler/shader_bundle.h"
+
+#include <array>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "impeller/compiler/compilation_cache.h"
 #include "impeller/compiler/compiler.h"
 #include "impeller/compiler/reflector.h"
 #include "impeller/compiler/source_options.h"
@@ -81,29 +88,67 @@ std::optional<ShaderBundleConfig> ParseShaderBundleConfig(
   return bundle;
 }
 
+/// The backends that every bundled shader is compiled for.
+static constexpr std::array<TargetPlatform, 5> kBundleBackends = {
+    TargetPlatform::kMetalIOS,       //
+    TargetPlatform::kMetalDesktop,   //
+    TargetPlatform::kOpenGLES,       //
+    TargetPlatform::kOpenGLDesktop,  //
+    TargetPlatform::kVulkan,         //
+};
+
+static std::unique_ptr<fb::shaderbundle::BackendShaderT>& GetBackendShaderFB(
+    fb::shaderbundle::ShaderT& shader,
+    TargetPlatform target_platform) {
+  switch (target_platform) {
+    case TargetPlatform::kMetalIOS:
+      return shader.metal_ios;
+    case TargetPlatform::kMetalDesktop:
+      return shader.metal_desktop;
+    case TargetPlatform::kOpenGLES:
+      return shader.opengl_es;
+    case TargetPlatform::kOpenGLDesktop:
+      return shader.opengl_desktop;
+    case TargetPlatform::kVulkan:
+    default:
+      return shader.vulkan;
+  }
+}
+
+static SourceOptions CreateBackendSourceOptions(
+    SourceOptions options,
+    TargetPlatform target_platform,
+    const std::string& shader_name,
+    const ShaderConfig& shader_config) {
+  /// Override options.
+  options.target_platform = target_platform;
+  options.file_name = shader_name;  // This is just used for error messages.
+  options.type = shader_config.type;
+  options.source_language = shader_config.language;
+  options.entry_point_name = EntryPointFunctionNameFromSourceName(
+      shader_config.source_file_name, options.type, options.source_language,
+      shader_config.entry_point);
+  return options;
+}
+
 static std::unique_ptr<fb::shaderbundle::BackendShaderT>
 GenerateShaderBackendFB(TargetPlatform target_platform,
-                        SourceOptions& options,
+                        const SourceOptions& base_options,
                         const std::string& shader_name,
-                        const ShaderConfig& shader_config) {
+                        const ShaderConfig& shader_config,
+                        std::ostream& error_stream) {
   auto result = std::make_unique<fb::shaderbundle::BackendShaderT>();
 
   std::shared_ptr<fml::FileMapping> source_file_mapping =
       fml::FileMapping::CreateReadOnly(shader_config.source_file_name);
   if (!source_file_mapping) {
-    std::cerr << "Could not open file for bundled shader \"" << shader_name
-              << "\"." << std::endl;
+    error_stream << "Could not open file for bundled shader \"" << shader_name
+                 << "\"." << std::endl;
     return nullptr;
   }
 
-  /// Override options.
-  options.target_platform = target_platform;
-  options.file_name = shader_name;  // This is just used for error messages.
-  options.type = shader_config.type;
-  options.source_language = shader_config.language;
-  options.entry_point_name = EntryPointFunctionNameFromSourceName(
-      shader_config.source_file_name, options.type, options.source_language,
-      shader_config.entry_point);
+  SourceOptions options = CreateBackendSourceOptions(
+      base_options, target_platform, shader_name, shader_config);
 
   Reflector::Options reflector_options;
   reflector_options.target_platform = options.target_platform;
@@ -112,73 +157,115 @@ GenerateShaderBackendFB(TargetPlatform target_platform,
 
   Compiler compiler(source_file_mapping, options, reflector_options);
   if (!compiler.IsValid()) {
-    std::cerr << "Compilation failed for bundled shader \"" << shader_name
-              << "\"." << std::endl;
-    std::cerr << compiler.GetErrorMessages() << std::endl;
+    error_stream << "Compilation failed for bundled shader \"" << shader_name
+                 << "\"." << std::endl;
+    error_stream << compiler.GetErrorMessages() << std::endl;
     return nullptr;
   }
 
   auto reflector = compiler.GetReflector();
   if (reflector == nullptr) {
-    std::cerr << "Could not create reflector for bundled shader \""
-              << shader_name << "\"." << std::endl;
+    error_stream << "Could not create reflector for bundled shader \""
+                 << shader_name << "\"." << std::endl;
     return nullptr;
   }
 
   auto bundle_data = reflector->GetShaderBundleData();
   if (!bundle_data) {
-    std::cerr << "Bundled shader information was nil for \"" << shader_name
-              << "\"." << std::endl;
+    error_stream << "Bundled shader information was nil for \"" << shader_name
+                 << "\"." << std::endl;
     return nullptr;
   }
 
   result = bundle_data->CreateFlatbuffer();
   if (!result) {
-    std::cerr << "Failed to create flatbuffer for bundled shader \""
-              << shader_name << "\"." << std::endl;
+    error_stream << "Failed to create flatbuffer for bundled shader \""
+                 << shader_name << "\"." << std::endl;
     return nullptr;
   }
 
   return result;
 }
 
-static std::unique_ptr<fb::shaderbundle::ShaderT> GenerateShaderFB(
-    SourceOptions options,
+/// Creates the key of a bundled shader in the compilation cache, or
+/// std::nullopt if its source can't be preprocessed.
+static std::optional<CompilationCacheKey> CreateShaderCacheKey(
+    const SourceOptions& options,
     const std::string& shader_name,
     const ShaderConfig& shader_config) {
-  auto result = std::make_unique<fb::shaderbundle::ShaderT>();
-  result->name = shader_name;
-  result->metal_ios = GenerateShaderBackendFB(
-      TargetPlatform::kMetalIOS, options, shader_name, shader_config);
-  if (!result->metal_ios) {
-    return nullptr;
+  std::shared_ptr<fml::FileMapping> source_file_mapping =
+      fml::FileMapping::CreateReadOnly(shader_config.source_file_name);
+  if (!source_file_mapping) {
+    return std::nullopt;
   }
-  result->metal_desktop = GenerateShaderBackendFB(
-      TargetPlatform::kMetalDesktop, options, shader_name, shader_config);
-  if (!result->metal_desktop) {
-    return nullptr;
+
+  CompilationCacheKey key;
+  key.Add("name", shader_name);
+  key.Add("file", shader_config.source_file_name);
+  key.Add("entry_point", shader_config.entry_point);
+  key.Add("gles_language_version",
+          std::to_string(options.gles_language_version));
+  key.Add("metal_version", options.metal_version);
+  key.Add("use_half_textures", options.use_half_textures ? "1" : "0");
+  key.Add("require_framebuffer_fetch",
+          options.require_framebuffer_fetch ? "1" : "0");
+  // The type, language, defines, and include directories all show in the
+  // preprocessed sources.
+  for (TargetPlatform backend : kBundleBackends) {
+    if (!key.AddPreprocessedSource(
+            TargetPlatformToString(backend), source_file_mapping,
+            CreateBackendSourceOptions(options, backend, shader_name,
+                                       shader_config))) {
+      return std::nullopt;
+    }
   }
-  result->opengl_es = GenerateShaderBackendFB(
-      TargetPlatform::kOpenGLES, options, shader_name, shader_config);
-  if (!result->opengl_es) {
+  return key;
+}
+
+static std::unique_ptr<fb::shaderbundle::ShaderT> GetCachedShaderFB(
+    const CompilationCache& cache,
+    const CompilationCacheKey& key) {
+  std::optional<CompilationCache::Outputs> outputs = cache.Get(key);
+  if (!outputs.has_value() || outputs->count("shader") == 0) {
     return nullptr;
   }
-  result->opengl_desktop = GenerateShaderBackendFB(
-      TargetPlatform::kOpenGLDesktop, options, shader_name, shader_config);
-  if (!result->opengl_desktop) {
+  const fml::Mapping& data = *outputs->at("shader");
+  flatbuffers::Verifier verifier(data.GetMapping(), data.GetSize());
+  if (!fb::shaderbundle::VerifyShaderBundleBuffer(verifier)) {
     return nullptr;
   }
-  result->vulkan = GenerateShaderBackendFB(TargetPlatform::kVulkan, options,
-                                           shader_name, shader_config);
-  if (!result->vulkan) {
+  std::unique_ptr<fb::shaderbundle::ShaderBundleT> bundle =
+      fb::shaderbundle::UnPackShaderBundle(data.GetMapping());
+  if (!bundle || bundle->shaders.size() != 1u) {
     return nullptr;
   }
-  return result;
+  return std::move(bundle->shaders.front());
+}
+
+static void CacheShaderFB(const CompilationCache& cache,
+                          const CompilationCacheKey& key,
+                          std::unique_ptr<fb::shaderbundle::ShaderT>& shader) {
+  // Store the shader as a bundle of its own, and take it back afterwards.
+  fb::shaderbundle::ShaderBundleT bundle;
+  bundle.shaders.push_back(std::move(shader));
+  auto builder = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  builder->Finish(fb::shaderbundle::ShaderBundle::Pack(*builder.get(), &bundle),
+                  fb::shaderbundle::ShaderBundleIdentifier());
+  shader = std::move(bundle.shaders.front());
+
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      builder->GetBufferPointer(), builder->GetSize(),
+      [builder](auto, auto) {});
+  if (!cache.Put(key, {{"shader", mapping}})) {
+    std::cerr << "Warning: Could not cache bundled shader \"" << shader->name
+              << "\"." << std::endl;
+  }
 }
 
 std::optional<fb::shaderbundle::ShaderBundleT> GenerateShaderBundleFlatbuffer(
     const std::string& bundle_config_json,
-    const SourceOptions& options) {
+    const SourceOptions& options,
+    const CompilationCache* cache) {
   // --------------------------------------------------------------------------
   /// 1. Parse the bundle configuration.
   ///
@@ -188,22 +275,74 @@ std::optional<fb::shaderbundle::ShaderBundleT> GenerateShaderBundleFlatbuffer(
   if (!bundle_config) {
     return std::nullopt;
   }
+  const std::vector<std::pair<std::string, ShaderConfig>> entries(
+      bundle_config->begin(), bundle_config->end());
 
   // --------------------------------------------------------------------------
-  /// 2. Build the deserialized shader bundle.
+  /// 2. Reuse the shaders whose sources and options haven't changed since
+  ///    they were cached.
   ///
 
-  fb::shaderbundle::ShaderBundleT shader_bundle;
+  std::vector<std::unique_ptr<fb::shaderbundle::ShaderT>> shaders(
+      entries.size());
+  std::vector<std::optional<CompilationCacheKey>> cache_keys(entries.size());
+  if (cache) {
+    ParallelFor(entries.size(), [&](size_t index) {
+      const auto& [shader_name, shader_config] = entries[index];
+      cache_keys[index] =
+          CreateShaderCacheKey(options, shader_name, shader_config);
+      if (cache_keys[index].has_value()) {
+        shaders[index] = GetCachedShaderFB(*cache, cache_keys[index].value());
+      }
+    });
+  }
 
-  for (const auto& [shader_name, shader_config] : bundle_config.value()) {
-    std::unique_ptr<fb::shaderbundle::ShaderT> shader =
-        GenerateShaderFB(options, shader_name, shader_config);
-    if (!shader) {
+  // --------------------------------------------------------------------------
+  /// 3. Compile every backend of the remaining shaders at once.
+  ///
+
+  std::vector<size_t> uncached_entries;
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (!shaders[i]) {
+      shaders[i] = std::make_unique<fb::shaderbundle::ShaderT>();
+      shaders[i]->name = entries[i].first;
+      uncached_entries.push_back(i);
+    }
+  }
+
+  const size_t job_count = uncached_entries.size() * kBundleBackends.size();
+  std::vector<std::stringstream> job_errors(job_count);
+  ParallelFor(job_count, [&](size_t job) {
+    const size_t index = uncached_entries[job / kBundleBackends.size()];
+    const TargetPlatform backend = kBundleBackends[job % kBundleBackends.size()];
+    const auto& [shader_name, shader_config] = entries[index];
+    GetBackendShaderFB(*shaders[index], backend) = GenerateShaderBackendFB(
+        backend, options, shader_name, shader_config, job_errors[job]);
+  });
+
+  // --------------------------------------------------------------------------
+  /// 4. Build the deserialized shader bundle.
+  ///
+
+  for (size_t job = 0; job < job_count; job++) {
+    const size_t index = uncached_entries[job / kBundleBackends.size()];
+    const TargetPlatform backend = kBundleBackends[job % kBundleBackends.size()];
+    if (!GetBackendShaderFB(*shaders[index], backend)) {
+      std::cerr << job_errors[job].str();
       return std::nullopt;
     }
-    shader_bundle.shaders.push_back(std::move(shader));
   }
 
+  if (cache) {
+    for (size_t index : uncached_entries) {
+      if (cache_keys[index].has_value()) {
+        CacheShaderFB(*cache, cache_keys[index].value(), shaders[index]);
+      }
+    }
+  }
+
+  fb::shaderbundle::ShaderBundleT shader_bundle;
+  shader_bundle.shaders = std::move(shaders);
   return shader_bundle;
 }
 
@@ -212,8 +351,17 @@ bool GenerateShaderBundle(Switches& switches) {
   /// 1. Parse the shader bundle and generate the flatbuffer result.
   ///
 
+  std::unique_ptr<CompilationCache> cache;
+  if (!switches.cache_directory.empty()) {
+    cache = CompilationCache::Open(switches.cache_directory);
+    if (!cache) {
+      std::cerr << "Warning: Could not open the cache directory "
+                << switches.cache_directory << "." << std::endl;
+    }
+  }
+
   auto shader_bundle = GenerateShaderBundleFlatbuffer(
-      switches.shader_bundle, switches.CreateSourceOptions());
+      switches.shader_bundle, switches.CreateSourceOptions(), cache.get());
   if (!shader_bundle.has_value()) {
     // Specific error messages are already handled by
     // GenerateShaderBundleFlatbuffer.
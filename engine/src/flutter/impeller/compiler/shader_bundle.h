@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_COMPILER_SHADER_BUNDLE_H_
 #define FLUTTER_IMPELLER_COMPILER_SHADER_BUNDLE_H_
 
+#include "impeller/compiler/compilation_cache.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/switches.h"
 #include "impeller/shader_bundle/shader_bundle_flatbuffers.h"
@@ -23,11 +24,16 @@ std::optional<ShaderBundleConfig> ParseShaderBundleConfig(
 /// @brief  Parses the JSON shader bundle configuration and invokes the
 ///         compiler multiple times to produce a shader bundle flatbuffer.
 ///
+///         The shaders are compiled concurrently. Shaders found in the
+///         `cache`, if one is given, aren't compiled again, and the others
+///         are added to it.
+///
 /// @note   Exposed only for testing purposes. Use `GenerateShaderBundle`
 ///         directly.
 std::optional<fb::shaderbundle::ShaderBundleT> GenerateShaderBundleFlatbuffer(
     const std::string& bundle_config_json,
-    const SourceOptions& options);
+    const SourceOptions& options,
+    const CompilationCache* cache = nullptr);
 
 /// @brief  Parses the JSON shader bundle configuration and invokes the
 ///         compiler multiple times to produce a shader bundle flatbuffer, which
@@ -65,6 +65,10 @@ class SPIRVCompiler {
       std::stringstream& error_stream,
       const shaderc::CompileOptions& spirv_options) const;
 
+  std::shared_ptr<fml::Mapping> Preprocess(
+      std::stringstream& error_stream,
+      const shaderc::CompileOptions& spirv_options) const;
+
  private:
   SourceOptions options_;
   const std::shared_ptr<const fml::Mapping> sources_;
@@ -111,6 +111,10 @@ void Switches::PrintHelp(std::ostream& stream) {
             "targeting metal)"
          << std::endl;
   stream << optional_prefix << "--require-framebuffer-fetch" << std::endl;
+  stream << optional_prefix
+         << "--cache-dir=<cache_directory> (reuses the outputs of previous "
+            "compilations of the same preprocessed sources and options)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -187,6 +191,7 @@ Switches::Switches(const fml::CommandLine& command_line)
       use_half_textures(command_line.HasOption("use-half-textures")),
       require_framebuffer_fetch(
           command_line.HasOption("require-framebuffer-fetch")),
+      cache_directory(command_line.GetOptionValueWithDefault("cache-dir", "")),
       target_platform_(TargetPlatformFromCommandLine(command_line)),
       runtime_stages_(RuntimeStagesFromCommandLine(command_line)) {
   auto language = ToLowerCase(
@@ -43,6 +43,9 @@ class Switches {
   std::string entry_point = "";
   bool use_half_textures = false;
   bool require_framebuffer_fetch = false;
+  /// A directory in which to cache compiler outputs, so that compiling
+  /// unchanged shaders again is skipped. Caching is off when empty.
+  std::string cache_directory = "";
 
   Switches();
 
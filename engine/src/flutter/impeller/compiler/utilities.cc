@@ -5,10 +5,13 @@
 #include "impeller/compiler/utilities.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <filesystem>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace impeller {
 namespace compiler {
@@ -96,5 +99,33 @@ bool StringStartsWith(const std::string& target, const std::string& prefix) {
   return true;
 }
 
+void ParallelFor(size_t count, const std::function<void(size_t)>& task) {
+  const size_t thread_count = std::min<size_t>(
+      count, std::max(1u, std::thread::hardware_concurrency()));
+  if (thread_count <= 1u) {
+    for (size_t i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  std::atomic_size_t next_index = 0u;
+  auto run_tasks = [&]() {
+    for (size_t i = next_index++; i < count; i = next_index++) {
+      task(i);
+    }
+  };
+  // The calling thread is one of the workers.
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1u);
+  for (size_t i = 1u; i < thread_count; i++) {
+    threads.emplace_back(run_tasks);
+  }
+  run_tasks();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
 }  // namespace compiler
 }  // namespace impeller
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_IMPELLER_COMPILER_UTILITIES_H_
 #define FLUTTER_IMPELLER_COMPILER_UTILITIES_H_
 
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <string_view>
 
@@ -35,6 +37,14 @@ std::string ConvertToEntrypointName(std::string_view string);
 
 bool StringStartsWith(const std::string& target, const std::string& prefix);
 
+/// @brief  Invokes `task` once with each index in [0, count), spread over as
+///         many threads as the machine has cores, and returns when all
+///         invocations are done.
+///
+///         The invocations run concurrently, so `task` must only touch state
+///         that belongs to its index.
+void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
 }  // namespace compiler
 }  // namespace impeller
 
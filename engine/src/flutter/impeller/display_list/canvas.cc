@@ -45,6 +45,7 @@
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/rect_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/triangle_strip_geometry.h"
 #include "impeller/entity/save_layer_utils.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/constants.h"
@@ -830,6 +831,7 @@ void Canvas::ClipGeometry(const Geometry& geometry,
   if (IsSkipping()) {
     return;
   }
+  FlushSolidColorBatch();
 
   // Ideally the clip depth would be greater than the current rendering
   // depth because any rendering calls that follow this clip operation will
@@ -1245,6 +1247,7 @@ void Canvas::SaveLayer(const Paint& paint,
                        bool can_distribute_opacity,
                        std::optional<int64_t> backdrop_id) {
   TRACE_EVENT0("flutter", "Canvas::saveLayer");
+  FlushSolidColorBatch();
   if (IsSkipping()) {
     return SkipUntilMatchingRestore(total_content_depth);
   }
@@ -1480,6 +1483,7 @@ bool Canvas::Restore() {
   if (transform_stack_.size() == 1) {
     return false;
   }
+  FlushSolidColorBatch();
 
   // This check is important to make sure we didn't exceed the depth
   // that the clips were rendered at while rendering any of the
@@ -1717,8 +1721,12 @@ void Canvas::AddRenderEntityWithFiltersToCurrentPass(Entity& entity,
   if (!paint.color_filter && !paint.invert_colors && !paint.image_filter &&
       !paint.mask_blur_descriptor.has_value()) {
     contents->SetGeometry(geometry);
+    const SolidColorContents* solid_color =
+        contents->IsSolidColor()
+            ? static_cast<const SolidColorContents*>(contents.get())
+            : nullptr;
     entity.SetContents(std::move(contents));
-    AddRenderEntityToCurrentPass(entity, reuse_depth);
+    AddRenderEntityToCurrentPass(entity, reuse_depth, solid_color);
     return;
   }
 
@@ -1787,7 +1795,10 @@ void Canvas::AddRenderEntityWithFiltersToCurrentPass(Entity& entity,
   AddRenderEntityToCurrentPass(entity, reuse_depth);
 }
 
-void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
+void Canvas::AddRenderEntityToCurrentPass(
+    Entity& entity,
+    bool reuse_depth,
+    const SolidColorContents* solid_color) {
   if (IsSkipping()) {
     return;
   }
@@ -1800,6 +1811,10 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
       entity.GetContents()->IsOpaque(entity.GetTransform())) {
     entity.SetBlendMode(BlendMode::kSrc);
   }
+  FML_DCHECK(!solid_color || solid_color == entity.GetContents().get());
+  // Advanced blends replace the contents of the entity below.
+  bool can_batch = solid_color_batching_enabled_ && solid_color != nullptr &&
+                   entity.GetBlendMode() <= Entity::kLastPipelineBlendMode;
 
   // If the entity covers the current render target and is a solid color, then
   // conditionally update the backdrop color to its solid color value blended
@@ -1882,9 +1897,97 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
     return;
   }
 
+  if (can_batch && AppendToSolidColorBatch(entity, *solid_color)) {
+    return;
+  }
+  FlushSolidColorBatch();
   entity.Render(renderer_, *result);
 }
 
+bool Canvas::AppendToSolidColorBatch(const Entity& entity,
+                                     const SolidColorContents& contents) {
+  const Geometry* geometry = contents.GetGeometry();
+  Color color = contents.GetColor();
+  if (geometry == nullptr || entity.GetTransform().HasPerspective2D()) {
+    return false;
+  }
+
+  SolidColorBatch& batch = solid_color_batch_;
+  if (batch.draw_count > 0 &&
+      (batch.transform != entity.GetTransform() ||
+       batch.blend_mode != entity.GetBlendMode() || batch.color != color)) {
+    FlushSolidColorBatch();
+  }
+
+  // Strips are joined by repeating the last vertex of the previous strip and
+  // the first vertex of the next strip, which forms degenerate triangles.
+  std::vector<Point>& vertices = batch.vertices;
+  size_t offset = vertices.size();
+  if (offset > 0) {
+    vertices.push_back(vertices.back());
+    vertices.emplace_back();
+  }
+  if (!geometry->AppendTriangleStrip(entity.GetTransform(),
+                                     renderer_.GetTessellator(), vertices)) {
+    vertices.resize(offset);
+    return false;
+  }
+  if (offset > 0) {
+    if (vertices.size() == offset + 2) {
+      vertices.resize(offset);
+    } else {
+      vertices[offset + 1] = vertices[offset + 2];
+    }
+  }
+
+  std::optional<Rect> coverage = geometry->GetCoverage(Matrix());
+  if (batch.draw_count == 0) {
+    batch.transform = entity.GetTransform();
+    batch.blend_mode = entity.GetBlendMode();
+    batch.color = color;
+    batch.coverage = coverage.value_or(Rect());
+  } else if (coverage.has_value()) {
+    batch.coverage = batch.coverage.Union(coverage.value());
+  }
+  batch.clip_depth = entity.GetClipDepth();
+  batch.draw_count++;
+  return true;
+}
+
+void Canvas::FlushSolidColorBatch() {
+  SolidColorBatch& batch = solid_color_batch_;
+  if (batch.draw_count == 0) {
+    return;
+  }
+
+  if (!batch.vertices.empty()) {
+    TriangleStripGeometry geometry(batch.vertices, batch.coverage);
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetColor(batch.color);
+    contents->SetGeometry(&geometry);
+
+    // All draws of the batch are rendered at the depth of the last draw.
+    // This is safe because clips end the batch, so no clip lies between the
+    // depths of the draws.
+    Entity entity;
+    entity.SetTransform(batch.transform);
+    entity.SetBlendMode(batch.blend_mode);
+    entity.SetClipDepth(batch.clip_depth);
+    entity.SetContents(std::move(contents));
+    entity.Render(renderer_, GetCurrentRenderPass());
+  }
+
+  batch.vertices.clear();
+  batch.draw_count = 0u;
+}
+
+void Canvas::SetSolidColorBatchingEnabled(bool enabled) {
+  if (!enabled) {
+    FlushSolidColorBatch();
+  }
+  solid_color_batching_enabled_ = enabled;
+}
+
 RenderPass& Canvas::GetCurrentRenderPass() const {
   return *render_passes_.back().GetInlinePassContext()->GetRenderPass();
 }
@@ -1900,6 +2003,7 @@ std::shared_ptr<Texture> Canvas::FlipBackdrop(Point global_pass_position,
                                               bool should_remove_texture,
                                               bool should_use_onscreen,
                                               bool post_depth_increment) {
+  FlushSolidColorBatch();
   LazyRenderingConfig rendering_config = std::move(render_passes_.back());
   render_passes_.pop_back();
 
@@ -2090,6 +2194,7 @@ bool Canvas::EnsureFinalMipmapGeneration() const {
 
 void Canvas::EndReplay() {
   FML_DCHECK(render_passes_.size() == 1u);
+  FlushSolidColorBatch();
   render_passes_.back().GetInlinePassContext()->GetRenderPass();
   render_passes_.back().GetInlinePassContext()->EndPass(
       /*is_onscreen=*/!requires_readback_ && is_onscreen_);
@@ -18,6 +18,7 @@
 #include "impeller/display_list/paint.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/solid_rrect_like_blur_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/entity.h"
@@ -282,6 +283,12 @@ class Canvas {
   /// are generated.
   bool EnsureFinalMipmapGeneration() const;
 
+  // Whether consecutive solid color draws are merged into a single draw,
+  // which is the default.
+  //
+  // Visible for testing.
+  void SetSolidColorBatchingEnabled(bool enabled);
+
  private:
   class RRectLikeBlurShape {
    public:
@@ -344,6 +351,24 @@ class Canvas {
 
   uint64_t current_depth_ = 0u;
 
+  /// Consecutive solid color draws with the same transform, color and blend
+  /// mode, whose vertices are merged into a single draw call.
+  ///
+  /// The batch is rendered by |FlushSolidColorBatch| before anything else
+  /// is rendered to, or changes the state of, the current render pass.
+  struct SolidColorBatch {
+    Matrix transform;
+    BlendMode blend_mode = BlendMode::kSrcOver;
+    Color color;
+    uint32_t clip_depth = 0u;
+    Rect coverage;
+    std::vector<Point> vertices;
+    size_t draw_count = 0u;
+  };
+
+  SolidColorBatch solid_color_batch_;
+  bool solid_color_batching_enabled_ = true;
+
   Point GetGlobalPassPosition() const;
 
   // clip depth of the previous save or 0.
@@ -393,7 +418,21 @@ class Canvas {
                                                const Paint& paint,
                                                bool reuse_depth = false);
 
-  void AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth = false);
+  /// If `solid_color` is the contents of the entity, the entity may be
+  /// merged with neighboring solid color draws.
+  void AddRenderEntityToCurrentPass(
+      Entity& entity,
+      bool reuse_depth = false,
+      const SolidColorContents* solid_color = nullptr);
+
+  /// Adds the entity to the solid color batch, rendering the batch first if
+  /// it is not compatible with the entity.
+  ///
+  /// Returns false if the geometry of the entity cannot be batched.
+  bool AppendToSolidColorBatch(const Entity& entity,
+                               const SolidColorContents& contents);
+
+  void FlushSolidColorBatch();
 
   bool AttemptDrawBlurredRRect(const Rect& rect,
                                Size corner_radii,
@@ -2,11 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <functional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/dl_tile_mode.h"
 #include "flutter/display_list/effects/dl_image_filter.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/core/formats.h"
@@ -15,6 +19,8 @@
 #include "impeller/display_list/canvas.h"
 #include "impeller/display_list/dl_runtime_effect_impeller.h"
 #include "impeller/display_list/dl_vertices_geometry.h"
+#include "impeller/entity/contents/test/recording_context.h"
+#include "impeller/entity/geometry/rect_geometry.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/widgets.h"
@@ -387,6 +393,138 @@ TEST_P(AiksTest, SupportsBlitToOnscreen) {
   }
 }
 
+// Replays |draw| on a canvas with solid color batching enabled or disabled,
+// and returns the rendered pixels and the number of draws that |context|,
+// which must be backed by |recording_context|, recorded for them.
+static std::pair<std::vector<uint8_t>, size_t> RenderWithSolidColorBatching(
+    ContentContext& context,
+    const RecordingContext& recording_context,
+    bool batching_enabled,
+    const std::function<void(Canvas&)>& draw) {
+  ISize size(100, 100);
+  RenderTargetAllocator render_target_allocator(
+      context.GetContext()->GetResourceAllocator());
+  RenderTarget render_target;
+  if (context.GetContext()->GetCapabilities()->SupportsOffscreenMSAA()) {
+    render_target = render_target_allocator.CreateOffscreenMSAA(
+        *context.GetContext(), size, /*mip_count=*/1);
+  } else {
+    render_target = render_target_allocator.CreateOffscreen(
+        *context.GetContext(), size, /*mip_count=*/1);
+  }
+  FML_CHECK(render_target.IsValid());
+
+  size_t initial_draw_count = recording_context.GetDrawCount();
+  Canvas canvas(context, render_target, /*is_onscreen=*/false,
+                /*requires_readback=*/false);
+  canvas.SetSolidColorBatchingEnabled(batching_enabled);
+  draw(canvas);
+  canvas.EndReplay();
+  size_t draw_count = recording_context.GetDrawCount() - initial_draw_count;
+
+  std::shared_ptr<Texture> texture = render_target.GetRenderTargetTexture();
+  DeviceBufferDescriptor desc;
+  desc.size = texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  desc.readback = true;
+  desc.storage_mode = StorageMode::kHostVisible;
+  auto device_buffer =
+      context.GetContext()->GetResourceAllocator()->CreateBuffer(desc);
+  FML_CHECK(device_buffer);
+  auto cmd_buffer = context.GetContext()->CreateCommandBuffer();
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  blit_pass->AddCopy(texture, device_buffer);
+  blit_pass->EncodeCommands();
+  auto latch = std::make_shared<fml::CountDownLatch>(1u);
+  context.GetContext()->GetCommandQueue()->Submit(
+      {cmd_buffer},
+      [latch](CommandBuffer::Status status) { latch->CountDown(); });
+  latch->Wait();
+
+  const uint8_t* contents = device_buffer->OnGetContents();
+  return {std::vector<uint8_t>(contents, contents + desc.size), draw_count};
+}
+
+TEST_P(AiksTest, CanvasMergesConsecutiveSolidColorDraws) {
+  auto recording_context = RecordingContext::Create(GetContext());
+  ContentContext context(recording_context, nullptr);
+  auto draw = [](Canvas& canvas) {
+    Paint red;
+    red.color = Color::Red();
+    canvas.DrawRect(Rect::MakeXYWH(10, 10, 10, 10), red);
+    canvas.DrawRect(Rect::MakeXYWH(30, 10, 10, 10), red);
+    canvas.DrawCircle(Point(55, 15), 5, red);
+    canvas.DrawOval(Rect::MakeXYWH(70, 10, 20, 10), red);
+
+    Paint blue;
+    blue.color = Color::Blue();
+    canvas.DrawRect(Rect::MakeXYWH(10, 30, 10, 10), blue);
+    canvas.DrawRect(Rect::MakeXYWH(30, 30, 10, 10), blue);
+  };
+
+  auto [batched_pixels, batched_count] = RenderWithSolidColorBatching(
+      context, *recording_context, /*batching_enabled=*/true, draw);
+  auto [pixels, count] = RenderWithSolidColorBatching(
+      context, *recording_context, /*batching_enabled=*/false, draw);
+
+  // The draws of each color are merged into one draw.
+  EXPECT_EQ(batched_count, 2u);
+  EXPECT_EQ(count, 6u);
+  EXPECT_EQ(batched_pixels, pixels);
+}
+
+TEST_P(AiksTest, CanvasSolidColorBatchingPreservesOutput) {
+  auto recording_context = RecordingContext::Create(GetContext());
+  ContentContext context(recording_context, nullptr);
+  auto draw = [](Canvas& canvas) {
+    Paint translucent_red;
+    translucent_red.color = Color::Red().WithAlpha(0.5);
+    Paint translucent_green;
+    translucent_green.color = Color::Green().WithAlpha(0.5);
+
+    // Overlapping translucent draws, whose order and depth matter.
+    canvas.DrawRect(Rect::MakeXYWH(0, 0, 40, 40), translucent_red);
+    canvas.DrawRect(Rect::MakeXYWH(20, 20, 40, 40), translucent_red);
+    canvas.DrawRect(Rect::MakeXYWH(10, 10, 40, 40), translucent_green);
+
+    // Draws on both sides of a clip.
+    canvas.Save();
+    RectGeometry clip(Rect::MakeXYWH(25, 25, 50, 50));
+    canvas.ClipGeometry(clip, Entity::ClipOperation::kIntersect);
+    canvas.DrawRect(Rect::MakeXYWH(0, 30, 100, 20), translucent_red);
+    canvas.DrawCircle(Point(50, 50), 20, translucent_red);
+    canvas.Restore();
+    canvas.DrawRect(Rect::MakeXYWH(0, 60, 100, 10), translucent_red);
+
+    // Draws on both sides of a save layer.
+    Paint layer_paint;
+    layer_paint.color = Color::White().WithAlpha(0.5);
+    canvas.DrawRect(Rect::MakeXYWH(60, 0, 30, 30), translucent_green);
+    canvas.SaveLayer(layer_paint);
+    canvas.DrawRect(Rect::MakeXYWH(65, 5, 30, 30), translucent_green);
+    canvas.DrawRect(Rect::MakeXYWH(70, 10, 30, 30), translucent_green);
+    canvas.Restore();
+    canvas.DrawRect(Rect::MakeXYWH(75, 15, 30, 30), translucent_green);
+
+    // Blend mode changes between draws of the same color.
+    Paint src_red = translucent_red;
+    src_red.blend_mode = BlendMode::kSrc;
+    Paint plus_red = translucent_red;
+    plus_red.blend_mode = BlendMode::kPlus;
+    canvas.DrawRect(Rect::MakeXYWH(0, 75, 40, 20), translucent_red);
+    canvas.DrawRect(Rect::MakeXYWH(10, 80, 40, 20), src_red);
+    canvas.DrawRect(Rect::MakeXYWH(20, 85, 40, 20), plus_red);
+    canvas.DrawRect(Rect::MakeXYWH(30, 90, 40, 20), translucent_red);
+  };
+
+  auto [batched_pixels, batched_count] = RenderWithSolidColorBatching(
+      context, *recording_context, /*batching_enabled=*/true, draw);
+  auto [pixels, count] = RenderWithSolidColorBatching(
+      context, *recording_context, /*batching_enabled=*/false, draw);
+
+  EXPECT_LT(batched_count, count);
+  EXPECT_EQ(batched_pixels, pixels);
+}
+
 TEST_P(AiksTest, RoundSuperellipseShadowComparison) {
   // Config
   Size default_size(600, 400);
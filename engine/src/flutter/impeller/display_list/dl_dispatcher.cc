@@ -1301,11 +1301,13 @@ bool RenderToTarget(ContentContext& context,
   const auto& [data, count] = collector.TakeBackdropData();
   impeller_dispatcher.SetBackdropData(data, count);
   context.GetTextShadowCache().MarkFrameStart();
+  context.GetPathTessellationCache().MarkFrameStart();
   fml::ScopedCleanupClosure cleanup([&] {
     if (reset_host_buffer) {
       context.ResetTransientsBuffers();
     }
     context.GetTextShadowCache().MarkFrameEnd();
+    context.GetPathTessellationCache().MarkFrameEnd();
   });
 
   display_list->Dispatch(impeller_dispatcher, cull_rect);
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/fml/mapping.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/vk/entity_shaders_vk.h"
+#include "impeller/entity/vk/framebuffer_blend_shaders_vk.h"
+#include "impeller/entity/vk/modern_shaders_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+
+namespace impeller {
+
+namespace {
+
+/// How long the mock driver takes to create each pipeline.
+constexpr fml::TimeDelta kPipelineCreationDelay =
+    fml::TimeDelta::FromMilliseconds(2);
+
+/// Stands in for the work the raster thread does for the first frame before it
+/// needs any pipelines, such as building and tessellating the scene.
+constexpr fml::TimeDelta kFirstFrameSetupTime =
+    fml::TimeDelta::FromMilliseconds(8);
+
+std::shared_ptr<ContextVK> CreateLazyContext() {
+  return testing::MockVulkanContextBuilder()
+      .SetSettingsCallback([](ContextVK::Settings& settings) {
+        settings.shader_libraries_data = {
+            std::make_shared<fml::NonOwnedMapping>(
+                impeller_entity_shaders_vk_data,
+                impeller_entity_shaders_vk_length),
+            std::make_shared<fml::NonOwnedMapping>(
+                impeller_modern_shaders_vk_data,
+                impeller_modern_shaders_vk_length),
+            std::make_shared<fml::NonOwnedMapping>(
+                impeller_framebuffer_blend_shaders_vk_data,
+                impeller_framebuffer_blend_shaders_vk_length),
+        };
+        settings.flags.lazy_shader_mode = true;
+      })
+      .Build();
+}
+
+/// Gets the pipelines that a typical first frame draws with.
+void GetFirstFramePipelines(const ContentContext& content_context) {
+  ContentContextOptions opts;
+  opts.color_attachment_pixel_format =
+      content_context.GetContext()->GetCapabilities()->GetDefaultColorFormat();
+
+  content_context.GetSolidFillPipeline(opts);
+  content_context.GetTexturePipeline(opts);
+  content_context.GetGlyphAtlasPipeline(opts);
+  content_context.GetRRectBlurPipeline(opts);
+  content_context.GetLinearGradientFillPipeline(opts);
+  content_context.GetClipPipeline(opts);
+
+  opts.blend_mode = BlendMode::kSrc;
+  content_context.GetSolidFillPipeline(opts);
+  content_context.GetTexturePipeline(opts);
+
+  opts.blend_mode = BlendMode::kSrcOver;
+  opts.primitive_type = PrimitiveType::kTriangleStrip;
+  content_context.GetSolidFillPipeline(opts);
+  content_context.GetTiledTexturePipeline(opts);
+
+  opts.stencil_mode = ContentContextOptions::StencilMode::kStencilNonZeroFill;
+  content_context.GetClipPipeline(opts);
+  opts.stencil_mode = ContentContextOptions::StencilMode::kCoverCompare;
+  content_context.GetSolidFillPipeline(opts);
+}
+
+/// Records the pipeline usage profile of a session that renders the first
+/// frame, like a previous launch of the application would.
+std::vector<PipelineUsageProfile::Entry> RecordFirstFrameProfile() {
+  std::shared_ptr<ContextVK> context = CreateLazyContext();
+  std::vector<PipelineUsageProfile::Entry> entries;
+  {
+    ContentContext content_context(context, TypographerContextSkia::Make());
+    GetFirstFramePipelines(content_context);
+    entries = content_context.GetPipelineUsageProfile()->GetEntries();
+  }
+  context->Shutdown();
+  return entries;
+}
+
+void BM_TimeToFirstFrame(benchmark::State& state, bool use_profile) {
+  testing::SetPipelineCreationDelay(kPipelineCreationDelay);
+  std::vector<PipelineUsageProfile::Entry> entries;
+  if (use_profile) {
+    entries = RecordFirstFrameProfile();
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::shared_ptr<ContextVK> context = CreateLazyContext();
+    state.ResumeTiming();
+
+    {
+      ContentContext content_context(context, TypographerContextSkia::Make());
+      // The constructor does this itself when the pipeline library persists a
+      // profile. The mock context has no cache directory to persist one to.
+      content_context.PrewarmPipelines(entries);
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(kFirstFrameSetupTime.ToMicroseconds()));
+      GetFirstFramePipelines(content_context);
+    }
+
+    state.PauseTiming();
+    context->Shutdown();
+    state.ResumeTiming();
+  }
+  state.counters["ProfileEntries"] = entries.size();
+
+  testing::SetPipelineCreationDelay(fml::TimeDelta::Zero());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_TimeToFirstFrame, without_profile, /*use_profile=*/false)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_TimeToFirstFrame, with_profile, /*use_profile=*/true)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace impeller
@@ -6,6 +6,7 @@
 
 #include <format>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 #include "fml/trace_event.h"
@@ -29,6 +30,30 @@ namespace impeller {
 
 namespace {
 
+/// Identifies the family of variants created from a default pipeline
+/// descriptor in pipeline usage profiles.
+///
+/// Profiles are persisted across launches, so unlike `PipelineDescriptor`
+/// hashes, this must be the same in every build. It is computed from the
+/// descriptor's label and specialization constants, which together tell apart
+/// all the default pipelines of a content context.
+uint64_t ComputeUsageProfileId(const PipelineDescriptor& desc) {
+  // 64-bit FNV-1a.
+  uint64_t hash = 0xcbf29ce484222325u;
+  auto add = [&hash](const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3u;
+    }
+  };
+  std::string_view label = desc.GetLabel();
+  add(label.data(), label.size());
+  for (Scalar constant : desc.GetSpecializationConstants()) {
+    add(&constant, sizeof(constant));
+  }
+  return hash;
+}
+
 /// A generic version of `Variants` which mostly exists to reduce code size.
 class GenericVariants {
  public:
@@ -63,10 +88,16 @@ class GenericVariants {
 
   void SetDefaultDescriptor(std::optional<PipelineDescriptor> desc) {
     desc_ = std::move(desc);
+    usage_profile_id_ =
+        desc_.has_value() ? ComputeUsageProfileId(desc_.value()) : 0u;
   }
 
   size_t GetPipelineCount() const { return pipelines_.size(); }
 
+  /// The ID of these variants in pipeline usage profiles, or 0 if there is no
+  /// default descriptor to create variants from.
+  uint64_t GetUsageProfileId() const { return usage_profile_id_; }
+
   bool IsDefault(const ContentContextOptions& opts) {
     return default_options_.has_value() &&
            opts.ToKey() == default_options_.value().ToKey();
@@ -75,6 +106,7 @@ class GenericVariants {
  protected:
   std::optional<PipelineDescriptor> desc_;
   std::optional<ContentContextOptions> default_options_;
+  uint64_t usage_profile_id_ = 0u;
   std::vector<std::pair<uint64_t, std::unique_ptr<GenericRenderPipelineHandle>>>
       pipelines_;
 };
@@ -125,7 +157,7 @@ class Variants : public GenericVariants {
       return;
     }
     options.ApplyToPipelineDescriptor(*desc);
-    desc_ = desc;
+    SetDefaultDescriptor(desc);
     if (context.GetFlags().lazy_shader_mode) {
       SetDefault(options, nullptr);
     } else {
@@ -138,6 +170,29 @@ class Variants : public GenericVariants {
     return static_cast<PipelineHandleT*>(GenericVariants::Get(options));
   }
 
+  /// Starts creating the variant for the given options on the worker
+  /// threads, unless it already exists.
+  ///
+  /// @return Whether the variant exists now.
+  bool Prewarm(const Context& context, const ContentContextOptions& options) {
+    if (Get(options) != nullptr) {
+      return true;
+    }
+    if (!desc_.has_value()) {
+      return false;
+    }
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    PipelineDescriptor desc = desc_.value();
+    if (!IsDefault(options)) {
+      options.ApplyToPipelineDescriptor(desc);
+      desc.SetLabel(
+          std::format("{} V#{}", desc.GetLabel(), GetPipelineCount()));
+    }
+    Set(options, std::make_unique<PipelineHandleT>(context, desc,
+                                                   /*async=*/true));
+    return true;
+  }
+
   PipelineHandleT* GetDefault(const Context& context) {
     if (!default_options_.has_value()) {
       return nullptr;
@@ -171,6 +226,14 @@ RenderPipelineHandleT* CreateIfNeeded(
     return found;
   }
 
+  // This is the first use of the variant. Record it so that the next launch
+  // can create it ahead of time.
+  if (container.GetUsageProfileId() != 0u) {
+    context->GetPipelineUsageProfile()->Record(
+        {.pipeline_id = container.GetUsageProfileId(),
+         .variant_key = opts.ToKey()});
+  }
+
   RenderPipelineHandleT* default_handle =
       container.GetDefault(*context->GetContext());
   if (container.IsDefault(opts)) {
@@ -306,8 +369,132 @@ struct ContentContext::Pipelines {
   Variants<TiledTextureUvExternalPipeline> tiled_texture_uv_external;
 #endif  // IMPELLER_ENABLE_OPENGLES
   // clang-format on
+
+  /// Calls `callback` with each of the containers above.
+  template <typename Callback>
+  void ForEach(const Callback& callback) {
+    callback(blend_colorburn);
+    callback(blend_colordodge);
+    callback(blend_color);
+    callback(blend_darken);
+    callback(blend_difference);
+    callback(blend_exclusion);
+    callback(blend_hardlight);
+    callback(blend_hue);
+    callback(blend_lighten);
+    callback(blend_luminosity);
+    callback(blend_multiply);
+    callback(blend_overlay);
+    callback(blend_saturation);
+    callback(blend_screen);
+    callback(blend_softlight);
+    callback(border_mask_blur);
+    callback(clip);
+    callback(color_matrix_color_filter);
+    callback(conical_gradient_fill);
+    callback(conical_gradient_fill_radial);
+    callback(conical_gradient_fill_strip);
+    callback(conical_gradient_fill_strip_and_radial);
+    callback(conical_gradient_ssbo_fill);
+    callback(conical_gradient_ssbo_fill_radial);
+    callback(conical_gradient_ssbo_fill_strip_and_radial);
+    callback(conical_gradient_ssbo_fill_strip);
+    callback(conical_gradient_uniform_fill);
+    callback(conical_gradient_uniform_fill_radial);
+    callback(conical_gradient_uniform_fill_strip);
+    callback(conical_gradient_uniform_fill_strip_and_radial);
+    callback(fast_gradient);
+    callback(framebuffer_blend_colorburn);
+    callback(framebuffer_blend_colordodge);
+    callback(framebuffer_blend_color);
+    callback(framebuffer_blend_darken);
+    callback(framebuffer_blend_difference);
+    callback(framebuffer_blend_exclusion);
+    callback(framebuffer_blend_hardlight);
+    callback(framebuffer_blend_hue);
+    callback(framebuffer_blend_lighten);
+    callback(framebuffer_blend_luminosity);
+    callback(framebuffer_blend_multiply);
+    callback(framebuffer_blend_overlay);
+    callback(framebuffer_blend_saturation);
+    callback(framebuffer_blend_screen);
+    callback(framebuffer_blend_softlight);
+    callback(gaussian_blur);
+    callback(glyph_atlas);
+    callback(line);
+    callback(linear_gradient_fill);
+    callback(linear_gradient_ssbo_fill);
+    callback(linear_gradient_uniform_fill);
+    callback(linear_to_srgb_filter);
+    callback(morphology_filter);
+    callback(clear_blend);
+    callback(destination_a_top_blend);
+    callback(destination_blend);
+    callback(destination_in_blend);
+    callback(destination_out_blend);
+    callback(destination_over_blend);
+    callback(modulate_blend);
+    callback(plus_blend);
+    callback(screen_blend);
+    callback(source_a_top_blend);
+    callback(source_blend);
+    callback(source_in_blend);
+    callback(source_out_blend);
+    callback(source_over_blend);
+    callback(xor_blend);
+    callback(radial_gradient_fill);
+    callback(radial_gradient_ssbo_fill);
+    callback(radial_gradient_uniform_fill);
+    callback(rrect_blur);
+    callback(rsuperellipse_blur);
+    callback(solid_fill);
+    callback(srgb_to_linear_filter);
+    callback(sweep_gradient_fill);
+    callback(sweep_gradient_ssbo_fill);
+    callback(sweep_gradient_uniform_fill);
+    callback(texture_downsample);
+    callback(texture);
+    callback(texture_strict_src);
+    callback(tiled_texture);
+    callback(vertices_uber_1_);
+    callback(vertices_uber_2_);
+    callback(yuv_to_rgb_filter);
+#ifdef IMPELLER_ENABLE_OPENGLES
+    callback(tiled_texture_external);
+    callback(texture_downsample_gles);
+    callback(tiled_texture_uv_external);
+#endif  // IMPELLER_ENABLE_OPENGLES
+  }
 };
 
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  ContentContextOptions options;
+  options.is_for_rrect_blur_clear = (key & 1llu) != 0;
+  options.has_depth_stencil_attachments = ((key >> 2) & 1llu) != 0;
+  options.depth_write_enabled = ((key >> 3) & 1llu) != 0;
+  options.color_attachment_pixel_format =
+      static_cast<PixelFormat>((key >> 8) & 0xFF);
+  options.primitive_type = static_cast<PrimitiveType>((key >> 16) & 0xFF);
+  options.stencil_mode = static_cast<StencilMode>((key >> 24) & 0xFF);
+  options.depth_compare = static_cast<CompareFunction>((key >> 32) & 0xFF);
+  options.blend_mode = static_cast<BlendMode>((key >> 40) & 0xFF);
+  options.sample_count = static_cast<SampleCount>((key >> 48) & 0xFF);
+
+  // Reject unused bits and out of range enums.
+  if (options.ToKey() != key ||
+      options.color_attachment_pixel_format > PixelFormat::kD32FloatS8UInt ||
+      options.primitive_type > PrimitiveType::kTriangleFan ||
+      options.stencil_mode > StencilMode::kOverdrawPreventionRestore ||
+      options.depth_compare > CompareFunction::kGreaterEqual ||
+      options.blend_mode > BlendMode::kLastMode ||
+      (options.sample_count != SampleCount::kCount1 &&
+       options.sample_count != SampleCount::kCount4)) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 void ContentContextOptions::ApplyToPipelineDescriptor(
     PipelineDescriptor& desc) const {
   auto pipeline_blend = blend_mode;
@@ -550,6 +737,7 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       pipelines_(new Pipelines()),
+      pipeline_usage_profile_(std::make_shared<PipelineUsageProfile>()),
       tessellator_(std::make_shared<Tessellator>()),
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
@@ -559,7 +747,8 @@ ContentContext::ContentContext(
           context_->GetResourceAllocator(),
           context_->GetIdleWaiter(),
           context_->GetCapabilities()->GetMinimumUniformAlignment())),
-      text_shadow_cache_(std::make_unique<TextShadowCache>()) {
+      text_shadow_cache_(std::make_unique<TextShadowCache>()),
+      path_tessellation_cache_(std::make_unique<PathTessellationCache>()) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -686,8 +875,8 @@ ContentContext::ContentContext(
     }
     clip_pipeline_descriptor->SetColorAttachmentDescriptors(
         std::move(clip_color_attachments));
+    pipelines_->clip.SetDefaultDescriptor(clip_pipeline_descriptor);
     if (GetContext()->GetFlags().lazy_shader_mode) {
-      pipelines_->clip.SetDefaultDescriptor(clip_pipeline_descriptor);
       pipelines_->clip.SetDefault(options, nullptr);
     } else {
       pipelines_->clip.SetDefault(
@@ -862,6 +1051,16 @@ ContentContext::ContentContext(
 #endif  // IMPELLER_ENABLE_OPENGLES
 
   is_valid_ = true;
+
+  // Record into the profile that the pipeline library persists, and start
+  // creating the variants that previous launches used before the first frame
+  // needs them.
+  if (std::shared_ptr<PipelineUsageProfile> persisted_profile =
+          context_->GetPipelineLibrary()->GetUsageProfile()) {
+    pipeline_usage_profile_ = std::move(persisted_profile);
+    PrewarmPipelines(pipeline_usage_profile_->GetEntries());
+  }
+
   InitializeCommonlyUsedShadersIfNeeded();
 }
 
@@ -987,6 +1186,32 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+size_t ContentContext::PrewarmPipelines(
+    const std::vector<PipelineUsageProfile::Entry>& entries) const {
+  if (!IsValid() || entries.empty()) {
+    return 0u;
+  }
+  TRACE_EVENT0("flutter", "ContentContext::PrewarmPipelines");
+  size_t prewarmed_count = 0u;
+  pipelines_->ForEach([&](auto& variants) {
+    const uint64_t id = variants.GetUsageProfileId();
+    if (id == 0u) {
+      return;
+    }
+    for (const PipelineUsageProfile::Entry& entry : entries) {
+      if (entry.pipeline_id != id) {
+        continue;
+      }
+      std::optional<ContentContextOptions> options =
+          ContentContextOptions::FromKey(entry.variant_key);
+      if (options.has_value() && variants.Prewarm(*context_, options.value())) {
+        prewarmed_count++;
+      }
+    }
+  });
+  return prewarmed_count;
+}
+
 void ContentContext::ResetTransientsBuffers() {
   data_host_buffer_->Reset();
 
@@ -10,6 +10,7 @@
 #include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/status_or.h"
@@ -17,11 +18,13 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/entity/contents/text_shadow_cache.h"
+#include "impeller/entity/geometry/path_tessellation_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_usage_profile.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/typographer_context.h"
@@ -122,6 +125,15 @@ struct ContentContextOptions {
            static_cast<uint64_t>(sample_count) << 48;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The inverse of `ToKey`.
+  ///
+  /// @return     The options, or std::nullopt if the key wasn't produced by
+  ///             `ToKey`, such as when it was read from a pipeline usage
+  ///             profile written by another version of the engine.
+  ///
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
+
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
@@ -290,6 +302,27 @@ class ContentContext {
   void ClearCachedRuntimeEffectPipeline(
       const std::string& unique_entrypoint_name) const;
 
+  /// @brief  The profile into which the pipeline variants created by this
+  ///         content context are recorded.
+  ///
+  /// This is the profile of the context's pipeline library if it persists
+  /// one, and a profile that is only kept in memory otherwise.
+  const std::shared_ptr<PipelineUsageProfile>& GetPipelineUsageProfile() const {
+    return pipeline_usage_profile_;
+  }
+
+  /// @brief  Starts creating the pipeline variants listed in the given profile
+  ///         entries on the context's worker threads, so that they are ready,
+  ///         or at least closer to ready, when they are first used.
+  ///
+  /// The constructor does this with the entries of the pipeline library's
+  /// usage profile, which hold the variants used by previous launches.
+  /// Entries that don't describe a known variant are ignored.
+  ///
+  /// @return The number of entries whose variants now exist.
+  size_t PrewarmPipelines(
+      const std::vector<PipelineUsageProfile::Entry>& entries) const;
+
   /// @brief Retrieve the current host buffer for transient storage of indexes
   ///        used for indexed draws.
   ///
@@ -314,6 +347,10 @@ class ContentContext {
 
   TextShadowCache& GetTextShadowCache() const { return *text_shadow_cache_; }
 
+  PathTessellationCache& GetPathTessellationCache() const {
+    return *path_tessellation_cache_;
+  }
+
  protected:
   // Visible for testing.
   void SetTransientsIndexesBuffer(std::shared_ptr<HostBuffer> host_buffer) {
@@ -365,6 +402,7 @@ class ContentContext {
 
   struct Pipelines;
   std::unique_ptr<Pipelines> pipelines_;
+  std::shared_ptr<PipelineUsageProfile> pipeline_usage_profile_;
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
@@ -373,6 +411,7 @@ class ContentContext {
   std::shared_ptr<HostBuffer> indexes_host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
   std::unique_ptr<TextShadowCache> text_shadow_cache_;
+  std::unique_ptr<PathTessellationCache> path_tessellation_cache_;
 
   ContentContext(const ContentContext&) = delete;
 
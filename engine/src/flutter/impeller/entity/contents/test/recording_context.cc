@@ -0,0 +1,251 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/test/recording_context.h"
+
+#include <utility>
+
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller::testing {
+
+// Forwards to a command buffer of the delegate context, and records the
+// render passes it creates.
+class RecordingCommandBuffer final : public CommandBuffer {
+ public:
+  RecordingCommandBuffer(std::shared_ptr<const RecordingContext> context,
+                         std::shared_ptr<CommandBuffer> delegate)
+      : CommandBuffer(context),
+        recording_context_(std::move(context)),
+        delegate_(std::move(delegate)) {}
+
+  const std::shared_ptr<CommandBuffer>& GetDelegate() const {
+    return delegate_;
+  }
+
+  // |CommandBuffer|
+  bool IsValid() const override { return delegate_->IsValid(); }
+
+  // |CommandBuffer|
+  void SetLabel(std::string_view label) const override {
+    delegate_->SetLabel(label);
+  }
+
+ private:
+  const std::shared_ptr<const RecordingContext> recording_context_;
+  const std::shared_ptr<CommandBuffer> delegate_;
+
+  // |CommandBuffer|
+  std::shared_ptr<RenderPass> OnCreateRenderPass(
+      RenderTarget render_target) override {
+    std::shared_ptr<RenderPass> render_pass =
+        delegate_->CreateRenderPass(render_target);
+    if (!render_pass) {
+      return nullptr;
+    }
+    // The recorded passes refer to the delegate context, as the recording
+    // context keeps them alive.
+    auto recording_pass = std::make_shared<RecordingRenderPass>(
+        std::move(render_pass), recording_context_->delegate_, render_target);
+    recording_context_->AddRenderPass(recording_pass);
+    return recording_pass;
+  }
+
+  // |CommandBuffer|
+  std::shared_ptr<BlitPass> OnCreateBlitPass() override {
+    return delegate_->CreateBlitPass();
+  }
+
+  // |CommandBuffer|
+  std::shared_ptr<ComputePass> OnCreateComputePass() override {
+    return delegate_->CreateComputePass();
+  }
+
+  // |CommandBuffer|
+  bool OnSubmitCommands(bool block_on_schedule,
+                        CompletionCallback callback) override {
+    // The context and its command queue submit the delegate instead.
+    return false;
+  }
+
+  // |CommandBuffer|
+  void OnWaitUntilCompleted() override { delegate_->WaitUntilCompleted(); }
+
+  // |CommandBuffer|
+  void OnWaitUntilScheduled() override { delegate_->WaitUntilScheduled(); }
+};
+
+namespace {
+
+// Only command buffers created by a |RecordingContext| are submitted to it.
+std::shared_ptr<CommandBuffer> GetDelegate(
+    const std::shared_ptr<CommandBuffer>& command_buffer) {
+  if (!command_buffer) {
+    return nullptr;
+  }
+  return static_cast<const RecordingCommandBuffer&>(*command_buffer)
+      .GetDelegate();
+}
+
+// Submits the command buffers of the delegate context.
+class RecordingCommandQueue : public CommandQueue {
+ public:
+  explicit RecordingCommandQueue(std::shared_ptr<CommandQueue> delegate)
+      : delegate_(std::move(delegate)) {}
+
+  // |CommandQueue|
+  fml::Status Submit(const std::vector<std::shared_ptr<CommandBuffer>>& buffers,
+                     const CompletionCallback& completion_callback,
+                     bool block_on_schedule) override {
+    std::vector<std::shared_ptr<CommandBuffer>> delegate_buffers;
+    delegate_buffers.reserve(buffers.size());
+    for (const std::shared_ptr<CommandBuffer>& buffer : buffers) {
+      delegate_buffers.push_back(GetDelegate(buffer));
+    }
+    return delegate_->Submit(delegate_buffers, completion_callback,
+                             block_on_schedule);
+  }
+
+ private:
+  const std::shared_ptr<CommandQueue> delegate_;
+};
+
+}  // namespace
+
+std::shared_ptr<RecordingContext> RecordingContext::Create(
+    std::shared_ptr<Context> delegate) {
+  return std::shared_ptr<RecordingContext>(
+      new RecordingContext(std::move(delegate)));
+}
+
+RecordingContext::RecordingContext(std::shared_ptr<Context> delegate)
+    : Context(delegate->GetFlags()),
+      delegate_(std::move(delegate)),
+      command_queue_(std::make_shared<RecordingCommandQueue>(
+          delegate_->GetCommandQueue())) {}
+
+RecordingContext::~RecordingContext() = default;
+
+std::vector<std::shared_ptr<RecordingRenderPass>>
+RecordingContext::GetRenderPasses() const {
+  std::scoped_lock lock(mutex_);
+  return render_passes_;
+}
+
+size_t RecordingContext::GetDrawCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t draw_count = 0u;
+  for (const std::shared_ptr<RecordingRenderPass>& render_pass :
+       render_passes_) {
+    draw_count += render_pass->GetCommands().size();
+  }
+  return draw_count;
+}
+
+void RecordingContext::AddRenderPass(
+    std::shared_ptr<RecordingRenderPass> render_pass) const {
+  std::scoped_lock lock(mutex_);
+  render_passes_.push_back(std::move(render_pass));
+}
+
+Context::BackendType RecordingContext::GetBackendType() const {
+  return delegate_->GetBackendType();
+}
+
+std::string RecordingContext::DescribeGpuModel() const {
+  return delegate_->DescribeGpuModel();
+}
+
+bool RecordingContext::IsValid() const {
+  return delegate_->IsValid();
+}
+
+const std::shared_ptr<const Capabilities>& RecordingContext::GetCapabilities()
+    const {
+  return delegate_->GetCapabilities();
+}
+
+bool RecordingContext::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
+  return delegate_->UpdateOffscreenLayerPixelFormat(format);
+}
+
+std::shared_ptr<Allocator> RecordingContext::GetResourceAllocator() const {
+  return delegate_->GetResourceAllocator();
+}
+
+std::shared_ptr<ShaderLibrary> RecordingContext::GetShaderLibrary() const {
+  return delegate_->GetShaderLibrary();
+}
+
+std::shared_ptr<SamplerLibrary> RecordingContext::GetSamplerLibrary() const {
+  return delegate_->GetSamplerLibrary();
+}
+
+std::shared_ptr<PipelineLibrary> RecordingContext::GetPipelineLibrary() const {
+  return delegate_->GetPipelineLibrary();
+}
+
+std::shared_ptr<CommandBuffer> RecordingContext::CreateCommandBuffer() const {
+  std::shared_ptr<CommandBuffer> command_buffer =
+      delegate_->CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  return std::make_shared<RecordingCommandBuffer>(shared_from_this(),
+                                                  std::move(command_buffer));
+}
+
+std::shared_ptr<CommandQueue> RecordingContext::GetCommandQueue() const {
+  return command_queue_;
+}
+
+void RecordingContext::Shutdown() {
+  delegate_->Shutdown();
+}
+
+void RecordingContext::StoreTaskForGPU(const fml::closure& task,
+                                       const fml::closure& failure) {
+  delegate_->StoreTaskForGPU(task, failure);
+}
+
+void RecordingContext::InitializeCommonlyUsedShadersIfNeeded() const {
+  delegate_->InitializeCommonlyUsedShadersIfNeeded();
+}
+
+void RecordingContext::DisposeThreadLocalCachedResources() {
+  delegate_->DisposeThreadLocalCachedResources();
+}
+
+bool RecordingContext::EnqueueCommandBuffer(
+    std::shared_ptr<CommandBuffer> command_buffer) {
+  return delegate_->EnqueueCommandBuffer(GetDelegate(command_buffer));
+}
+
+bool RecordingContext::FlushCommandBuffers() {
+  return delegate_->FlushCommandBuffers();
+}
+
+bool RecordingContext::AddTrackingFence(
+    const std::shared_ptr<Texture>& texture) const {
+  return delegate_->AddTrackingFence(texture);
+}
+
+std::shared_ptr<const IdleWaiter> RecordingContext::GetIdleWaiter() const {
+  return delegate_->GetIdleWaiter();
+}
+
+void RecordingContext::ResetThreadLocalState() const {
+  delegate_->ResetThreadLocalState();
+}
+
+RuntimeStageBackend RecordingContext::GetRuntimeStageBackend() const {
+  return delegate_->GetRuntimeStageBackend();
+}
+
+bool RecordingContext::SubmitOnscreen(
+    std::shared_ptr<CommandBuffer> cmd_buffer) {
+  return delegate_->SubmitOnscreen(GetDelegate(cmd_buffer));
+}
+
+}  // namespace impeller::testing
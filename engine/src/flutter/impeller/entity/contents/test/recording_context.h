@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_TEST_RECORDING_CONTEXT_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_TEST_RECORDING_CONTEXT_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "impeller/entity/contents/test/recording_render_pass.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller::testing {
+
+/// A context that forwards to another context, and wraps every render pass
+/// created from its command buffers in a |RecordingRenderPass|, so that the
+/// commands of code that creates its own render passes can be inspected.
+class RecordingContext final
+    : public Context,
+      public std::enable_shared_from_this<RecordingContext> {
+ public:
+  static std::shared_ptr<RecordingContext> Create(
+      std::shared_ptr<Context> delegate);
+
+  ~RecordingContext() override;
+
+  /// The render passes created so far, in order of creation.
+  std::vector<std::shared_ptr<RecordingRenderPass>> GetRenderPasses() const;
+
+  /// The number of draw commands recorded by all render passes.
+  size_t GetDrawCount() const;
+
+  // |Context|
+  BackendType GetBackendType() const override;
+
+  // |Context|
+  std::string DescribeGpuModel() const override;
+
+  // |Context|
+  bool IsValid() const override;
+
+  // |Context|
+  const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
+
+  // |Context|
+  bool UpdateOffscreenLayerPixelFormat(PixelFormat format) override;
+
+  // |Context|
+  std::shared_ptr<Allocator> GetResourceAllocator() const override;
+
+  // |Context|
+  std::shared_ptr<ShaderLibrary> GetShaderLibrary() const override;
+
+  // |Context|
+  std::shared_ptr<SamplerLibrary> GetSamplerLibrary() const override;
+
+  // |Context|
+  std::shared_ptr<PipelineLibrary> GetPipelineLibrary() const override;
+
+  // |Context|
+  std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override;
+
+  // |Context|
+  std::shared_ptr<CommandQueue> GetCommandQueue() const override;
+
+  // |Context|
+  void Shutdown() override;
+
+  // |Context|
+  void StoreTaskForGPU(const fml::closure& task,
+                       const fml::closure& failure) override;
+
+  // |Context|
+  void InitializeCommonlyUsedShadersIfNeeded() const override;
+
+  // |Context|
+  void DisposeThreadLocalCachedResources() override;
+
+  // |Context|
+  bool EnqueueCommandBuffer(
+      std::shared_ptr<CommandBuffer> command_buffer) override;
+
+  // |Context|
+  bool FlushCommandBuffers() override;
+
+  // |Context|
+  bool AddTrackingFence(const std::shared_ptr<Texture>& texture) const override;
+
+  // |Context|
+  std::shared_ptr<const IdleWaiter> GetIdleWaiter() const override;
+
+  // |Context|
+  void ResetThreadLocalState() const override;
+
+  // |Context|
+  RuntimeStageBackend GetRuntimeStageBackend() const override;
+
+  // |Context|
+  bool SubmitOnscreen(std::shared_ptr<CommandBuffer> cmd_buffer) override;
+
+ private:
+  friend class RecordingCommandBuffer;
+
+  const std::shared_ptr<Context> delegate_;
+  std::shared_ptr<CommandQueue> command_queue_;
+  mutable std::mutex mutex_;
+  mutable std::vector<std::shared_ptr<RecordingRenderPass>> render_passes_;
+
+  explicit RecordingContext(std::shared_ptr<Context> delegate);
+
+  void AddRenderPass(std::shared_ptr<RecordingRenderPass> render_pass) const;
+
+  RecordingContext(const RecordingContext&) = delete;
+
+  RecordingContext& operator=(const RecordingContext&) = delete;
+};
+
+}  // namespace impeller::testing
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_TEST_RECORDING_CONTEXT_H_
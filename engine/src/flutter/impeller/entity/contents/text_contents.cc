@@ -4,9 +4,11 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
@@ -91,7 +93,8 @@ void TextContents::ComputeVertexData(
     const Matrix& entity_transform,
     Vector2 offset,
     std::optional<GlyphProperties> glyph_properties,
-    const std::shared_ptr<GlyphAtlas>& atlas) {
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    std::vector<size_t>* glyph_pages) {
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
   // unit-sized quad. The size of the glyph is specified in per instance data
@@ -102,7 +105,7 @@ void TextContents::ComputeVertexData(
   constexpr std::array<Point, 4> unit_points = {Point{0, 0}, Point{1, 0},
                                                 Point{0, 1}, Point{1, 1}};
 
-  ISize atlas_size = atlas->GetTexture()->GetSize();
+  ISize first_page_size = atlas->GetTexture()->GetSize();
   bool is_translation_scale = entity_transform.IsTranslationScaleOnly();
   Matrix basis_transform = entity_transform.Basis();
 
@@ -150,6 +153,10 @@ void TextContents::ComputeVertexData(
       bounds_offset++;
       auto atlas_glyph_bounds = frame_bounds.atlas_bounds;
       auto glyph_bounds = frame_bounds.glyph_bounds;
+      size_t atlas_page = frame_bounds.page;
+      if (glyph_pages) {
+        glyph_pages->push_back(atlas_page);
+      }
 
       // If frame_bounds.is_placeholder is true, this is the first frame
       // the glyph has been rendered and so its atlas position was not
@@ -179,7 +186,16 @@ void TextContents::ComputeVertexData(
           continue;
         }
         atlas_glyph_bounds = maybe_atlas_glyph_bounds.value().atlas_bounds;
+        atlas_page = maybe_atlas_glyph_bounds.value().page;
+      }
+      if (glyph_pages) {
+        glyph_pages->back() = atlas_page;
       }
+      // Pages other than the first are only present in paged atlases, and
+      // may differ in height.
+      ISize atlas_size = atlas_page == 0u
+                             ? first_page_size
+                             : atlas->GetTexture(atlas_page)->GetSize();
 
       Rect scaled_bounds = glyph_bounds.Scale(inverted_rounded_scale);
       // For each glyph, we compute two rectangles. One for the vertex
@@ -217,6 +233,28 @@ void TextContents::ComputeVertexData(
   }
 }
 
+namespace {
+/// Emplace the indices of |glyph_count| glyph quads of 4 vertices each.
+BufferView EmplaceGlyphIndices(HostBuffer& indexes_host_buffer,
+                               size_t glyph_count) {
+  return indexes_host_buffer.Emplace(
+      glyph_count * 6 * sizeof(uint16_t), alignof(uint16_t),
+      [&](uint8_t* data) {
+        uint16_t* indices = reinterpret_cast<uint16_t*>(data);
+        size_t j = 0;
+        for (auto i = 0u; i < glyph_count; i++) {
+          size_t base = i * 4;
+          indices[j++] = base + 0;
+          indices[j++] = base + 1;
+          indices[j++] = base + 2;
+          indices[j++] = base + 1;
+          indices[j++] = base + 2;
+          indices[j++] = base + 3;
+        }
+      });
+}
+}  // namespace
+
 bool TextContents::Render(const ContentContext& renderer,
                           const Entity& entity,
                           RenderPass& pass) const {
@@ -240,10 +278,9 @@ bool TextContents::Render(const ContentContext& renderer,
   }
 
   // Information shared by all glyph draw calls.
-  pass.SetCommandLabel("TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  pass.SetPipeline(renderer.GetGlyphAtlasPipeline(opts));
+  PipelineRef pipeline = renderer.GetGlyphAtlasPipeline(opts);
 
   // Common vertex uniforms for all glyphs.
   VS::FrameInfo frame_info;
@@ -252,16 +289,16 @@ bool TextContents::Render(const ContentContext& renderer,
   bool is_translation_scale = entity.GetTransform().IsTranslationScaleOnly();
   Matrix entity_transform = entity.GetTransform();
 
-  VS::BindFrameInfo(
-      pass, renderer.GetTransientsDataBuffer().EmplaceUniform(frame_info));
+  BufferView frame_info_view =
+      renderer.GetTransientsDataBuffer().EmplaceUniform(frame_info);
 
   FS::FragInfo frag_info;
   frag_info.use_text_color = force_text_color_ ? 1.0 : 0.0;
   frag_info.text_color = ToVector(color.Premultiply());
   frag_info.is_color_glyph = type == GlyphAtlas::Type::kColorBitmap;
 
-  FS::BindFragInfo(
-      pass, renderer.GetTransientsDataBuffer().EmplaceUniform(frag_info));
+  BufferView frag_info_view =
+      renderer.GetTransientsDataBuffer().EmplaceUniform(frag_info);
 
   SamplerDescriptor sampler_desc;
   if (is_translation_scale) {
@@ -279,13 +316,21 @@ bool TextContents::Render(const ContentContext& renderer,
 
   // No mipmaps for glyph atlas (glyphs are generated at exact scales).
   sampler_desc.mip_filter = MipFilter::kBase;
-
-  FS::BindGlyphAtlasSampler(
-      pass,                 // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  raw_ptr<const Sampler> sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+
+  // Every draw call needs the full set of bindings, as they are reset after
+  // each draw.
+  auto bind_glyph_atlas_page = [&](const std::shared_ptr<Texture>& texture) {
+    pass.SetCommandLabel("TextFrame");
+    pass.SetPipeline(pipeline);
+    VS::BindFrameInfo(pass, frame_info_view);
+    FS::BindFragInfo(pass, frag_info_view);
+    FS::BindGlyphAtlasSampler(pass,     // command
+                              texture,  // texture
+                              sampler   // sampler
+    );
+  };
 
   HostBuffer& data_host_buffer = renderer.GetTransientsDataBuffer();
   HostBuffer& indexes_host_buffer = renderer.GetTransientsIndexesBuffer();
@@ -296,6 +341,63 @@ bool TextContents::Render(const ContentContext& renderer,
   size_t vertex_count = glyph_count * 4;
   size_t index_count = glyph_count * 6;
 
+  // Glyphs of a paged atlas are batched into one draw call per page, as each
+  // page is a separate texture.
+  if (atlas->GetPageCount() > 1u) {
+    std::vector<VS::PerVertexData> vertices(vertex_count);
+    std::vector<size_t> glyph_pages;
+    glyph_pages.reserve(glyph_count);
+    ComputeVertexData(/*vtx_contents=*/vertices.data(),
+                      /*frame=*/frame_,
+                      /*scale=*/scale_,
+                      /*entity_transform=*/entity_transform,
+                      /*offset=*/offset_,
+                      /*glyph_properties=*/GetGlyphProperties(),
+                      /*atlas=*/atlas,
+                      /*glyph_pages=*/&glyph_pages);
+    FML_DCHECK(glyph_pages.size() == glyph_count);
+
+    std::vector<size_t> page_glyph_counts(atlas->GetPageCount(), 0u);
+    size_t max_page_glyph_count = 0u;
+    for (size_t page : glyph_pages) {
+      max_page_glyph_count =
+          std::max(max_page_glyph_count, ++page_glyph_counts[page]);
+    }
+
+    // The indices only depend on the glyph count, so the same buffer is shared
+    // by all pages.
+    BufferView index_buffer_view =
+        EmplaceGlyphIndices(indexes_host_buffer, max_page_glyph_count);
+    for (size_t page = 0u; page < page_glyph_counts.size(); page++) {
+      size_t page_glyph_count = page_glyph_counts[page];
+      if (page_glyph_count == 0u) {
+        continue;
+      }
+      BufferView page_buffer_view = data_host_buffer.Emplace(
+          page_glyph_count * 4 * sizeof(VS::PerVertexData),
+          alignof(VS::PerVertexData), [&](uint8_t* data) {
+            VS::PerVertexData* vtx_contents =
+                reinterpret_cast<VS::PerVertexData*>(data);
+            for (size_t i = 0u; i < glyph_count; i++) {
+              if (glyph_pages[i] == page) {
+                std::memcpy(vtx_contents, &vertices[i * 4],
+                            4 * sizeof(VS::PerVertexData));
+                vtx_contents += 4;
+              }
+            }
+          });
+
+      bind_glyph_atlas_page(atlas->GetTexture(page));
+      pass.SetVertexBuffer(std::move(page_buffer_view));
+      pass.SetIndexBuffer(index_buffer_view, IndexType::k16bit);
+      pass.SetElementCount(page_glyph_count * 6);
+      if (!pass.Draw().ok()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   BufferView buffer_view = data_host_buffer.Emplace(
       vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
       [&](uint8_t* data) {
@@ -309,21 +411,10 @@ bool TextContents::Render(const ContentContext& renderer,
                           /*glyph_properties=*/GetGlyphProperties(),
                           /*atlas=*/atlas);
       });
-  BufferView index_buffer_view = indexes_host_buffer.Emplace(
-      index_count * sizeof(uint16_t), alignof(uint16_t), [&](uint8_t* data) {
-        uint16_t* indices = reinterpret_cast<uint16_t*>(data);
-        size_t j = 0;
-        for (auto i = 0u; i < glyph_count; i++) {
-          size_t base = i * 4;
-          indices[j++] = base + 0;
-          indices[j++] = base + 1;
-          indices[j++] = base + 2;
-          indices[j++] = base + 1;
-          indices[j++] = base + 2;
-          indices[j++] = base + 3;
-        }
-      });
+  BufferView index_buffer_view =
+      EmplaceGlyphIndices(indexes_host_buffer, glyph_count);
 
+  bind_glyph_atlas_page(atlas->GetTexture());
   pass.SetVertexBuffer(std::move(buffer_view));
   pass.SetIndexBuffer(index_buffer_view, IndexType::k16bit);
   pass.SetElementCount(index_count);
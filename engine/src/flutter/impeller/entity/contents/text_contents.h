@@ -60,6 +60,10 @@ class TextContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  /// @brief Compute the vertices of every glyph of |frame|.
+  ///
+  ///        If |glyph_pages| is not null, the atlas page each glyph is
+  ///        sampled from is appended to it, one entry per glyph.
   static void ComputeVertexData(
       GlyphAtlasPipeline::VertexShader::PerVertexData* vtx_contents,
       const std::shared_ptr<TextFrame>& frame,
@@ -67,7 +71,8 @@ class TextContents final : public Contents {
       const Matrix& entity_transform,
       Vector2 offset,
       std::optional<GlyphProperties> glyph_properties,
-      const std::shared_ptr<GlyphAtlas>& atlas);
+      const std::shared_ptr<GlyphAtlas>& atlas,
+      std::vector<size_t>* glyph_pages = nullptr);
 
  private:
   std::optional<GlyphProperties> GetGlyphProperties() const;
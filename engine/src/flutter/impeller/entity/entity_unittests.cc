@@ -2243,6 +2243,50 @@ TEST_P(EntityTest, ContentContextOptionsHasReasonableHashFunctions) {
   EXPECT_NE(hash_c, hash_d);
 }
 
+TEST_P(EntityTest, ContentContextOptionsCanBeRecoveredFromKeys) {
+  ContentContextOptions opts;
+  opts.blend_mode = BlendMode::kColorBurn;
+  opts.primitive_type = PrimitiveType::kTriangleStrip;
+  opts.stencil_mode =
+      ContentContextOptions::StencilMode::kOverdrawPreventionRestore;
+  opts.sample_count = SampleCount::kCount4;
+  opts.color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt;
+  opts.depth_write_enabled = true;
+
+  std::optional<ContentContextOptions> restored =
+      ContentContextOptions::FromKey(opts.ToKey());
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_EQ(restored->ToKey(), opts.ToKey());
+
+  // The unused bit, and enum values out of range.
+  EXPECT_FALSE(ContentContextOptions::FromKey(opts.ToKey() | 2llu));
+  EXPECT_FALSE(ContentContextOptions::FromKey(opts.ToKey() | 0xFFllu << 40));
+  EXPECT_FALSE(ContentContextOptions::FromKey(opts.ToKey() | 1llu << 56));
+}
+
+TEST_P(EntityTest, ContentContextPrewarmsRecordedPipelineVariants) {
+  auto content_context = GetContentContext();
+  ContentContextOptions opts;
+  opts.blend_mode = BlendMode::kPlus;
+  opts.color_attachment_pixel_format =
+      GetContext()->GetCapabilities()->GetDefaultColorFormat();
+  ASSERT_TRUE(content_context->GetSolidFillPipeline(opts));
+
+  std::vector<PipelineUsageProfile::Entry> entries =
+      content_context->GetPipelineUsageProfile()->GetEntries();
+  EXPECT_TRUE(std::any_of(entries.begin(), entries.end(),
+                          [&](const PipelineUsageProfile::Entry& entry) {
+                            return entry.variant_key == opts.ToKey();
+                          }));
+
+  ContentContext next_launch(GetContext(), GetTypographerContext());
+  ASSERT_TRUE(next_launch.IsValid());
+  EXPECT_EQ(next_launch.PrewarmPipelines(entries), entries.size());
+  EXPECT_EQ(next_launch.PrewarmPipelines(
+                {{.pipeline_id = 1, .variant_key = opts.ToKey()}}),
+            0u);
+}
+
 #ifdef FML_OS_LINUX
 TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
   // Using framebuffer fetch on Vulkan requires that we maintain a subpass input
@@ -2663,6 +2707,78 @@ TEST_P(EntityTest, RoundSuperellipseGetPositionBufferFlushes) {
   EXPECT_TRUE(device_buffer->flush_called());
 }
 
+TEST_P(EntityTest, PathTessellationCacheReusesVerticesAcrossFrames) {
+  RenderTarget target;
+  testing::MockRenderPass mock_pass(GetContext(), target);
+  auto content_context = GetContentContext();
+  PathTessellationCache& cache = content_context->GetPathTessellationCache();
+
+  flutter::DlPath path =
+      flutter::DlPathBuilder{}.AddCircle(Point(50, 50), 40).TakePath();
+  auto fill = Geometry::MakeFillPath(path);
+  auto stroke = Geometry::MakeStrokePath(path, {.width = 5.0f});
+
+  Entity entity;
+  entity.SetTransform(Matrix::MakeScale({2.1, 2.1, 1.0}));
+
+  // The first draw only records the paths.
+  cache.MarkFrameStart();
+  auto fill_result =
+      fill->GetPositionBuffer(*content_context, entity, mock_pass);
+  auto stroke_result =
+      stroke->GetPositionBuffer(*content_context, entity, mock_pass);
+  cache.MarkFrameEnd();
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 2u);
+  EXPECT_EQ(cache.GetByteSizeForTesting(), 0u);
+
+  // The second draw caches the vertices, at a translation and a slightly
+  // different scale of the same bucket.
+  cache.MarkFrameStart();
+  entity.SetTransform(Matrix::MakeTranslation({10, 20}) *
+                      Matrix::MakeScale({2.2, 2.2, 1.0}));
+  auto cached_fill_result =
+      fill->GetPositionBuffer(*content_context, entity, mock_pass);
+  auto cached_stroke_result =
+      stroke->GetPositionBuffer(*content_context, entity, mock_pass);
+  cache.MarkFrameEnd();
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 2u);
+  size_t cached_bytes = cache.GetByteSizeForTesting();
+  EXPECT_GT(cached_bytes, 0u);
+  EXPECT_EQ(cached_fill_result.type, fill_result.type);
+  EXPECT_EQ(cached_fill_result.mode, fill_result.mode);
+  EXPECT_GE(cached_fill_result.vertex_buffer.vertex_count,
+            fill_result.vertex_buffer.vertex_count);
+  EXPECT_EQ(cached_stroke_result.mode, stroke_result.mode);
+  EXPECT_GE(cached_stroke_result.vertex_buffer.vertex_count,
+            stroke_result.vertex_buffer.vertex_count);
+
+  // Later draws re-use the cached vertices.
+  cache.MarkFrameStart();
+  auto reused_fill_result =
+      fill->GetPositionBuffer(*content_context, entity, mock_pass);
+  cache.MarkFrameEnd();
+  EXPECT_EQ(reused_fill_result.vertex_buffer.vertex_count,
+            cached_fill_result.vertex_buffer.vertex_count);
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 1u);
+  EXPECT_LT(cache.GetByteSizeForTesting(), cached_bytes);
+
+  // Entries that are not drawn in a frame are removed.
+  cache.MarkFrameStart();
+  cache.MarkFrameEnd();
+  EXPECT_EQ(cache.GetCacheSizeForTesting(), 0u);
+  EXPECT_EQ(cache.GetByteSizeForTesting(), 0u);
+}
+
+TEST(PathTessellationCacheTest, QuantizeScaleRoundsUp) {
+  EXPECT_EQ(PathTessellationCache::QuantizeScale(1.0f), 1.0f);
+  EXPECT_EQ(PathTessellationCache::QuantizeScale(2.0f), 2.0f);
+  EXPECT_EQ(PathTessellationCache::QuantizeScale(0.5f), 0.5f);
+  Scalar bucket = PathTessellationCache::QuantizeScale(1.1f);
+  EXPECT_GE(bucket, 1.1f);
+  EXPECT_EQ(PathTessellationCache::QuantizeScale(1.15f), bucket);
+  EXPECT_EQ(PathTessellationCache::QuantizeScale(0.0f), 0.0f);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
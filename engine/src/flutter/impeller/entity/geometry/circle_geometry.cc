@@ -37,21 +37,34 @@ Scalar CircleGeometry::ComputeAlphaCoverage(const Matrix& transform) const {
   return Geometry::ComputeStrokeAlphaCoverage(transform, stroke_width_);
 }
 
-GeometryResult CircleGeometry::GetPositionBuffer(const ContentContext& renderer,
-                                                 const Entity& entity,
-                                                 RenderPass& pass) const {
-  auto& transform = entity.GetTransform();
-
+Tessellator::EllipticalVertexGenerator CircleGeometry::MakeGenerator(
+    const Matrix& transform,
+    Tessellator& tessellator) const {
   Scalar half_width = stroke_width_ < 0 ? 0.0
                                         : LineGeometry::ComputePixelHalfWidth(
                                               transform, stroke_width_);
 
   // We call the StrokedCircle method which will simplify to a
   // FilledCircleGenerator if the inner_radius is <= 0.
-  auto generator = renderer.GetTessellator().StrokedCircle(transform, center_,
-                                                           radius_, half_width);
+  return tessellator.StrokedCircle(transform, center_, radius_, half_width);
+}
 
-  return ComputePositionGeometry(renderer, generator, entity, pass);
+GeometryResult CircleGeometry::GetPositionBuffer(const ContentContext& renderer,
+                                                 const Entity& entity,
+                                                 RenderPass& pass) const {
+  return ComputePositionGeometry(
+      renderer, MakeGenerator(entity.GetTransform(), renderer.GetTessellator()),
+      entity, pass);
+}
+
+bool CircleGeometry::AppendTriangleStrip(const Matrix& transform,
+                                         Tessellator& tessellator,
+                                         std::vector<Point>& vertices) const {
+  if (ComputeAlphaCoverage(transform) < 1.0f) {
+    return false;
+  }
+  return AppendGeneratedTriangleStrip(MakeGenerator(transform, tessellator),
+                                      vertices);
 }
 
 std::optional<Rect> CircleGeometry::GetCoverage(const Matrix& transform) const {
@@ -30,6 +30,11 @@ class CircleGeometry final : public Geometry {
   // |Geometry|
   Scalar ComputeAlphaCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool AppendTriangleStrip(const Matrix& transform,
+                           Tessellator& tessellator,
+                           std::vector<Point>& vertices) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -39,6 +44,10 @@ class CircleGeometry final : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  Tessellator::EllipticalVertexGenerator MakeGenerator(
+      const Matrix& transform,
+      Tessellator& tessellator) const;
+
   Point center_;
   Scalar radius_;
   Scalar stroke_width_;
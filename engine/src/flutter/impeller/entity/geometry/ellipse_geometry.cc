@@ -22,6 +22,13 @@ GeometryResult EllipseGeometry::GetPositionBuffer(
       entity, pass);
 }
 
+bool EllipseGeometry::AppendTriangleStrip(const Matrix& transform,
+                                          Tessellator& tessellator,
+                                          std::vector<Point>& vertices) const {
+  return AppendGeneratedTriangleStrip(
+      tessellator.FilledEllipse(transform, bounds_), vertices);
+}
+
 std::optional<Rect> EllipseGeometry::GetCoverage(
     const Matrix& transform) const {
   return bounds_.TransformBounds(transform);
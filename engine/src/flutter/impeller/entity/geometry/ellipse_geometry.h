@@ -30,6 +30,11 @@ class EllipseGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  bool AppendTriangleStrip(const Matrix& transform,
+                           Tessellator& tessellator,
+                           std::vector<Point>& vertices) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
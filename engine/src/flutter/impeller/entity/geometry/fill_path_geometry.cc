@@ -9,6 +9,7 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -43,19 +44,39 @@ GeometryResult FillPathSourceGeometry::GetPositionBuffer(
   bool supports_triangle_fan =
       renderer.GetDeviceCapabilities().SupportsTriangleFan() &&
       supports_primitive_restart;
-  VertexBuffer vertex_buffer = renderer.GetTessellator().TessellateConvex(
-      GetSource(), data_host_buffer, indexes_host_buffer,
-      entity.GetTransform().GetMaxBasisLengthXY(),
-      /*supports_primitive_restart=*/supports_primitive_restart,
-      /*supports_triangle_fan=*/supports_triangle_fan);
-
-  return GeometryResult{
+  GeometryResult result{
       .type = supports_triangle_fan ? PrimitiveType::kTriangleFan
                                     : PrimitiveType::kTriangleStrip,
-      .vertex_buffer = std::move(vertex_buffer),
       .transform = entity.GetShaderTransform(pass),
       .mode = GetResultMode(),
   };
+
+  if (const flutter::DlPath* path = GetCacheablePath()) {
+    auto key = PathTessellationCache::Key::MakeFill(
+        *path,
+        PathTessellationCache::QuantizeScale(
+            entity.GetTransform().GetMaxBasisLengthXY()),
+        supports_primitive_restart, supports_triangle_fan);
+    std::optional<VertexBuffer> cached =
+        renderer.GetPathTessellationCache().Lookup(
+            key, *path, data_host_buffer, indexes_host_buffer,
+            [&](std::vector<Point>& points, std::vector<uint16_t>& indices) {
+              return Tessellator::TessellateConvexToVectors(
+                  GetSource(), points, indices, key.scale,
+                  supports_primitive_restart, supports_triangle_fan);
+            });
+    if (cached.has_value()) {
+      result.vertex_buffer = std::move(cached.value());
+      return result;
+    }
+  }
+
+  result.vertex_buffer = renderer.GetTessellator().TessellateConvex(
+      GetSource(), data_host_buffer, indexes_host_buffer,
+      entity.GetTransform().GetMaxBasisLengthXY(),
+      /*supports_primitive_restart=*/supports_primitive_restart,
+      /*supports_triangle_fan=*/supports_triangle_fan);
+  return result;
 }
 
 GeometryResult::Mode FillPathSourceGeometry::GetResultMode() const {
@@ -100,6 +121,10 @@ const PathSource& FillPathGeometry::GetSource() const {
   return path_;
 }
 
+const flutter::DlPath* FillPathGeometry::GetCacheablePath() const {
+  return &path_;
+}
+
 FillDiffRoundRectGeometry::FillDiffRoundRectGeometry(const RoundRect& outer,
                                                      const RoundRect& inner)
     : FillPathSourceGeometry(std::nullopt), source_(outer, inner) {}
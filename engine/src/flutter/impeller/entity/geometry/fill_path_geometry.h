@@ -30,6 +30,10 @@ class FillPathSourceGeometry : public Geometry {
   /// vertices.
   virtual const PathSource& GetSource() const = 0;
 
+  /// The path whose tessellation can be kept in the |PathTessellationCache|,
+  /// or nullptr if the source is not a |DlPath|.
+  virtual const flutter::DlPath* GetCacheablePath() const { return nullptr; }
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -60,6 +64,8 @@ class FillPathGeometry final : public FillPathSourceGeometry {
  protected:
   const PathSource& GetSource() const override;
 
+  const flutter::DlPath* GetCacheablePath() const override;
+
  private:
   const flutter::DlPath path_;
 };
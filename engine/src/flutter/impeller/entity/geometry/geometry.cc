@@ -29,6 +29,8 @@ GeometryResult Geometry::ComputePositionGeometry(
     const Entity& entity,
     RenderPass& pass) {
   using VT = SolidFillVertexShader::PerVertexData;
+  // The generator writes the vertices as consecutive Points.
+  static_assert(sizeof(VT) == sizeof(Point));
 
   size_t count = generator.GetVertexCount();
 
@@ -39,14 +41,9 @@ GeometryResult Geometry::ComputePositionGeometry(
               .vertex_buffer = renderer.GetTransientsDataBuffer().Emplace(
                   count * sizeof(VT), alignof(VT),
                   [&generator](uint8_t* buffer) {
-                    auto vertices = reinterpret_cast<VT*>(buffer);
-                    generator.GenerateVertices([&vertices](const Point& p) {
-                      *vertices++ = {
-                          .position = p,
-                      };
-                    });
-                    FML_DCHECK(vertices == reinterpret_cast<VT*>(buffer) +
-                                               generator.GetVertexCount());
+                    [[maybe_unused]] size_t written = generator.WriteVertices(
+                        reinterpret_cast<Point*>(buffer));
+                    FML_DCHECK(written == generator.GetVertexCount());
                   }),
               .vertex_count = count,
               .index_type = IndexType::kNone,
@@ -145,6 +142,25 @@ bool Geometry::CanApplyMaskFilter() const {
   return true;
 }
 
+bool Geometry::AppendTriangleStrip(const Matrix& transform,
+                                   Tessellator& tessellator,
+                                   std::vector<Point>& vertices) const {
+  return false;
+}
+
+bool Geometry::AppendGeneratedTriangleStrip(
+    const Tessellator::VertexGenerator& generator,
+    std::vector<Point>& vertices) {
+  if (generator.GetTriangleType() != PrimitiveType::kTriangleStrip) {
+    return false;
+  }
+  size_t offset = vertices.size();
+  vertices.resize(offset + generator.GetVertexCount());
+  size_t written = generator.WriteVertices(vertices.data() + offset);
+  vertices.resize(offset + written);
+  return true;
+}
+
 // static
 Scalar Geometry::ComputeStrokeAlphaCoverage(const Matrix& transform,
                                             Scalar stroke_width) {
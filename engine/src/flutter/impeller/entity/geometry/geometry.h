@@ -126,11 +126,30 @@ class Geometry {
     return 1.0;
   }
 
+  /// @brief    Appends the vertices of this geometry, as a triangle strip in
+  ///           the local coordinate space, to `vertices`.
+  ///
+  ///           This allows consecutive draws of simple shapes to be merged
+  ///           into a single draw call.
+  ///
+  /// @returns  `false`, leaving `vertices` unchanged, if the geometry cannot
+  ///           be drawn as a single triangle strip with full alpha coverage
+  ///           under the given `transform`.
+  virtual bool AppendTriangleStrip(const Matrix& transform,
+                                   Tessellator& tessellator,
+                                   std::vector<Point>& vertices) const;
+
   static GeometryResult ComputePositionGeometry(
       const ContentContext& renderer,
       const Tessellator::VertexGenerator& generator,
       const Entity& entity,
       RenderPass& pass);
+
+  /// @brief  Appends the vertices of a generator that produces a triangle
+  ///         strip to `vertices`, see |AppendTriangleStrip|.
+  static bool AppendGeneratedTriangleStrip(
+      const Tessellator::VertexGenerator& generator,
+      std::vector<Point>& vertices);
 };
 
 }  // namespace impeller
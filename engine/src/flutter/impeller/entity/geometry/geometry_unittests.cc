@@ -1346,5 +1346,47 @@ TEST(EntityGeometryTest, RotatedStrokedCircleGeometryCoverage) {
       << "  circle bounds: " << circle_bounds;
 }
 
+TEST(EntityGeometryTest, AppendTriangleStripForFilledShapes) {
+  Tessellator tessellator;
+  std::vector<Point> vertices;
+
+  auto rect = Geometry::MakeRect(Rect::MakeLTRB(10, 20, 30, 40));
+  EXPECT_TRUE(rect->AppendTriangleStrip({}, tessellator, vertices));
+  ASSERT_EQ(vertices.size(), 4u);
+  EXPECT_POINT_NEAR(vertices[0], Point(10, 20));
+  EXPECT_POINT_NEAR(vertices[3], Point(30, 40));
+
+  Point center = Point(50, 50);
+  auto circle = Geometry::MakeCircle(center, 50);
+  size_t circle_start = vertices.size();
+  EXPECT_TRUE(circle->AppendTriangleStrip({}, tessellator, vertices));
+  EXPECT_GT(vertices.size(), circle_start);
+  for (size_t i = circle_start; i < vertices.size(); i++) {
+    EXPECT_LE(vertices[i].GetDistance(center), 50.0f + kEhCloseEnough);
+  }
+
+  auto round_rect =
+      Geometry::MakeRoundRect(Rect::MakeLTRB(0, 0, 100, 60), Size(10, 10));
+  size_t round_rect_start = vertices.size();
+  EXPECT_TRUE(round_rect->AppendTriangleStrip({}, tessellator, vertices));
+  EXPECT_GT(vertices.size(), round_rect_start);
+}
+
+TEST(EntityGeometryTest, AppendTriangleStripRejectsPartialCoverage) {
+  Tessellator tessellator;
+  std::vector<Point> vertices;
+
+  // A sub-pixel stroke is drawn with a reduced alpha coverage which a merged
+  // solid color draw could not apply.
+  auto thin_circle = Geometry::MakeStrokedCircle(Point(50, 50), 50, 0.25);
+  EXPECT_FALSE(thin_circle->AppendTriangleStrip({}, tessellator, vertices));
+  EXPECT_TRUE(vertices.empty());
+
+  auto path = Geometry::MakeFillPath(
+      flutter::DlPath::MakeCircle(flutter::DlPoint(50, 50), 50));
+  EXPECT_FALSE(path->AppendTriangleStrip({}, tessellator, vertices));
+  EXPECT_TRUE(vertices.empty());
+}
+
 }  // namespace testing
 }  // namespace impeller
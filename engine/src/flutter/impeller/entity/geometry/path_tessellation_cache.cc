@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/path_tessellation_cache.h"
+
+#include <cmath>
+
+namespace impeller {
+
+PathTessellationCache::Key PathTessellationCache::Key::MakeFill(
+    const flutter::DlPath& path,
+    Scalar scale,
+    bool supports_primitive_restart,
+    bool supports_triangle_fan) {
+  return Key{
+      .path_identifier = path.GetSharedDataIdentifier(),
+      .scale = scale,
+      .is_stroke = false,
+      .supports_primitive_restart = supports_primitive_restart,
+      .supports_triangle_fan = supports_triangle_fan,
+      .stroke = {},
+  };
+}
+
+PathTessellationCache::Key PathTessellationCache::Key::MakeStroke(
+    const flutter::DlPath& path,
+    Scalar scale,
+    const StrokeParameters& stroke) {
+  return Key{
+      .path_identifier = path.GetSharedDataIdentifier(),
+      .scale = scale,
+      .is_stroke = true,
+      .supports_primitive_restart = false,
+      .supports_triangle_fan = false,
+      .stroke = stroke,
+  };
+}
+
+Scalar PathTessellationCache::QuantizeScale(Scalar scale) {
+  if (!(scale > 0.0f) || !std::isfinite(scale)) {
+    return scale;
+  }
+  Scalar bucket = std::ceil(std::log2(scale) * kScaleBucketsPerOctave);
+  return std::exp2(bucket / kScaleBucketsPerOctave);
+}
+
+void PathTessellationCache::MarkFrameStart() {
+  for (auto& entry : entries_) {
+    entry.second.used_this_frame = false;
+  }
+}
+
+void PathTessellationCache::MarkFrameEnd() {
+  absl::erase_if(entries_, [this](const auto& pair) {
+    if (pair.second.used_this_frame) {
+      return false;
+    }
+    byte_size_ -= pair.second.GetByteSize();
+    return true;
+  });
+}
+
+std::optional<VertexBuffer> PathTessellationCache::Lookup(
+    const Key& key,
+    const flutter::DlPath& path,
+    HostBuffer& data_host_buffer,
+    HostBuffer& indexes_host_buffer,
+    const TessellateProc& tessellate) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    // Only remember that the path was seen, it is cached if it is drawn again.
+    entries_.emplace(key, Entry{.path = path});
+    return std::nullopt;
+  }
+
+  Entry& entry = it->second;
+  entry.used_this_frame = true;
+  if (entry.has_vertices) {
+    return EmplaceEntry(entry, data_host_buffer, indexes_host_buffer);
+  }
+
+  entry.vertex_count = tessellate(entry.points, entry.indices);
+  VertexBuffer vertex_buffer =
+      EmplaceEntry(entry, data_host_buffer, indexes_host_buffer);
+  size_t byte_size = entry.GetByteSize();
+  if (byte_size_ + byte_size > byte_budget_) {
+    // Try again when the entry is drawn in a later frame, when other entries
+    // may have been removed.
+    entry.points = {};
+    entry.indices = {};
+    return vertex_buffer;
+  }
+  entry.has_vertices = true;
+  byte_size_ += byte_size;
+  return vertex_buffer;
+}
+
+VertexBuffer PathTessellationCache::EmplaceEntry(
+    const Entry& entry,
+    HostBuffer& data_host_buffer,
+    HostBuffer& indexes_host_buffer) {
+  if (entry.vertex_count == 0u || entry.points.empty()) {
+    return VertexBuffer{
+        .vertex_buffer = {},
+        .index_buffer = {},
+        .vertex_count = 0u,
+        .index_type = entry.indices.empty() ? IndexType::kNone
+                                            : IndexType::k16bit,
+    };
+  }
+
+  BufferView vertex_buffer = data_host_buffer.Emplace(
+      entry.points.data(), entry.points.size() * sizeof(Point),
+      alignof(Point));
+  if (entry.indices.empty()) {
+    return VertexBuffer{
+        .vertex_buffer = std::move(vertex_buffer),
+        .vertex_count = entry.vertex_count,
+        .index_type = IndexType::kNone,
+    };
+  }
+
+  BufferView index_buffer = indexes_host_buffer.Emplace(
+      entry.indices.data(), entry.indices.size() * sizeof(uint16_t),
+      alignof(uint16_t));
+  return VertexBuffer{
+      .vertex_buffer = std::move(vertex_buffer),
+      .index_buffer = std::move(index_buffer),
+      .vertex_count = entry.vertex_count,
+      .index_type = IndexType::k16bit,
+  };
+}
+
+}  // namespace impeller
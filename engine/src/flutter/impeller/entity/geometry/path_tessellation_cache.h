@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_PATH_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_PATH_TESSELLATION_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/third_party/abseil-cpp/absl/container/flat_hash_map.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/stroke_parameters.h"
+
+namespace impeller {
+
+/// @brief A cache for the tessellated vertices of fill and stroke paths that
+///        re-uses them across frames.
+///
+/// The vertices of a path are computed in the coordinate space of the path,
+/// so the same vertices can be drawn with any transform that has a similar
+/// scale. Entries are keyed by the identity of the |DlPath| data, which is
+/// shared by all copies of the path, along with the stroke parameters and the
+/// transform scale rounded up to a bucket of |QuantizeScale|.
+///
+/// A path is only cached the second time it is drawn, so that paths that are
+/// created anew every frame don't pay for the copy into the cache. Entries
+/// that are not used in a frame are removed at the end of the frame, and the
+/// total size of the cached vertices is limited to the byte budget.
+///
+/// This object is not thread safe, and must only be used from the raster
+/// thread.
+class PathTessellationCache {
+ public:
+  /// The default limit on the size of the cached vertices and indices.
+  static constexpr size_t kDefaultByteBudget = 4u * 1024u * 1024u;
+
+  /// The number of scale buckets per doubling of the transform scale.
+  static constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+  /// @brief A callback that tessellates a path at the scale of a key into
+  ///        the given vectors and returns the vertex count to draw.
+  ///
+  /// The index vector is left empty for non-indexed geometry.
+  using TessellateProc =
+      std::function<size_t(std::vector<Point>& points,
+                           std::vector<uint16_t>& indices)>;
+
+  /// @brief A key to look up cached tessellations.
+  struct Key {
+    const void* path_identifier;
+    Scalar scale;
+    bool is_stroke;
+    bool supports_primitive_restart;
+    bool supports_triangle_fan;
+    StrokeParameters stroke;
+
+    /// A key for the interior of |path|, tessellated for |TessellateConvex|
+    /// with the given device capabilities.
+    static Key MakeFill(const flutter::DlPath& path,
+                        Scalar scale,
+                        bool supports_primitive_restart,
+                        bool supports_triangle_fan);
+
+    /// A key for the outline of |path| as stroked with |stroke|.
+    static Key MakeStroke(const flutter::DlPath& path,
+                          Scalar scale,
+                          const StrokeParameters& stroke);
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        return fml::HashCombine(
+            key.path_identifier, key.scale, key.is_stroke,
+            key.supports_primitive_restart, key.supports_triangle_fan,
+            key.stroke.width, key.stroke.cap, key.stroke.join,
+            key.stroke.miter_limit);
+      }
+    };
+
+    struct Equal {
+      constexpr bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.path_identifier == rhs.path_identifier &&
+               lhs.scale == rhs.scale && lhs.is_stroke == rhs.is_stroke &&
+               lhs.supports_primitive_restart ==
+                   rhs.supports_primitive_restart &&
+               lhs.supports_triangle_fan == rhs.supports_triangle_fan &&
+               lhs.stroke == rhs.stroke;
+      }
+    };
+  };
+
+  PathTessellationCache() = default;
+
+  ~PathTessellationCache() = default;
+
+  /// @brief Round |scale| up to the nearest scale bucket.
+  ///
+  /// Tessellating at the rounded up scale never produces fewer subdivisions
+  /// than the original scale would, so the result can be drawn at any scale
+  /// of the bucket.
+  static Scalar QuantizeScale(Scalar scale);
+
+  /// @brief Mark all entries as unused this frame.
+  void MarkFrameStart();
+
+  /// @brief Remove all entries that were not used at least once this frame.
+  void MarkFrameEnd();
+
+  /// @brief Limit the total size of the cached vertices and indices.
+  void SetByteBudget(size_t byte_budget) { byte_budget_ = byte_budget; }
+
+  /// @brief Emplace the cached tessellation of |key| into the host buffers,
+  ///        tessellating it with |tessellate| if it should be cached now.
+  ///
+  /// Returns std::nullopt if the path is not cached, in which case the caller
+  /// tessellates the path directly into the host buffers as usual.
+  std::optional<VertexBuffer> Lookup(const Key& key,
+                                     const flutter::DlPath& path,
+                                     HostBuffer& data_host_buffer,
+                                     HostBuffer& indexes_host_buffer,
+                                     const TessellateProc& tessellate);
+
+  // Visible for testing.
+  size_t GetCacheSizeForTesting() const { return entries_.size(); }
+
+  // Visible for testing.
+  size_t GetByteSizeForTesting() const { return byte_size_; }
+
+ private:
+  PathTessellationCache(const PathTessellationCache&) = delete;
+
+  PathTessellationCache& operator=(const PathTessellationCache&) = delete;
+
+  struct Entry {
+    // Keeps the path data, and hence the identifier in the key, alive.
+    flutter::DlPath path;
+    bool used_this_frame = true;
+    bool has_vertices = false;
+    std::vector<Point> points;
+    std::vector<uint16_t> indices;
+    size_t vertex_count = 0u;
+
+    size_t GetByteSize() const {
+      return points.size() * sizeof(Point) +
+             indices.size() * sizeof(uint16_t);
+    }
+  };
+
+  static VertexBuffer EmplaceEntry(const Entry& entry,
+                                   HostBuffer& data_host_buffer,
+                                   HostBuffer& indexes_host_buffer);
+
+  size_t byte_budget_ = kDefaultByteBudget;
+  size_t byte_size_ = 0u;
+  absl::flat_hash_map<Key, Entry, Key::Hash, Key::Equal> entries_;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_PATH_TESSELLATION_CACHE_H_
@@ -49,12 +49,10 @@ GeometryResult PointFieldGeometry::GetPositionBuffer(
         renderer.GetTessellator().FilledCircle(transform, {}, radius);
     FML_DCHECK(generator.GetTriangleType() == PrimitiveType::kTriangleStrip);
 
-    std::vector<Point> circle_vertices;
-    circle_vertices.reserve(generator.GetVertexCount());
-    generator.GenerateVertices([&circle_vertices](const Point& p) {  //
-      circle_vertices.push_back(p);
-    });
-    FML_DCHECK(circle_vertices.size() == generator.GetVertexCount());
+    std::vector<Point> circle_vertices(generator.GetVertexCount());
+    [[maybe_unused]] size_t written =
+        generator.WriteVertices(circle_vertices.data());
+    FML_DCHECK(written == circle_vertices.size());
 
     vertex_count = (circle_vertices.size() + 2) * point_count_ - 2;
     buffer_view = data_host_buffer.Emplace(
@@ -47,6 +47,15 @@ bool FillRectGeometry::IsAxisAlignedRect() const {
   return true;
 }
 
+bool FillRectGeometry::AppendTriangleStrip(const Matrix& transform,
+                                           Tessellator& tessellator,
+                                           std::vector<Point>& vertices) const {
+  for (const Point& point : rect_.GetPoints()) {
+    vertices.push_back(point);
+  }
+  return true;
+}
+
 StrokeRectGeometry::StrokeRectGeometry(const Rect& rect,
                                        const StrokeParameters& stroke)
     : rect_(rect),
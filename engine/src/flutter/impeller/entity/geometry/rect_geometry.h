@@ -22,6 +22,11 @@ class FillRectGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  bool AppendTriangleStrip(const Matrix& transform,
+                           Tessellator& tessellator,
+                           std::vector<Point>& vertices) const override;
+
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
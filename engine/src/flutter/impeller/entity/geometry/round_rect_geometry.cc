@@ -21,6 +21,14 @@ GeometryResult RoundRectGeometry::GetPositionBuffer(
                                  entity, pass);
 }
 
+bool RoundRectGeometry::AppendTriangleStrip(
+    const Matrix& transform,
+    Tessellator& tessellator,
+    std::vector<Point>& vertices) const {
+  return AppendGeneratedTriangleStrip(
+      tessellator.FilledRoundRect(transform, bounds_, radii_), vertices);
+}
+
 std::optional<Rect> RoundRectGeometry::GetCoverage(
     const Matrix& transform) const {
   return bounds_.TransformBounds(transform);
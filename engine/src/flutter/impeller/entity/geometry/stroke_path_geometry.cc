@@ -8,6 +8,7 @@
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/pipelines.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/constants.h"
@@ -757,6 +758,39 @@ GeometryResult StrokeSegmentsGeometry::GetPositionBuffer(
   auto scale = entity.GetTransform().GetMaxBasisLengthXY();
   auto& tessellator = renderer.GetTessellator();
 
+  if (const flutter::DlPath* path = GetCacheablePath()) {
+    auto key = PathTessellationCache::Key::MakeStroke(
+        *path, PathTessellationCache::QuantizeScale(scale), adjusted_stroke);
+    std::optional<VertexBuffer> cached =
+        renderer.GetPathTessellationCache().Lookup(
+            key, *path, data_host_buffer,
+            renderer.GetTransientsIndexesBuffer(),
+            [&](std::vector<Point>& points, std::vector<uint16_t>& indices) {
+              PositionWriter position_writer(tessellator.GetStrokePointCache());
+              StrokePathSegmentReceiver receiver(tessellator, position_writer,
+                                                 adjusted_stroke, key.scale);
+              Dispatch(receiver, tessellator, key.scale);
+
+              const auto [arena_length, oversized_length] =
+                  position_writer.GetUsedSize();
+              const std::vector<Point>& arena =
+                  tessellator.GetStrokePointCache();
+              const std::vector<Point>& oversized_data =
+                  position_writer.GetOversizedBuffer();
+              points.assign(arena.begin(), arena.begin() + arena_length);
+              points.insert(points.end(), oversized_data.begin(),
+                            oversized_data.end());
+              indices.clear();
+              return arena_length + oversized_length;
+            });
+    if (cached.has_value()) {
+      return GeometryResult{.type = PrimitiveType::kTriangleStrip,
+                            .vertex_buffer = std::move(cached.value()),
+                            .transform = entity.GetShaderTransform(pass),
+                            .mode = GeometryResult::Mode::kPreventOverdraw};
+    }
+  }
+
   PositionWriter position_writer(tessellator.GetStrokePointCache());
   StrokePathSegmentReceiver receiver(tessellator, position_writer,
                                      adjusted_stroke, scale);
@@ -859,6 +893,10 @@ const PathSource& StrokePathGeometry::GetSource() const {
   return path_;
 }
 
+const flutter::DlPath* StrokePathGeometry::GetCacheablePath() const {
+  return &path_;
+}
+
 ArcStrokeGeometry::ArcStrokeGeometry(const Arc& arc,
                                      const StrokeParameters& parameters)
     : StrokeSegmentsGeometry(parameters), arc_(arc) {}
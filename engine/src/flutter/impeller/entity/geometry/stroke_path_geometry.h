@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_STROKE_PATH_GEOMETRY_H_
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_STROKE_PATH_GEOMETRY_H_
 
+#include "flutter/display_list/geometry/dl_path.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/dashed_line_path_source.h"
 #include "impeller/geometry/matrix.h"
@@ -60,6 +61,11 @@ class StrokeSegmentsGeometry : public Geometry {
   std::optional<Rect> GetStrokeCoverage(const Matrix& transform,
                                         const Rect& segment_bounds) const;
 
+  /// The path whose stroked tessellation can be kept in the
+  /// |PathTessellationCache|, or nullptr if the segments do not come from a
+  /// |DlPath|.
+  virtual const flutter::DlPath* GetCacheablePath() const { return nullptr; }
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -121,6 +127,9 @@ class StrokePathGeometry final : public StrokePathSourceGeometry {
   // |StrokePathSourceGeometry|
   const PathSource& GetSource() const override;
 
+  // |StrokeSegmentsGeometry|
+  const flutter::DlPath* GetCacheablePath() const override;
+
  private:
   const flutter::DlPath path_;
 };
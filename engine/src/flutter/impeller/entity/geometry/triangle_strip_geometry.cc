@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/triangle_strip_geometry.h"
+
+namespace impeller {
+
+TriangleStripGeometry::TriangleStripGeometry(const std::vector<Point>& vertices,
+                                             Rect coverage)
+    : vertices_(vertices), coverage_(coverage) {}
+
+GeometryResult TriangleStripGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  auto& data_host_buffer = renderer.GetTransientsDataBuffer();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          {
+              .vertex_buffer = data_host_buffer.Emplace(
+                  vertices_.data(), vertices_.size() * sizeof(Point),
+                  alignof(Point)),
+              .vertex_count = vertices_.size(),
+              .index_type = IndexType::kNone,
+          },
+      .transform = entity.GetShaderTransform(pass),
+      .mode = GeometryResult::Mode::kNormal,
+  };
+}
+
+std::optional<Rect> TriangleStripGeometry::GetCoverage(
+    const Matrix& transform) const {
+  return coverage_.TransformBounds(transform);
+}
+
+}  // namespace impeller
@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_TRIANGLE_STRIP_GEOMETRY_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_TRIANGLE_STRIP_GEOMETRY_H_
+
+#include <vector>
+
+#include "impeller/entity/geometry/geometry.h"
+
+namespace impeller {
+
+/// @brief A geometry for vertices that were already tessellated into a
+///        triangle strip, such as the shapes of consecutive draws that are
+///        merged into a single draw call.
+///
+/// The vertices are not copied and must outlive the geometry.
+class TriangleStripGeometry final : public Geometry {
+ public:
+  TriangleStripGeometry(const std::vector<Point>& vertices, Rect coverage);
+
+  ~TriangleStripGeometry() override = default;
+
+ private:
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const override;
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override;
+
+  const std::vector<Point>& vertices_;
+  const Rect coverage_;
+
+  TriangleStripGeometry(const TriangleStripGeometry&) = delete;
+
+  TriangleStripGeometry& operator=(const TriangleStripGeometry&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_TRIANGLE_STRIP_GEOMETRY_H_
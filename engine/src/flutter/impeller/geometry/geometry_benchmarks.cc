@@ -85,6 +85,92 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+enum class GeneratorShape {
+  kFilledCircle,
+  kFilledRoundRect,
+  kStrokedArc,
+};
+
+static size_t EmitVertices(const Tessellator::VertexGenerator& generator,
+                           bool write_vertices,
+                           std::vector<Point>& vertices) {
+  vertices.resize(generator.GetVertexCount());
+  if (write_vertices) {
+    return generator.WriteVertices(vertices.data());
+  }
+  Point* next = vertices.data();
+  generator.GenerateVertices([&next](const Point& p) { *next++ = p; });
+  return next - vertices.data();
+}
+
+/// Tessellates a scatter plot of small shapes, delivering the vertices either
+/// through the |TessellatedVertexProc| callback or with |WriteVertices|.
+static void BM_VertexGenerator(benchmark::State& state,
+                               GeneratorShape shape,
+                               bool write_vertices) {
+  Tessellator tessellator;
+  const Matrix transform = Matrix::MakeScale({2.0f, 2.0f, 1.0f});
+  const Scalar radius = 6.0f;
+  const int shape_count = 1000;
+
+  std::vector<Point> vertices;
+  size_t point_count = 0u;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < shape_count; i++) {
+      Point center((i % 40) * 16.0f, (i / 40) * 16.0f);
+      switch (shape) {
+        case GeneratorShape::kFilledCircle:
+          point_count += EmitVertices(
+              tessellator.FilledCircle(transform, center, radius),
+              write_vertices, vertices);
+          break;
+        case GeneratorShape::kFilledRoundRect:
+          point_count += EmitVertices(
+              tessellator.FilledRoundRect(
+                  transform, Rect::MakeOriginSize(center, {14.0f, 10.0f}),
+                  {3.0f, 3.0f}),
+              write_vertices, vertices);
+          break;
+        case GeneratorShape::kStrokedArc:
+          point_count += EmitVertices(
+              tessellator.StrokedArc(
+                  transform,
+                  Arc(Rect::MakeOriginSize(center, {12.0f, 12.0f}),
+                      Degrees(15), Degrees(270), false),
+                  Cap::kButt, 1.5f),
+              write_vertices, vertices);
+          break;
+      }
+    }
+  }
+  state.counters["TotalPointCount"] = point_count;
+}
+
+BENCHMARK_CAPTURE(BM_VertexGenerator,
+                  filled_circle_callback,
+                  GeneratorShape::kFilledCircle,
+                  false);
+BENCHMARK_CAPTURE(BM_VertexGenerator,
+                  filled_circle_write,
+                  GeneratorShape::kFilledCircle,
+                  true);
+BENCHMARK_CAPTURE(BM_VertexGenerator,
+                  filled_round_rect_callback,
+                  GeneratorShape::kFilledRoundRect,
+                  false);
+BENCHMARK_CAPTURE(BM_VertexGenerator,
+                  filled_round_rect_write,
+                  GeneratorShape::kFilledRoundRect,
+                  true);
+BENCHMARK_CAPTURE(BM_VertexGenerator,
+                  stroked_arc_callback,
+                  GeneratorShape::kStrokedArc,
+                  false);
+BENCHMARK_CAPTURE(BM_VertexGenerator,
+                  stroked_arc_write,
+                  GeneratorShape::kStrokedArc,
+                  true);
+
 #define MAKE_STROKE_PATH_BENCHMARK_CAPTURE(path, cap, join, closed) \
   BENCHMARK_CAPTURE(BM_StrokePath, stroke_##path##_##cap##_##join,  \
                     Create##path(closed), Cap::k##cap, Join::k##join)
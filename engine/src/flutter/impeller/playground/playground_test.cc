@@ -67,6 +67,16 @@ void PlaygroundTest::SetUp() {
 
   switches.flags.antialiased_lines =
       test_name.find("ExperimentAntialiasLines/") != std::string::npos;
+  // Test names that end with "MultiPageGlyphAtlas" will use glyph atlases
+  // made up of up to 4 pages.
+  if (test_name.find("MultiPageGlyphAtlas/") != std::string::npos) {
+    switches.flags.glyph_atlas_max_pages = 4u;
+  }
+  // Test names that end with "SmallGlyphAtlas" will use glyph atlases of at
+  // most 8 MiB.
+  if (test_name.find("SmallGlyphAtlas/") != std::string::npos) {
+    switches.flags.glyph_atlas_max_bytes = 4096u * 2048u;
+  }
 
   SetupContext(GetParam(), switches);
   SetupWindow();
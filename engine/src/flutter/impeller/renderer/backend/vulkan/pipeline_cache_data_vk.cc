@@ -4,6 +4,9 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 
+#include <cstring>
+#include <vector>
+
 #include "flutter/fml/file.h"
 #include "impeller/base/allocation.h"
 #include "impeller/base/validation.h"
@@ -13,6 +16,9 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+static constexpr const char* kPipelineUsageProfileFileName =
+    "flutter.impeller.vkusage";
+
 bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
                               const VkPhysicalDeviceProperties& props,
                               const vk::UniquePipelineCache& cache) {
@@ -98,6 +104,52 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
       on_disk_header.data_size, [on_disk_data](auto, auto) {});
 }
 
+bool PipelineUsageProfileDataPersist(const fml::UniqueFD& cache_directory,
+                                     const VkPhysicalDeviceProperties& props,
+                                     const fml::Mapping& profile_data) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  const auto header = PipelineCacheHeaderVK{props, profile_data.GetSize()};
+  std::vector<uint8_t> data(sizeof(header) + profile_data.GetSize());
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + sizeof(header), profile_data.GetMapping(),
+              profile_data.GetSize());
+
+  if (!fml::WriteAtomically(cache_directory, kPipelineUsageProfileFileName,
+                            fml::DataMapping(std::move(data)))) {
+    VALIDATION_LOG << "Could not write pipeline usage profile to disk.";
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageProfileDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  std::shared_ptr<fml::FileMapping> on_disk_data =
+      fml::FileMapping::CreateReadOnly(cache_directory,
+                                       kPipelineUsageProfileFileName);
+  if (!on_disk_data ||
+      on_disk_data->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+  auto on_disk_header = PipelineCacheHeaderVK{};
+  std::memcpy(&on_disk_header, on_disk_data->GetMapping(),
+              sizeof(on_disk_header));
+  if (!on_disk_header.IsCompatibleWith(PipelineCacheHeaderVK{props, 0u}) ||
+      on_disk_header.data_size !=
+          on_disk_data->GetSize() - sizeof(on_disk_header)) {
+    return nullptr;
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      on_disk_data->GetMapping() + sizeof(on_disk_header),
+      on_disk_header.data_size, [on_disk_data](auto, auto) {});
+}
+
 PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
 
 PipelineCacheHeaderVK::PipelineCacheHeaderVK(
@@ -104,6 +104,35 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
     const fml::UniqueFD& cache_directory,
     const VkPhysicalDeviceProperties& props);
 
+//------------------------------------------------------------------------------
+/// @brief      Persist a serialized pipeline usage profile to a file in the
+///             given cache directory, with the same header as the pipeline
+///             cache so that the profile is discarded along with the cache
+///             when the device or driver changes.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  props            The physical device properties
+/// @param[in]  profile_data     The data from `PipelineUsageProfile::Serialize`
+///
+/// @return     If the profile could be persisted to disk.
+///
+bool PipelineUsageProfileDataPersist(const fml::UniqueFD& cache_directory,
+                                     const VkPhysicalDeviceProperties& props,
+                                     const fml::Mapping& profile_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Retrieve the previously persisted pipeline usage profile data,
+///             if it was persisted for a compatible device and driver.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  props            The properties
+///
+/// @return     The profile data, stripped of its header.
+///
+std::unique_ptr<fml::Mapping> PipelineUsageProfileDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props);
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
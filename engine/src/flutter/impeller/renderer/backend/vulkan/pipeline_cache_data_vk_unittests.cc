@@ -11,6 +11,7 @@
 #include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/pipeline_usage_profile.h"
 
 namespace impeller::testing {
 
@@ -111,6 +112,30 @@ TEST(PipelineCacheDataVKTest, WritesIncompleteCacheData) {
   ASSERT_EQ(mapping->GetSize(), sizeof(header) + header.data_size);
 }
 
+TEST(PipelineCacheDataVKTest, CanPersistAndRetrieveUsageProfile) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto context = MockVulkanContextBuilder().Build();
+  const auto& caps = CapabilitiesVK::Cast(*context->GetCapabilities());
+
+  PipelineUsageProfile profile;
+  profile.Record({.pipeline_id = 1, .variant_key = 2});
+  ASSERT_TRUE(PipelineUsageProfileDataPersist(
+      temp_dir.fd(), caps.GetPhysicalDeviceProperties(), *profile.Serialize()));
+
+  std::unique_ptr<fml::Mapping> data = PipelineUsageProfileDataRetrieve(
+      temp_dir.fd(), caps.GetPhysicalDeviceProperties());
+  ASSERT_TRUE(data);
+  std::shared_ptr<PipelineUsageProfile> restored =
+      PipelineUsageProfile::MakeFromData(*data);
+  ASSERT_TRUE(restored);
+  EXPECT_EQ(restored->GetEntries(), profile.GetEntries());
+
+  // Profiles from other devices or drivers are ignored.
+  VkPhysicalDeviceProperties other_props = caps.GetPhysicalDeviceProperties();
+  other_props.driverVersion++;
+  EXPECT_FALSE(PipelineUsageProfileDataRetrieve(temp_dir.fd(), other_props));
+}
+
 using PipelineCacheDataVKPlaygroundTest = PlaygroundTest;
 INSTANTIATE_VULKAN_PLAYGROUND_SUITE(PipelineCacheDataVKPlaygroundTest);
 
@@ -60,6 +60,22 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
   }
 
   is_valid_ = !!cache_;
+
+  if (cache_directory_.is_valid()) {
+    auto existing_profile_data = PipelineUsageProfileDataRetrieve(
+        cache_directory_, vk_caps.GetPhysicalDeviceProperties());
+    if (existing_profile_data) {
+      usage_profile_ =
+          PipelineUsageProfile::MakeFromData(*existing_profile_data);
+      if (!usage_profile_) {
+        FML_LOG(INFO) << "Existing pipeline usage profile was invalid. "
+                         "Starting with an empty profile.";
+      }
+    }
+    if (!usage_profile_) {
+      usage_profile_ = std::make_shared<PipelineUsageProfile>();
+    }
+  }
 }
 
 PipelineCacheVK::~PipelineCacheVK() {
@@ -120,10 +136,21 @@ void PipelineCacheVK::PersistCacheToDisk() {
                            vk_caps.GetPhysicalDeviceProperties(),  //
                            cache_                                  //
   );
+  if (usage_profile_ && usage_profile_->IsDirty()) {
+    PipelineUsageProfileDataPersist(cache_directory_,                       //
+                                    vk_caps.GetPhysicalDeviceProperties(),  //
+                                    *usage_profile_->Serialize()            //
+    );
+  }
 }
 
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
 
+const std::shared_ptr<PipelineUsageProfile>& PipelineCacheVK::GetUsageProfile()
+    const {
+  return usage_profile_;
+}
+
 }  // namespace impeller
@@ -9,6 +9,7 @@
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/pipeline_usage_profile.h"
 
 namespace impeller {
 
@@ -32,6 +33,16 @@ class PipelineCacheVK {
 
   const CapabilitiesVK* GetCapabilities() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The pipeline usage profile that is persisted alongside the
+  ///             cache. It starts out with the entries persisted by previous
+  ///             launches, if they are compatible with the current device.
+  ///
+  /// @return     The profile, or nullptr if there is no cache directory to
+  ///             persist it to.
+  ///
+  const std::shared_ptr<PipelineUsageProfile>& GetUsageProfile() const;
+
   void PersistCacheToDisk();
 
  private:
@@ -39,6 +50,7 @@ class PipelineCacheVK {
   std::weak_ptr<DeviceHolderVK> device_holder_;
   const fml::UniqueFD cache_directory_;
   vk::UniquePipelineCache cache_;
+  std::shared_ptr<PipelineUsageProfile> usage_profile_;
   bool is_valid_ = false;
   Mutex persist_mutex_;
 
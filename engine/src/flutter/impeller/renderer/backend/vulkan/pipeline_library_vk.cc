@@ -274,6 +274,12 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
   });
 }
 
+// |PipelineLibrary|
+std::shared_ptr<PipelineUsageProfile> PipelineLibraryVK::GetUsageProfile()
+    const {
+  return pso_cache_->GetUsageProfile();
+}
+
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   if (++frames_acquired_ == 50u) {
     if (cache_dirty_) {
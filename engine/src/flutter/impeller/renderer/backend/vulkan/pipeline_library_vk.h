@@ -76,6 +76,9 @@ class PipelineLibraryVK final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
+  // |PipelineLibrary|
+  std::shared_ptr<PipelineUsageProfile> GetUsageProfile() const override;
+
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc,
       PipelineKey pipeline_key);
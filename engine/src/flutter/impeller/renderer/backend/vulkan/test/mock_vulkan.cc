@@ -4,8 +4,10 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -49,6 +51,9 @@ struct MockFramebuffer {};
 
 static ISize currentImageSize = ISize{1, 1};
 
+// Pipelines are created on worker threads, so this isn't thread local.
+static std::atomic<int64_t> pipelineCreationDelayMicros = 0;
+
 class MockDevice final {
  public:
   explicit MockDevice() : called_functions_(new std::vector<std::string>()) {}
@@ -394,6 +399,10 @@ VkResult vkCreateGraphicsPipelines(
     VkPipeline* pPipelines) {
   MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
   mock_device->AddCalledFunction("vkCreateGraphicsPipelines");
+  int64_t delay_micros = pipelineCreationDelayMicros.load();
+  if (delay_micros > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(delay_micros));
+  }
   *pPipelines = reinterpret_cast<VkPipeline>(0x99999999);
   return VK_SUCCESS;
 }
@@ -1012,6 +1021,10 @@ void SetSwapchainImageSize(ISize size) {
   currentImageSize = size;
 }
 
+void SetPipelineCreationDelay(fml::TimeDelta delay) {
+  pipelineCreationDelayMicros = delay.ToMicroseconds();
+}
+
 std::vector<VkImageMemoryBarrier>& GetImageMemoryBarriers(
     VkCommandBuffer buffer) {
   MockCommandBuffer* mock_command_buffer =
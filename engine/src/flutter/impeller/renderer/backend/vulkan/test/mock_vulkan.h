@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "vulkan/vulkan_core.h"
@@ -131,6 +132,10 @@ class MockVulkanContextBuilder {
 /// @brief Override the image size returned by all swapchain images.
 void SetSwapchainImageSize(ISize size);
 
+/// @brief Make every call to vkCreateGraphicsPipelines take at least the given
+///        time, to stand in for the shader compilation done by real drivers.
+void SetPipelineCreationDelay(fml::TimeDelta delay);
+
 std::vector<VkImageMemoryBarrier>& GetImageMemoryBarriers(
     VkCommandBuffer buffer);
 
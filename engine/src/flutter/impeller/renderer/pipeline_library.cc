@@ -10,6 +10,11 @@ PipelineLibrary::PipelineLibrary() = default;
 
 PipelineLibrary::~PipelineLibrary() = default;
 
+std::shared_ptr<PipelineUsageProfile> PipelineLibrary::GetUsageProfile()
+    const {
+  return nullptr;
+}
+
 PipelineFuture<PipelineDescriptor> PipelineLibrary::GetPipeline(
     std::optional<PipelineDescriptor> descriptor,
     bool async) {
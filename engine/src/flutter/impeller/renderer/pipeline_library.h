@@ -11,6 +11,7 @@
 #include "compute_pipeline_descriptor.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_usage_profile.h"
 
 namespace impeller {
 
@@ -74,6 +75,19 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The profile of pipeline variants used by renderers, which is
+  ///             persisted alongside the pipeline cache of backends that have
+  ///             one.
+  ///
+  ///             When the library is created, this holds the variants used
+  ///             by previous launches of the application, which renderers
+  ///             may prepare ahead of time.
+  ///
+  /// @return     The profile, or nullptr if the backend doesn't persist one.
+  ///
+  virtual std::shared_ptr<PipelineUsageProfile> GetUsageProfile() const;
+
  protected:
   PipelineLibrary();
 
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/pipeline_usage_profile.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace impeller {
+
+namespace {
+
+struct ProfileHeader {
+  // Changing the layout of the data requires changing the magic number, so
+  // that data in the old layout is ignored.
+  uint32_t magic = 0x50555031;  // PUP1
+  uint32_t reserved = 0;
+  uint64_t entry_count = 0;
+};
+
+}  // namespace
+
+PipelineUsageProfile::PipelineUsageProfile() = default;
+
+PipelineUsageProfile::~PipelineUsageProfile() = default;
+
+std::shared_ptr<PipelineUsageProfile> PipelineUsageProfile::MakeFromData(
+    const fml::Mapping& data) {
+  ProfileHeader header;
+  if (data.GetSize() < sizeof(header)) {
+    return nullptr;
+  }
+  std::memcpy(&header, data.GetMapping(), sizeof(header));
+  if (header.magic != ProfileHeader{}.magic ||
+      header.entry_count > kMaxEntries ||
+      data.GetSize() != sizeof(header) + header.entry_count * sizeof(Entry)) {
+    return nullptr;
+  }
+
+  auto profile = std::make_shared<PipelineUsageProfile>();
+  Lock lock(profile->mutex_);
+  profile->entries_.resize(header.entry_count);
+  std::memcpy(profile->entries_.data(), data.GetMapping() + sizeof(header),
+              header.entry_count * sizeof(Entry));
+  return profile;
+}
+
+bool PipelineUsageProfile::Record(const Entry& entry) {
+  Lock lock(mutex_);
+  if (entries_.size() >= kMaxEntries ||
+      std::find(entries_.begin(), entries_.end(), entry) != entries_.end()) {
+    return false;
+  }
+  entries_.push_back(entry);
+  is_dirty_ = true;
+  return true;
+}
+
+std::vector<PipelineUsageProfile::Entry> PipelineUsageProfile::GetEntries()
+    const {
+  Lock lock(mutex_);
+  return entries_;
+}
+
+bool PipelineUsageProfile::IsDirty() const {
+  Lock lock(mutex_);
+  return is_dirty_;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageProfile::Serialize() {
+  Lock lock(mutex_);
+  ProfileHeader header;
+  header.entry_count = entries_.size();
+  std::vector<uint8_t> data(sizeof(header) + entries_.size() * sizeof(Entry));
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + sizeof(header), entries_.data(),
+              entries_.size() * sizeof(Entry));
+  is_dirty_ = false;
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+}  // namespace impeller
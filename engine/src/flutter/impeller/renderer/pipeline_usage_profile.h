@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_PROFILE_H_
+#define FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_PROFILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A record of the pipeline variants that were created while
+///             rendering, so that the next launch of the application can
+///             prepare the same variants before the first frame needs them.
+///
+///             The profile doesn't know what its entries mean. Renderers
+///             choose the identifiers they record, and must tolerate entries
+///             they no longer recognize, since profiles outlive the versions
+///             of the engine that wrote them.
+///
+///             The profile is safe to use from multiple threads.
+///
+class PipelineUsageProfile {
+ public:
+  struct Entry {
+    /// Identifies the family of pipelines the variant belongs to.
+    uint64_t pipeline_id = 0;
+    /// Identifies the variant within its family.
+    uint64_t variant_key = 0;
+
+    constexpr bool operator==(const Entry& other) const {
+      return pipeline_id == other.pipeline_id &&
+             variant_key == other.variant_key;
+    }
+  };
+
+  /// The maximum number of entries in a profile. Once reached, further entries
+  /// are not recorded.
+  static constexpr size_t kMaxEntries = 4096u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an empty profile.
+  ///
+  PipelineUsageProfile();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a profile from data previously returned by
+  ///             `Serialize`.
+  ///
+  /// @return     The profile, or nullptr if the data is malformed.
+  ///
+  static std::shared_ptr<PipelineUsageProfile> MakeFromData(
+      const fml::Mapping& data);
+
+  ~PipelineUsageProfile();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that a variant was used. Recording an entry that is
+  ///             already in the profile does nothing.
+  ///
+  /// @return     Whether the entry was added.
+  ///
+  bool Record(const Entry& entry);
+
+  //----------------------------------------------------------------------------
+  /// @return     All entries, in the order they were first recorded.
+  ///
+  std::vector<Entry> GetEntries() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     Whether entries were added since the profile was created or
+  ///             last serialized.
+  ///
+  bool IsDirty() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes the profile so that it can be persisted, and
+  ///             clears the dirty flag.
+  ///
+  std::unique_ptr<fml::Mapping> Serialize();
+
+ private:
+  mutable Mutex mutex_;
+  std::vector<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  bool is_dirty_ IPLR_GUARDED_BY(mutex_) = false;
+
+  PipelineUsageProfile(const PipelineUsageProfile&) = delete;
+
+  PipelineUsageProfile& operator=(const PipelineUsageProfile&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_PROFILE_H_
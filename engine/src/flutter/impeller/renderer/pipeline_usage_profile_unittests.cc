@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/pipeline_usage_profile.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineUsageProfileTest, RecordsEachEntryOnce) {
+  PipelineUsageProfile profile;
+  EXPECT_FALSE(profile.IsDirty());
+
+  EXPECT_TRUE(profile.Record({.pipeline_id = 1, .variant_key = 2}));
+  EXPECT_TRUE(profile.Record({.pipeline_id = 1, .variant_key = 3}));
+  EXPECT_FALSE(profile.Record({.pipeline_id = 1, .variant_key = 2}));
+  EXPECT_TRUE(profile.IsDirty());
+
+  std::vector<PipelineUsageProfile::Entry> expected = {
+      {.pipeline_id = 1, .variant_key = 2},
+      {.pipeline_id = 1, .variant_key = 3},
+  };
+  EXPECT_EQ(profile.GetEntries(), expected);
+}
+
+TEST(PipelineUsageProfileTest, RoundTripsThroughSerialization) {
+  PipelineUsageProfile profile;
+  profile.Record({.pipeline_id = 0xABCDEF0123456789, .variant_key = 7});
+  profile.Record({.pipeline_id = 42, .variant_key = 0xFFFFFFFFFFFFFFFF});
+
+  std::unique_ptr<fml::Mapping> data = profile.Serialize();
+  ASSERT_TRUE(data);
+  EXPECT_FALSE(profile.IsDirty());
+
+  std::shared_ptr<PipelineUsageProfile> restored =
+      PipelineUsageProfile::MakeFromData(*data);
+  ASSERT_TRUE(restored);
+  EXPECT_EQ(restored->GetEntries(), profile.GetEntries());
+  EXPECT_FALSE(restored->IsDirty());
+}
+
+TEST(PipelineUsageProfileTest, RejectsMalformedData) {
+  PipelineUsageProfile profile;
+  profile.Record({.pipeline_id = 1, .variant_key = 2});
+  std::unique_ptr<fml::Mapping> data = profile.Serialize();
+  ASSERT_TRUE(data);
+
+  fml::NonOwnedMapping truncated(data->GetMapping(), data->GetSize() - 1);
+  EXPECT_EQ(PipelineUsageProfile::MakeFromData(truncated), nullptr);
+
+  std::vector<uint8_t> bad_magic(data->GetMapping(),
+                                 data->GetMapping() + data->GetSize());
+  bad_magic[0] ^= 0xFF;
+  EXPECT_EQ(PipelineUsageProfile::MakeFromData(fml::DataMapping(bad_magic)),
+            nullptr);
+
+  EXPECT_EQ(PipelineUsageProfile::MakeFromData(fml::DataMapping("")),
+            nullptr);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -142,6 +142,8 @@ class MockImpellerContext : public Context {
  public:
   MockImpellerContext() : Context(Flags{}) {}
 
+  explicit MockImpellerContext(const Flags& flags) : Context(flags) {}
+
   MOCK_METHOD(Context::BackendType, GetBackendType, (), (const, override));
 
   MOCK_METHOD(std::string, DescribeGpuModel, (), (const, override));
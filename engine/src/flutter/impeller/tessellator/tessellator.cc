@@ -409,6 +409,42 @@ void Tessellator::TessellateConvexInternal(const PathSource& path,
   PathTessellator::PathToFilledVertices(path, writer, tolerance);
 }
 
+size_t Tessellator::TessellateConvexToVectors(
+    const PathSource& path,
+    std::vector<Point>& point_buffer,
+    std::vector<uint16_t>& index_buffer,
+    Scalar tolerance,
+    bool supports_primitive_restart,
+    bool supports_triangle_fan) {
+  if (!supports_primitive_restart) {
+    TessellateConvexInternal(path, point_buffer, index_buffer, tolerance);
+    return index_buffer.size();
+  }
+
+  const auto [point_count, contour_count] =
+      PathTessellator::CountFillStorage(path, tolerance);
+  point_buffer.resize(point_count);
+  index_buffer.resize(point_count + contour_count);
+  size_t used_points;
+  size_t used_indices;
+  if (supports_triangle_fan) {
+    FanPathVertexWriter writer(point_buffer.data(), index_buffer.data());
+    PathTessellator::PathToFilledVertices(path, writer, tolerance);
+    used_points = writer.GetPointCount();
+    used_indices = writer.GetIndexCount();
+  } else {
+    StripPathVertexWriter writer(point_buffer.data(), index_buffer.data());
+    PathTessellator::PathToFilledVertices(path, writer, tolerance);
+    used_points = writer.GetPointCount();
+    used_indices = writer.GetIndexCount();
+  }
+  FML_DCHECK(used_points <= point_count);
+  FML_DCHECK(used_indices <= (point_count + contour_count));
+  point_buffer.resize(used_points);
+  index_buffer.resize(used_indices);
+  return used_indices;
+}
+
 Tessellator::Trigs::Trigs(Scalar pixel_radius)
     : Tessellator::Trigs(ComputeQuadrantDivisions(pixel_radius)) {}
 
@@ -439,13 +475,21 @@ using TessellatedVertexProc = Tessellator::TessellatedVertexProc;
 using EllipticalVertexGenerator = Tessellator::EllipticalVertexGenerator;
 using ArcVertexGenerator = Tessellator::ArcVertexGenerator;
 
+size_t Tessellator::VertexGenerator::WriteVertices(Point* vertices) const {
+  Point* next = vertices;
+  GenerateVertices([&next](const Point& p) { *next++ = p; });
+  return next - vertices;
+}
+
 EllipticalVertexGenerator::EllipticalVertexGenerator(
     EllipticalVertexGenerator::GeneratorProc& generator,
+    WriterProc& writer,
     Trigs&& trigs,
     PrimitiveType triangle_type,
     size_t vertices_per_trig,
     Data&& data)
     : impl_(generator),
+      writer_impl_(writer),
       trigs_(std::move(trigs)),
       data_(data),
       vertices_per_trig_(vertices_per_trig) {}
@@ -456,14 +500,16 @@ EllipticalVertexGenerator Tessellator::FilledCircle(
     Scalar radius) {
   size_t divisions =
       ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledCircle,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = {radius, radius},
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      Tessellator::GenerateFilledCircle<const TessellatedVertexProc>,
+      Tessellator::WriteEllipticalVertices<
+          Tessellator::GenerateFilledCircle<PointWriter>>,
+      GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = {radius, radius},
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::StrokedCircle(
@@ -474,14 +520,16 @@ EllipticalVertexGenerator Tessellator::StrokedCircle(
   if (half_width > 0) {
     auto divisions = ComputeQuadrantDivisions(
         view_transform.GetMaxBasisLengthXY() * radius + half_width);
-    return EllipticalVertexGenerator(Tessellator::GenerateStrokedCircle,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 8,
-                                     {
-                                         .reference_centers = {center, center},
-                                         .radii = {radius, radius},
-                                         .half_width = half_width,
-                                     });
+    return EllipticalVertexGenerator(
+        Tessellator::GenerateStrokedCircle<const TessellatedVertexProc>,
+        Tessellator::WriteEllipticalVertices<
+            Tessellator::GenerateStrokedCircle<PointWriter>>,
+        GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 8,
+        {
+            .reference_centers = {center, center},
+            .radii = {radius, radius},
+            .half_width = half_width,
+        });
   } else {
     return FilledCircle(view_transform, center, radius);
   }
@@ -541,6 +589,17 @@ size_t ArcVertexGenerator::GetVertexCount() const {
 
 void ArcVertexGenerator::GenerateVertices(
     const TessellatedVertexProc& proc) const {
+  Generate(proc);
+}
+
+size_t ArcVertexGenerator::WriteVertices(Point* vertices) const {
+  PointWriter writer(vertices);
+  Generate(writer);
+  return writer.next() - vertices;
+}
+
+template <typename VertexProc>
+void ArcVertexGenerator::Generate(VertexProc& proc) const {
   if (half_width_ > 0) {
     FML_DCHECK(!use_center_);
     Tessellator::GenerateStrokedArc(trigs_, iteration_, oval_bounds_,
@@ -591,14 +650,16 @@ EllipticalVertexGenerator Tessellator::RoundCapLine(
   if (length > kEhCloseEnough) {
     auto divisions =
         ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-    return EllipticalVertexGenerator(Tessellator::GenerateRoundCapLine,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers = {p0, p1},
-                                         .radii = {radius, radius},
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        Tessellator::GenerateRoundCapLine<const TessellatedVertexProc>,
+        Tessellator::WriteEllipticalVertices<
+            Tessellator::GenerateRoundCapLine<PointWriter>>,
+        GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers = {p0, p1},
+            .radii = {radius, radius},
+            .half_width = -1.0f,
+        });
   } else {
     return FilledCircle(view_transform, p0, radius);
   }
@@ -615,14 +676,16 @@ EllipticalVertexGenerator Tessellator::FilledEllipse(
   auto divisions = ComputeQuadrantDivisions(
       view_transform.GetMaxBasisLengthXY() * max_radius);
   auto center = bounds.GetCenter();
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledEllipse,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = bounds.GetSize() * 0.5f,
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      Tessellator::GenerateFilledEllipse<const TessellatedVertexProc>,
+      Tessellator::WriteEllipticalVertices<
+          Tessellator::GenerateFilledEllipse<PointWriter>>,
+      GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = bounds.GetSize() * 0.5f,
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::FilledRoundRect(
@@ -636,27 +699,30 @@ EllipticalVertexGenerator Tessellator::FilledRoundRect(
         view_transform.GetMaxBasisLengthXY() * max_radius);
     auto upper_left = bounds.GetLeftTop() + radii;
     auto lower_right = bounds.GetRightBottom() - radii;
-    return EllipticalVertexGenerator(Tessellator::GenerateFilledRoundRect,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers =
-                                             {
-                                                 upper_left,
-                                                 lower_right,
-                                             },
-                                         .radii = radii,
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        Tessellator::GenerateFilledRoundRect<const TessellatedVertexProc>,
+        Tessellator::WriteEllipticalVertices<
+            Tessellator::GenerateFilledRoundRect<PointWriter>>,
+        GetTrigsForDivisions(divisions), PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers =
+                {
+                    upper_left,
+                    lower_right,
+                },
+            .radii = radii,
+            .half_width = -1.0f,
+        });
   } else {
     return FilledEllipse(view_transform, bounds);
   }
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateFilledCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexProc& proc) {
   auto center = data.reference_centers[0];
   auto radius = data.radii.width;
 
@@ -683,10 +749,11 @@ void Tessellator::GenerateFilledCircle(
   }
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateStrokedCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexProc& proc) {
   auto center = data.reference_centers[0];
 
   FML_DCHECK(center == data.reference_centers[1]);
@@ -738,11 +805,12 @@ void Tessellator::GenerateStrokedCircle(
   }
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateFilledArcFan(const Trigs& trigs,
                                        const Arc::Iteration& iteration,
                                        const Rect& oval_bounds,
                                        bool use_center,
-                                       const TessellatedVertexProc& proc) {
+                                       VertexProc& proc) {
   Point center = oval_bounds.GetCenter();
   Size radii = oval_bounds.GetSize() * 0.5f;
 
@@ -759,11 +827,12 @@ void Tessellator::GenerateFilledArcFan(const Trigs& trigs,
   proc(center + iteration.end * radii);
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateFilledArcStrip(const Trigs& trigs,
                                          const Arc::Iteration& iteration,
                                          const Rect& oval_bounds,
                                          bool use_center,
-                                         const TessellatedVertexProc& proc) {
+                                         VertexProc& proc) {
   Point center = oval_bounds.GetCenter();
   Size radii = oval_bounds.GetSize() * 0.5f;
 
@@ -794,12 +863,13 @@ void Tessellator::GenerateFilledArcStrip(const Trigs& trigs,
   proc(center + iteration.end * radii);
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateStrokedArc(const Trigs& trigs,
                                      const Arc::Iteration& iteration,
                                      const Rect& oval_bounds,
                                      Scalar half_width,
                                      Cap cap,
-                                     const TessellatedVertexProc& proc) {
+                                     VertexProc& proc) {
   Point center = oval_bounds.GetCenter();
   Size base_radii = oval_bounds.GetSize() * 0.5f;
   Size inner_radii = base_radii - Size(half_width, half_width);
@@ -830,10 +900,11 @@ void Tessellator::GenerateStrokedArc(const Trigs& trigs,
   }
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateRoundCapLine(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexProc& proc) {
   auto p0 = data.reference_centers[0];
   auto p1 = data.reference_centers[1];
   auto radius = data.radii.width;
@@ -863,10 +934,11 @@ void Tessellator::GenerateRoundCapLine(
   }
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateFilledEllipse(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexProc& proc) {
   auto center = data.reference_centers[0];
   auto radii = data.radii;
 
@@ -892,10 +964,11 @@ void Tessellator::GenerateFilledEllipse(
   }
 }
 
+template <typename VertexProc>
 void Tessellator::GenerateFilledRoundRect(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexProc& proc) {
   Scalar left = data.reference_centers[0].x;
   Scalar top = data.reference_centers[0].y;
   Scalar right = data.reference_centers[1].x;
@@ -133,6 +133,16 @@ class Tessellator {
     ///         order (as required by the PrimitiveType) to the given
     ///         callback function.
     virtual void GenerateVertices(const TessellatedVertexProc& proc) const = 0;
+
+    /// @brief  Write the vertices in the same order as |GenerateVertices|
+    ///         directly into the consecutive |Point|s at |vertices| and
+    ///         return the number of vertices written.
+    ///
+    ///         The caller must provide room for |GetVertexCount| vertices.
+    ///         The default implementation delivers the vertices through
+    ///         |GenerateVertices|, the generators in this file override it
+    ///         to avoid an indirect call per vertex.
+    virtual size_t WriteVertices(Point* vertices) const;
   };
 
   /// @brief  The |VertexGenerator| implementation common to all shapes
@@ -154,6 +164,11 @@ class Tessellator {
       impl_(trigs_, data_, proc);
     }
 
+    /// |VertexGenerator|
+    size_t WriteVertices(Point* vertices) const override {
+      return writer_impl_(trigs_, data_, vertices);
+    }
+
    private:
     friend class Tessellator;
 
@@ -174,12 +189,18 @@ class Tessellator {
                                const Data& data,
                                const TessellatedVertexProc& proc);
 
+    typedef size_t WriterProc(const Trigs& trigs,
+                              const Data& data,
+                              Point* vertices);
+
     GeneratorProc& impl_;
+    WriterProc& writer_impl_;
     const Trigs trigs_;
     const Data data_;
     const size_t vertices_per_trig_;
 
     EllipticalVertexGenerator(GeneratorProc& generator,
+                              WriterProc& writer,
                               Trigs&& trigs,
                               PrimitiveType triangle_type,
                               size_t vertices_per_trig,
@@ -199,9 +220,15 @@ class Tessellator {
     /// |VertexGenerator|
     void GenerateVertices(const TessellatedVertexProc& proc) const override;
 
+    /// |VertexGenerator|
+    size_t WriteVertices(Point* vertices) const override;
+
    private:
     friend class Tessellator;
 
+    template <typename VertexProc>
+    void Generate(VertexProc& proc) const;
+
     const Arc::Iteration iteration_;
     const Trigs trigs_;
     const Rect oval_bounds_;
@@ -255,6 +282,21 @@ class Tessellator {
                                        std::vector<uint16_t>& index_buffer,
                                        Scalar tolerance);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Given a convex path, create the same vertices and indices
+  ///             that |TessellateConvex| would create, but in the provided
+  ///             vectors instead of a host buffer so that they can be kept
+  ///             across frames.
+  ///
+  /// @return The number of indices to draw, which is the vertex count of the
+  ///         resulting |VertexBuffer|.
+  static size_t TessellateConvexToVectors(const PathSource& path,
+                                          std::vector<Point>& point_buffer,
+                                          std::vector<uint16_t>& index_buffer,
+                                          Scalar tolerance,
+                                          bool supports_primitive_restart,
+                                          bool supports_triangle_fan);
+
   //----------------------------------------------------------------------------
   /// @brief   The pixel tolerance used by the algorighm to determine how
   ///          many divisions to create for a circle.
@@ -391,45 +433,80 @@ class Tessellator {
 
   Trigs GetTrigsForDivisions(size_t divisions);
 
+  // Delivers vertices to consecutive |Point|s. The generators below are
+  // templates over the type of their vertex callback so that writing the
+  // vertices through this class is inlined into their loops.
+  class PointWriter {
+   public:
+    explicit PointWriter(Point* vertices) : next_(vertices) {}
+
+    void operator()(const Point& p) { *next_++ = p; }
+
+    Point* next() const { return next_; }
+
+   private:
+    Point* next_;
+  };
+
+  template <void (&Generate)(const Trigs& trigs,
+                             const EllipticalVertexGenerator::Data& data,
+                             PointWriter& proc)>
+  static size_t WriteEllipticalVertices(
+      const Trigs& trigs,
+      const EllipticalVertexGenerator::Data& data,
+      Point* vertices) {
+    PointWriter writer(vertices);
+    Generate(trigs, data, writer);
+    return writer.next() - vertices;
+  }
+
+  template <typename VertexProc>
   static void GenerateFilledCircle(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+                                   VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateStrokedCircle(const Trigs& trigs,
                                     const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+                                    VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateFilledArcFan(const Trigs& trigs,
                                    const Arc::Iteration& iteration,
                                    const Rect& oval_bounds,
                                    bool use_center,
-                                   const TessellatedVertexProc& proc);
+                                   VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateFilledArcStrip(const Trigs& trigs,
                                      const Arc::Iteration& iteration,
                                      const Rect& oval_bounds,
                                      bool use_center,
-                                     const TessellatedVertexProc& proc);
+                                     VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateStrokedArc(const Trigs& trigs,
                                  const Arc::Iteration& iteration,
                                  const Rect& oval_bounds,
                                  Scalar half_width,
                                  Cap cap,
-                                 const TessellatedVertexProc& proc);
+                                 VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateRoundCapLine(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+                                   VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateFilledEllipse(const Trigs& trigs,
                                     const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+                                    VertexProc& proc);
 
+  template <typename VertexProc>
   static void GenerateFilledRoundRect(
       const Trigs& trigs,
       const EllipticalVertexGenerator::Data& data,
-      const TessellatedVertexProc& proc);
+      VertexProc& proc);
 
   Tessellator(const Tessellator&) = delete;
 
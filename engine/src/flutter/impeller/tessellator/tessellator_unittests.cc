@@ -510,6 +510,34 @@ TEST(TessellatorTest, FilledRoundRectTessellationVertices) {
        Rect::MakeXYWH(5000, 10000, 2000, 3000), {50, 70});
 }
 
+TEST(TessellatorTest, WriteVerticesMatchesGenerateVertices) {
+  auto tessellator = std::make_shared<Tessellator>();
+
+  auto test = [](const Tessellator::VertexGenerator& generator) {
+    auto generated = std::vector<Point>();
+    generator.GenerateVertices([&generated](const Point& p) {  //
+      generated.push_back(p);
+    });
+    auto written = std::vector<Point>(generator.GetVertexCount());
+    EXPECT_EQ(generator.WriteVertices(written.data()), generated.size());
+    written.resize(generated.size());
+    EXPECT_EQ(written, generated);
+  };
+
+  Matrix transform = Matrix::MakeScale({3.0, 3.0, 1.0});
+  test(tessellator->FilledCircle(transform, {10, 20}, 15));
+  test(tessellator->StrokedCircle(transform, {10, 20}, 15, 2));
+  test(tessellator->RoundCapLine(transform, {10, 20}, {40, 50}, 5));
+  test(tessellator->FilledEllipse(transform, Rect::MakeXYWH(5, 10, 20, 30)));
+  test(tessellator->FilledRoundRect(transform, Rect::MakeXYWH(5, 10, 50, 60),
+                                    {4, 6}));
+
+  Arc arc(Rect::MakeXYWH(5, 10, 40, 40), Degrees(30), Degrees(200), false);
+  test(tessellator->FilledArc(transform, arc, true));
+  test(tessellator->FilledArc(transform, arc, false));
+  test(tessellator->StrokedArc(transform, arc, Cap::kSquare, 3));
+}
+
 TEST(TessellatorTest, EarlyReturnEmptyConvexShape) {
   // This path is not technically empty (it has a size in one dimension), but
   // it contains only move commands and no actual path segment definitions.
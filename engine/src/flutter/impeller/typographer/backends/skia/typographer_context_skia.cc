@@ -4,17 +4,24 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <numeric>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
 
+#include "impeller/base/flags.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
@@ -47,6 +54,27 @@ namespace impeller {
 
 constexpr auto kPadding = 2;
 
+/// The minimum number of new glyphs in a single atlas update before their
+/// rasterization is sharded across the worker task runner. Below this, the
+/// cost of dispatching and joining the shards outweighs the savings.
+static constexpr size_t kMinGlyphsForConcurrentRasterization = 64u;
+
+/// The minimum number of glyphs rasterized by a single shard.
+static constexpr size_t kMinGlyphsPerShard = 32u;
+
+/// The maximum number of shards a single atlas update is split into.
+static constexpr size_t kMaxRasterizationShards = 8u;
+
+// Because we can't grow the skyline packer horizontally, pick a reasonable
+// large width for all atlases.
+static constexpr int64_t kAtlasWidth = 4096;
+static constexpr int64_t kMinAtlasHeight = 1024;
+
+/// The number of atlas updates a glyph must have gone unused for before its
+/// space may be reclaimed. A value of 1 allows any glyph that is not needed by
+/// the current update to be evicted, least recently used first.
+static constexpr size_t kMinIdleGenerationsForEviction = 1u;
+
 namespace {
 SkPaint::Cap ToSkiaCap(Cap cap) {
   switch (cap) {
@@ -77,8 +105,18 @@ std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
   return std::make_shared<TypographerContextSkia>();
 }
 
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  return std::make_shared<TypographerContextSkia>(
+      std::move(worker_task_runner));
+}
+
 TypographerContextSkia::TypographerContextSkia() = default;
 
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : worker_task_runner_(std::move(worker_task_runner)) {}
+
 TypographerContextSkia::~TypographerContextSkia() = default;
 
 std::shared_ptr<GlyphAtlasContext>
@@ -97,8 +135,19 @@ static SkImageInfo GetImageInfo(const GlyphAtlas& atlas, Size size) {
   FML_UNREACHABLE();
 }
 
-/// Append as many glyphs to the texture as will fit, and return the first index
-/// of [extra_pairs] that did not fit.
+static PixelFormat GetGlyphAtlasFormat(const Context& context,
+                                       GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return context.GetCapabilities()->GetDefaultGlyphAtlasFormat();
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+/// Append as many glyphs starting at [start_index] to the texture as will fit,
+/// and return the first index of [extra_pairs] that did not fit.
 static size_t AppendToExistingAtlas(
     const std::shared_ptr<GlyphAtlas>& atlas,
     const std::vector<FontGlyphPair>& extra_pairs,
@@ -106,13 +155,14 @@ static size_t AppendToExistingAtlas(
     const std::vector<Rect>& glyph_sizes,
     ISize atlas_size,
     int64_t height_adjustment,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+    const std::shared_ptr<RectanglePacker>& rect_packer,
+    size_t start_index) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!rect_packer || atlas_size.IsEmpty()) {
-    return 0;
+    return start_index;
   }
 
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
+  for (size_t i = start_index; i < extra_pairs.size(); i++) {
     ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
     IPoint16 location_in_atlas;
     if (!rect_packer->AddRect(glyph_size.width + kPadding,   //
@@ -170,11 +220,6 @@ static ISize ComputeNextAtlasSize(
     const std::vector<Rect>& glyph_sizes,
     size_t glyph_index_start,
     int64_t max_texture_height) {
-  // Because we can't grow the skyline packer horizontally, pick a reasonable
-  // large width for all atlases.
-  static constexpr int64_t kAtlasWidth = 4096;
-  static constexpr int64_t kMinAtlasHeight = 1024;
-
   ISize current_size = ISize(kAtlasWidth, kMinAtlasHeight);
   if (atlas_context->GetAtlasSize().height > current_size.height) {
     current_size.height = atlas_context->GetAtlasSize().height * 2;
@@ -204,6 +249,128 @@ static ISize ComputeNextAtlasSize(
   return {};
 }
 
+/// Compute the maximum height of an atlas of the given type, taking both the
+/// device texture size limit and the configured atlas memory cap into account.
+static int64_t ComputeMaxAtlasHeight(const Context& context,
+                                     GlyphAtlas::Type type,
+                                     const Flags& flags) {
+  int64_t max_texture_height =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported().height;
+  if (flags.glyph_atlas_max_bytes == 0u) {
+    return max_texture_height;
+  }
+  int64_t bytes_per_row =
+      kAtlasWidth *
+      BytesPerPixelForPixelFormat(GetGlyphAtlasFormat(context, type));
+  int64_t max_height_for_bytes =
+      static_cast<int64_t>(flags.glyph_atlas_max_bytes) / bytes_per_row;
+  // Atlas heights are always the minimum height times a power of two.
+  int64_t max_height = kMinAtlasHeight;
+  while (max_height * 2 <= max_height_for_bytes) {
+    max_height *= 2;
+  }
+  return std::min(max_texture_height, max_height);
+}
+
+/// Place the glyphs starting at [start_index] into the pages of a multi-page
+/// atlas, opening new pages as needed while fewer than [max_pages] exist.
+///
+/// Pages that are opened are appended to [new_page_sizes]. Their rect packers
+/// are added to the atlas context, but the atlas itself is not modified.
+///
+/// Returns the first index of [pairs] that could not be placed.
+static size_t PackGlyphsIntoPages(
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    const std::vector<FontGlyphPair>& pairs,
+    const std::vector<Rect>& glyph_sizes,
+    std::vector<Rect>& glyph_positions,
+    std::vector<size_t>& glyph_pages,
+    std::vector<ISize>& new_page_sizes,
+    size_t start_index,
+    size_t max_pages,
+    int64_t max_page_height) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  for (size_t i = start_index; i < pairs.size(); i++) {
+    ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
+    IPoint16 location_in_page;
+    std::optional<size_t> glyph_page;
+    // Earlier pages are tried first, as smaller glyphs may still fit in their
+    // remaining gaps.
+    for (size_t page = 0u; page < atlas_context->GetPagePackerCount();
+         page++) {
+      if (atlas_context->GetPagePacker(page)->AddRect(
+              glyph_size.width + kPadding,   //
+              glyph_size.height + kPadding,  //
+              &location_in_page              //
+              )) {
+        glyph_page = page;
+        break;
+      }
+    }
+    if (!glyph_page.has_value()) {
+      if (atlas_context->GetPagePackerCount() >= max_pages) {
+        return i;
+      }
+      // Pages are usually the minimum atlas height, but are made taller for
+      // glyphs that would not fit otherwise.
+      int64_t page_height = kMinAtlasHeight;
+      while (page_height < glyph_size.height + kPadding &&
+             page_height * 2 <= max_page_height) {
+        page_height *= 2;
+      }
+      auto rect_packer = RectanglePacker::Factory(kAtlasWidth, page_height);
+      if (!rect_packer->AddRect(glyph_size.width + kPadding,   //
+                                glyph_size.height + kPadding,  //
+                                &location_in_page              //
+                                )) {
+        return i;
+      }
+      glyph_page = atlas_context->GetPagePackerCount();
+      atlas_context->AddPagePacker(std::move(rect_packer));
+      new_page_sizes.push_back(ISize(kAtlasWidth, page_height));
+    }
+    // Position the glyph in the center of the 1px padding.
+    glyph_positions.push_back(Rect::MakeXYWH(location_in_page.x() + 1,  //
+                                             location_in_page.y() + 1,  //
+                                             glyph_size.width,          //
+                                             glyph_size.height          //
+                                             ));
+    glyph_pages.push_back(glyph_page.value());
+  }
+  return pairs.size();
+}
+
+/// Undo the addition of [new_glyphs] to a multi-page atlas when the atlas
+/// cannot be updated. The glyphs are removed from [atlas], the space of those
+/// placed in existing pages by [PackGlyphsIntoPages] is returned to their rect
+/// packers, and the rect packers of the pages opened at or after
+/// [first_new_page] are removed, so the context keeps matching the atlas.
+static void RollBackNewGlyphs(
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    GlyphAtlas& atlas,
+    const std::vector<FontGlyphPair>& new_glyphs,
+    const std::vector<Rect>& glyph_positions,
+    const std::vector<size_t>& glyph_pages,
+    size_t first_new_page) {
+  for (const FontGlyphPair& pair : new_glyphs) {
+    atlas.RemoveTypefaceGlyph(pair);
+  }
+  for (size_t i = 0; i < glyph_positions.size(); i++) {
+    if (glyph_pages[i] >= first_new_page) {
+      continue;
+    }
+    // Glyphs are positioned in the center of their 1px padding.
+    IRect padded = IRect::RoundOut(glyph_positions[i]).Expand(1);
+    atlas_context->GetPagePacker(glyph_pages[i])
+        ->ReclaimRect(static_cast<int>(padded.GetX()),      //
+                      static_cast<int>(padded.GetY()),      //
+                      static_cast<int>(padded.GetWidth()),  //
+                      static_cast<int>(padded.GetHeight())  //
+        );
+  }
+  atlas_context->TruncatePagePackers(first_new_page);
+}
+
 static Point SubpixelPositionToPoint(SubpixelPosition pos) {
   return Point((pos & 0xff) / 4.f, (pos >> 2 & 0xff) / 4.f);
 }
@@ -259,52 +426,126 @@ static void DrawGlyph(SkCanvas* canvas,
   canvas->restore();
 }
 
+/// @brief Invoke |proc| over contiguous sub-ranges of the glyphs in
+///        [start_index, end_index).
+///
+/// If a worker task runner is available and the range is large enough, all
+/// but the first sub-range are processed on the workers while the calling
+/// thread processes the first one. This blocks until every sub-range has been
+/// processed.
+static void ForEachGlyphShard(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    size_t start_index,
+    size_t end_index,
+    const std::function<void(size_t shard_start, size_t shard_end)>& proc) {
+  size_t count = end_index - start_index;
+  if (!worker_task_runner || count < kMinGlyphsForConcurrentRasterization) {
+    proc(start_index, end_index);
+    return;
+  }
+
+  size_t shard_count =
+      std::min(kMaxRasterizationShards, count / kMinGlyphsPerShard);
+  size_t shard_size = (count + shard_count - 1) / shard_count;
+
+  TRACE_EVENT1("impeller", "ConcurrentGlyphRasterization", "Shards",
+               std::to_string(shard_count).c_str());
+  fml::CountDownLatch latch(shard_count - 1);
+  for (size_t shard = 1; shard < shard_count; shard++) {
+    size_t shard_start = start_index + shard * shard_size;
+    size_t shard_end = std::min(end_index, shard_start + shard_size);
+    worker_task_runner->PostTask([&proc, &latch, shard_start, shard_end]() {
+      TRACE_EVENT0("impeller", "RasterizeGlyphShard");
+      proc(shard_start, shard_end);
+      latch.CountDown();
+    });
+  }
+  proc(start_index, std::min(end_index, start_index + shard_size));
+  latch.Wait();
+}
+
+/// @brief Draw the glyphs in [start_index, end_index) into |bitmap| at their
+///        recorded atlas positions.
+///
+/// Each glyph is drawn through a canvas clipped to its own padded atlas cell.
+/// Since the cells never overlap, shards may safely draw into the same
+/// bitmap concurrently.
+static bool DrawGlyphsToBitmap(
+    const GlyphAtlas& atlas,
+    SkBitmap& bitmap,
+    const std::vector<FontGlyphPair>& new_pairs,
+    size_t start_index,
+    size_t end_index,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+
+  std::atomic_bool success = true;
+  ForEachGlyphShard(
+      worker_task_runner, start_index, end_index,
+      [&](size_t shard_start, size_t shard_end) {
+        auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
+        if (!surface) {
+          success = false;
+          return;
+        }
+        auto canvas = surface->getCanvas();
+        if (!canvas) {
+          success = false;
+          return;
+        }
+
+        for (size_t i = shard_start; i < shard_end; i++) {
+          const FontGlyphPair& pair = new_pairs[i];
+          auto data = atlas.FindFontGlyphBounds(pair);
+          if (!data.has_value()) {
+            continue;
+          }
+          auto [pos, bounds, placeholder] = data.value();
+          FML_DCHECK(!placeholder);
+          Size size = pos.GetSize();
+          if (size.IsEmpty()) {
+            continue;
+          }
+
+          canvas->save();
+          canvas->clipRect(SkRect::MakeLTRB(pos.GetLeft() - 1,   //
+                                            pos.GetTop() - 1,    //
+                                            pos.GetRight() + 1,  //
+                                            pos.GetBottom() + 1  //
+                                            ));
+          DrawGlyph(canvas, SkPoint::Make(pos.GetLeft(), pos.GetTop()),
+                    pair.scaled_font, pair.glyph, bounds,
+                    pair.glyph.properties, has_color);
+          canvas->restore();
+        }
+      });
+  return success;
+}
+
 /// @brief Batch render to a single surface.
 ///
 /// This is only safe for use when updating a fresh texture.
-static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
-                                  std::shared_ptr<BlitPass>& blit_pass,
-                                  HostBuffer& data_host_buffer,
-                                  const std::shared_ptr<Texture>& texture,
-                                  const std::vector<FontGlyphPair>& new_pairs,
-                                  size_t start_index,
-                                  size_t end_index) {
+static bool BulkUpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    std::shared_ptr<BlitPass>& blit_pass,
+    HostBuffer& data_host_buffer,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<FontGlyphPair>& new_pairs,
+    size_t start_index,
+    size_t end_index,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
   SkBitmap bitmap;
   bitmap.setInfo(GetImageInfo(atlas, Size(texture->GetSize())));
   if (!bitmap.tryAllocPixels()) {
     return false;
   }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
-  if (!surface) {
+  if (!DrawGlyphsToBitmap(atlas, bitmap, new_pairs, start_index, end_index,
+                          worker_task_runner)) {
     return false;
   }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return false;
-  }
-
-  for (size_t i = start_index; i < end_index; i++) {
-    const FontGlyphPair& pair = new_pairs[i];
-    auto data = atlas.FindFontGlyphBounds(pair);
-    if (!data.has_value()) {
-      continue;
-    }
-    auto [pos, bounds, placeholder] = data.value();
-    FML_DCHECK(!placeholder);
-    Size size = pos.GetSize();
-    if (size.IsEmpty()) {
-      continue;
-    }
-
-    DrawGlyph(canvas, SkPoint::Make(pos.GetLeft(), pos.GetTop()),
-              pair.scaled_font, pair.glyph, bounds, pair.glyph.properties,
-              has_color);
-  }
 
   // Writing to a malloc'd buffer and then copying to the staging buffers
   // benchmarks as substantially faster on a number of Android devices.
@@ -321,59 +562,88 @@ static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
                                             texture->GetSize().height));
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              std::shared_ptr<BlitPass>& blit_pass,
-                              HostBuffer& data_host_buffer,
-                              const std::shared_ptr<Texture>& texture,
-                              const std::vector<FontGlyphPair>& new_pairs,
-                              size_t start_index,
-                              size_t end_index) {
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    std::shared_ptr<BlitPass>& blit_pass,
+    HostBuffer& data_host_buffer,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<FontGlyphPair>& new_pairs,
+    size_t start_index,
+    size_t end_index,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
 
-  for (size_t i = start_index; i < end_index; i++) {
-    const FontGlyphPair& pair = new_pairs[i];
-    auto data = atlas.FindFontGlyphBounds(pair);
-    if (!data.has_value()) {
-      continue;
-    }
-    auto [pos, bounds, placeholder] = data.value();
-    FML_DCHECK(!placeholder);
+  // Each glyph is rasterized into its own staging bitmap, possibly on a worker
+  // thread. Neither the host buffer nor the blit pass are thread safe, so the
+  // uploads are encoded afterwards on this thread.
+  std::vector<SkBitmap> staging_bitmaps(end_index - start_index);
+  std::vector<IRect> staging_regions(end_index - start_index);
+  std::atomic_bool success = true;
+  ForEachGlyphShard(
+      worker_task_runner, start_index, end_index,
+      [&](size_t shard_start, size_t shard_end) {
+        for (size_t i = shard_start; i < shard_end; i++) {
+          const FontGlyphPair& pair = new_pairs[i];
+          auto data = atlas.FindFontGlyphBounds(pair);
+          if (!data.has_value()) {
+            continue;
+          }
+          auto [pos, bounds, placeholder] = data.value();
+          FML_DCHECK(!placeholder);
+
+          Size size = pos.GetSize();
+          if (size.IsEmpty()) {
+            continue;
+          }
+          // The uploaded bitmap is expanded by 1px of padding
+          // on each side.
+          size.width += 2;
+          size.height += 2;
+
+          SkBitmap& bitmap = staging_bitmaps[i - start_index];
+          bitmap.setInfo(GetImageInfo(atlas, size));
+          if (!bitmap.tryAllocPixels()) {
+            success = false;
+            return;
+          }
+
+          auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
+          if (!surface) {
+            success = false;
+            return;
+          }
+          auto canvas = surface->getCanvas();
+          if (!canvas) {
+            success = false;
+            return;
+          }
+
+          DrawGlyph(canvas, SkPoint::Make(1, 1), pair.scaled_font, pair.glyph,
+                    bounds, pair.glyph.properties, has_color);
+
+          staging_regions[i - start_index] = IRect::MakeXYWH(
+              pos.GetLeft() - 1, pos.GetTop() - 1, size.width, size.height);
+        }
+      });
+  if (!success) {
+    return false;
+  }
 
-    Size size = pos.GetSize();
-    if (size.IsEmpty()) {
+  for (size_t i = 0; i < staging_bitmaps.size(); i++) {
+    const SkBitmap& bitmap = staging_bitmaps[i];
+    if (bitmap.drawsNothing()) {
       continue;
     }
-    // The uploaded bitmap is expanded by 1px of padding
-    // on each side.
-    size.width += 2;
-    size.height += 2;
-
-    SkBitmap bitmap;
-    bitmap.setInfo(GetImageInfo(atlas, size));
-    if (!bitmap.tryAllocPixels()) {
-      return false;
-    }
-
-    auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
-    if (!surface) {
-      return false;
-    }
-    auto canvas = surface->getCanvas();
-    if (!canvas) {
-      return false;
-    }
-
-    DrawGlyph(canvas, SkPoint::Make(1, 1), pair.scaled_font, pair.glyph, bounds,
-              pair.glyph.properties, has_color);
+    const IRect& region = staging_regions[i];
 
     // Writing to a malloc'd buffer and then copying to the staging buffers
     // benchmarks as substantially faster on a number of Android devices.
     BufferView buffer_view = data_host_buffer.Emplace(
         bitmap.getAddr(0, 0),
-        size.Area() * BytesPerPixelForPixelFormat(
-                          atlas.GetTexture()->GetTextureDescriptor().format),
+        region.Area() * BytesPerPixelForPixelFormat(
+                            atlas.GetTexture()->GetTextureDescriptor().format),
         data_host_buffer.GetMinimumUniformAlignment());
 
     // convert_to_read is set to false so that the texture remains in a transfer
@@ -381,12 +651,11 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
     // on Vulkan where we are responsible for managing image layouts.
     if (!blit_pass->AddCopy(std::move(buffer_view),  //
                             texture,                 //
-                            IRect::MakeXYWH(pos.GetLeft() - 1, pos.GetTop() - 1,
-                                            size.width, size.height),  //
-                            /*label=*/"",                              //
-                            /*mip_level=*/0,                           //
-                            /*slice=*/0,                               //
-                            /*convert_to_read=*/false                  //
+                            region,                  //
+                            /*label=*/"",            //
+                            /*mip_level=*/0,         //
+                            /*slice=*/0,             //
+                            /*convert_to_read=*/false  //
                             )) {
       return false;
     }
@@ -418,6 +687,17 @@ static Rect ComputeGlyphSize(const SkFont& font,
                         scaled_bounds.fBottom);
 };
 
+bool TypographerContextSkia::RasterizeGlyphs(
+    const GlyphAtlas& atlas,
+    SkBitmap& bitmap,
+    const std::vector<FontGlyphPair>& pairs,
+    size_t start_index,
+    size_t end_index,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  return DrawGlyphsToBitmap(atlas, bitmap, pairs, start_index, end_index,
+                            worker_task_runner);
+}
+
 std::pair<std::vector<FontGlyphPair>, std::vector<Rect>>
 TypographerContextSkia::CollectNewGlyphs(
     const std::shared_ptr<GlyphAtlas>& atlas,
@@ -474,7 +754,7 @@ TypographerContextSkia::CollectNewGlyphs(
         SubpixelGlyph subpixel_glyph(glyph_position.glyph, subpixel,
                                      frame->GetProperties());
         const auto& font_glyph_bounds =
-            font_glyph_atlas->FindGlyphBounds(subpixel_glyph);
+            font_glyph_atlas->FindGlyphBoundsAndMarkUsed(subpixel_glyph);
 
         if (!font_glyph_bounds.has_value()) {
           new_glyphs.push_back(FontGlyphPair{scaled_font, subpixel_glyph});
@@ -515,6 +795,22 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   if (text_frames.empty()) {
     return last_atlas;
   }
+  last_atlas->AdvanceUseGeneration();
+
+  const int64_t max_texture_height =
+      ComputeMaxAtlasHeight(context, type, context.GetFlags());
+  if (context.GetFlags().glyph_atlas_max_pages > 0u) {
+    return CreateMultiPageGlyphAtlas(context, type, data_host_buffer,
+                                     atlas_context, text_frames,
+                                     context.GetFlags().glyph_atlas_max_pages,
+                                     max_texture_height);
+  }
+  // An atlas that is as big as it can get, or that cannot be grown without
+  // being rebuilt, reclaims the space of its least recently used glyphs before
+  // falling back to a rebuild.
+  const bool can_grow_atlas =
+      atlas_context->GetAtlasSize().height < max_texture_height &&
+      context.GetBackendType() != Context::BackendType::kOpenGLES;
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -539,7 +835,28 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     first_missing_index = AppendToExistingAtlas(
         last_atlas, new_glyphs, glyph_positions, glyph_sizes,
         atlas_context->GetAtlasSize(), atlas_context->GetHeightAdjustment(),
-        atlas_context->GetRectPacker());
+        atlas_context->GetRectPacker(), 0);
+
+    // -------------------------------------------------------------------------
+    // Step 2b: If the remaining glyphs don't fit and the atlas can't grow,
+    //          evict cold glyphs and retry before resorting to a rebuild.
+    // -------------------------------------------------------------------------
+    if (first_missing_index < new_glyphs.size() && !can_grow_atlas) {
+      size_t required_area = 0u;
+      for (size_t i = first_missing_index; i < new_glyphs.size(); i++) {
+        ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
+        required_area += (glyph_size.width + kPadding) *
+                         (glyph_size.height + kPadding);
+      }
+      if (atlas_context->ReclaimColdGlyphs(required_area,
+                                           kMinIdleGenerationsForEviction)) {
+        first_missing_index = AppendToExistingAtlas(
+            last_atlas, new_glyphs, glyph_positions, glyph_sizes,
+            atlas_context->GetAtlasSize(),
+            atlas_context->GetHeightAdjustment(),
+            atlas_context->GetRectPacker(), first_missing_index);
+      }
+    }
 
     // ---------------------------------------------------------------------------
     // Step 3a: Record the positions in the glyph atlas of the newly added
@@ -566,7 +883,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // ---------------------------------------------------------------------------
     if (!UpdateAtlasBitmap(*last_atlas, blit_pass, data_host_buffer,
                            last_atlas->GetTexture(), new_glyphs, 0,
-                           first_missing_index)) {
+                           first_missing_index, worker_task_runner_)) {
       return nullptr;
     }
 
@@ -577,8 +894,6 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   }
 
   int64_t height_adjustment = atlas_context->GetAtlasSize().height;
-  const int64_t max_texture_height =
-      context.GetResourceAllocator()->GetMaxTextureSizeSupported().height;
 
   // IF the current atlas size is as big as it can get, then "GC" and create an
   // atlas with only the required glyphs. OpenGLES cannot reliably perform the
@@ -587,8 +902,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // and 2) is missing a GLES 2.0 implementation and cap check.
   bool blit_old_atlas = true;
   std::shared_ptr<GlyphAtlas> new_atlas = last_atlas;
-  if (atlas_context->GetAtlasSize().height >= max_texture_height ||
-      context.GetBackendType() == Context::BackendType::kOpenGLES) {
+  if (!can_grow_atlas) {
     blit_old_atlas = false;
     new_atlas = std::make_shared<GlyphAtlas>(
         type, /*initial_generation=*/last_atlas->GetAtlasGeneration() + 1);
@@ -623,15 +937,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   FML_DCHECK(new_glyphs.size() == glyph_positions.size());
 
   TextureDescriptor descriptor;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      descriptor.format =
-          context.GetCapabilities()->GetDefaultGlyphAtlasFormat();
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
+  descriptor.format = GetGlyphAtlasFormat(context, type);
   descriptor.size = atlas_size;
   descriptor.storage_mode = StorageMode::kDevicePrivate;
   descriptor.usage = TextureUsage::kShaderRead;
@@ -672,7 +978,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   if (!BulkUpdateAtlasBitmap(*new_atlas, blit_pass, data_host_buffer,
                              new_atlas->GetTexture(), new_glyphs,
-                             first_missing_index, new_glyphs.size())) {
+                             first_missing_index, new_glyphs.size(),
+                             worker_task_runner_)) {
     return nullptr;
   }
 
@@ -690,4 +997,170 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   return new_atlas;
 }
 
+std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateMultiPageGlyphAtlas(
+    Context& context,
+    GlyphAtlas::Type type,
+    HostBuffer& data_host_buffer,
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    const std::vector<std::shared_ptr<TextFrame>>& text_frames,
+    size_t max_pages,
+    int64_t max_page_height) const {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  std::shared_ptr<GlyphAtlas> atlas = atlas_context->GetGlyphAtlas();
+
+  // ---------------------------------------------------------------------------
+  // Step 1: Collect the font glyph pairs that are not yet in the atlas and
+  //         compute their sizes at scale.
+  // ---------------------------------------------------------------------------
+  auto [new_glyphs, glyph_sizes] = CollectNewGlyphs(atlas, text_frames);
+  if (new_glyphs.size() == 0) {
+    return atlas;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Step 2: Place the new glyphs into the existing pages, opening new pages
+  //         for the glyphs that don't fit. Existing pages are never resized,
+  //         so their contents never need to be copied.
+  // ---------------------------------------------------------------------------
+  std::vector<Rect> glyph_positions;
+  std::vector<size_t> glyph_pages;
+  std::vector<ISize> new_page_sizes;
+  glyph_positions.reserve(new_glyphs.size());
+  glyph_pages.reserve(new_glyphs.size());
+  size_t first_missing_index = PackGlyphsIntoPages(
+      atlas_context, new_glyphs, glyph_sizes, glyph_positions, glyph_pages,
+      new_page_sizes, 0, max_pages, max_page_height);
+
+  // ---------------------------------------------------------------------------
+  // Step 2b: If all pages are in use and full, evict cold glyphs and retry.
+  // ---------------------------------------------------------------------------
+  if (first_missing_index < new_glyphs.size()) {
+    size_t required_area = 0u;
+    for (size_t i = first_missing_index; i < new_glyphs.size(); i++) {
+      ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
+      required_area +=
+          (glyph_size.width + kPadding) * (glyph_size.height + kPadding);
+    }
+    if (atlas_context->ReclaimColdGlyphs(required_area,
+                                         kMinIdleGenerationsForEviction)) {
+      first_missing_index = PackGlyphsIntoPages(
+          atlas_context, new_glyphs, glyph_sizes, glyph_positions,
+          glyph_pages, new_page_sizes, first_missing_index, max_pages,
+          max_page_height);
+    }
+  }
+
+  // ---------------------------------------------------------------------------
+  // Step 2c: As a last resort, rebuild the atlas with only the glyphs
+  //          required by these frames.
+  // ---------------------------------------------------------------------------
+  if (first_missing_index < new_glyphs.size()) {
+    atlas = std::make_shared<GlyphAtlas>(
+        type, /*initial_generation=*/atlas->GetAtlasGeneration() + 1);
+
+    auto [update_glyphs, update_sizes] = CollectNewGlyphs(atlas, text_frames);
+    new_glyphs = std::move(update_glyphs);
+    glyph_sizes = std::move(update_sizes);
+
+    glyph_positions.clear();
+    glyph_pages.clear();
+    new_page_sizes.clear();
+    atlas_context->ResetPagePackers();
+    atlas_context->UpdateGlyphAtlas(atlas, {0, 0}, 0);
+
+    first_missing_index = PackGlyphsIntoPages(
+        atlas_context, new_glyphs, glyph_sizes, glyph_positions, glyph_pages,
+        new_page_sizes, 0, max_pages, max_page_height);
+    if (first_missing_index < new_glyphs.size()) {
+      RollBackNewGlyphs(atlas_context, *atlas, new_glyphs, glyph_positions,
+                        glyph_pages, /*first_new_page=*/0);
+      return nullptr;
+    }
+  }
+  FML_DCHECK(new_glyphs.size() == glyph_positions.size());
+  FML_DCHECK(new_glyphs.size() == glyph_pages.size());
+
+  // ---------------------------------------------------------------------------
+  // Step 3: Allocate the textures of the newly opened pages. They are only
+  //         added to the atlas once all of them have been allocated.
+  // ---------------------------------------------------------------------------
+  const size_t first_new_page =
+      atlas_context->GetPagePackerCount() - new_page_sizes.size();
+  std::vector<std::shared_ptr<Texture>> page_textures;
+  page_textures.reserve(new_page_sizes.size());
+  for (size_t i = 0; i < new_page_sizes.size(); i++) {
+    TextureDescriptor descriptor;
+    descriptor.format = GetGlyphAtlasFormat(context, type);
+    descriptor.size = new_page_sizes[i];
+    descriptor.storage_mode = StorageMode::kDevicePrivate;
+    descriptor.usage = TextureUsage::kShaderRead;
+    std::shared_ptr<Texture> page_texture =
+        context.GetResourceAllocator()->CreateTexture(descriptor);
+    if (!page_texture) {
+      RollBackNewGlyphs(atlas_context, *atlas, new_glyphs, glyph_positions,
+                        glyph_pages, first_new_page);
+      return nullptr;
+    }
+    page_texture->SetLabel("GlyphAtlasPage");
+    page_textures.push_back(std::move(page_texture));
+  }
+  for (size_t i = 0; i < page_textures.size(); i++) {
+    if (first_new_page + i == 0u) {
+      atlas->SetTexture(std::move(page_textures[i]));
+    } else {
+      [[maybe_unused]] size_t page =
+          atlas->AddPage(std::move(page_textures[i]));
+      FML_DCHECK(page == first_new_page + i);
+    }
+  }
+  atlas_context->UpdateGlyphAtlas(atlas, atlas->GetTexture()->GetSize(), 0);
+
+  // ---------------------------------------------------------------------------
+  // Step 3a: Record the positions in the glyph atlas of the newly added
+  //          glyphs.
+  // ---------------------------------------------------------------------------
+  std::vector<std::vector<FontGlyphPair>> pairs_per_page(
+      atlas->GetPageCount());
+  for (size_t i = 0; i < new_glyphs.size(); i++) {
+    atlas->AddTypefaceGlyphPositionAndBounds(new_glyphs[i], glyph_positions[i],
+                                             glyph_sizes[i], glyph_pages[i]);
+    pairs_per_page[glyph_pages[i]].push_back(new_glyphs[i]);
+  }
+
+  std::shared_ptr<CommandBuffer> cmd_buffer = context.CreateCommandBuffer();
+  std::shared_ptr<BlitPass> blit_pass = cmd_buffer->CreateBlitPass();
+
+  fml::ScopedCleanupClosure closure([&]() {
+    blit_pass->EncodeCommands();
+    if (!context.EnqueueCommandBuffer(std::move(cmd_buffer))) {
+      VALIDATION_LOG << "Failed to submit glyph atlas command buffer";
+    }
+  });
+
+  // ---------------------------------------------------------------------------
+  // Step 4: Draw new font-glyph pairs into the a host buffer and encode
+  //         the uploads of each page into the blit pass. New pages are
+  //         uploaded in bulk, existing pages only where glyphs were added.
+  // ---------------------------------------------------------------------------
+  for (size_t page = 0; page < pairs_per_page.size(); page++) {
+    const std::vector<FontGlyphPair>& page_pairs = pairs_per_page[page];
+    if (page_pairs.empty()) {
+      continue;
+    }
+    bool success =
+        page >= first_new_page
+            ? BulkUpdateAtlasBitmap(*atlas, blit_pass, data_host_buffer,
+                                    atlas->GetTexture(page), page_pairs, 0,
+                                    page_pairs.size(), worker_task_runner_)
+            : UpdateAtlasBitmap(*atlas, blit_pass, data_host_buffer,
+                                atlas->GetTexture(page), page_pairs, 0,
+                                page_pairs.size(), worker_task_runner_);
+    if (!success) {
+      return nullptr;
+    }
+  }
+
+  return atlas;
+}
+
 }  // namespace impeller
@@ -5,16 +5,38 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "impeller/typographer/typographer_context.h"
 
+class SkBitmap;
+
 namespace impeller {
 
 class TypographerContextSkia : public TypographerContext {
  public:
   static std::shared_ptr<TypographerContext> Make();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a typographer context that shards the rasterization of
+  ///             large batches of new glyphs across the workers of the given
+  ///             concurrent task runner.
+  ///
+  ///             Small batches are still rasterized on the calling thread, and
+  ///             the upload of the rasterized glyphs is always encoded into a
+  ///             single blit pass on the calling thread.
+  ///
+  /// @param[in]  worker_task_runner  The concurrent task runner to rasterize
+  ///                                 glyphs on. May be null, in which case
+  ///                                 rasterization is serial.
+  ///
+  static std::shared_ptr<TypographerContext> Make(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
   TypographerContextSkia();
 
+  explicit TypographerContextSkia(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
   ~TypographerContextSkia() override;
 
   // |TypographerContext|
@@ -31,10 +53,37 @@ class TypographerContextSkia : public TypographerContext {
       const override;
 
  private:
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create or update a glyph atlas made up of up to |max_pages|
+  ///             fixed size pages.
+  ///
+  ///             Unlike the single texture atlas, growing a multi-page atlas
+  ///             only allocates and uploads the new page, and never copies
+  ///             the contents of the existing pages.
+  ///
+  std::shared_ptr<GlyphAtlas> CreateMultiPageGlyphAtlas(
+      Context& context,
+      GlyphAtlas::Type type,
+      HostBuffer& data_host_buffer,
+      const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+      const std::vector<std::shared_ptr<TextFrame>>& text_frames,
+      size_t max_pages,
+      int64_t max_page_height) const;
+
   static std::pair<std::vector<FontGlyphPair>, std::vector<Rect>>
   CollectNewGlyphs(const std::shared_ptr<GlyphAtlas>& atlas,
                    const std::vector<std::shared_ptr<TextFrame>>& text_frames);
 
+  static bool RasterizeGlyphs(
+      const GlyphAtlas& atlas,
+      SkBitmap& bitmap,
+      const std::vector<FontGlyphPair>& pairs,
+      size_t start_index,
+      size_t end_index,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
   TypographerContextSkia(const TypographerContextSkia&) = delete;
 
   TypographerContextSkia& operator=(const TypographerContextSkia&) = delete;
@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
@@ -46,13 +47,78 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
+size_t GlyphAtlasContext::GetPagePackerCount() const {
+  return page_packers_.size();
+}
+
+const std::shared_ptr<RectanglePacker>& GlyphAtlasContext::GetPagePacker(
+    size_t page) const {
+  FML_DCHECK(page < page_packers_.size());
+  return page_packers_[page];
+}
+
+void GlyphAtlasContext::AddPagePacker(
+    std::shared_ptr<RectanglePacker> rect_packer) {
+  page_packers_.push_back(std::move(rect_packer));
+}
+
+void GlyphAtlasContext::ResetPagePackers() {
+  page_packers_.clear();
+}
+
+void GlyphAtlasContext::TruncatePagePackers(size_t page_count) {
+  if (page_count < page_packers_.size()) {
+    page_packers_.resize(page_count);
+  }
+}
+
+size_t GlyphAtlasContext::ReclaimColdGlyphs(size_t required_area,
+                                            size_t min_idle_generations) {
+  if ((!rect_packer_ && page_packers_.empty()) || !atlas_) {
+    return 0u;
+  }
+  std::vector<FrameBounds> evicted =
+      atlas_->EvictLeastRecentlyUsedGlyphs(required_area, min_idle_generations);
+  for (const FrameBounds& bounds : evicted) {
+    // Glyphs are positioned in the center of their 1px padding.
+    IRect padded = IRect::RoundOut(bounds.atlas_bounds).Expand(1);
+    if (!page_packers_.empty()) {
+      // Each page of a multi-page atlas has its own packer covering the
+      // entire page.
+      if (bounds.page < page_packers_.size()) {
+        page_packers_[bounds.page]->ReclaimRect(
+            static_cast<int>(padded.GetX()),      //
+            static_cast<int>(padded.GetY()),      //
+            static_cast<int>(padded.GetWidth()),  //
+            static_cast<int>(padded.GetHeight())  //
+        );
+      }
+      continue;
+    }
+    // The rect packer of a single page atlas is offset from the top of the
+    // atlas by the height adjustment.
+    rect_packer_->ReclaimRect(
+        static_cast<int>(padded.GetX()),                       //
+        static_cast<int>(padded.GetY() - height_adjustment_),  //
+        static_cast<int>(padded.GetWidth()),                   //
+        static_cast<int>(padded.GetHeight())                   //
+    );
+  }
+  if (!evicted.empty()) {
+    // Any text frame that recorded the previous generation can no longer
+    // assume that all of its glyphs are present.
+    atlas_->SetAtlasGeneration(atlas_->GetAtlasGeneration() + 1);
+  }
+  return evicted.size();
+}
+
 GlyphAtlas::GlyphAtlas(Type type, size_t initial_generation)
-    : type_(type), generation_(initial_generation) {}
+    : type_(type), pages_(1u), generation_(initial_generation) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
 
 bool GlyphAtlas::IsValid() const {
-  return !!texture_;
+  return !!pages_.front();
 }
 
 GlyphAtlas::Type GlyphAtlas::GetType() const {
@@ -60,11 +126,25 @@ GlyphAtlas::Type GlyphAtlas::GetType() const {
 }
 
 const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
-  return texture_;
+  return pages_.front();
+}
+
+const std::shared_ptr<Texture>& GlyphAtlas::GetTexture(size_t page) const {
+  FML_DCHECK(page < pages_.size());
+  return pages_[page];
 }
 
 void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
-  texture_ = std::move(texture);
+  pages_.front() = std::move(texture);
+}
+
+size_t GlyphAtlas::AddPage(std::shared_ptr<Texture> texture) {
+  pages_.push_back(std::move(texture));
+  return pages_.size() - 1;
+}
+
+size_t GlyphAtlas::GetPageCount() const {
+  return pages_.size();
 }
 
 size_t GlyphAtlas::GetAtlasGeneration() const {
@@ -75,13 +155,85 @@ void GlyphAtlas::SetAtlasGeneration(size_t generation) {
   generation_ = generation;
 }
 
+size_t GlyphAtlas::GetUseGeneration() const {
+  return use_generation_;
+}
+
+void GlyphAtlas::AdvanceUseGeneration() {
+  use_generation_++;
+  for (auto& [scaled_font, font_glyph_atlas] : font_atlas_map_) {
+    font_glyph_atlas.use_generation_ = use_generation_;
+  }
+}
+
+std::vector<FrameBounds> GlyphAtlas::EvictLeastRecentlyUsedGlyphs(
+    size_t required_area,
+    size_t min_idle_generations) {
+  min_idle_generations = std::max<size_t>(min_idle_generations, 1u);
+  if (use_generation_ < min_idle_generations) {
+    return {};
+  }
+  const size_t max_last_used = use_generation_ - min_idle_generations;
+
+  struct Candidate {
+    size_t last_used_generation;
+    FontAtlasMap::iterator font;
+    SubpixelGlyph glyph;
+  };
+  std::vector<Candidate> candidates;
+  for (auto it = font_atlas_map_.begin(); it != font_atlas_map_.end(); ++it) {
+    for (const auto& [glyph, entry] : it->second.positions_) {
+      if (entry.last_used_generation <= max_last_used) {
+        candidates.push_back({entry.last_used_generation, it, glyph});
+      }
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate& a, const Candidate& b) {
+                     return a.last_used_generation < b.last_used_generation;
+                   });
+
+  std::vector<FrameBounds> evicted;
+  size_t evicted_area = 0u;
+  for (const Candidate& candidate : candidates) {
+    if (evicted_area >= required_area) {
+      break;
+    }
+    auto& positions = candidate.font->second.positions_;
+    auto found = positions.find(candidate.glyph);
+    FML_DCHECK(found != positions.end());
+    const FrameBounds& bounds = found->second.bounds;
+    // Placeholders were never given space in the atlas, so there is nothing
+    // to reclaim, but they are still stale.
+    if (!bounds.is_placeholder && !bounds.atlas_bounds.IsEmpty()) {
+      evicted.push_back(bounds);
+      evicted_area += static_cast<size_t>(
+          (bounds.atlas_bounds.GetWidth() + 2) *
+          (bounds.atlas_bounds.GetHeight() + 2));
+    }
+    positions.erase(found);
+  }
+  return evicted;
+}
+
 void GlyphAtlas::AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                                    Rect position,
-                                                   Rect bounds) {
+                                                   Rect bounds,
+                                                   size_t page) {
   FontAtlasMap::iterator it = font_atlas_map_.find(pair.scaled_font);
   FML_DCHECK(it != font_atlas_map_.end());
-  it->second.positions_[pair.glyph] =
-      FrameBounds{position, bounds, /*is_placeholder=*/false};
+  it->second.positions_[pair.glyph] = FontGlyphAtlas::GlyphEntry{
+      .bounds = FrameBounds{position, bounds, /*is_placeholder=*/false, page},
+      .last_used_generation = use_generation_,
+  };
+}
+
+void GlyphAtlas::RemoveTypefaceGlyph(const FontGlyphPair& pair) {
+  FontAtlasMap::iterator it = font_atlas_map_.find(pair.scaled_font);
+  if (it == font_atlas_map_.end()) {
+    return;
+  }
+  it->second.positions_.erase(pair.glyph);
 }
 
 std::optional<FrameBounds> GlyphAtlas::FindFontGlyphBounds(
@@ -97,6 +249,9 @@ FontGlyphAtlas* GlyphAtlas::GetOrCreateFontGlyphAtlas(
     const ScaledFont& scaled_font) {
   auto [iter, inserted] =
       font_atlas_map_.try_emplace(scaled_font, FontGlyphAtlas());
+  if (inserted) {
+    iter->second.use_generation_ = use_generation_;
+  }
   return &iter->second;
 }
 
@@ -120,7 +275,7 @@ size_t GlyphAtlas::IterateGlyphs(
     for (const auto& glyph_value : font_value.second.positions_) {
       count++;
       if (!iterator(font_value.first, glyph_value.first,
-                    glyph_value.second.atlas_bounds)) {
+                    glyph_value.second.bounds.atlas_bounds)) {
         return count;
       }
     }
@@ -134,12 +289,25 @@ std::optional<FrameBounds> FontGlyphAtlas::FindGlyphBounds(
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return found->second.bounds;
+}
+
+std::optional<FrameBounds> FontGlyphAtlas::FindGlyphBoundsAndMarkUsed(
+    const SubpixelGlyph& glyph) {
+  auto found = positions_.find(glyph);
+  if (found == positions_.end()) {
+    return std::nullopt;
+  }
+  found->second.last_used_generation = use_generation_;
+  return found->second.bounds;
 }
 
 void FontGlyphAtlas::AppendGlyph(const SubpixelGlyph& glyph,
                                  const FrameBounds& frame_bounds) {
-  positions_[glyph] = frame_bounds;
+  positions_[glyph] = GlyphEntry{
+      .bounds = frame_bounds,
+      .last_used_generation = use_generation_,
+  };
 }
 
 }  // namespace impeller
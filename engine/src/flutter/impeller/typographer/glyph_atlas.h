@@ -8,6 +8,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/third_party/abseil-cpp/absl/container/flat_hash_map.h"
 #include "impeller/core/texture.h"
@@ -27,6 +28,8 @@ struct FrameBounds {
   /// Whether [atlas_bounds] are still a placeholder and have
   /// not yet been computed.
   bool is_placeholder = true;
+  /// The page of the glyph atlas that [atlas_bounds] refer to.
+  size_t page = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -72,30 +75,68 @@ class GlyphAtlas {
   Type GetType() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Set the texture for the glyph atlas.
+  /// @brief      Set the texture for the first page of the glyph atlas.
   ///
   /// @param[in]  texture  The texture
   ///
   void SetTexture(std::shared_ptr<Texture> texture);
 
   //----------------------------------------------------------------------------
-  /// @brief      Get the texture for the glyph atlas.
+  /// @brief      Get the texture for the first page of the glyph atlas.
   ///
   /// @return     The texture.
   ///
   const std::shared_ptr<Texture>& GetTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture for a page of the glyph atlas.
+  ///
+  /// @param[in]  page  The page index. Must be less than |GetPageCount|.
+  ///
+  /// @return     The texture.
+  ///
+  const std::shared_ptr<Texture>& GetTexture(size_t page) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Append a page to the glyph atlas.
+  ///
+  ///             Atlases that are made up of multiple pages grow by adding
+  ///             pages instead of copying their contents into a larger
+  ///             texture.
+  ///
+  /// @param[in]  texture  The texture backing the new page.
+  ///
+  /// @return     The index of the new page.
+  ///
+  size_t AddPage(std::shared_ptr<Texture> texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the number of pages (textures) in the glyph atlas. Every
+  ///             atlas has at least one page.
+  ///
+  size_t GetPageCount() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Record the location of a specific font-glyph pair within the
   ///             atlas.
   ///
   /// @param[in]  pair  The font-glyph pair
-  /// @param[in]  rect  The position in the atlas
+  /// @param[in]  rect  The position in the atlas page
   /// @param[in]  bounds The bounds of the glyph at scale
+  /// @param[in]  page  The page of the atlas the glyph was placed in
   ///
   void AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                          Rect position,
-                                         Rect bounds);
+                                         Rect bounds,
+                                         size_t page = 0);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove a specific font-glyph pair from the atlas, for example
+  ///             when the glyph could not be placed in the atlas.
+  ///
+  /// @param[in]  pair  The font-glyph pair
+  ///
+  void RemoveTypefaceGlyph(const FontGlyphPair& pair);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -155,10 +196,46 @@ class GlyphAtlas {
   /// @brief      Update the atlas generation.
   void SetAtlasGeneration(size_t value);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the use generation for this glyph atlas.
+  ///
+  ///             Every glyph records the use generation in which it was last
+  ///             looked up via |FontGlyphAtlas::FindGlyphBoundsAndMarkUsed| or
+  ///             appended. This is used to find the least recently used glyphs
+  ///             when space in the atlas needs to be reclaimed.
+  size_t GetUseGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Advance the use generation. This is expected to be called
+  ///             once per atlas update, before glyphs are looked up.
+  void AdvanceUseGeneration();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove glyphs that have not been used in the last
+  ///             |min_idle_generations| use generations, least recently used
+  ///             first, until the removed glyphs cover at least
+  ///             |required_area| pixels.
+  ///
+  ///             Glyphs used in the current use generation are never removed.
+  ///
+  /// @param[in]  required_area         The minimum area to reclaim. Eviction
+  ///                                   stops as soon as this is reached.
+  /// @param[in]  min_idle_generations  The minimum number of use generations
+  ///                                   a glyph must have been unused for to
+  ///                                   be eligible for eviction. Values less
+  ///                                   than 1 are treated as 1.
+  ///
+  /// @return     The bounds in the atlas of the removed glyphs.
+  ///
+  std::vector<FrameBounds> EvictLeastRecentlyUsedGlyphs(
+      size_t required_area,
+      size_t min_idle_generations);
+
  private:
   const Type type_;
-  std::shared_ptr<Texture> texture_;
+  std::vector<std::shared_ptr<Texture>> pages_;
   size_t generation_ = 0;
+  size_t use_generation_ = 0;
 
   using FontAtlasMap = absl::flat_hash_map<ScaledFont,
                                            FontGlyphAtlas,
@@ -211,10 +288,55 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the number of per-page rect packers of a multi-page
+  ///             glyph atlas.
+  size_t GetPagePackerCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the rect packer for a page of a multi-page glyph
+  ///             atlas.
+  const std::shared_ptr<RectanglePacker>& GetPagePacker(size_t page) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add the rect packer for a newly added page of a multi-page
+  ///             glyph atlas.
+  void AddPagePacker(std::shared_ptr<RectanglePacker> rect_packer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove all per-page rect packers, for example when a
+  ///             multi-page glyph atlas is rebuilt from scratch.
+  void ResetPagePackers();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove the rect packers of the pages at or after
+  ///             [page_count], for example when the textures of newly opened
+  ///             pages could not be allocated.
+  void TruncatePagePackers(size_t page_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Make room for new glyphs in the current atlas by evicting the
+  ///             least recently used glyphs and returning their space to the
+  ///             rect packer.
+  ///
+  ///             This allows an atlas that cannot (or should not) grow any
+  ///             further to be reused without rebuilding it from scratch.
+  ///
+  /// @param[in]  required_area         The area in pixels, including padding,
+  ///                                   that the new glyphs need.
+  /// @param[in]  min_idle_generations  The minimum number of atlas updates a
+  ///                                   glyph must have been unused for to be
+  ///                                   evicted.
+  ///
+  /// @return     The number of glyphs that were evicted.
+  ///
+  size_t ReclaimColdGlyphs(size_t required_area, size_t min_idle_generations);
+
  private:
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<RectanglePacker> rect_packer_;
+  std::vector<std::shared_ptr<RectanglePacker>> page_packers_;
   int64_t height_adjustment_;
 
   GlyphAtlasContext(const GlyphAtlasContext&) = delete;
@@ -241,6 +363,18 @@ class FontGlyphAtlas {
   ///
   std::optional<FrameBounds> FindGlyphBounds(const SubpixelGlyph& glyph) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Find the location of a glyph in the atlas and record that it
+  ///             was used in the current use generation of the atlas.
+  ///
+  /// @param[in]  glyph The glyph
+  ///
+  /// @return     The location of the glyph in the atlas.
+  ///             `std::nullopt` if the glyph is not in the atlas.
+  ///
+  std::optional<FrameBounds> FindGlyphBoundsAndMarkUsed(
+      const SubpixelGlyph& glyph);
+
   //----------------------------------------------------------------------------
   /// @brief      Append the frame bounds of a glyph to this atlas.
   ///
@@ -251,12 +385,20 @@ class FontGlyphAtlas {
  private:
   friend class GlyphAtlas;
 
+  struct GlyphEntry {
+    FrameBounds bounds;
+    /// The use generation of the owning atlas in which this glyph was last
+    /// used.
+    size_t last_used_generation = 0;
+  };
+
   using PositionsMap = absl::flat_hash_map<SubpixelGlyph,
-                                           FrameBounds,
+                                           GlyphEntry,
                                            absl::Hash<SubpixelGlyph>,
                                            SubpixelGlyph::Equal>;
 
   PositionsMap positions_;
+  size_t use_generation_ = 0;
   FontGlyphAtlas(const FontGlyphAtlas&) = delete;
 };
 
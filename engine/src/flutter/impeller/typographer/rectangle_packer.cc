@@ -5,6 +5,7 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -26,10 +27,13 @@ class SkylineRectanglePacker final : public RectanglePacker {
     area_so_far_ = 0;
     skyline_.clear();
     skyline_.push_back(SkylineSegment{0, 0, width()});
+    reclaimed_.clear();
   }
 
   bool AddRect(int w, int h, IPoint16* loc) final;
 
+  void ReclaimRect(int x, int y, int w, int h) final;
+
   Scalar PercentFull() const final {
     return area_so_far_ / (static_cast<float>(width()) * height());
   }
@@ -41,10 +45,32 @@ class SkylineRectanglePacker final : public RectanglePacker {
     int width_;
   };
 
+  struct ReclaimedRect {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+  };
+
   std::vector<SkylineSegment> skyline_;
 
+  // The maximum number of reclaimed rectangles that are kept for reuse.
+  static constexpr size_t kMaxReclaimedRects = 256u;
+
+  // Rectangles that were handed back via ReclaimRect and have not been reused
+  // yet. These are independent of the skyline.
+  std::vector<ReclaimedRect> reclaimed_;
+
   int32_t area_so_far_;
 
+  // The area of a rectangle, which may lie partly above this packer, that is
+  // counted by |area_so_far_|.
+  int AreaWithinPacker(int x, int y, int p_width, int p_height) const;
+
+  // Attempt to place a width x height rectangle in the smallest reclaimed
+  // rectangle that can hold it, splitting off the unused remainder.
+  bool AddReclaimedRect(int width, int height, IPoint16* loc);
+
   // Can a width x height rectangle fit in the free space represented by
   // the skyline segments >= 'skyline_index'? If so, return true and fill in
   // 'y' with the y-location at which it fits (the x location is pulled from
@@ -60,6 +86,10 @@ class SkylineRectanglePacker final : public RectanglePacker {
 };
 
 bool SkylineRectanglePacker::AddRect(int p_width, int p_height, IPoint16* loc) {
+  if (AddReclaimedRect(p_width, p_height, loc)) {
+    return true;
+  }
+
   if (static_cast<unsigned>(p_width) > static_cast<unsigned>(width()) ||
       static_cast<unsigned>(p_height) > static_cast<unsigned>(height())) {
     return false;
@@ -98,6 +128,109 @@ bool SkylineRectanglePacker::AddRect(int p_width, int p_height, IPoint16* loc) {
   return false;
 }
 
+void SkylineRectanglePacker::ReclaimRect(int x, int y, int w, int h) {
+  // Rectangles above this packer, in the region of the atlas packed by a
+  // previous packer, are kept so that their space can be reused. Anything
+  // beside or below the packer is not part of the atlas.
+  int left = std::max(x, 0);
+  int top = std::max(y, static_cast<int>(std::numeric_limits<int16_t>::min()));
+  int right = std::min(x + w, width());
+  int bottom = std::min(y + h, height());
+  if (right <= left || bottom <= top) {
+    return;
+  }
+  ReclaimedRect rect{left, top, right - left, bottom - top};
+  area_so_far_ -= AreaWithinPacker(rect.x_, rect.y_, rect.width_, rect.height_);
+
+  // Merge the rectangle with the reclaimed rectangles that share a full edge
+  // with it, so that neighbouring glyphs can be replaced by larger ones.
+  for (auto i = 0u; i < reclaimed_.size();) {
+    const ReclaimedRect& other = reclaimed_[i];
+    if (other.y_ == rect.y_ && other.height_ == rect.height_ &&
+        (other.x_ + other.width_ == rect.x_ ||
+         rect.x_ + rect.width_ == other.x_)) {
+      rect.x_ = std::min(rect.x_, other.x_);
+      rect.width_ += other.width_;
+    } else if (other.x_ == rect.x_ && other.width_ == rect.width_ &&
+               (other.y_ + other.height_ == rect.y_ ||
+                rect.y_ + rect.height_ == other.y_)) {
+      rect.y_ = std::min(rect.y_, other.y_);
+      rect.height_ += other.height_;
+    } else {
+      i++;
+      continue;
+    }
+    reclaimed_.erase(reclaimed_.begin() + i);
+    i = 0u;
+  }
+  reclaimed_.push_back(rect);
+
+  // Keep the list short, as it is searched by every call to AddRect. The
+  // smallest rectangle is given up and counted as filled again.
+  if (reclaimed_.size() > kMaxReclaimedRects) {
+    auto smallest = std::min_element(
+        reclaimed_.begin(), reclaimed_.end(),
+        [](const ReclaimedRect& a, const ReclaimedRect& b) {
+          return a.width_ * a.height_ < b.width_ * b.height_;
+        });
+    area_so_far_ += AreaWithinPacker(smallest->x_, smallest->y_,
+                                     smallest->width_, smallest->height_);
+    reclaimed_.erase(smallest);
+  }
+}
+
+bool SkylineRectanglePacker::AddReclaimedRect(int p_width,
+                                              int p_height,
+                                              IPoint16* loc) {
+  if (reclaimed_.empty() || p_width <= 0 || p_height <= 0) {
+    return false;
+  }
+
+  // Best area fit.
+  int best_index = -1;
+  int64_t best_area = 0;
+  for (auto i = 0u; i < reclaimed_.size(); ++i) {
+    const ReclaimedRect& rect = reclaimed_[i];
+    if (rect.width_ < p_width || rect.height_ < p_height) {
+      continue;
+    }
+    int64_t area = static_cast<int64_t>(rect.width_) * rect.height_;
+    if (best_index == -1 || area < best_area) {
+      best_index = i;
+      best_area = area;
+    }
+  }
+  if (best_index == -1) {
+    return false;
+  }
+
+  ReclaimedRect rect = reclaimed_[best_index];
+  reclaimed_.erase(reclaimed_.begin() + best_index);
+  loc->x_ = rect.x_;
+  loc->y_ = rect.y_;
+  area_so_far_ += AreaWithinPacker(rect.x_, rect.y_, p_width, p_height);
+
+  // Guillotine split the remainder into the area to the right of the new
+  // rectangle and the full-width area below it.
+  if (rect.width_ > p_width) {
+    reclaimed_.push_back(ReclaimedRect{rect.x_ + p_width, rect.y_,
+                                       rect.width_ - p_width, p_height});
+  }
+  if (rect.height_ > p_height) {
+    reclaimed_.push_back(ReclaimedRect{rect.x_, rect.y_ + p_height,
+                                       rect.width_, rect.height_ - p_height});
+  }
+  return true;
+}
+
+int SkylineRectanglePacker::AreaWithinPacker(int x,
+                                             int y,
+                                             int p_width,
+                                             int p_height) const {
+  int visible_height = std::min(y + p_height, height()) - std::max(y, 0);
+  return visible_height > 0 ? p_width * visible_height : 0;
+}
+
 bool SkylineRectanglePacker::RectangleFits(size_t skyline_index,
                                            int p_width,
                                            int p_height,
@@ -45,6 +45,26 @@ class RectanglePacker {
   ///
   virtual bool AddRect(int width, int height, IPoint16* loc) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Return the area of a previously added rectangle to the packer
+  ///            so that subsequent calls to |AddRect| may reuse it.
+  ///
+  ///            The rectangle may also lie above the area managed by this
+  ///            packer, in a region of the atlas that was packed by a previous
+  ///            packer. Coordinates are relative to the origin of this packer,
+  ///            so |y| is then negative, and so may be the locations returned
+  ///            by |AddRect| that reuse the space. Only the part of such a
+  ///            rectangle within this packer counts towards |PercentFull|.
+  ///            Parts of the rectangle beside or below this packer are
+  ///            ignored.
+  ///
+  /// @param[in]   x       The x coordinate of the upper-left corner.
+  /// @param[in]   y       The y coordinate of the upper-left corner.
+  /// @param[in]   width   The width of the rectangle to reclaim.
+  /// @param[in]   height  The height of the rectangle to reclaim.
+  ///
+  virtual void ReclaimRect(int x, int y, int width, int height) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief     Returns how much area has been filled with rectangles.
   ///
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace impeller {
+
+namespace {
+
+/// Create text frames that together reference |glyph_count| unique glyphs.
+///
+/// Glyphs are taken in order from the test typeface. Once the typeface is
+/// exhausted, the same glyphs are repeated at a different scale so that they
+/// occupy distinct atlas entries.
+std::vector<std::shared_ptr<TextFrame>> CreateTextFrames(size_t glyph_count) {
+  SkFont font = flutter::testing::CreateTestFontOfSize(12);
+  size_t typeface_glyph_count =
+      static_cast<size_t>(font.getTypeface()->countGlyphs());
+
+  std::vector<std::shared_ptr<TextFrame>> frames;
+  int32_t scale_step = 0;
+  while (glyph_count > 0) {
+    size_t run_count = std::min(glyph_count, typeface_glyph_count - 1);
+    std::vector<SkGlyphID> glyphs(run_count);
+    for (size_t i = 0; i < run_count; i++) {
+      glyphs[i] = static_cast<SkGlyphID>(i + 1);
+    }
+    auto blob = SkTextBlob::MakeFromText(glyphs.data(),
+                                         glyphs.size() * sizeof(SkGlyphID),
+                                         font, SkTextEncoding::kGlyphID);
+    auto frame = MakeTextFrameFromTextBlobSkia(blob);
+    frame->SetPerFrameData(Rational(10 + scale_step, 10), {0, 0}, Matrix(),
+                           std::nullopt);
+    frames.push_back(std::move(frame));
+    glyph_count -= run_count;
+    scale_step++;
+  }
+  return frames;
+}
+
+}  // namespace
+
+/// Measures the time the calling (raster) thread spends creating a fresh
+/// glyph atlas for a batch of new glyphs, optionally sharding their
+/// rasterization across a pool of workers.
+///
+/// The context is backed by a mock Vulkan driver, so the time is spent
+/// packing, rasterizing, and encoding the upload of the glyphs.
+static void BM_RasterizeGlyphs(benchmark::State& state, size_t worker_count) {
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop;
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
+  if (worker_count > 0) {
+    loop = fml::ConcurrentMessageLoop::Create(worker_count);
+    worker_task_runner = loop->GetTaskRunner();
+  }
+
+  std::shared_ptr<ContextVK> context =
+      testing::MockVulkanContextBuilder().Build();
+  auto data_host_buffer = HostBuffer::Create(
+      context->GetResourceAllocator(), context->GetIdleWaiter(),
+      context->GetCapabilities()->GetMinimumUniformAlignment());
+  auto typographer_context = TypographerContextSkia::Make(worker_task_runner);
+  auto frames = CreateTextFrames(static_cast<size_t>(state.range(0)));
+
+  size_t glyph_count = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto atlas_context = typographer_context->CreateGlyphAtlasContext(
+        GlyphAtlas::Type::kAlphaBitmap);
+    data_host_buffer->Reset();
+    state.ResumeTiming();
+
+    auto atlas = typographer_context->CreateGlyphAtlas(
+        *context, GlyphAtlas::Type::kAlphaBitmap, *data_host_buffer,
+        atlas_context, frames);
+    if (!atlas) {
+      state.SkipWithError("Failed to create the glyph atlas.");
+      break;
+    }
+    glyph_count = atlas->GetGlyphCount();
+  }
+  context->Shutdown();
+  state.counters["GlyphCount"] = glyph_count;
+  state.SetItemsProcessed(state.iterations() * glyph_count);
+}
+
+BENCHMARK_CAPTURE(BM_RasterizeGlyphs, Serial, 0u)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_RasterizeGlyphs, Workers2, 2u)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_RasterizeGlyphs, Workers4, 4u)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_RasterizeGlyphs, Workers8, 8u)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace impeller
@@ -3,11 +3,14 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/renderer/testing/mocks.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/font_glyph_pair.h"
@@ -59,6 +62,31 @@ static std::shared_ptr<GlyphAtlas> CreateGlyphAtlas(
                                                atlas_context, frames);
 }
 
+// Reads back the contents of the texture of a glyph atlas.
+static std::vector<uint8_t> ReadTexturePixels(
+    Context& context,
+    const std::shared_ptr<Texture>& texture) {
+  DeviceBufferDescriptor desc;
+  desc.size = texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  desc.readback = true;
+  desc.storage_mode = StorageMode::kHostVisible;
+  auto device_buffer = context.GetResourceAllocator()->CreateBuffer(desc);
+  FML_CHECK(device_buffer);
+
+  auto cmd_buffer = context.CreateCommandBuffer();
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  blit_pass->AddCopy(texture, device_buffer);
+  blit_pass->EncodeCommands();
+  auto latch = std::make_shared<fml::CountDownLatch>(1u);
+  context.GetCommandQueue()->Submit(
+      {cmd_buffer},
+      [latch](CommandBuffer::Status status) { latch->CountDown(); });
+  latch->Wait();
+
+  const uint8_t* contents = device_buffer->OnGetContents();
+  return std::vector<uint8_t>(contents, contents + desc.size);
+}
+
 TEST_P(TypographerTest, CanConvertTextBlob) {
   SkFont font = flutter::testing::CreateTestFontOfSize(12);
   auto blob = SkTextBlob::MakeFromString(
@@ -259,6 +287,80 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   EXPECT_TRUE(atlas->GetTexture()->GetSize().height > 0);
 }
 
+TEST_P(TypographerTest, GlyphAtlasCanRasterizeGlyphsConcurrently) {
+  auto data_host_buffer = HostBuffer::Create(
+      GetContext()->GetResourceAllocator(), GetContext()->GetIdleWaiter(),
+      GetContext()->GetCapabilities()->GetMinimumUniformAlignment());
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto serial_context = TypographerContextSkia::Make();
+  auto context = TypographerContextSkia::Make(loop->GetTaskRunner());
+  ASSERT_TRUE(context && context->IsValid());
+  auto serial_atlas_context =
+      serial_context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm,.<>[]{};':"
+      "2134567890-=!@#$%^&*()_+",
+      sk_font);
+  ASSERT_TRUE(blob);
+  auto make_frames = [&blob](size_t first_index, size_t last_index) {
+    std::vector<std::shared_ptr<TextFrame>> frames;
+    for (size_t index = first_index; index <= last_index; index += 1) {
+      frames.push_back(MakeTextFrameFromTextBlobSkia(blob));
+      frames.back()->SetPerFrameData(Rational(index, 2), {0, 0}, Matrix(), {});
+    }
+    return frames;
+  };
+
+  // The first batch is large enough to be sharded into a fresh atlas.
+  auto serial_atlas = serial_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, *data_host_buffer,
+      serial_atlas_context, make_frames(1, 4));
+  auto atlas =
+      context->CreateGlyphAtlas(*GetContext(), GlyphAtlas::Type::kAlphaBitmap,
+                                *data_host_buffer, atlas_context,
+                                make_frames(1, 4));
+  ASSERT_NE(serial_atlas, nullptr);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+  size_t first_glyph_count = atlas->GetGlyphCount();
+  EXPECT_GT(first_glyph_count, 64u);
+  EXPECT_EQ(first_glyph_count, serial_atlas->GetGlyphCount());
+  ASSERT_EQ(atlas->GetTexture()->GetSize(),
+            serial_atlas->GetTexture()->GetSize());
+  EXPECT_EQ(ReadTexturePixels(*GetContext(), atlas->GetTexture()),
+            ReadTexturePixels(*GetContext(), serial_atlas->GetTexture()));
+
+  // The second batch is appended to the existing atlas.
+  auto next_serial_atlas = serial_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, *data_host_buffer,
+      serial_atlas_context, make_frames(5, 8));
+  auto next_atlas =
+      context->CreateGlyphAtlas(*GetContext(), GlyphAtlas::Type::kAlphaBitmap,
+                                *data_host_buffer, atlas_context,
+                                make_frames(5, 8));
+  ASSERT_NE(next_serial_atlas, nullptr);
+  ASSERT_NE(next_atlas, nullptr);
+  EXPECT_GT(next_atlas->GetGlyphCount(), first_glyph_count);
+  EXPECT_EQ(next_atlas->GetGlyphCount(), next_serial_atlas->GetGlyphCount());
+  ASSERT_EQ(next_atlas->GetTexture()->GetSize(),
+            next_serial_atlas->GetTexture()->GetSize());
+  EXPECT_EQ(ReadTexturePixels(*GetContext(), next_atlas->GetTexture()),
+            ReadTexturePixels(*GetContext(), next_serial_atlas->GetTexture()));
+
+  size_t iterated_count = next_atlas->IterateGlyphs(
+      [&](const ScaledFont& scaled_font, const SubpixelGlyph& glyph,
+          const Rect& rect) {
+        EXPECT_TRUE(Rect::MakeSize(next_atlas->GetTexture()->GetSize())
+                        .Contains(rect));
+        return true;
+      });
+  EXPECT_EQ(iterated_count, next_atlas->GetGlyphCount());
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto data_host_buffer = HostBuffer::Create(
       GetContext()->GetResourceAllocator(), GetContext()->GetIdleWaiter(),
@@ -431,6 +533,223 @@ TEST(TypographerTest, RectanglePackerFillsRows) {
   EXPECT_EQ(loc.y(), 16);
 }
 
+TEST(TypographerTest, RectanglePackerReusesReclaimedRects) {
+  auto packer = RectanglePacker::Factory(64, 32);
+
+  IPoint16 first = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(32, 32, &first));
+  IPoint16 second = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(32, 32, &second));
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 1.0));
+
+  // The packer is full.
+  IPoint16 output;
+  EXPECT_FALSE(packer->AddRect(16, 16, &output));
+
+  packer->ReclaimRect(first.x(), first.y(), 32, 32);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.5));
+
+  // A rectangle that is too large for the reclaimed area still doesn't fit.
+  EXPECT_FALSE(packer->AddRect(33, 16, &output));
+
+  // The reclaimed area can be split to hold several smaller rectangles.
+  IPoint16 third = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(16, 16, &third));
+  EXPECT_EQ(third.x(), first.x());
+  EXPECT_EQ(third.y(), first.y());
+  IPoint16 fourth = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(16, 16, &fourth));
+  IPoint16 fifth = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(32, 16, &fifth));
+  EXPECT_EQ(fifth.x(), first.x());
+  EXPECT_EQ(fifth.y(), first.y() + 16);
+  EXPECT_FALSE(SkIRect::Intersects(
+      SkIRect::MakeXYWH(third.x(), third.y(), 16, 16),
+      SkIRect::MakeXYWH(fourth.x(), fourth.y(), 16, 16)));
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 1.0));
+  EXPECT_FALSE(packer->AddRect(1, 1, &output));
+
+  // Resetting the packer discards reclaimed areas.
+  packer->ReclaimRect(second.x(), second.y(), 32, 32);
+  packer->Reset();
+  ASSERT_TRUE(packer->AddRect(64, 32, &output));
+  EXPECT_EQ(output.x(), 0);
+  EXPECT_EQ(output.y(), 0);
+}
+
+TEST(TypographerTest, RectanglePackerClipsAndMergesReclaimedRects) {
+  auto packer = RectanglePacker::Factory(64, 32);
+
+  IPoint16 first = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(32, 32, &first));
+  IPoint16 second = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(32, 32, &second));
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 1.0));
+
+  // The parts of a reclaimed rectangle beside or below the packer are
+  // ignored.
+  packer->ReclaimRect(first.x() - 16, first.y(), 48, 48);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.5));
+  packer->ReclaimRect(0, 32, 16, 16);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.5));
+
+  // Neighbouring reclaimed rectangles are merged.
+  packer->ReclaimRect(second.x(), second.y(), 32, 32);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.0));
+  IPoint16 output = {-1, -1};
+  ASSERT_TRUE(packer->AddRect(64, 32, &output));
+  EXPECT_EQ(output.x(), 0);
+  EXPECT_EQ(output.y(), 0);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 1.0));
+
+  // Space above the packer, packed by a previous packer, is reused without
+  // counting towards the area of this packer.
+  packer->ReclaimRect(0, -16, 64, 16);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 1.0));
+  ASSERT_TRUE(packer->AddRect(32, 16, &output));
+  EXPECT_EQ(output.x(), 0);
+  EXPECT_EQ(output.y(), -16);
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 1.0));
+
+  // Rectangles that can't be merged are kept up to a limit, past which the
+  // smallest are given up.
+  auto row_packer = RectanglePacker::Factory(600, 1);
+  std::vector<IPoint16> locations(600);
+  for (IPoint16& location : locations) {
+    ASSERT_TRUE(row_packer->AddRect(1, 1, &location));
+  }
+  for (size_t i = 0; i < locations.size(); i += 2) {
+    row_packer->ReclaimRect(locations[i].x(), locations[i].y(), 1, 1);
+  }
+  EXPECT_TRUE(
+      flutter::testing::NumberNear(row_packer->PercentFull(), 344.0 / 600.0));
+}
+
+TEST_P(TypographerTest, GlyphAtlasContextReclaimsLeastRecentlyUsedGlyphs) {
+  auto data_host_buffer = HostBuffer::Create(
+      GetContext()->GetResourceAllocator(), GetContext()->GetIdleWaiter(),
+      GetContext()->GetCapabilities()->GetMinimumUniformAlignment());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto cold_blob = SkTextBlob::MakeFromString("abc", sk_font);
+  auto hot_blob = SkTextBlob::MakeFromString("xyz", sk_font);
+  ASSERT_TRUE(cold_blob && hot_blob);
+
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(1),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(cold_blob));
+  ASSERT_NE(atlas, nullptr);
+  size_t cold_glyph_count = atlas->GetGlyphCount();
+  ASSERT_GT(cold_glyph_count, 0u);
+
+  auto next_atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(1),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(hot_blob));
+  ASSERT_EQ(next_atlas, atlas);
+  size_t total_glyph_count = atlas->GetGlyphCount();
+  ASSERT_GT(total_glyph_count, cold_glyph_count);
+  size_t atlas_generation = atlas->GetAtlasGeneration();
+
+  // Only the glyphs that were not used by the last update are evicted.
+  EXPECT_EQ(atlas_context->ReclaimColdGlyphs(
+                std::numeric_limits<size_t>::max(), /*min_idle_generations=*/1),
+            cold_glyph_count);
+  EXPECT_EQ(atlas->GetGlyphCount(), total_glyph_count - cold_glyph_count);
+  EXPECT_GT(atlas->GetAtlasGeneration(), atlas_generation);
+  EXPECT_EQ(atlas_context->ReclaimColdGlyphs(
+                std::numeric_limits<size_t>::max(), /*min_idle_generations=*/1),
+            0u);
+
+  // Adding the evicted glyphs back reuses the same atlas texture.
+  auto texture = atlas->GetTexture();
+  next_atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(1),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(cold_blob));
+  ASSERT_EQ(next_atlas, atlas);
+  EXPECT_EQ(atlas->GetTexture(), texture);
+  EXPECT_EQ(atlas->GetGlyphCount(), total_glyph_count);
+}
+
+TEST_P(TypographerTest, GrownGlyphAtlasReusesEvictedSpaceSmallGlyphAtlas) {
+  if (GetBackend() == PlaygroundBackend::kOpenGLES) {
+    GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
+  }
+  ASSERT_EQ(GetContext()->GetFlags().glyph_atlas_max_bytes, 4096u * 2048u);
+  if (BytesPerPixelForPixelFormat(
+          GetContext()->GetCapabilities()->GetDefaultGlyphAtlasFormat()) !=
+      1u) {
+    GTEST_SKIP() << "The atlas can only grow with a single channel format.";
+  }
+  const int64_t max_height = 2048;
+
+  auto data_host_buffer = HostBuffer::Create(
+      GetContext()->GetResourceAllocator(), GetContext()->GetIdleWaiter(),
+      GetContext()->GetCapabilities()->GetMinimumUniformAlignment());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+
+  // Every typeface is distinct, so every update adds a glyph of the same size
+  // and the least recently used glyph is evicted once the atlas is full.
+  auto add_glyph = [&]() {
+    SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+    auto frame =
+        MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("H", sk_font));
+    auto atlas =
+        CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                         GlyphAtlas::Type::kAlphaBitmap, Rational(40),
+                         atlas_context, frame);
+    return std::make_pair(atlas, frame);
+  };
+
+  // Grow the atlas to its maximum height.
+  auto atlas = add_glyph().first;
+  ASSERT_TRUE(!!atlas);
+  size_t growth_updates = 1u;
+  while (atlas_context->GetAtlasSize().height < max_height) {
+    auto [next_atlas, next_frame] = add_glyph();
+    ASSERT_EQ(next_atlas, atlas);
+    ASSERT_LT(++growth_updates, 1000u);
+  }
+  const int64_t height_adjustment = atlas_context->GetHeightAdjustment();
+  ASSERT_EQ(height_adjustment, max_height / 2);
+  auto texture = atlas->GetTexture();
+
+  // The region of the last rect packer is as tall as the region above it, so
+  // it is full well before as many glyphs have been added again. The glyphs
+  // added after that are placed in the space of evicted glyphs in the region
+  // above the packer instead of rebuilding the atlas.
+  bool reused_space_above_packer = false;
+  for (size_t i = 0; i < 2 * growth_updates; i++) {
+    auto [next_atlas, next_frame] = add_glyph();
+    ASSERT_EQ(next_atlas, atlas);
+    ASSERT_EQ(atlas->GetTexture(), texture);
+    ASSERT_EQ(atlas_context->GetAtlasSize().height, max_height);
+    const Font& font = next_frame->GetFont();
+    size_t found_glyphs = 0u;
+    atlas->IterateGlyphs([&](const ScaledFont& scaled_font,
+                             const SubpixelGlyph& glyph,
+                             const Rect& rect) -> bool {
+      if (scaled_font.font.IsEqual(font)) {
+        found_glyphs++;
+        if (rect.GetTop() < height_adjustment) {
+          reused_space_above_packer = true;
+        }
+      }
+      return true;
+    });
+    EXPECT_EQ(found_glyphs, 1u);
+  }
+  EXPECT_TRUE(reused_space_above_packer);
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
   if (GetBackend() == PlaygroundBackend::kOpenGLES) {
     GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
@@ -502,6 +821,136 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
   ASSERT_EQ(atlas->GetGlyphCount(), 2u);
 }
 
+TEST_P(TypographerTest, GlyphAtlasGrowsByAddingPagesMultiPageGlyphAtlas) {
+  ASSERT_EQ(GetContext()->GetFlags().glyph_atlas_max_pages, 4u);
+  auto data_host_buffer = HostBuffer::Create(
+      GetContext()->GetResourceAllocator(), GetContext()->GetIdleWaiter(),
+      GetContext()->GetCapabilities()->GetMinimumUniformAlignment());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", sk_font);
+  ASSERT_TRUE(blob);
+
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(10),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_TRUE(!!atlas);
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+  auto first_page = atlas->GetTexture();
+  EXPECT_EQ(first_page->GetSize(), ISize(4096, 1024));
+
+  // Keep adding the same glyphs at larger scales until a second page is
+  // needed. The first page must neither be reallocated nor resized.
+  for (int i = 11; i < 40 && atlas->GetPageCount() == 1u; i++) {
+    auto next_atlas = CreateGlyphAtlas(
+        *GetContext(), context.get(), *data_host_buffer,
+        GlyphAtlas::Type::kAlphaBitmap, Rational(i), atlas_context,
+        MakeTextFrameFromTextBlobSkia(blob));
+    ASSERT_EQ(next_atlas, atlas);
+    EXPECT_EQ(atlas->GetTexture(), first_page);
+  }
+  ASSERT_GE(atlas->GetPageCount(), 2u);
+  EXPECT_EQ(atlas->GetTexture(0), first_page);
+  EXPECT_EQ(atlas->GetTexture(1)->GetSize().width, 4096);
+
+  // Glyphs are recorded with the page they were placed in.
+  bool has_glyph_on_second_page = false;
+  atlas->IterateGlyphs([&](const ScaledFont& scaled_font,
+                           const SubpixelGlyph& glyph,
+                           const Rect& rect) -> bool {
+    auto bounds =
+        atlas->FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph});
+    EXPECT_TRUE(bounds.has_value());
+    if (bounds.has_value() && bounds->page == 1u) {
+      has_glyph_on_second_page = true;
+      EXPECT_TRUE(Rect::MakeSize(atlas->GetTexture(1)->GetSize())
+                      .Contains(bounds->atlas_bounds));
+    }
+    return true;
+  });
+  EXPECT_TRUE(has_glyph_on_second_page);
+}
+
+TEST_P(TypographerTest, RollsBackWhenPageAllocationFailsMultiPageGlyphAtlas) {
+  ASSERT_EQ(GetContext()->GetFlags().glyph_atlas_max_pages, 4u);
+  auto data_host_buffer = HostBuffer::Create(
+      GetContext()->GetResourceAllocator(), GetContext()->GetIdleWaiter(),
+      GetContext()->GetCapabilities()->GetMinimumUniformAlignment());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", sk_font);
+  ASSERT_TRUE(blob);
+
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(10),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_TRUE(!!atlas);
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+  ASSERT_EQ(atlas_context->GetPagePackerCount(), 1u);
+  const size_t glyph_count = atlas->GetGlyphCount();
+  const Scalar first_page_full =
+      atlas_context->GetPagePacker(0)->PercentFull();
+
+  // Adding the glyphs at a much larger scale needs new pages, whose textures
+  // can't be allocated.
+  const std::shared_ptr<const Capabilities>& capabilities =
+      GetContext()->GetCapabilities();
+  auto mock_allocator = std::make_shared<MockAllocator>();
+  EXPECT_CALL(*mock_allocator, GetMaxTextureSizeSupported())
+      .WillRepeatedly(::testing::Return(
+          GetContext()->GetResourceAllocator()->GetMaxTextureSizeSupported()));
+  EXPECT_CALL(*mock_allocator, OnCreateTexture(::testing::_, ::testing::_))
+      .Times(::testing::AtLeast(1))
+      .WillRepeatedly(::testing::Return(nullptr));
+  auto mock_context =
+      std::make_shared<MockImpellerContext>(GetContext()->GetFlags());
+  EXPECT_CALL(*mock_context, GetResourceAllocator())
+      .WillRepeatedly(::testing::Return(mock_allocator));
+  EXPECT_CALL(*mock_context, GetCapabilities())
+      .WillRepeatedly(::testing::ReturnRef(capabilities));
+
+  auto failed_atlas =
+      CreateGlyphAtlas(*mock_context, context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(40),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(blob));
+  EXPECT_FALSE(failed_atlas);
+
+  // The atlas and its context are left as they were.
+  EXPECT_EQ(atlas_context->GetGlyphAtlas(), atlas);
+  EXPECT_EQ(atlas->GetPageCount(), 1u);
+  EXPECT_EQ(atlas->GetGlyphCount(), glyph_count);
+  EXPECT_EQ(atlas_context->GetPagePackerCount(), 1u);
+  EXPECT_EQ(atlas_context->GetPagePacker(0)->PercentFull(), first_page_full);
+
+  // The glyphs are added once the pages can be allocated.
+  auto next_atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *data_host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, Rational(40),
+                       atlas_context, MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_EQ(next_atlas, atlas);
+  EXPECT_GE(atlas->GetPageCount(), 2u);
+  EXPECT_EQ(atlas_context->GetPagePackerCount(), atlas->GetPageCount());
+  EXPECT_GT(atlas->GetGlyphCount(), glyph_count);
+  atlas->IterateGlyphs([&](const ScaledFont& scaled_font,
+                           const SubpixelGlyph& glyph,
+                           const Rect& rect) -> bool {
+    auto bounds =
+        atlas->FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph});
+    EXPECT_TRUE(bounds.has_value() && !bounds->is_placeholder);
+    return true;
+  });
+}
+
 TEST_P(TypographerTest, TextFrameInitialBoundsArePlaceholder) {
   SkFont font = flutter::testing::CreateTestFontOfSize(12);
   auto blob = SkTextBlob::MakeFromString(
@@ -14,6 +14,7 @@
 #include "flutter/impeller/display_list/dl_image_impeller.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/lib/ui/painting/image_downscaler.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
@@ -134,7 +135,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
     const std::shared_ptr<const impeller::Capabilities>& capabilities,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    const std::shared_ptr<fml::BasicTaskRunner>& scale_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -193,10 +195,38 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
   }
 
   auto bitmap = std::make_shared<SkBitmap>();
-  bitmap->setInfo(image_info);
   auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
 
-  if (descriptor->is_compressed()) {
+  // When the image is scaled down, try decoding it straight to the target
+  // size, so that it is never held in memory at the decoded size.
+  // Unpremultiplied images are premultiplied as they are decoded.
+  bool decoded_to_target_size = false;
+  if (descriptor->is_compressed() && !is_wide_gamut &&
+      !target_size.isEmpty() && target_size != decode_size &&
+      target_size.width() <= decode_size.width() &&
+      target_size.height() <= decode_size.height()) {
+    const SkImageInfo target_info =
+        image_info.makeDimensions(target_size)
+            .makeAlphaType(alpha_type == kUnpremul_SkAlphaType
+                               ? kPremul_SkAlphaType
+                               : alpha_type);
+    bitmap->setInfo(target_info);
+    if (bitmap->tryAllocPixels(bitmap_allocator.get()) &&
+        descriptor->get_downscaled_pixels(bitmap->pixmap())) {
+      image_info = target_info;
+      alpha_type = target_info.alphaType();
+      decoded_to_target_size = true;
+    } else {
+      // Single copy of ImpellerAllocator crashes.
+      bitmap = std::make_shared<SkBitmap>();
+      bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
+    }
+  }
+
+  if (decoded_to_target_size) {
+    bitmap->setImmutable();
+  } else if (descriptor->is_compressed()) {
+    bitmap->setInfo(image_info);
     if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
       std::string decode_error(
           "Could not allocate intermediate for image decompression.");
@@ -210,6 +240,7 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       return DecompressResult{.decode_error = decode_error};
     }
   } else {
+    bitmap->setInfo(image_info);
     auto temp_bitmap = std::make_shared<SkBitmap>();
     temp_bitmap->setInfo(base_image_info);
     auto pixel_ref = SkMallocPixelRef::MakeWithData(
@@ -257,9 +288,10 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
           ? std::nullopt
           : std::optional<SkImageInfo>(image_info.makeDimensions(target_size));
 
-  if (source_size.width() > max_texture_size.width ||
-      source_size.height() > max_texture_size.height ||
-      !capabilities->SupportsTextureToTextureBlits()) {
+  if (!decoded_to_target_size &&
+      (source_size.width() > max_texture_size.width ||
+       source_size.height() > max_texture_size.height ||
+       !capabilities->SupportsTextureToTextureBlits())) {
     //----------------------------------------------------------------------------
     /// 2. If the decoded image isn't the requested target size and the src size
     ///    exceeds the device max texture size, perform a slow CPU resize.
@@ -276,7 +308,9 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
     }
-    if (!bitmap->pixmap().scalePixels(
+    if (!DownscalePixels(bitmap->pixmap(), scaled_bitmap->pixmap(),
+                         scale_task_runner) &&
+        !bitmap->pixmap().scalePixels(
             scaled_bitmap->pixmap(),
             SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone))) {
       FML_LOG(ERROR) << "Could not scale decoded bitmap data.";
@@ -554,6 +588,7 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        context = context_.get(),                                  //
        target_size = SkISize::Make(target_width, target_height),  //
        io_runner = runners_.GetIOTaskRunner(),                    //
+       concurrent_task_runner = concurrent_task_runner_,          //
        result,
        wide_gamut_enabled = wide_gamut_enabled_,  //
        gpu_disabled_switch = gpu_disabled_switch_]() {
@@ -576,7 +611,8 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
             raw_descriptor, target_size, max_size_supported,
             /*supports_wide_gamut=*/wide_gamut_enabled &&
                 context->GetCapabilities()->SupportsExtendedRangeFormats(),
-            context->GetCapabilities(), context->GetResourceAllocator());
+            context->GetCapabilities(), context->GetResourceAllocator(),
+            concurrent_task_runner);
         if (!bitmap_result.device_buffer) {
           result(nullptr, bitmap_result.decode_error);
           return;
@@ -11,6 +11,7 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
+#include "flutter/lib/ui/painting/image_downscaler.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
@@ -27,9 +28,11 @@ ImageDecoderSkia::ImageDecoderSkia(
 
 ImageDecoderSkia::~ImageDecoderSkia() = default;
 
-static sk_sp<SkImage> ResizeRasterImage(const sk_sp<SkImage>& image,
-                                        const SkISize& resized_dimensions,
-                                        const fml::tracing::TraceFlow& flow) {
+static sk_sp<SkImage> ResizeRasterImage(
+    const sk_sp<SkImage>& image,
+    const SkISize& resized_dimensions,
+    const fml::tracing::TraceFlow& flow,
+    const std::shared_ptr<fml::BasicTaskRunner>& scale_task_runner) {
   FML_DCHECK(!image->isTextureBacked());
 
   TRACE_EVENT0("flutter", __FUNCTION__);
@@ -54,7 +57,12 @@ static sk_sp<SkImage> ResizeRasterImage(const sk_sp<SkImage>& image,
     return nullptr;
   }
 
-  if (!image->scalePixels(
+  SkPixmap pixmap;
+  const bool downscaled =
+      image->peekPixels(&pixmap) &&
+      DownscalePixels(pixmap, scaled_bitmap.pixmap(), scale_task_runner);
+  if (!downscaled &&
+      !image->scalePixels(
           scaled_bitmap.pixmap(),
           SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone),
           SkImage::kDisallow_CachingHint)) {
@@ -79,7 +87,8 @@ static sk_sp<SkImage> ImageFromDecompressedData(
     ImageDescriptor* descriptor,
     uint32_t target_width,
     uint32_t target_height,
-    const fml::tracing::TraceFlow& flow) {
+    const fml::tracing::TraceFlow& flow,
+    const std::shared_ptr<fml::BasicTaskRunner>& scale_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   flow.Step(__FUNCTION__);
   auto image = SkImages::RasterFromData(
@@ -96,14 +105,15 @@ static sk_sp<SkImage> ImageFromDecompressedData(
   }
 
   return ResizeRasterImage(image, SkISize::Make(target_width, target_height),
-                           flow);
+                           flow, scale_task_runner);
 }
 
 sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     ImageDescriptor* descriptor,
     uint32_t target_width,
     uint32_t target_height,
-    const fml::tracing::TraceFlow& flow) {
+    const fml::tracing::TraceFlow& flow,
+    const std::shared_ptr<fml::BasicTaskRunner>& scale_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   flow.Step(__FUNCTION__);
 
@@ -117,6 +127,24 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
   const SkISize resized_dimensions = {static_cast<int32_t>(target_width),
                                       static_cast<int32_t>(target_height)};
 
+  // When downscaling, try decoding straight to the target size, so that the
+  // image is never held in memory at a larger size.
+  if (resized_dimensions.width() <= source_dimensions.width() &&
+      resized_dimensions.height() <= source_dimensions.height()) {
+    SkImageInfo target_info =
+        descriptor->image_info().makeDimensions(resized_dimensions);
+    if (target_info.alphaType() == kUnpremul_SkAlphaType) {
+      target_info = target_info.makeAlphaType(kPremul_SkAlphaType);
+    }
+
+    SkBitmap target_bitmap;
+    if (target_bitmap.tryAllocPixels(target_info) &&
+        descriptor->get_downscaled_pixels(target_bitmap.pixmap())) {
+      target_bitmap.setImmutable();
+      return SkImages::RasterFromBitmap(target_bitmap);
+    }
+  }
+
   auto decode_dimensions = descriptor->get_scaled_dimensions(
       std::max(static_cast<float>(resized_dimensions.width()) /
                    source_dimensions.width(),
@@ -149,7 +177,8 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
             << "Could not create a scaled image from a scaled bitmap.";
         return nullptr;
       }
-      return ResizeRasterImage(decoded_image, resized_dimensions, flow);
+      return ResizeRasterImage(decoded_image, resized_dimensions, flow,
+                               scale_task_runner);
     }
   }
 
@@ -158,7 +187,7 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     return nullptr;
   }
 
-  return ResizeRasterImage(image, resized_dimensions, flow);
+  return ResizeRasterImage(image, resized_dimensions, flow, scale_task_runner);
 }
 
 static SkiaGPUObject<SkImage> UploadRasterImage(
@@ -267,26 +296,30 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
   }
 
   concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([raw_descriptor,                          //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
+      fml::MakeCopyable([raw_descriptor,                                    //
+                         io_manager = io_manager_,                          //
+                         io_runner = runners_.GetIOTaskRunner(),            //
+                         concurrent_task_runner = concurrent_task_runner_,  //
+                         result,                                            //
+                         target_width = target_width,                       //
+                         target_height = target_height,                     //
+                         flow = std::move(flow)                             //
   ]() mutable {
         // Step 1: Decompress the image.
         // On Worker.
 
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
+        auto decompressed =
+            raw_descriptor->is_compressed()
+                ? ImageFromCompressedData(raw_descriptor,  //
+                                          target_width,    //
+                                          target_height,   //
+                                          flow,            //
+                                          concurrent_task_runner)
+                : ImageFromDecompressedData(raw_descriptor,  //
+                                            target_width,    //
+                                            target_height,   //
+                                            flow,            //
+                                            concurrent_task_runner);
 
         if (!decompressed) {
           FML_DLOG(ERROR) << "Could not decompress image.";
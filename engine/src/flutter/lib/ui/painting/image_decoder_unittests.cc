@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -13,6 +15,7 @@
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_no_gl_unittests.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_downscaler.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
@@ -27,6 +30,7 @@
 #include "impeller/core/runtime_types.h"
 #include "impeller/renderer/command_queue.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -932,6 +936,38 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100), {});
 }
 
+TEST(ImageDecoderTest, VerifyDownscaledDecodingMatchesDecodingAndScaling) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.png");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+  ASSERT_EQ(descriptor->image_info().dimensions(), SkISize::Make(300, 100));
+
+  SkBitmap full_size;
+  full_size.allocPixels(descriptor->image_info());
+  ASSERT_TRUE(descriptor->get_pixels(full_size.pixmap()));
+  SkBitmap expected;
+  expected.allocPixels(descriptor->image_info().makeWH(70, 30));
+  ASSERT_TRUE(DownscalePixels(full_size.pixmap(), expected.pixmap()));
+
+  SkBitmap actual;
+  actual.allocPixels(expected.info());
+  ASSERT_TRUE(descriptor->get_downscaled_pixels(actual.pixmap()));
+  EXPECT_EQ(std::memcmp(expected.getPixels(), actual.getPixels(),
+                        expected.computeByteSize()),
+            0);
+
+  auto image = ImageDecoderSkia::ImageFromCompressedData(
+      descriptor.get(), 70, 30, fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(70, 30));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -107,28 +107,43 @@ void ImageDescriptor::initRaw(Dart_Handle descriptor_handle,
   descriptor->AssociateWithDartWrapper(descriptor_handle);
 }
 
+unsigned int ImageDescriptor::GetFrameCount() const {
+  std::scoped_lock lock(*generator_mutex_);
+  return generator_->GetFrameCount();
+}
+
 void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
                                        int target_width,
                                        int target_height) {
   fml::RefPtr<Codec> ui_codec;
-  if (!generator_ || generator_->GetFrameCount() == 1) {
+  if (!generator_ || GetFrameCount() == 1) {
     ui_codec = fml::MakeRefCounted<SingleFrameCodec>(
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    ui_codec =
+        fml::MakeRefCounted<MultiFrameCodec>(generator_, generator_mutex_);
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
 
 sk_sp<SkImage> ImageDescriptor::image() const {
+  std::scoped_lock lock(*generator_mutex_);
   return generator_->GetImage();
 }
 
 bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
   FML_DCHECK(generator_);
+  std::scoped_lock lock(*generator_mutex_);
   return generator_->GetPixels(pixmap.info(), pixmap.writable_addr(),
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_downscaled_pixels(const SkPixmap& pixmap) const {
+  FML_DCHECK(generator_);
+  std::scoped_lock lock(*generator_mutex_);
+  return generator_->GetDownscaledPixels(pixmap.info(), pixmap.writable_addr(),
+                                         pixmap.rowBytes());
+}
+
 }  // namespace flutter
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 #include "flutter/fml/macros.h"
@@ -101,6 +102,7 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   /// @see    `ImageGenerator::GetScaledDimensions`
   SkISize get_scaled_dimensions(float scale) {
     if (generator_) {
+      std::scoped_lock lock(*generator_mutex_);
       return generator_->GetScaledDimensions(scale);
     }
     return image_info_.dimensions();
@@ -110,6 +112,14 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets pixels for this image downscaled to the size of `pixmap`,
+  ///         decoding and scaling rows as they are produced so that the full
+  ///         size image is never held in memory.
+  /// @return False if the image can't be decoded this way, in which case it
+  ///         should be decoded with `get_pixels` and scaled afterwards.
+  /// @see    `ImageGenerator::GetDownscaledPixels`
+  bool get_downscaled_pixels(const SkPixmap& pixmap) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -125,11 +135,17 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
 
   sk_sp<SkData> buffer_;
   std::shared_ptr<ImageGenerator> generator_;
+  // Guards all use of |generator_|, which is not thread safe, by this
+  // descriptor and by the codecs instantiated from it.
+  const std::shared_ptr<std::mutex> generator_mutex_ =
+      std::make_shared<std::mutex>();
   const SkImageInfo image_info_;
   std::optional<size_t> row_bytes_;
 
   const SkImageInfo CreateImageInfo() const;
 
+  unsigned int GetFrameCount() const;
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImageDescriptor);
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDescriptor);
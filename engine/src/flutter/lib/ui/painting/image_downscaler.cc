@@ -0,0 +1,311 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_downscaler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// Filter weights are fixed point numbers with this many fractional bits. The
+// weights of each destination pixel add up to exactly kWeightOne.
+constexpr int kWeightBits = 12;
+constexpr int32_t kWeightOne = 1 << kWeightBits;
+
+// The number of fractional bits kept in the results of the vertical pass,
+// which are stored as uint16_t.
+constexpr int kIntermediateBits = 8;
+
+// The number of destination rows processed by a task at a time.
+constexpr int kRowsPerBand = 16;
+
+// Images with fewer source pixels than this are always scaled on the calling
+// thread, since posting tasks costs more than it saves.
+constexpr int64_t kMinPixelsForConcurrency = 1024 * 1024;
+
+int ChannelCount(SkColorType color_type) {
+  switch (color_type) {
+    case kRGBA_8888_SkColorType:
+    case kBGRA_8888_SkColorType:
+    case kRGB_888x_SkColorType:
+      return 4;
+    case kAlpha_8_SkColorType:
+    case kGray_8_SkColorType:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+struct DownscaleJob {
+  DownscaleJob(const SkPixmap& p_src, const SkPixmap& p_dst, int p_band_count)
+      : src(p_src),
+        dst(p_dst),
+        horizontal(DownscaleFilter::Make(src.width(), dst.width())),
+        vertical(DownscaleFilter::Make(src.height(), dst.height())),
+        band_count(p_band_count),
+        latch(p_band_count) {}
+
+  const SkPixmap src;
+  const SkPixmap dst;
+  const DownscaleFilter horizontal;
+  const DownscaleFilter vertical;
+  const int band_count;
+  std::atomic_int next_band = 0;
+  fml::CountDownLatch latch;
+};
+
+// Adds |weight| times the source row to the accumulated row.
+//
+// This and the loops in ResolveRow run over contiguous memory with a fixed
+// channel count, so that the compiler can vectorize them.
+void AccumulateRow(const uint8_t* src_row,
+                   uint32_t weight,
+                   size_t row_length,
+                   uint32_t* accumulator) {
+  for (size_t i = 0; i < row_length; i++) {
+    accumulator[i] += weight * src_row[i];
+  }
+}
+
+// Writes the destination row whose source rows have all been accumulated, by
+// combining the contributing columns of the accumulated row.
+template <int kChannels>
+void ResolveRow(const DownscaleFilter& horizontal,
+                int dst_width,
+                const uint32_t* accumulator,
+                size_t row_length,
+                uint16_t* intermediate,
+                uint8_t* dst_row) {
+  constexpr int kIntermediateShift = kWeightBits - kIntermediateBits;
+  for (size_t i = 0; i < row_length; i++) {
+    intermediate[i] = static_cast<uint16_t>(
+        (accumulator[i] + (1u << (kIntermediateShift - 1))) >>
+        kIntermediateShift);
+  }
+
+  constexpr int kOutputShift = kWeightBits + kIntermediateBits;
+  for (int x = 0; x < dst_width; x++) {
+    const int32_t* column_weights = &horizontal.weights[horizontal.offset[x]];
+    const uint16_t* column =
+        &intermediate[static_cast<size_t>(horizontal.first[x]) * kChannels];
+    uint32_t sums[kChannels] = {};
+    for (int k = 0; k < horizontal.count[x]; k++) {
+      const uint32_t weight = column_weights[k];
+      for (int c = 0; c < kChannels; c++) {
+        sums[c] += weight * column[k * kChannels + c];
+      }
+    }
+    for (int c = 0; c < kChannels; c++) {
+      const uint32_t value =
+          (sums[c] + (1u << (kOutputShift - 1))) >> kOutputShift;
+      dst_row[x * kChannels + c] = static_cast<uint8_t>(std::min(value, 255u));
+    }
+  }
+}
+
+void ResolveRow(int channels,
+                const DownscaleFilter& horizontal,
+                int dst_width,
+                const uint32_t* accumulator,
+                size_t row_length,
+                uint16_t* intermediate,
+                uint8_t* dst_row) {
+  if (channels == 4) {
+    ResolveRow<4>(horizontal, dst_width, accumulator, row_length, intermediate,
+                  dst_row);
+  } else {
+    ResolveRow<1>(horizontal, dst_width, accumulator, row_length, intermediate,
+                  dst_row);
+  }
+}
+
+// Scales the destination rows [begin, end).
+//
+// The vertical pass combines the contributing source rows into a single row,
+// and the horizontal pass then combines the contributing columns of that row.
+void DownscaleRows(const DownscaleJob& job,
+                   int channels,
+                   int begin,
+                   int end,
+                   std::vector<uint32_t>& accumulator,
+                   std::vector<uint16_t>& intermediate) {
+  const SkPixmap& src = job.src;
+  const SkPixmap& dst = job.dst;
+  const uint8_t* src_pixels = static_cast<const uint8_t*>(src.addr());
+  uint8_t* dst_pixels = static_cast<uint8_t*>(dst.writable_addr());
+
+  for (int y = begin; y < end; y++) {
+    std::fill(accumulator.begin(), accumulator.end(), 0u);
+    const int32_t* row_weights = &job.vertical.weights[job.vertical.offset[y]];
+    for (int k = 0; k < job.vertical.count[y]; k++) {
+      AccumulateRow(src_pixels + (job.vertical.first[y] + k) * src.rowBytes(),
+                    row_weights[k], accumulator.size(), accumulator.data());
+    }
+    ResolveRow(channels, job.horizontal, dst.width(), accumulator.data(),
+               accumulator.size(), intermediate.data(),
+               dst_pixels + y * dst.rowBytes());
+  }
+}
+
+void RunBands(DownscaleJob& job) {
+  const int channels = ChannelCount(job.src.colorType());
+  const size_t row_length = static_cast<size_t>(job.src.width()) * channels;
+  std::vector<uint32_t> accumulator;
+  std::vector<uint16_t> intermediate;
+  int band;
+  while ((band = job.next_band.fetch_add(1)) < job.band_count) {
+    if (accumulator.empty()) {
+      accumulator.resize(row_length);
+      intermediate.resize(row_length);
+    }
+    const int begin = band * kRowsPerBand;
+    const int end = std::min(begin + kRowsPerBand, job.dst.height());
+    DownscaleRows(job, channels, begin, end, accumulator, intermediate);
+    job.latch.CountDown();
+  }
+}
+
+}  // namespace
+
+static bool IsDownscaleSupported(const SkImageInfo& src_info,
+                                 const SkImageInfo& dst_info) {
+  return src_info.colorType() == dst_info.colorType() &&
+         ChannelCount(src_info.colorType()) != 0 &&
+         src_info.alphaType() == dst_info.alphaType() &&
+         src_info.alphaType() != kUnpremul_SkAlphaType &&
+         !dst_info.isEmpty() && dst_info.width() <= src_info.width() &&
+         dst_info.height() <= src_info.height();
+}
+
+bool CanDownscalePixels(const SkPixmap& src, const SkPixmap& dst) {
+  return src.addr() != nullptr && dst.addr() != nullptr &&
+         IsDownscaleSupported(src.info(), dst.info());
+}
+
+DownscaleFilter DownscaleFilter::Make(int src_size, int dst_size) {
+  DownscaleFilter filter;
+  filter.first.resize(dst_size);
+  filter.count.resize(dst_size);
+  filter.offset.resize(dst_size);
+  const double scale = static_cast<double>(src_size) / dst_size;
+  for (int i = 0; i < dst_size; i++) {
+    const double begin = i * scale;
+    const double end = std::min<double>((i + 1) * scale, src_size);
+    const int first = static_cast<int>(begin);
+    const int last = std::min(static_cast<int>(std::ceil(end)), src_size);
+    filter.first[i] = first;
+    filter.count[i] = std::max(last - first, 1);
+    filter.offset[i] = filter.weights.size();
+
+    int32_t total = 0;
+    size_t largest = filter.weights.size();
+    for (int j = first; j < first + filter.count[i]; j++) {
+      const double overlap = std::min(end, j + 1.0) - std::max(begin, 1.0 * j);
+      const int32_t weight =
+          static_cast<int32_t>(std::lround(overlap / scale * kWeightOne));
+      filter.weights.push_back(weight);
+      total += weight;
+      if (weight > filter.weights[largest]) {
+        largest = filter.weights.size() - 1;
+      }
+    }
+    // Make the weights add up to one, so that solid colors are unchanged.
+    filter.weights[largest] += kWeightOne - total;
+  }
+  return filter;
+}
+
+bool DownscalePixels(const SkPixmap& src,
+                     const SkPixmap& dst,
+                     const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  if (!CanDownscalePixels(src, dst)) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "DownscalePixels");
+
+  const int band_count = (dst.height() + kRowsPerBand - 1) / kRowsPerBand;
+  auto job = std::make_shared<DownscaleJob>(src, dst, band_count);
+
+  const int64_t src_pixel_count =
+      static_cast<int64_t>(src.width()) * src.height();
+  if (task_runner && band_count > 1 &&
+      src_pixel_count >= kMinPixelsForConcurrency) {
+    // Tasks that only run after all bands were taken return right away.
+    const int helper_count = std::min<int>(
+        band_count - 1, std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 0; i < helper_count; i++) {
+      task_runner->PostTask([job]() { RunBands(*job); });
+    }
+  }
+
+  RunBands(*job);
+  job->latch.Wait();
+  return true;
+}
+
+bool RowDownscaler::CanDownscale(const SkImageInfo& src_info,
+                                 const SkPixmap& dst) {
+  return dst.addr() != nullptr && IsDownscaleSupported(src_info, dst.info());
+}
+
+RowDownscaler::RowDownscaler(const SkISize& src_size, const SkPixmap& dst)
+    : dst_(dst),
+      src_height_(src_size.height()),
+      channels_(ChannelCount(dst.colorType())),
+      row_length_(static_cast<size_t>(src_size.width()) * channels_),
+      horizontal_(DownscaleFilter::Make(src_size.width(), dst.width())),
+      vertical_(DownscaleFilter::Make(src_size.height(), dst.height())),
+      accumulators_{std::vector<uint32_t>(row_length_),
+                    std::vector<uint32_t>(row_length_)},
+      intermediate_(row_length_) {
+  FML_DCHECK(CanDownscale(dst.info().makeDimensions(src_size), dst));
+}
+
+RowDownscaler::~RowDownscaler() = default;
+
+void RowDownscaler::AddRow(const void* row) {
+  FML_DCHECK(!IsComplete());
+  const int src_row = next_src_row_++;
+  const uint8_t* pixels = static_cast<const uint8_t*>(row);
+  // Destination rows are completed in order, so only the next two can
+  // contain this row.
+  for (int y = next_dst_row_; y < std::min(next_dst_row_ + 2, dst_.height());
+       y++) {
+    const int k = src_row - vertical_.first[y];
+    if (k >= 0 && k < vertical_.count[y]) {
+      AccumulateRow(pixels, vertical_.weights[vertical_.offset[y] + k],
+                    row_length_, accumulators_[y % 2].data());
+    }
+  }
+
+  while (next_dst_row_ < dst_.height() &&
+         src_row + 1 >=
+             vertical_.first[next_dst_row_] + vertical_.count[next_dst_row_]) {
+    std::vector<uint32_t>& accumulator = accumulators_[next_dst_row_ % 2];
+    ResolveRow(channels_, horizontal_, dst_.width(), accumulator.data(),
+               row_length_, intermediate_.data(),
+               static_cast<uint8_t*>(dst_.writable_addr()) +
+                   next_dst_row_ * dst_.rowBytes());
+    std::fill(accumulator.begin(), accumulator.end(), 0u);
+    next_dst_row_++;
+  }
+}
+
+bool RowDownscaler::IsComplete() const {
+  return next_src_row_ >= src_height_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DOWNSCALER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_DOWNSCALER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Returns whether `DownscalePixels` can scale `src` into `dst`.
+///
+///             Both pixmaps must have the same 8-bit per channel color type
+///             (RGBA, BGRA, RGBx, alpha or gray) and alpha type, the alpha
+///             type must not be unpremultiplied, and `dst` must not be larger
+///             than `src` in either dimension.
+///
+bool CanDownscalePixels(const SkPixmap& src, const SkPixmap& dst);
+
+//------------------------------------------------------------------------------
+/// @brief      Downscales `src` into `dst` with an area (box) filter, where
+///             each destination pixel is the average of the source pixels
+///             it covers.
+///
+///             Unlike bilinear sampling without mipmaps, this doesn't alias
+///             at large scale factors, and it is considerably faster than
+///             `SkPixmap::scalePixels` with mipmaps for the large decoded
+///             images this is used for.
+///
+///             If a task runner is given, rows of large images are split
+///             across tasks posted to it. The calling thread processes rows
+///             too and returns once all rows are done, so this makes progress
+///             even when called from a task on the same runner.
+///
+/// @param[in]  src          The pixels to downscale.
+/// @param[in]  dst          The pixels to write the result to.
+/// @param[in]  task_runner  An optional runner on which to process rows
+///                          concurrently, such as the concurrent worker pool.
+///
+/// @return     Whether the pixels were scaled. This is false if
+///             `CanDownscalePixels` is false, in which case the caller should
+///             fall back to `SkPixmap::scalePixels`.
+///
+bool DownscalePixels(
+    const SkPixmap& src,
+    const SkPixmap& dst,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner = nullptr);
+
+//------------------------------------------------------------------------------
+/// @brief      The source pixels that contribute to each destination pixel
+///             along one axis of a downscale, and their weights.
+///
+struct DownscaleFilter {
+  static DownscaleFilter Make(int src_size, int dst_size);
+
+  std::vector<int> first;
+  std::vector<int> count;
+  std::vector<size_t> offset;
+  std::vector<int32_t> weights;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Downscales an image one source row at a time, with the same
+///             filter as `DownscalePixels`.
+///
+///             This allows an image to be downscaled as it is decoded,
+///             without ever holding all of its full size rows in memory.
+///             Only two rows of intermediate results are kept.
+///
+class RowDownscaler {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Returns whether rows of `src_info` can be downscaled into
+  ///             `dst`, under the same conditions as `CanDownscalePixels`.
+  ///
+  static bool CanDownscale(const SkImageInfo& src_info, const SkPixmap& dst);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a downscaler for rows of `src_size` pixels, with the
+  ///             color type of `dst`, into `dst`. `CanDownscale` must be true.
+  ///
+  RowDownscaler(const SkISize& src_size, const SkPixmap& dst);
+
+  ~RowDownscaler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the next source row, from top to bottom. Destination
+  ///             rows are written as soon as all of their source rows have
+  ///             been added.
+  ///
+  void AddRow(const void* row);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether all source rows have been added, and so all of the
+  ///             destination has been written.
+  ///
+  bool IsComplete() const;
+
+ private:
+  const SkPixmap dst_;
+  const int src_height_;
+  const int channels_;
+  const size_t row_length_;
+  const DownscaleFilter horizontal_;
+  const DownscaleFilter vertical_;
+  int next_src_row_ = 0;
+  int next_dst_row_ = 0;
+  // The accumulated source rows of the next two destination rows, since a
+  // source row may straddle two destination rows.
+  std::vector<uint32_t> accumulators_[2];
+  std::vector<uint16_t> intermediate_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RowDownscaler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DOWNSCALER_H_
@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_downscaler.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+
+namespace {
+
+enum class ScaleMode {
+  // SkPixmap::scalePixels with bilinear sampling, the previous fallback.
+  kSkiaLinear,
+  kDownscale,
+  kDownscaleConcurrently,
+};
+
+SkBitmap MakeSourceBitmap(int width, int height, SkColorType color_type) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::Make(width, height, color_type,
+                                       kPremul_SkAlphaType));
+  uint8_t* pixels = static_cast<uint8_t*>(bitmap.getPixels());
+  for (size_t i = 0; i < bitmap.computeByteSize(); i++) {
+    pixels[i] = static_cast<uint8_t>(i * 31);
+  }
+  return bitmap;
+}
+
+}  // namespace
+
+// The arguments are the source width and height, and the factor by which
+// each of them is divided.
+static void BM_DownscaleImage(benchmark::State& state,
+                              ScaleMode mode,
+                              SkColorType color_type) {
+  const int width = state.range(0);
+  const int height = state.range(1);
+  const int factor = state.range(2);
+  SkBitmap src = MakeSourceBitmap(width, height, color_type);
+  SkBitmap dst;
+  dst.allocPixels(src.info().makeWH(width / factor, height / factor));
+
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  std::shared_ptr<fml::BasicTaskRunner> task_runner =
+      mode == ScaleMode::kDownscaleConcurrently ? loop->GetTaskRunner()
+                                                : nullptr;
+  for (auto _ : state) {
+    if (mode == ScaleMode::kSkiaLinear) {
+      src.pixmap().scalePixels(
+          dst.pixmap(),
+          SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone));
+    } else {
+      DownscalePixels(src.pixmap(), dst.pixmap(), task_runner);
+    }
+    benchmark::DoNotOptimize(dst.getPixels());
+  }
+  state.SetBytesProcessed(state.iterations() * src.computeByteSize());
+  loop->Terminate();
+}
+
+// Common camera resolutions: 12 MP (4:3), 8 MP (4:3) and 1080p, scaled to a
+// half, a quarter and a thumbnail-sized eighth.
+static void CameraResolutionArgs(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"width", "height", "factor"})
+      ->ArgsProduct({{4032}, {3024}, {2, 4, 8}})
+      ->ArgsProduct({{3264}, {2448}, {2, 4, 8}})
+      ->ArgsProduct({{1920}, {1080}, {2, 4, 8}})
+      ->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_CAPTURE(BM_DownscaleImage,
+                  rgba_skia_linear,
+                  ScaleMode::kSkiaLinear,
+                  kRGBA_8888_SkColorType)
+    ->Apply(CameraResolutionArgs);
+BENCHMARK_CAPTURE(BM_DownscaleImage,
+                  rgba_box,
+                  ScaleMode::kDownscale,
+                  kRGBA_8888_SkColorType)
+    ->Apply(CameraResolutionArgs);
+BENCHMARK_CAPTURE(BM_DownscaleImage,
+                  rgba_box_concurrent,
+                  ScaleMode::kDownscaleConcurrently,
+                  kRGBA_8888_SkColorType)
+    ->Apply(CameraResolutionArgs);
+BENCHMARK_CAPTURE(BM_DownscaleImage,
+                  a8_skia_linear,
+                  ScaleMode::kSkiaLinear,
+                  kAlpha_8_SkColorType)
+    ->Apply(CameraResolutionArgs);
+BENCHMARK_CAPTURE(BM_DownscaleImage,
+                  a8_box,
+                  ScaleMode::kDownscale,
+                  kAlpha_8_SkColorType)
+    ->Apply(CameraResolutionArgs);
+BENCHMARK_CAPTURE(BM_DownscaleImage,
+                  a8_box_concurrent,
+                  ScaleMode::kDownscaleConcurrently,
+                  kAlpha_8_SkColorType)
+    ->Apply(CameraResolutionArgs);
+
+}  // namespace flutter
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_downscaler.h"
+
+#include <cstring>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ImageDownscalerTest, AveragesCoveredPixels) {
+  SkBitmap src;
+  src.allocPixels(SkImageInfo::Make(4, 2, kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType));
+  // Each 2x2 block of the source becomes one destination pixel.
+  const uint32_t colors[2][4] = {
+      {0x00000000, 0x04040404, 0xFF000000, 0xFF000000},
+      {0x08080808, 0x0C0C0C0C, 0xFF00FF00, 0xFF000000},
+  };
+  for (int y = 0; y < 2; y++) {
+    for (int x = 0; x < 4; x++) {
+      *src.getAddr32(x, y) = colors[y][x];
+    }
+  }
+
+  SkBitmap dst;
+  dst.allocPixels(src.info().makeWH(2, 1));
+  ASSERT_TRUE(DownscalePixels(src.pixmap(), dst.pixmap()));
+  EXPECT_EQ(*dst.getAddr32(0, 0), 0x06060606u);
+  EXPECT_EQ(*dst.getAddr32(1, 0), 0xFF004000u);
+}
+
+TEST(ImageDownscalerTest, PreservesSolidColorsAtFractionalScales) {
+  SkBitmap src;
+  src.allocPixels(
+      SkImageInfo::Make(97, 61, kGray_8_SkColorType, kOpaque_SkAlphaType));
+  src.eraseColor(SkColorSetRGB(0x7F, 0x7F, 0x7F));
+
+  SkBitmap dst;
+  dst.allocPixels(src.info().makeWH(13, 29));
+  ASSERT_TRUE(DownscalePixels(src.pixmap(), dst.pixmap()));
+  for (int y = 0; y < dst.height(); y++) {
+    for (int x = 0; x < dst.width(); x++) {
+      ASSERT_EQ(*dst.getAddr8(x, y), 0x7F) << x << ", " << y;
+    }
+  }
+}
+
+TEST(ImageDownscalerTest, RejectsUnsupportedPixmaps) {
+  SkBitmap src;
+  src.allocPixels(
+      SkImageInfo::Make(8, 8, kRGBA_F16_SkColorType, kPremul_SkAlphaType));
+  SkBitmap dst;
+  dst.allocPixels(src.info().makeWH(4, 4));
+  EXPECT_FALSE(DownscalePixels(src.pixmap(), dst.pixmap()));
+
+  SkBitmap unpremul;
+  unpremul.allocPixels(
+      SkImageInfo::Make(8, 8, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));
+  SkBitmap unpremul_dst;
+  unpremul_dst.allocPixels(unpremul.info().makeWH(4, 4));
+  EXPECT_FALSE(CanDownscalePixels(unpremul.pixmap(), unpremul_dst.pixmap()));
+
+  SkBitmap small;
+  small.allocPixels(
+      SkImageInfo::Make(4, 4, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+  SkBitmap large;
+  large.allocPixels(small.info().makeWH(8, 8));
+  EXPECT_FALSE(CanDownscalePixels(small.pixmap(), large.pixmap()));
+}
+
+TEST(ImageDownscalerTest, ConcurrentScalingMatchesSingleThreadedScaling) {
+  SkBitmap src;
+  src.allocPixels(SkImageInfo::Make(1500, 1000, kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType));
+  for (int y = 0; y < src.height(); y++) {
+    for (int x = 0; x < src.width(); x++) {
+      *src.getAddr32(x, y) = 0xFF000000 | ((x * 7) & 0xFF) << 16 |
+                             ((y * 13) & 0xFF) << 8 | ((x + y) & 0xFF);
+    }
+  }
+
+  SkBitmap expected;
+  expected.allocPixels(src.info().makeWH(333, 250));
+  ASSERT_TRUE(DownscalePixels(src.pixmap(), expected.pixmap()));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  SkBitmap actual;
+  actual.allocPixels(expected.info());
+  ASSERT_TRUE(
+      DownscalePixels(src.pixmap(), actual.pixmap(), loop->GetTaskRunner()));
+
+  EXPECT_EQ(std::memcmp(expected.getPixels(), actual.getPixels(),
+                        expected.computeByteSize()),
+            0);
+  loop->Terminate();
+}
+
+TEST(ImageDownscalerTest, RowDownscalerMatchesDownscalePixels) {
+  SkBitmap src;
+  src.allocPixels(SkImageInfo::Make(487, 311, kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType));
+  for (int y = 0; y < src.height(); y++) {
+    for (int x = 0; x < src.width(); x++) {
+      *src.getAddr32(x, y) = 0xFF000000 | ((x * 5) & 0xFF) << 16 |
+                             ((y * 11) & 0xFF) << 8 | ((x * y) & 0xFF);
+    }
+  }
+
+  SkBitmap expected;
+  expected.allocPixels(src.info().makeWH(97, 40));
+  ASSERT_TRUE(DownscalePixels(src.pixmap(), expected.pixmap()));
+
+  SkBitmap actual;
+  actual.allocPixels(expected.info());
+  ASSERT_TRUE(RowDownscaler::CanDownscale(src.info(), actual.pixmap()));
+  RowDownscaler downscaler(src.dimensions(), actual.pixmap());
+  for (int y = 0; y < src.height(); y++) {
+    ASSERT_FALSE(downscaler.IsComplete());
+    downscaler.AddRow(src.getAddr(0, y));
+  }
+  EXPECT_TRUE(downscaler.IsComplete());
+
+  EXPECT_EQ(std::memcmp(expected.getPixels(), actual.getPixels(),
+                        expected.computeByteSize()),
+            0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,9 +4,13 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_downscaler.h"
 #include "third_party/skia/include/codec/SkEncodedOrigin.h"
 #include "third_party/skia/include/codec/SkPixmapUtils.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -16,6 +20,12 @@ namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+bool ImageGenerator::GetDownscaledPixels(const SkImageInfo& info,
+                                         void* pixels,
+                                         size_t row_bytes) {
+  return false;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -188,6 +198,61 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetDownscaledPixels(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes) {
+  // Rows are only produced in display order for images that don't need to be
+  // re-oriented.
+  if (codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getFrameCount() > 1) {
+    return false;
+  }
+
+  // Let the codec do as much of the scaling as it can while decoding, as it
+  // does for GetPixels.
+  const SkISize full_size = codec_->dimensions();
+  SkISize decode_size = codec_->getScaledDimensions(
+      std::max(static_cast<float>(info.width()) / full_size.width(),
+               static_cast<float>(info.height()) / full_size.height()));
+  if (decode_size.width() < info.width() ||
+      decode_size.height() < info.height()) {
+    decode_size = full_size;
+  }
+
+  const SkImageInfo decode_info = info.makeDimensions(decode_size);
+  SkPixmap output_pixmap(info, pixels, row_bytes);
+  if (!RowDownscaler::CanDownscale(decode_info, output_pixmap)) {
+    return false;
+  }
+  if (codec_->startScanlineDecode(decode_info) != SkCodec::kSuccess) {
+    // Not all codecs support decoding rows incrementally.
+    return false;
+  }
+  if (codec_->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+
+  TRACE_EVENT0("flutter", "GetDownscaledPixels");
+  RowDownscaler downscaler(decode_size, output_pixmap);
+  constexpr int kRowsPerRead = 16;
+  const size_t decode_row_bytes = decode_info.minRowBytes();
+  std::vector<uint8_t> rows(decode_row_bytes * kRowsPerRead);
+  while (!downscaler.IsComplete()) {
+    const int row_count = std::min(
+        kRowsPerRead, decode_size.height() - codec_->nextScanline());
+    if (codec_->getScanlines(rows.data(), row_count, decode_row_bytes) !=
+        row_count) {
+      FML_DLOG(WARNING) << "codec could not get scanlines.";
+      return false;
+    }
+    for (int i = 0; i < row_count; i++) {
+      downscaler.AddRow(rows.data() + i * decode_row_bytes);
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -135,6 +135,31 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Decode the first frame of the image into a given buffer,
+  ///             downscaled to any size no larger than the image, without
+  ///             holding the full size image in memory at any point.
+  ///
+  ///             This is used to decode large images into small textures,
+  ///             such as photos into thumbnails, with a fraction of the
+  ///             memory that decoding with `GetPixels` and then scaling
+  ///             would need.
+  /// @param[in]  info       The desired size and color info of the decoded
+  ///                        image to be returned.
+  /// @param[in]  pixels     The location where the raw decoded image data
+  ///                        should be written.
+  /// @param[in]  row_bytes  The total number of bytes that should make up a
+  ///                        single row of decoded image data.
+  /// @return     True if the image was successfully decoded. False if the
+  ///             generator can't decode this image to this size, in which
+  ///             case callers should decode it with `GetPixels` and scale it
+  ///             afterwards. The default implementation always returns false.
+  /// @note       Like `GetPixels`, this method performs potentially long
+  ///             synchronous work and should never be executed on the UI
+  ///             thread.
+  virtual bool GetDownscaledPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +237,11 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetDownscaledPixels(const SkImageInfo& info,
+                           void* pixels,
+                           size_t row_bytes) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
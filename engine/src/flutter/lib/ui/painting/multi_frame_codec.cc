@@ -15,7 +15,6 @@
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "third_party/dart/runtime/include/dart_api.h"
-#include "third_party/skia/include/codec/SkCodecAnimation.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
@@ -23,18 +22,27 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 std::shared_ptr<std::mutex> generator_mutex)
+    : state_(new State(std::move(generator),
+                       std::move(generator_mutex),
+                       UIDartState::Current()->GetConcurrentTaskRunner())) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
-    : generator_(std::move(generator)),
-      frameCount_(generator_->GetFrameCount()),
-      repetitionCount_(generator_->GetPlayCount() ==
+MultiFrameCodec::State::State(
+    std::shared_ptr<ImageGenerator> generator,
+    std::shared_ptr<std::mutex> generator_mutex,
+    std::shared_ptr<fml::BasicTaskRunner> concurrent_task_runner)
+    : decoder_(std::make_shared<MultiFrameDecoder>(
+          std::move(generator),
+          std::move(generator_mutex),
+          std::move(concurrent_task_runner))),
+      frameCount_(decoder_->GetFrameCount()),
+      repetitionCount_(decoder_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
-                           : generator_->GetPlayCount() - 1),
+                           : decoder_->GetPlayCount() - 1),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
 
 static void InvokeNextFrameCallback(
@@ -57,92 +65,16 @@ static void InvokeNextFrameCallback(
 
 std::pair<sk_sp<DlImage>, std::string>
 MultiFrameCodec::State::GetNextFrameImage(
+    const MultiFrameDecoder::Frame& frame,
     const fml::WeakPtr<GrDirectContext>& resourceContext,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     const std::shared_ptr<impeller::Context>& impeller_context,
     const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
-  }
-  if (!bitmap.tryAllocPixels(info)) {
-    std::ostringstream ostr;
-    ostr << "Failed to allocate memory for bitmap of size "
-         << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
-  }
-
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
-
-  const int requiredFrameIndex =
-      frameInfo.required_frame.value_or(SkCodec::kNoFrame);
-
-  if (requiredFrameIndex != SkCodec::kNoFrame) {
-    // We are here when the frame said |disposal_method| is
-    // `DisposalMethod::kKeep` or `DisposalMethod::kRestorePrevious` and
-    // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
-    if (!lastRequiredFrame_.has_value()) {
-      FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
-          << requiredFrameIndex
-          << " and no required frames are cached. Using blank slate instead.";
-    } else {
-      // Copy the previous frame's output buffer into the current frame as the
-      // starting point.
-      bitmap.writePixels(lastRequiredFrame_->pixmap());
-      if (restoreBGColorRect_.has_value()) {
-        bitmap.erase(SK_ColorTRANSPARENT, restoreBGColorRect_.value());
-      }
-    }
-  }
-
-  // Write the new frame to the output buffer. The bitmap pixels as supplied
-  // are already set in accordance with the previous frame's disposal policy.
-  if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
-  }
-
-  const bool keep_current_frame =
-      frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
-  const bool restore_previous_frame =
-      frameInfo.disposal_method ==
-      SkCodecAnimation::DisposalMethod::kRestorePrevious;
-  const bool previous_frame_available = lastRequiredFrame_.has_value();
-
-  // Store the current frame in `lastRequiredFrame_` if the frame's disposal
-  // method indicates we should do so.
-  // * When the disposal method is "Keep", the stored frame should always be
-  //   overwritten with the new frame we just crafted.
-  // * When the disposal method is "RestorePrevious", the previously stored
-  //   frame should be retained and used as the backdrop for the next frame
-  //   again. If there isn't already a stored frame, that means we haven't
-  //   rendered any frames yet! When this happens, we just fall back to "Keep"
-  //   behavior and store the current frame as the backdrop of the next frame.
-
-  if (keep_current_frame ||
-      (previous_frame_available && !restore_previous_frame)) {
-    // Replace the stored frame. The `lastRequiredFrame_` will get used as the
-    // starting backdrop for the next frame.
-    lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
-  }
-
-  if (frameInfo.disposal_method ==
-      SkCodecAnimation::DisposalMethod::kRestoreBGColor) {
-    restoreBGColorRect_ = frameInfo.disposal_rect;
-  } else {
-    restoreBGColorRect_.reset();
+  if (frame.bitmap.isNull()) {
+    return std::make_pair(nullptr, frame.decode_error);
   }
+  SkBitmap bitmap = frame.bitmap;
+  const SkImageInfo& info = bitmap.info();
 
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
@@ -233,16 +165,15 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   int duration = 0;
   sk_sp<DlImage> dlImage;
   std::string decode_error;
-  std::tie(dlImage, decode_error) = GetNextFrameImage(
-      resourceContext, gpu_disable_sync_switch, impeller_context, unref_queue);
+  MultiFrameDecoder::Frame frame = decoder_->GetNextFrame();
+  std::tie(dlImage, decode_error) =
+      GetNextFrameImage(frame, resourceContext, gpu_disable_sync_switch,
+                        impeller_context, unref_queue);
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -8,14 +8,27 @@
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
 
+#include <memory>
+#include <mutex>
 #include <utility>
 
 namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a codec for the frames of `generator`.
+  ///
+  /// @param[in]  generator        The generator of the frames.
+  /// @param[in]  generator_mutex  The mutex that guards all use of
+  ///                              `generator`, shared by all of its users, or
+  ///                              nullptr if only this codec uses it.
+  ///
+  explicit MultiFrameCodec(
+      std::shared_ptr<ImageGenerator> generator,
+      std::shared_ptr<std::mutex> generator_mutex = nullptr);
 
   ~MultiFrameCodec() override;
 
@@ -39,27 +52,20 @@ class MultiFrameCodec : public Codec {
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
   struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+    State(std::shared_ptr<ImageGenerator> generator,
+          std::shared_ptr<std::mutex> generator_mutex,
+          std::shared_ptr<fml::BasicTaskRunner> concurrent_task_runner);
+
+    // Composites the frames, and decodes upcoming frames ahead of time on the
+    // concurrent task runner. The codec only uses the generator through it.
+    const std::shared_ptr<MultiFrameDecoder> decoder_;
 
-    const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
 
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
-    int nextFrameIndex_ = 0;
-    // The last decoded frame that's required to decode any subsequent frames.
-    std::optional<SkBitmap> lastRequiredFrame_;
-    // The index of the last decoded required frame.
-    int lastRequiredFrameIndex_ = -1;
-
-    // The rectangle that should be cleared if the previous frame's disposal
-    // method was kRestoreBGColor.
-    std::optional<SkIRect> restoreBGColorRect_;
-
     std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+        const MultiFrameDecoder::Frame& frame,
         const fml::WeakPtr<GrDirectContext>& resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -0,0 +1,331 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/codec/SkCodecAnimation.h"
+
+namespace flutter {
+
+static int GetFrameCount(ImageGenerator& generator, std::mutex& mutex) {
+  std::scoped_lock lock(mutex);
+  return generator.GetFrameCount();
+}
+
+static unsigned int GetPlayCount(ImageGenerator& generator, std::mutex& mutex) {
+  std::scoped_lock lock(mutex);
+  return generator.GetPlayCount();
+}
+
+static SkImageInfo GetFrameImageInfo(ImageGenerator& generator,
+                                     std::mutex& mutex) {
+  std::scoped_lock lock(mutex);
+  SkImageInfo info = generator.GetInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+  return info;
+}
+
+MultiFrameDecoder::LookAheadBudget::LookAheadBudget(size_t byte_budget)
+    : byte_budget_(byte_budget) {}
+
+const std::shared_ptr<MultiFrameDecoder::LookAheadBudget>&
+MultiFrameDecoder::LookAheadBudget::GetShared() {
+  // Decoders may be released during shutdown, so the budget is never
+  // destroyed.
+  static std::shared_ptr<LookAheadBudget>* budget =
+      new std::shared_ptr<LookAheadBudget>(
+          std::make_shared<LookAheadBudget>(kDefaultLookAheadByteBudget));
+  return *budget;
+}
+
+bool MultiFrameDecoder::LookAheadBudget::TryReserve(size_t bytes) {
+  std::scoped_lock lock(mutex_);
+  if (reserved_bytes_ + bytes > byte_budget_) {
+    return false;
+  }
+  reserved_bytes_ += bytes;
+  return true;
+}
+
+void MultiFrameDecoder::LookAheadBudget::Release(size_t bytes) {
+  std::scoped_lock lock(mutex_);
+  FML_DCHECK(bytes <= reserved_bytes_);
+  reserved_bytes_ -= bytes;
+}
+
+bool MultiFrameDecoder::LookAheadBudget::HasRoomFor(size_t bytes) const {
+  std::scoped_lock lock(mutex_);
+  return reserved_bytes_ + bytes <= byte_budget_;
+}
+
+size_t MultiFrameDecoder::LookAheadBudget::GetReservedBytes() const {
+  std::scoped_lock lock(mutex_);
+  return reserved_bytes_;
+}
+
+static std::shared_ptr<std::mutex> EnsureGeneratorMutex(
+    std::shared_ptr<std::mutex> generator_mutex) {
+  if (!generator_mutex) {
+    return std::make_shared<std::mutex>();
+  }
+  return generator_mutex;
+}
+
+MultiFrameDecoder::MultiFrameDecoder(
+    std::shared_ptr<ImageGenerator> generator,
+    std::shared_ptr<std::mutex> generator_mutex,
+    std::shared_ptr<fml::BasicTaskRunner> look_ahead_task_runner,
+    size_t look_ahead_frame_count,
+    std::shared_ptr<LookAheadBudget> look_ahead_budget)
+    : generator_(std::move(generator)),
+      generator_mutex_(EnsureGeneratorMutex(std::move(generator_mutex))),
+      frame_count_(GetFrameCount(*generator_, *generator_mutex_)),
+      play_count_(GetPlayCount(*generator_, *generator_mutex_)),
+      look_ahead_task_runner_(std::move(look_ahead_task_runner)),
+      look_ahead_frame_count_(look_ahead_frame_count),
+      look_ahead_budget_(look_ahead_budget ? std::move(look_ahead_budget)
+                                           : LookAheadBudget::GetShared()),
+      frame_info_(GetFrameImageInfo(*generator_, *generator_mutex_)),
+      frame_bytes_(frame_info_.computeMinByteSize()) {}
+
+MultiFrameDecoder::~MultiFrameDecoder() {
+  look_ahead_budget_->Release(look_ahead_bytes_);
+}
+
+int MultiFrameDecoder::GetFrameCount() const {
+  return frame_count_;
+}
+
+unsigned int MultiFrameDecoder::GetPlayCount() const {
+  return play_count_;
+}
+
+MultiFrameDecoder::Frame MultiFrameDecoder::GetNextFrame() {
+  Frame frame;
+  {
+    std::scoped_lock lock(mutex_);
+    if (TakeLookAheadFrameLocked(frame)) {
+      return frame;
+    }
+  }
+
+  // Wait for any frame that is being decoded ahead of time. It is queued
+  // before the lock is released, so that frames are returned in order.
+  std::scoped_lock decode_lock(decode_mutex_);
+  {
+    std::scoped_lock lock(mutex_);
+    if (TakeLookAheadFrameLocked(frame)) {
+      return frame;
+    }
+    if (look_ahead_task_runner_) {
+      look_ahead_miss_count_++;
+    }
+  }
+  frame = DecodeNextFrameLocked();
+
+  std::scoped_lock lock(mutex_);
+  ScheduleLookAheadLocked();
+  TraceLookAheadLocked();
+  return frame;
+}
+
+bool MultiFrameDecoder::TakeLookAheadFrameLocked(Frame& frame) {
+  if (look_ahead_frames_.empty()) {
+    return false;
+  }
+  frame = std::move(look_ahead_frames_.front());
+  look_ahead_frames_.pop_front();
+  look_ahead_bytes_ -= frame_bytes_;
+  look_ahead_budget_->Release(frame_bytes_);
+  look_ahead_hit_count_++;
+  ScheduleLookAheadLocked();
+  TraceLookAheadLocked();
+  return true;
+}
+
+void MultiFrameDecoder::TraceLookAheadLocked() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "MultiFrameDecoder",
+                    reinterpret_cast<int64_t>(this), "LookAheadHits",
+                    look_ahead_hit_count_, "LookAheadMisses",
+                    look_ahead_miss_count_, "LookAheadFrames",
+                    look_ahead_frames_.size(), "LookAheadKBytes",
+                    look_ahead_bytes_ / 1024);
+#endif  // !FLUTTER_RELEASE
+}
+
+size_t MultiFrameDecoder::GetLookAheadHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return look_ahead_hit_count_;
+}
+
+size_t MultiFrameDecoder::GetLookAheadMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return look_ahead_miss_count_;
+}
+
+size_t MultiFrameDecoder::GetLookAheadFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return look_ahead_frames_.size();
+}
+
+bool MultiFrameDecoder::IsLookAheadFullLocked() const {
+  return look_ahead_frames_.size() >= look_ahead_frame_count_;
+}
+
+bool MultiFrameDecoder::IsPlaybackDecodedLocked() const {
+  if (play_count_ == ImageGenerator::kInfinitePlayCount) {
+    return false;
+  }
+  return decoded_frame_count_ >=
+         static_cast<size_t>(frame_count_) * std::max(play_count_, 1u);
+}
+
+void MultiFrameDecoder::ScheduleLookAheadLocked() {
+  if (!look_ahead_task_runner_ || frame_count_ <= 1 || look_ahead_pending_ ||
+      look_ahead_exhausted_ || IsLookAheadFullLocked() ||
+      !look_ahead_budget_->HasRoomFor(frame_bytes_)) {
+    return;
+  }
+  look_ahead_pending_ = true;
+  look_ahead_task_runner_->PostTask([weak_decoder = weak_from_this()]() {
+    if (auto decoder = weak_decoder.lock()) {
+      decoder->DecodeAhead();
+    }
+  });
+}
+
+void MultiFrameDecoder::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameDecoder::DecodeAhead");
+  while (true) {
+    // Frames are decoded without holding |mutex_|, so that a frame that is
+    // ready can be taken while the next one is decoded.
+    std::scoped_lock decode_lock(decode_mutex_);
+    {
+      std::scoped_lock lock(mutex_);
+      // Frames past the last repetition are never requested.
+      if (IsPlaybackDecodedLocked()) {
+        look_ahead_exhausted_ = true;
+      }
+      if (look_ahead_exhausted_ || IsLookAheadFullLocked() ||
+          !look_ahead_budget_->TryReserve(frame_bytes_)) {
+        look_ahead_pending_ = false;
+        return;
+      }
+    }
+    Frame frame = DecodeNextFrameLocked();
+    const bool failed = frame.bitmap.isNull();
+    std::scoped_lock lock(mutex_);
+    look_ahead_bytes_ += frame_bytes_;
+    // A failed frame is queued as well, so that its error is reported when it
+    // is requested.
+    look_ahead_frames_.push_back(std::move(frame));
+    if (failed) {
+      look_ahead_pending_ = false;
+      return;
+    }
+  }
+}
+
+MultiFrameDecoder::Frame MultiFrameDecoder::DecodeNextFrameLocked() {
+  TRACE_EVENT0("flutter", "MultiFrameDecoder::DecodeNextFrame");
+  const int frame_index = decode_index_;
+  decode_index_ = (decode_index_ + 1) % frame_count_;
+  decoded_frame_count_++;
+
+  Frame frame;
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(frame_info_)) {
+    std::ostringstream ostr;
+    ostr << "Failed to allocate memory for bitmap of size "
+         << frame_info_.computeMinByteSize() << "B";
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
+  }
+
+  // Other decoders of the same generator may be decoding on other threads.
+  std::scoped_lock generator_lock(*generator_mutex_);
+  ImageGenerator::FrameInfo frame_info = generator_->GetFrameInfo(frame_index);
+
+  const int required_frame_index =
+      frame_info.required_frame.value_or(SkCodec::kNoFrame);
+
+  if (required_frame_index != SkCodec::kNoFrame) {
+    // We are here when the frame said |disposal_method| is
+    // `DisposalMethod::kKeep` or `DisposalMethod::kRestorePrevious` and
+    // |required_frame_index| is set to ex-frame or ex-ex-frame.
+    if (!last_required_frame_.has_value()) {
+      FML_DLOG(INFO)
+          << "Frame " << frame_index << " depends on frame "
+          << required_frame_index
+          << " and no required frames are cached. Using blank slate instead.";
+    } else {
+      // Copy the previous frame's output buffer into the current frame as the
+      // starting point.
+      bitmap.writePixels(last_required_frame_->pixmap());
+      if (restore_bg_color_rect_.has_value()) {
+        bitmap.erase(SK_ColorTRANSPARENT, restore_bg_color_rect_.value());
+      }
+    }
+  }
+
+  // Write the new frame to the output buffer. The bitmap pixels as supplied
+  // are already set in accordance with the previous frame's disposal policy.
+  if (!generator_->GetPixels(frame_info_, bitmap.getPixels(),
+                             bitmap.rowBytes(), frame_index,
+                             required_frame_index)) {
+    std::ostringstream ostr;
+    ostr << "Could not getPixels for frame " << frame_index;
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
+  }
+
+  const bool keep_current_frame =
+      frame_info.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
+  const bool restore_previous_frame =
+      frame_info.disposal_method ==
+      SkCodecAnimation::DisposalMethod::kRestorePrevious;
+  const bool previous_frame_available = last_required_frame_.has_value();
+
+  // Store the current frame in `last_required_frame_` if the frame's disposal
+  // method indicates we should do so.
+  // * When the disposal method is "Keep", the stored frame should always be
+  //   overwritten with the new frame we just crafted.
+  // * When the disposal method is "RestorePrevious", the previously stored
+  //   frame should be retained and used as the backdrop for the next frame
+  //   again. If there isn't already a stored frame, that means we haven't
+  //   rendered any frames yet! When this happens, we just fall back to "Keep"
+  //   behavior and store the current frame as the backdrop of the next frame.
+
+  if (keep_current_frame ||
+      (previous_frame_available && !restore_previous_frame)) {
+    // Replace the stored frame. The `last_required_frame_` will get used as
+    // the starting backdrop for the next frame.
+    last_required_frame_ = bitmap;
+  }
+
+  if (frame_info.disposal_method ==
+      SkCodecAnimation::DisposalMethod::kRestoreBGColor) {
+    restore_bg_color_rect_ = frame_info.disposal_rect;
+  } else {
+    restore_bg_color_rect_.reset();
+  }
+
+  frame.bitmap = std::move(bitmap);
+  frame.duration = frame_info.duration;
+  return frame;
+}
+
+}  // namespace flutter
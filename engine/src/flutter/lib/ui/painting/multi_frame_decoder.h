@@ -0,0 +1,235 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Composites the frames of an animated image in playback order.
+///
+///             Each frame of an animated image may be drawn on top of an
+///             earlier one, according to the disposal method and required
+///             frame reported by `ImageGenerator::GetFrameInfo`, so frames
+///             are always composited one after the other.
+///
+///             When given a task runner, the decoder also composites up to a
+///             fixed number of upcoming frames ahead of time on that runner,
+///             so that frames that take longer to decode than to display
+///             don't stall the animation. Frames decoded ahead of time are
+///             held in memory until they are requested, within a byte budget
+///             that is usually shared by all decoders. Frames past the last
+///             repetition of the animation are not decoded ahead of time.
+///
+///             `GetNextFrame` may be called on any one thread at a time. The
+///             image generator is only ever used under a lock, which is
+///             separate from the lock on the decoded frames, so that a frame
+///             decoded ahead of time can be taken while the next one is
+///             decoded. Decoders of the same generator must share that lock,
+///             as image generators are not thread safe.
+///
+class MultiFrameDecoder
+    : public std::enable_shared_from_this<MultiFrameDecoder> {
+ public:
+  // The default number of frames to decode ahead of the current one.
+  static constexpr size_t kDefaultLookAheadFrameCount = 3;
+
+  // The size of the byte budget shared by default by all decoders.
+  static constexpr size_t kDefaultLookAheadByteBudget = 32 * 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A limit on the memory held by frames decoded ahead of time,
+  ///             which may be shared by several decoders.
+  ///
+  class LookAheadBudget {
+   public:
+    explicit LookAheadBudget(size_t byte_budget);
+
+    //--------------------------------------------------------------------------
+    /// @brief      The budget shared by decoders that are not given one, of
+    ///             `kDefaultLookAheadByteBudget` bytes.
+    ///
+    static const std::shared_ptr<LookAheadBudget>& GetShared();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Reserves `bytes` of the budget, if they are available.
+    ///
+    bool TryReserve(size_t bytes);
+
+    //--------------------------------------------------------------------------
+    /// @brief      Returns `bytes` previously reserved with `TryReserve`.
+    ///
+    void Release(size_t bytes);
+
+    //--------------------------------------------------------------------------
+    /// @brief      Whether `bytes` could currently be reserved.
+    ///
+    bool HasRoomFor(size_t bytes) const;
+
+    size_t GetReservedBytes() const;
+
+   private:
+    const size_t byte_budget_;
+    mutable std::mutex mutex_;
+    size_t reserved_bytes_ = 0;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(LookAheadBudget);
+  };
+
+  struct Frame {
+    // The composited frame, or a null bitmap if decoding failed.
+    SkBitmap bitmap;
+    // The duration of the frame in milliseconds.
+    int duration = 0;
+    // The reason decoding failed, if it did.
+    std::string decode_error;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a decoder for the frames of `generator`.
+  ///
+  /// @param[in]  generator                The generator of the frames.
+  /// @param[in]  generator_mutex          The mutex that guards all use of
+  ///                                      `generator`, shared with every other
+  ///                                      user of the generator, or nullptr if
+  ///                                      the generator is only used by this
+  ///                                      decoder.
+  /// @param[in]  look_ahead_task_runner   The runner on which to decode
+  ///                                      upcoming frames, or nullptr to
+  ///                                      decode every frame on request.
+  /// @param[in]  look_ahead_frame_count   The maximum number of frames to
+  ///                                      decode ahead of time.
+  /// @param[in]  look_ahead_budget        The budget for the memory held by
+  ///                                      frames decoded ahead of time, or
+  ///                                      nullptr to use the shared budget.
+  ///
+  MultiFrameDecoder(
+      std::shared_ptr<ImageGenerator> generator,
+      std::shared_ptr<std::mutex> generator_mutex,
+      std::shared_ptr<fml::BasicTaskRunner> look_ahead_task_runner,
+      size_t look_ahead_frame_count = kDefaultLookAheadFrameCount,
+      std::shared_ptr<LookAheadBudget> look_ahead_budget = nullptr);
+
+  ~MultiFrameDecoder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the next frame in playback order, and schedules the
+  ///             decoding of the frames after it.
+  ///
+  ///             After the last frame, playback starts over from the first.
+  ///
+  Frame GetNextFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames of the image.
+  ///
+  int GetFrameCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of times the animation should play through, or
+  ///             `ImageGenerator::kInfinitePlayCount`.
+  ///
+  unsigned int GetPlayCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames returned by `GetNextFrame` that had
+  ///             already been decoded ahead of time.
+  ///
+  size_t GetLookAheadHitCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames returned by `GetNextFrame` that had to
+  ///             be decoded on request, even though look-ahead is enabled.
+  ///
+  size_t GetLookAheadMissCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames currently held after being decoded
+  ///             ahead of time.
+  ///
+  size_t GetLookAheadFrameCount() const;
+
+ private:
+  // Composites the frame at |decode_index_| onto the previously required
+  // frame, and advances |decode_index_|. Requires |decode_mutex_|.
+  Frame DecodeNextFrameLocked();
+
+  // Moves the oldest frame decoded ahead of time into |frame|, if there is
+  // one. Requires |mutex_|.
+  bool TakeLookAheadFrameLocked(Frame& frame);
+
+  void ScheduleLookAheadLocked();
+
+  void TraceLookAheadLocked() const;
+
+  // Decodes upcoming frames until the look-ahead queue is full.
+  void DecodeAhead();
+
+  // Whether all frames of all repetitions have been composited. Requires
+  // |decode_mutex_|.
+  bool IsPlaybackDecodedLocked() const;
+
+  bool IsLookAheadFullLocked() const;
+
+  const std::shared_ptr<ImageGenerator> generator_;
+  // Guards all use of |generator_|. When held with the locks below, this one
+  // is acquired last.
+  const std::shared_ptr<std::mutex> generator_mutex_;
+  const int frame_count_;
+  const unsigned int play_count_;
+  const std::shared_ptr<fml::BasicTaskRunner> look_ahead_task_runner_;
+  const size_t look_ahead_frame_count_;
+  const std::shared_ptr<LookAheadBudget> look_ahead_budget_;
+  const SkImageInfo frame_info_;
+  // The bytes reserved in |look_ahead_budget_| for each frame decoded ahead
+  // of time.
+  const size_t frame_bytes_;
+
+  // Guards the decoding state below. When both this lock and |mutex_| are
+  // held, this one is acquired first.
+  std::mutex decode_mutex_;
+
+  // The index of the next frame to composite. This is ahead of the next frame
+  // returned by |GetNextFrame| by the number of frames in
+  // |look_ahead_frames_|.
+  int decode_index_ = 0;
+  // The last decoded frame that's required to decode any subsequent frames.
+  std::optional<SkBitmap> last_required_frame_;
+  // The rectangle that should be cleared if the previous frame's disposal
+  // method was kRestoreBGColor.
+  std::optional<SkIRect> restore_bg_color_rect_;
+  // The number of frames composited so far, over all repetitions.
+  size_t decoded_frame_count_ = 0;
+
+  // Guards the frames decoded ahead of time and the members below.
+  mutable std::mutex mutex_;
+
+  // Frames decoded ahead of time, in playback order.
+  std::deque<Frame> look_ahead_frames_;
+  // The bytes of |look_ahead_budget_| reserved for |look_ahead_frames_|.
+  size_t look_ahead_bytes_ = 0;
+  bool look_ahead_pending_ = false;
+  // Whether every frame that will be played has been decoded.
+  bool look_ahead_exhausted_ = false;
+  size_t look_ahead_hit_count_ = 0;
+  size_t look_ahead_miss_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MultiFrameDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_DECODER_H_
@@ -0,0 +1,329 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_decoder.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Runs posted tasks only when asked to.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  void RunPendingTasks() {
+    std::vector<fml::closure> tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+std::shared_ptr<ImageGenerator> CreateAnimatedGenerator() {
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+  FML_CHECK(gif_mapping);
+  ImageGeneratorRegistry registry;
+  return registry.CreateCompatibleGenerator(gif_mapping);
+}
+
+// Forwards to another generator.
+class ForwardingImageGenerator : public ImageGenerator {
+ public:
+  explicit ForwardingImageGenerator(std::shared_ptr<ImageGenerator> generator)
+      : generator_(std::move(generator)) {}
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override { return generator_->GetInfo(); }
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override {
+    return generator_->GetFrameCount();
+  }
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override {
+    return generator_->GetPlayCount();
+  }
+
+  // |ImageGenerator|
+  const FrameInfo GetFrameInfo(unsigned int frame_index) override {
+    return generator_->GetFrameInfo(frame_index);
+  }
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float scale) override {
+    return generator_->GetScaledDimensions(scale);
+  }
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    return generator_->GetPixels(info, pixels, row_bytes, frame_index,
+                                 prior_frame);
+  }
+
+ private:
+  std::shared_ptr<ImageGenerator> generator_;
+};
+
+// Blocks the next decode once armed until it is resumed.
+class BlockingImageGenerator : public ForwardingImageGenerator {
+ public:
+  using ForwardingImageGenerator::ForwardingImageGenerator;
+
+  void BlockNextDecode() { block_next_decode_ = true; }
+
+  void WaitUntilBlocked() { blocked_.Wait(); }
+
+  void Resume() { resume_.Signal(); }
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    if (block_next_decode_.exchange(false)) {
+      blocked_.Signal();
+      resume_.Wait();
+    }
+    return ForwardingImageGenerator::GetPixels(info, pixels, row_bytes,
+                                               frame_index, prior_frame);
+  }
+
+ private:
+  std::atomic<bool> block_next_decode_{false};
+  fml::AutoResetWaitableEvent blocked_;
+  fml::AutoResetWaitableEvent resume_;
+};
+
+// Plays the animation once.
+class PlayOnceImageGenerator : public ForwardingImageGenerator {
+ public:
+  using ForwardingImageGenerator::ForwardingImageGenerator;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override { return 1; }
+};
+
+// Records whether decodes ever overlap.
+class OverlapDetectingImageGenerator : public ForwardingImageGenerator {
+ public:
+  using ForwardingImageGenerator::ForwardingImageGenerator;
+
+  bool DecodesOverlapped() const { return decodes_overlapped_; }
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    if (decodes_in_progress_.fetch_add(1) != 0) {
+      decodes_overlapped_ = true;
+    }
+    std::this_thread::yield();
+    bool result = ForwardingImageGenerator::GetPixels(
+        info, pixels, row_bytes, frame_index, prior_frame);
+    decodes_in_progress_.fetch_sub(1);
+    return result;
+  }
+
+ private:
+  std::atomic<int> decodes_in_progress_{0};
+  std::atomic<bool> decodes_overlapped_{false};
+};
+
+bool FramesAreEqual(const MultiFrameDecoder::Frame& a,
+                    const MultiFrameDecoder::Frame& b) {
+  return a.duration == b.duration && a.bitmap.info() == b.bitmap.info() &&
+         a.bitmap.computeByteSize() == b.bitmap.computeByteSize() &&
+         std::memcmp(a.bitmap.getPixels(), b.bitmap.getPixels(),
+                     a.bitmap.computeByteSize()) == 0;
+}
+
+}  // namespace
+
+TEST(MultiFrameDecoderTest, LookAheadProducesSameFramesAsDecodingOnRequest) {
+  auto generator = CreateAnimatedGenerator();
+  ASSERT_TRUE(generator);
+  const int frame_count = generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto on_request =
+      std::make_shared<MultiFrameDecoder>(generator, nullptr, nullptr);
+  auto look_ahead = std::make_shared<MultiFrameDecoder>(
+      CreateAnimatedGenerator(), nullptr, runner);
+
+  // Play the animation twice, to cover the wrap around to the first frame.
+  for (int i = 0; i < frame_count * 2; i++) {
+    MultiFrameDecoder::Frame expected = on_request->GetNextFrame();
+    MultiFrameDecoder::Frame frame = look_ahead->GetNextFrame();
+    ASSERT_FALSE(frame.bitmap.isNull()) << frame.decode_error;
+    EXPECT_TRUE(FramesAreEqual(frame, expected)) << "Frame " << i;
+    runner->RunPendingTasks();
+  }
+
+  // Only the first frame was decoded on request.
+  EXPECT_EQ(look_ahead->GetLookAheadMissCount(), 1u);
+  EXPECT_EQ(look_ahead->GetLookAheadHitCount(),
+            static_cast<size_t>(frame_count * 2 - 1));
+  EXPECT_EQ(on_request->GetLookAheadMissCount(), 0u);
+  EXPECT_EQ(on_request->GetLookAheadHitCount(), 0u);
+}
+
+TEST(MultiFrameDecoderTest, LookAheadIsLimitedByFrameCountAndByteBudget) {
+  auto generator = CreateAnimatedGenerator();
+  ASSERT_TRUE(generator);
+  const size_t frame_bytes = generator->GetInfo().computeMinByteSize();
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto decoder = std::make_shared<MultiFrameDecoder>(
+      generator, nullptr, runner, /*look_ahead_frame_count=*/1,
+      std::make_shared<MultiFrameDecoder::LookAheadBudget>(frame_bytes * 8));
+  decoder->GetNextFrame();
+  runner->RunPendingTasks();
+  EXPECT_EQ(decoder->GetLookAheadFrameCount(), 1u);
+
+  auto small_budget_runner = std::make_shared<ManualTaskRunner>();
+  auto small_budget_decoder = std::make_shared<MultiFrameDecoder>(
+      CreateAnimatedGenerator(), nullptr, small_budget_runner,
+      /*look_ahead_frame_count=*/4,
+      std::make_shared<MultiFrameDecoder::LookAheadBudget>(frame_bytes - 1));
+  for (int i = 0; i < 3; i++) {
+    small_budget_decoder->GetNextFrame();
+    small_budget_runner->RunPendingTasks();
+  }
+  EXPECT_EQ(small_budget_decoder->GetLookAheadFrameCount(), 0u);
+  EXPECT_EQ(small_budget_decoder->GetLookAheadMissCount(), 3u);
+  EXPECT_EQ(small_budget_decoder->GetLookAheadHitCount(), 0u);
+}
+
+TEST(MultiFrameDecoderTest, DecodedFramesCanBeTakenWhileDecodingAhead) {
+  auto generator =
+      std::make_shared<BlockingImageGenerator>(CreateAnimatedGenerator());
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto decoder = std::make_shared<MultiFrameDecoder>(
+      generator, nullptr, runner, /*look_ahead_frame_count=*/2);
+  decoder->GetNextFrame();
+  runner->RunPendingTasks();
+  ASSERT_EQ(decoder->GetLookAheadFrameCount(), 2u);
+
+  // Taking a frame schedules the decoding of another one, which blocks.
+  generator->BlockNextDecode();
+  decoder->GetNextFrame();
+  std::thread look_ahead_thread([&runner]() { runner->RunPendingTasks(); });
+  generator->WaitUntilBlocked();
+
+  MultiFrameDecoder::Frame frame = decoder->GetNextFrame();
+  EXPECT_FALSE(frame.bitmap.isNull());
+  EXPECT_EQ(decoder->GetLookAheadHitCount(), 2u);
+
+  generator->Resume();
+  look_ahead_thread.join();
+  EXPECT_EQ(decoder->GetLookAheadMissCount(), 1u);
+}
+
+TEST(MultiFrameDecoderTest, LookAheadBudgetIsSharedBetweenDecoders) {
+  auto generator = CreateAnimatedGenerator();
+  ASSERT_TRUE(generator);
+  const size_t frame_bytes = generator->GetInfo().computeMinByteSize();
+  auto budget =
+      std::make_shared<MultiFrameDecoder::LookAheadBudget>(frame_bytes * 2);
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto first = std::make_shared<MultiFrameDecoder>(
+      generator, nullptr, runner, /*look_ahead_frame_count=*/2, budget);
+  auto second = std::make_shared<MultiFrameDecoder>(
+      CreateAnimatedGenerator(), nullptr, runner,
+      /*look_ahead_frame_count=*/2, budget);
+  first->GetNextFrame();
+  runner->RunPendingTasks();
+  second->GetNextFrame();
+  runner->RunPendingTasks();
+  EXPECT_EQ(first->GetLookAheadFrameCount(), 2u);
+  EXPECT_EQ(second->GetLookAheadFrameCount(), 0u);
+  EXPECT_EQ(budget->GetReservedBytes(), frame_bytes * 2);
+
+  // Taking a frame hands its bytes back to the budget.
+  first->GetNextFrame();
+  EXPECT_EQ(budget->GetReservedBytes(), frame_bytes);
+  second->GetNextFrame();
+  runner->RunPendingTasks();
+  EXPECT_EQ(budget->GetReservedBytes(), frame_bytes * 2);
+
+  first.reset();
+  second.reset();
+  EXPECT_EQ(budget->GetReservedBytes(), 0u);
+}
+
+TEST(MultiFrameDecoderTest, LookAheadStopsAfterLastRepetition) {
+  auto generator =
+      std::make_shared<PlayOnceImageGenerator>(CreateAnimatedGenerator());
+  const int frame_count = generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto decoder = std::make_shared<MultiFrameDecoder>(
+      generator, nullptr, runner,
+      /*look_ahead_frame_count=*/frame_count + 2);
+  decoder->GetNextFrame();
+  runner->RunPendingTasks();
+  EXPECT_EQ(decoder->GetLookAheadFrameCount(),
+            static_cast<size_t>(frame_count - 1));
+
+  for (int i = 1; i < frame_count; i++) {
+    decoder->GetNextFrame();
+    runner->RunPendingTasks();
+  }
+  EXPECT_EQ(decoder->GetLookAheadFrameCount(), 0u);
+  EXPECT_EQ(decoder->GetLookAheadMissCount(), 1u);
+  EXPECT_EQ(decoder->GetLookAheadHitCount(),
+            static_cast<size_t>(frame_count - 1));
+}
+
+TEST(MultiFrameDecoderTest, DecodersOfTheSameGeneratorDoNotDecodeAtOnce) {
+  auto generator = std::make_shared<OverlapDetectingImageGenerator>(
+      CreateAnimatedGenerator());
+  const int frame_count = generator->GetFrameCount();
+  auto generator_mutex = std::make_shared<std::mutex>();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; i++) {
+    threads.emplace_back([&generator, &generator_mutex, frame_count]() {
+      auto decoder = std::make_shared<MultiFrameDecoder>(
+          generator, generator_mutex, nullptr);
+      for (int j = 0; j < frame_count * 4; j++) {
+        EXPECT_FALSE(decoder->GetNextFrame().bitmap.isNull());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(generator->DecodesOverlapped());
+}
+
+}  // namespace testing
+}  // namespace flutter
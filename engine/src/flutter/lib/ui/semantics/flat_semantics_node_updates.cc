@@ -0,0 +1,306 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+FlatSemanticsNodeUpdates::FlatSemanticsNodeUpdates() = default;
+
+FlatSemanticsNodeUpdates::FlatSemanticsNodeUpdates(
+    const FlatSemanticsNodeUpdates& other) = default;
+
+FlatSemanticsNodeUpdates::FlatSemanticsNodeUpdates(
+    FlatSemanticsNodeUpdates&& other) = default;
+
+FlatSemanticsNodeUpdates& FlatSemanticsNodeUpdates::operator=(
+    const FlatSemanticsNodeUpdates& other) = default;
+
+FlatSemanticsNodeUpdates& FlatSemanticsNodeUpdates::operator=(
+    FlatSemanticsNodeUpdates&& other) = default;
+
+FlatSemanticsNodeUpdates::~FlatSemanticsNodeUpdates() = default;
+
+FlatSemanticsNodeUpdates::StringRef FlatSemanticsNodeUpdates::AddString(
+    std::string_view string) {
+  if (string.empty()) {
+    return {};
+  }
+  FML_DCHECK(strings_.size() + string.size() <
+             std::numeric_limits<uint32_t>::max());
+  StringRef ref{
+      .offset = static_cast<uint32_t>(strings_.size()),
+      .length = static_cast<uint32_t>(string.size()),
+  };
+  strings_.append(string);
+  strings_.push_back('\0');
+  return ref;
+}
+
+FlatSemanticsNodeUpdates::Int32Range FlatSemanticsNodeUpdates::AddInt32s(
+    const int32_t* values,
+    size_t count) {
+  if (count == 0) {
+    return {};
+  }
+  Int32Range range{
+      .offset = static_cast<uint32_t>(int32s_.size()),
+      .count = static_cast<uint32_t>(count),
+  };
+  int32s_.insert(int32s_.end(), values, values + count);
+  return range;
+}
+
+FlatSemanticsNodeUpdates::AttributeRange
+FlatSemanticsNodeUpdates::AddStringAttributes(
+    const StringAttributes& attributes) {
+  AttributeRange range{
+      .offset = static_cast<uint32_t>(string_attributes_.size()),
+      .count = static_cast<uint32_t>(attributes.size()),
+  };
+  for (const auto& attribute : attributes) {
+    AddStringAttribute(*attribute);
+  }
+  return attributes.empty() ? AttributeRange{} : range;
+}
+
+FlatSemanticsNodeUpdates::AttributeRange
+FlatSemanticsNodeUpdates::AddStringAttributes(
+    const std::vector<NativeStringAttribute*>& attributes) {
+  AttributeRange range{
+      .offset = static_cast<uint32_t>(string_attributes_.size()),
+      .count = static_cast<uint32_t>(attributes.size()),
+  };
+  for (const auto* attribute : attributes) {
+    AddStringAttribute(*attribute->GetAttribute());
+  }
+  return attributes.empty() ? AttributeRange{} : range;
+}
+
+void FlatSemanticsNodeUpdates::AddStringAttribute(
+    const StringAttribute& attribute) {
+  StringAttributeRecord record{
+      .start = attribute.start,
+      .end = attribute.end,
+      .type = attribute.type,
+  };
+  if (attribute.type == StringAttributeType::kLocale) {
+    record.locale =
+        AddString(static_cast<const LocaleStringAttribute&>(attribute).locale);
+  }
+  string_attributes_.push_back(record);
+}
+
+void FlatSemanticsNodeUpdates::AddRecord(const Record& record) {
+  records_.push_back(record);
+}
+
+void FlatSemanticsNodeUpdates::Add(const SemanticsNode& node) {
+  Record record;
+  record.id = node.id;
+  record.flags = node.flags;
+  record.actions = node.actions;
+  record.maxValueLength = node.maxValueLength;
+  record.currentValueLength = node.currentValueLength;
+  record.textSelectionBase = node.textSelectionBase;
+  record.textSelectionExtent = node.textSelectionExtent;
+  record.platformViewId = node.platformViewId;
+  record.scrollChildren = node.scrollChildren;
+  record.scrollIndex = node.scrollIndex;
+  record.scrollPosition = node.scrollPosition;
+  record.scrollExtentMax = node.scrollExtentMax;
+  record.scrollExtentMin = node.scrollExtentMin;
+  record.identifier = AddString(node.identifier);
+  record.label = AddString(node.label);
+  record.labelAttributes = AddStringAttributes(node.labelAttributes);
+  record.hint = AddString(node.hint);
+  record.hintAttributes = AddStringAttributes(node.hintAttributes);
+  record.value = AddString(node.value);
+  record.valueAttributes = AddStringAttributes(node.valueAttributes);
+  record.increasedValue = AddString(node.increasedValue);
+  record.increasedValueAttributes =
+      AddStringAttributes(node.increasedValueAttributes);
+  record.decreasedValue = AddString(node.decreasedValue);
+  record.decreasedValueAttributes =
+      AddStringAttributes(node.decreasedValueAttributes);
+  record.tooltip = AddString(node.tooltip);
+  record.textDirection = node.textDirection;
+  record.rect = node.rect;
+  record.transform = node.transform;
+  record.childrenInTraversalOrder =
+      AddInt32s(node.childrenInTraversalOrder.data(),
+                node.childrenInTraversalOrder.size());
+  record.childrenInHitTestOrder = AddInt32s(
+      node.childrenInHitTestOrder.data(), node.childrenInHitTestOrder.size());
+  record.customAccessibilityActions =
+      AddInt32s(node.customAccessibilityActions.data(),
+                node.customAccessibilityActions.size());
+  record.headingLevel = node.headingLevel;
+  record.linkUrl = AddString(node.linkUrl);
+  record.role = node.role;
+  record.validationResult = node.validationResult;
+  record.locale = AddString(node.locale);
+  AddRecord(record);
+}
+
+void FlatSemanticsNodeUpdates::RemoveSupersededRecords() {
+  if (records_.size() < 2) {
+    return;
+  }
+
+  // Sorting (id, index) pairs puts the updates of a node next to each other,
+  // with the last one at the end of its run.
+  std::vector<std::pair<int32_t, uint32_t>> ids;
+  ids.reserve(records_.size());
+  for (size_t i = 0; i < records_.size(); i++) {
+    ids.emplace_back(records_[i].id, static_cast<uint32_t>(i));
+  }
+  std::sort(ids.begin(), ids.end());
+
+  std::vector<bool> superseded(records_.size(), false);
+  bool has_superseded = false;
+  for (size_t i = 1; i < ids.size(); i++) {
+    if (ids[i - 1].first == ids[i].first) {
+      superseded[ids[i - 1].second] = true;
+      has_superseded = true;
+    }
+  }
+  if (!has_superseded) {
+    return;
+  }
+
+  // The tables are left as they are, superseded records only waste the space
+  // of their strings until the update is destroyed.
+  size_t kept = 0;
+  for (size_t i = 0; i < records_.size(); i++) {
+    if (!superseded[i]) {
+      records_[kept++] = records_[i];
+    }
+  }
+  records_.resize(kept);
+}
+
+std::string_view FlatSemanticsNodeUpdates::GetString(StringRef ref) const {
+  if (ref.length == 0) {
+    return {};
+  }
+  return std::string_view(strings_.data() + ref.offset, ref.length);
+}
+
+const char* FlatSemanticsNodeUpdates::GetCString(StringRef ref) const {
+  if (ref.length == 0) {
+    return "";
+  }
+  return strings_.data() + ref.offset;
+}
+
+const int32_t* FlatSemanticsNodeUpdates::GetInt32s(Int32Range range) const {
+  if (range.count == 0) {
+    return nullptr;
+  }
+  return int32s_.data() + range.offset;
+}
+
+const FlatSemanticsNodeUpdates::StringAttributeRecord*
+FlatSemanticsNodeUpdates::GetStringAttributes(AttributeRange range) const {
+  if (range.count == 0) {
+    return nullptr;
+  }
+  return string_attributes_.data() + range.offset;
+}
+
+StringAttributes FlatSemanticsNodeUpdates::ToStringAttributes(
+    AttributeRange range) const {
+  StringAttributes result;
+  result.reserve(range.count);
+  const StringAttributeRecord* records = GetStringAttributes(range);
+  for (size_t i = 0; i < range.count; i++) {
+    const StringAttributeRecord& record = records[i];
+    StringAttributePtr attribute;
+    switch (record.type) {
+      case StringAttributeType::kSpellOut:
+        attribute = std::make_shared<SpellOutStringAttribute>();
+        break;
+      case StringAttributeType::kLocale: {
+        auto locale_attribute = std::make_shared<LocaleStringAttribute>();
+        locale_attribute->locale = GetString(record.locale);
+        attribute = std::move(locale_attribute);
+        break;
+      }
+    }
+    attribute->start = record.start;
+    attribute->end = record.end;
+    attribute->type = record.type;
+    result.push_back(std::move(attribute));
+  }
+  return result;
+}
+
+SemanticsNode FlatSemanticsNodeUpdates::ToSemanticsNode(
+    const Record& record) const {
+  auto to_vector = [this](Int32Range range) {
+    const int32_t* values = GetInt32s(range);
+    return std::vector<int32_t>(values, values + range.count);
+  };
+
+  SemanticsNode node;
+  node.id = record.id;
+  node.flags = record.flags;
+  node.actions = record.actions;
+  node.maxValueLength = record.maxValueLength;
+  node.currentValueLength = record.currentValueLength;
+  node.textSelectionBase = record.textSelectionBase;
+  node.textSelectionExtent = record.textSelectionExtent;
+  node.platformViewId = record.platformViewId;
+  node.scrollChildren = record.scrollChildren;
+  node.scrollIndex = record.scrollIndex;
+  node.scrollPosition = record.scrollPosition;
+  node.scrollExtentMax = record.scrollExtentMax;
+  node.scrollExtentMin = record.scrollExtentMin;
+  node.identifier = GetString(record.identifier);
+  node.label = GetString(record.label);
+  node.labelAttributes = ToStringAttributes(record.labelAttributes);
+  node.hint = GetString(record.hint);
+  node.hintAttributes = ToStringAttributes(record.hintAttributes);
+  node.value = GetString(record.value);
+  node.valueAttributes = ToStringAttributes(record.valueAttributes);
+  node.increasedValue = GetString(record.increasedValue);
+  node.increasedValueAttributes =
+      ToStringAttributes(record.increasedValueAttributes);
+  node.decreasedValue = GetString(record.decreasedValue);
+  node.decreasedValueAttributes =
+      ToStringAttributes(record.decreasedValueAttributes);
+  node.tooltip = GetString(record.tooltip);
+  node.textDirection = record.textDirection;
+  node.rect = record.rect;
+  node.transform = record.transform;
+  node.childrenInTraversalOrder = to_vector(record.childrenInTraversalOrder);
+  node.childrenInHitTestOrder = to_vector(record.childrenInHitTestOrder);
+  node.customAccessibilityActions =
+      to_vector(record.customAccessibilityActions);
+  node.headingLevel = record.headingLevel;
+  node.linkUrl = GetString(record.linkUrl);
+  node.role = record.role;
+  node.validationResult = record.validationResult;
+  node.locale = GetString(record.locale);
+  return node;
+}
+
+SemanticsNodeUpdates FlatSemanticsNodeUpdates::ToSemanticsNodeUpdates() const {
+  SemanticsNodeUpdates nodes;
+  nodes.reserve(records_.size());
+  for (const Record& record : records_) {
+    nodes[record.id] = ToSemanticsNode(record);
+  }
+  return nodes;
+}
+
+}  // namespace flutter
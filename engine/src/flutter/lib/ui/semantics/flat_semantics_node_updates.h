@@ -0,0 +1,178 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_FLAT_SEMANTICS_NODE_UPDATES_H_
+#define FLUTTER_LIB_UI_SEMANTICS_FLAT_SEMANTICS_NODE_UPDATES_H_
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "third_party/skia/include/core/SkM44.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A batch of semantics node updates stored in a handful of flat
+///             tables instead of one heap allocated `SemanticsNode` per node.
+///
+///             Every node is a fixed-size `Record`. Its strings, child lists
+///             and string attributes live in tables shared by all records of
+///             the update and are referred to by offset. Strings in the
+///             string table are null terminated, so that consumers such as
+///             the embedder API can point into the table instead of copying
+///             each string.
+///
+///             The tables only grow while the update is built. Pointers
+///             returned by the getters stay valid for as long as the update
+///             is neither modified nor destroyed.
+///
+class FlatSemanticsNodeUpdates {
+ public:
+  /// A string in the string table. The empty string is `{0, 0}`.
+  struct StringRef {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+  };
+
+  /// A run of values in the int32 table.
+  struct Int32Range {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+  };
+
+  /// A run of records in the string attribute table.
+  struct AttributeRange {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+  };
+
+  struct StringAttributeRecord {
+    int32_t start = -1;
+    int32_t end = -1;
+    StringAttributeType type = StringAttributeType::kSpellOut;
+    /// Only set for `StringAttributeType::kLocale`.
+    StringRef locale;
+  };
+
+  /// The flat counterpart of `SemanticsNode`.
+  struct Record {
+    int32_t id = 0;
+    SemanticsFlags flags;
+    int32_t actions = 0;
+    int32_t maxValueLength = -1;
+    int32_t currentValueLength = -1;
+    int32_t textSelectionBase = -1;
+    int32_t textSelectionExtent = -1;
+    int32_t platformViewId = -1;
+    int32_t scrollChildren = 0;
+    int32_t scrollIndex = 0;
+    double scrollPosition = std::nan("");
+    double scrollExtentMax = std::nan("");
+    double scrollExtentMin = std::nan("");
+    StringRef identifier;
+    StringRef label;
+    AttributeRange labelAttributes;
+    StringRef hint;
+    AttributeRange hintAttributes;
+    StringRef value;
+    AttributeRange valueAttributes;
+    StringRef increasedValue;
+    AttributeRange increasedValueAttributes;
+    StringRef decreasedValue;
+    AttributeRange decreasedValueAttributes;
+    StringRef tooltip;
+    int32_t textDirection = 0;  // 0=unknown, 1=rtl, 2=ltr
+    SkRect rect = SkRect::MakeEmpty();
+    SkM44 transform = SkM44{};
+    Int32Range childrenInTraversalOrder;
+    Int32Range childrenInHitTestOrder;
+    Int32Range customAccessibilityActions;
+    int32_t headingLevel = 0;
+    StringRef linkUrl;
+    SemanticsRole role = SemanticsRole::kNone;
+    SemanticsValidationResult validationResult =
+        SemanticsValidationResult::kNone;
+    StringRef locale;
+  };
+
+  FlatSemanticsNodeUpdates();
+
+  FlatSemanticsNodeUpdates(const FlatSemanticsNodeUpdates& other);
+
+  FlatSemanticsNodeUpdates(FlatSemanticsNodeUpdates&& other);
+
+  FlatSemanticsNodeUpdates& operator=(const FlatSemanticsNodeUpdates& other);
+
+  FlatSemanticsNodeUpdates& operator=(FlatSemanticsNodeUpdates&& other);
+
+  ~FlatSemanticsNodeUpdates();
+
+  //----------------------------------------------------------------------------
+  /// Builder methods. The refs returned by the `Add*` methods are used to fill
+  /// in a `Record` that is then passed to `AddRecord`.
+
+  StringRef AddString(std::string_view string);
+
+  Int32Range AddInt32s(const int32_t* values, size_t count);
+
+  AttributeRange AddStringAttributes(const StringAttributes& attributes);
+
+  AttributeRange AddStringAttributes(
+      const std::vector<NativeStringAttribute*>& attributes);
+
+  void AddRecord(const Record& record);
+
+  /// Adds a record for |node|, copying its strings and lists into the tables.
+  void Add(const SemanticsNode& node);
+
+  /// Drops every record that is followed by a later record with the same id,
+  /// so that the last update of a node wins. Surviving records keep their
+  /// order.
+  void RemoveSupersededRecords();
+
+  //----------------------------------------------------------------------------
+  /// Reader methods.
+
+  size_t size() const { return records_.size(); }
+
+  bool empty() const { return records_.empty(); }
+
+  const std::vector<Record>& records() const { return records_; }
+
+  std::string_view GetString(StringRef ref) const;
+
+  /// Returns a null terminated string that points into the string table.
+  const char* GetCString(StringRef ref) const;
+
+  /// Returns a pointer into the int32 table, or null for an empty range.
+  const int32_t* GetInt32s(Int32Range range) const;
+
+  const StringAttributeRecord* GetStringAttributes(AttributeRange range) const;
+
+  /// Copies |record| out of the tables into a standalone `SemanticsNode`.
+  SemanticsNode ToSemanticsNode(const Record& record) const;
+
+  /// Copies all records into a `SemanticsNodeUpdates` map, for consumers that
+  /// keep the nodes beyond the lifetime of this update.
+  SemanticsNodeUpdates ToSemanticsNodeUpdates() const;
+
+ private:
+  std::string strings_;
+  std::vector<int32_t> int32s_;
+  std::vector<StringAttributeRecord> string_attributes_;
+  std::vector<Record> records_;
+
+  void AddStringAttribute(const StringAttribute& attribute);
+
+  StringAttributes ToStringAttributes(AttributeRange range) const;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_FLAT_SEMANTICS_NODE_UPDATES_H_
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
+
+#include <memory>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(FlatSemanticsNodeUpdatesTest, RoundTripsSemanticsNodes) {
+  SemanticsNode node;
+  node.id = 7;
+  node.flags.isButton = true;
+  node.flags.isChecked = SemanticsCheckState::kMixed;
+  node.actions = static_cast<int32_t>(SemanticsAction::kTap);
+  node.label = "label";
+  node.hint = "";
+  node.tooltip = "tooltip";
+  node.rect = SkRect::MakeLTRB(1, 2, 3, 4);
+  node.transform = SkM44::Translate(5, 6);
+  node.childrenInTraversalOrder = {1, 2, 3};
+  node.childrenInHitTestOrder = {3, 2, 1};
+  node.role = SemanticsRole::kListItem;
+  auto spell_out = std::make_shared<SpellOutStringAttribute>();
+  spell_out->start = 0;
+  spell_out->end = 1;
+  spell_out->type = StringAttributeType::kSpellOut;
+  auto locale = std::make_shared<LocaleStringAttribute>();
+  locale->start = 1;
+  locale->end = 5;
+  locale->type = StringAttributeType::kLocale;
+  locale->locale = "en-US";
+  node.labelAttributes = {spell_out, locale};
+
+  FlatSemanticsNodeUpdates updates;
+  updates.Add(node);
+  ASSERT_EQ(updates.size(), 1u);
+
+  const auto& record = updates.records()[0];
+  EXPECT_EQ(updates.GetString(record.label), "label");
+  EXPECT_STREQ(updates.GetCString(record.hint), "");
+  EXPECT_STREQ(updates.GetCString(record.tooltip), "tooltip");
+  EXPECT_EQ(updates.GetInt32s(record.customAccessibilityActions), nullptr);
+
+  SemanticsNode result = updates.ToSemanticsNode(record);
+  EXPECT_EQ(result.id, 7);
+  EXPECT_TRUE(result.flags.isButton);
+  EXPECT_EQ(result.flags.isChecked, SemanticsCheckState::kMixed);
+  EXPECT_EQ(result.actions, node.actions);
+  EXPECT_EQ(result.label, "label");
+  EXPECT_EQ(result.tooltip, "tooltip");
+  EXPECT_EQ(result.rect, node.rect);
+  EXPECT_EQ(result.transform, node.transform);
+  EXPECT_EQ(result.childrenInTraversalOrder, node.childrenInTraversalOrder);
+  EXPECT_EQ(result.childrenInHitTestOrder, node.childrenInHitTestOrder);
+  EXPECT_TRUE(result.customAccessibilityActions.empty());
+  EXPECT_EQ(result.role, SemanticsRole::kListItem);
+  ASSERT_EQ(result.labelAttributes.size(), 2u);
+  EXPECT_EQ(result.labelAttributes[0]->type, StringAttributeType::kSpellOut);
+  EXPECT_EQ(result.labelAttributes[0]->end, 1);
+  EXPECT_EQ(result.labelAttributes[1]->type, StringAttributeType::kLocale);
+  EXPECT_EQ(result.labelAttributes[1]->start, 1);
+  EXPECT_EQ(std::static_pointer_cast<LocaleStringAttribute>(
+                result.labelAttributes[1])
+                ->locale,
+            "en-US");
+}
+
+TEST(FlatSemanticsNodeUpdatesTest, LastUpdateOfANodeWins) {
+  FlatSemanticsNodeUpdates updates;
+  SemanticsNode node;
+  node.id = 1;
+  node.label = "first";
+  updates.Add(node);
+  node.id = 2;
+  node.label = "other";
+  updates.Add(node);
+  node.id = 1;
+  node.label = "second";
+  updates.Add(node);
+
+  updates.RemoveSupersededRecords();
+
+  ASSERT_EQ(updates.size(), 2u);
+  EXPECT_EQ(updates.records()[0].id, 2);
+  EXPECT_EQ(updates.GetString(updates.records()[0].label), "other");
+  EXPECT_EQ(updates.records()[1].id, 1);
+  EXPECT_EQ(updates.GetString(updates.records()[1].label), "second");
+
+  SemanticsNodeUpdates nodes = updates.ToSemanticsNodeUpdates();
+  ASSERT_EQ(nodes.size(), 2u);
+  EXPECT_EQ(nodes[1].label, "second");
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -7,7 +7,7 @@
 
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
-#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
 
 namespace flutter {
 
@@ -18,20 +18,20 @@ class SemanticsUpdate : public RefCountedDartWrappable<SemanticsUpdate> {
  public:
   ~SemanticsUpdate() override;
   static void create(Dart_Handle semantics_update_handle,
-                     SemanticsNodeUpdates nodes,
+                     FlatSemanticsNodeUpdates nodes,
                      CustomAccessibilityActionUpdates actions);
 
-  SemanticsNodeUpdates takeNodes();
+  FlatSemanticsNodeUpdates takeNodes();
 
   CustomAccessibilityActionUpdates takeActions();
 
   void dispose();
 
  private:
-  explicit SemanticsUpdate(SemanticsNodeUpdates nodes,
+  explicit SemanticsUpdate(FlatSemanticsNodeUpdates nodes,
                            CustomAccessibilityActionUpdates updates);
 
-  SemanticsNodeUpdates nodes_;
+  FlatSemanticsNodeUpdates nodes_;
   CustomAccessibilityActionUpdates actions_;
 };
 
@@ -16,14 +16,6 @@
 
 namespace flutter {
 
-void pushStringAttributes(
-    StringAttributes& destination,
-    const std::vector<NativeStringAttribute*>& native_attributes) {
-  for (const auto& native_attribute : native_attributes) {
-    destination.push_back(native_attribute->GetAttribute());
-  }
-}
-
 IMPLEMENT_WRAPPERTYPEINFO(ui, SemanticsUpdateBuilder);
 
 SemanticsUpdateBuilder::SemanticsUpdateBuilder() = default;
@@ -76,7 +68,9 @@ void SemanticsUpdateBuilder::updateNode(
             (scrollChildren > 0 && childrenInHitTestOrder.data()))
       << "Semantics update contained scrollChildren but did not have "
          "childrenInHitTestOrder";
-  SemanticsNode node;
+  // The node is written straight into the flat tables of the update, so that
+  // no per-node strings or vectors are allocated.
+  FlatSemanticsNodeUpdates::Record node;
   node.id = id;
   auto* flags_object =
       tonic::DartConverter<flutter::NativeSemanticsFlags*>::FromDart(flags);
@@ -94,18 +88,20 @@ void SemanticsUpdateBuilder::updateNode(
   node.scrollExtentMin = scrollExtentMin;
   node.rect = SkRect::MakeLTRB(SafeNarrow(left), SafeNarrow(top),
                                SafeNarrow(right), SafeNarrow(bottom));
-  node.identifier = std::move(identifier);
-  node.label = std::move(label);
-  pushStringAttributes(node.labelAttributes, labelAttributes);
-  node.value = std::move(value);
-  pushStringAttributes(node.valueAttributes, valueAttributes);
-  node.increasedValue = std::move(increasedValue);
-  pushStringAttributes(node.increasedValueAttributes, increasedValueAttributes);
-  node.decreasedValue = std::move(decreasedValue);
-  pushStringAttributes(node.decreasedValueAttributes, decreasedValueAttributes);
-  node.hint = std::move(hint);
-  pushStringAttributes(node.hintAttributes, hintAttributes);
-  node.tooltip = std::move(tooltip);
+  node.identifier = nodes_.AddString(identifier);
+  node.label = nodes_.AddString(label);
+  node.labelAttributes = nodes_.AddStringAttributes(labelAttributes);
+  node.value = nodes_.AddString(value);
+  node.valueAttributes = nodes_.AddStringAttributes(valueAttributes);
+  node.increasedValue = nodes_.AddString(increasedValue);
+  node.increasedValueAttributes =
+      nodes_.AddStringAttributes(increasedValueAttributes);
+  node.decreasedValue = nodes_.AddString(decreasedValue);
+  node.decreasedValueAttributes =
+      nodes_.AddStringAttributes(decreasedValueAttributes);
+  node.hint = nodes_.AddString(hint);
+  node.hintAttributes = nodes_.AddStringAttributes(hintAttributes);
+  node.tooltip = nodes_.AddString(tooltip);
   node.textDirection = textDirection;
   SkScalar scalarTransform[16];
   for (int i = 0; i < 16; ++i) {
@@ -113,23 +109,20 @@ void SemanticsUpdateBuilder::updateNode(
   }
   node.transform = SkM44::ColMajor(scalarTransform);
   node.childrenInTraversalOrder =
-      std::vector<int32_t>(childrenInTraversalOrder.data(),
-                           childrenInTraversalOrder.data() +
-                               childrenInTraversalOrder.num_elements());
-  node.childrenInHitTestOrder = std::vector<int32_t>(
-      childrenInHitTestOrder.data(),
-      childrenInHitTestOrder.data() + childrenInHitTestOrder.num_elements());
-  node.customAccessibilityActions = std::vector<int32_t>(
-      localContextActions.data(),
-      localContextActions.data() + localContextActions.num_elements());
+      nodes_.AddInt32s(childrenInTraversalOrder.data(),
+                       childrenInTraversalOrder.num_elements());
+  node.childrenInHitTestOrder = nodes_.AddInt32s(
+      childrenInHitTestOrder.data(), childrenInHitTestOrder.num_elements());
+  node.customAccessibilityActions = nodes_.AddInt32s(
+      localContextActions.data(), localContextActions.num_elements());
   node.headingLevel = headingLevel;
-  node.linkUrl = std::move(linkUrl);
+  node.linkUrl = nodes_.AddString(linkUrl);
   node.role = static_cast<SemanticsRole>(role);
   node.validationResult =
       static_cast<SemanticsValidationResult>(validationResult);
-  node.locale = std::move(locale);
+  node.locale = nodes_.AddString(locale);
 
-  nodes_[id] = node;
+  nodes_.AddRecord(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -145,6 +138,7 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
+  nodes_.RemoveSupersededRecords();
   SemanticsUpdate::create(semantics_update_handle, std::move(nodes_),
                           std::move(actions_));
   ClearDartWrapper();
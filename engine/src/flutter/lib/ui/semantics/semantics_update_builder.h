@@ -81,7 +81,7 @@ class SemanticsUpdateBuilder
 
  private:
   explicit SemanticsUpdateBuilder();
-  SemanticsNodeUpdates nodes_;
+  FlatSemanticsNodeUpdates nodes_;
   CustomAccessibilityActionUpdates actions_;
 };
 
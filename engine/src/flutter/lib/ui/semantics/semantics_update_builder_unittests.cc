@@ -22,7 +22,7 @@ TEST_F(SemanticsUpdateBuilderTest, CanHandleAttributedStrings) {
         handle, tonic::DartWrappable::kPeerIndex, &peer);
     ASSERT_FALSE(Dart_IsError(result));
     SemanticsUpdate* update = reinterpret_cast<SemanticsUpdate*>(peer);
-    SemanticsNodeUpdates nodes = update->takeNodes();
+    SemanticsNodeUpdates nodes = update->takeNodes().ToSemanticsNodeUpdates();
     ASSERT_EQ(nodes.size(), static_cast<size_t>(1));
     auto found = nodes.find(0);
     ASSERT_NE(found, nodes.end());
@@ -100,7 +100,7 @@ TEST_F(SemanticsUpdateBuilderTest, CanHandleSemanticsRole) {
         handle, tonic::DartWrappable::kPeerIndex, &peer);
     ASSERT_FALSE(Dart_IsError(result));
     SemanticsUpdate* update = reinterpret_cast<SemanticsUpdate*>(peer);
-    SemanticsNodeUpdates nodes = update->takeNodes();
+    SemanticsNodeUpdates nodes = update->takeNodes().ToSemanticsNodeUpdates();
     auto found = nodes.find(0);
     ASSERT_NE(found, nodes.end());
     SemanticsNode node = found->second;
@@ -144,7 +144,7 @@ TEST_F(SemanticsUpdateBuilderTest, CanHandleSemanticsLocale) {
         handle, tonic::DartWrappable::kPeerIndex, &peer);
     ASSERT_FALSE(Dart_IsError(result));
     SemanticsUpdate* update = reinterpret_cast<SemanticsUpdate*>(peer);
-    SemanticsNodeUpdates nodes = update->takeNodes();
+    SemanticsNodeUpdates nodes = update->takeNodes().ToSemanticsNodeUpdates();
     ASSERT_EQ(nodes.size(), static_cast<size_t>(1));
     auto found = nodes.find(0);
     ASSERT_NE(found, nodes.end());
@@ -189,7 +189,7 @@ TEST_F(SemanticsUpdateBuilderTest, CanSetIsLink) {
         handle, tonic::DartWrappable::kPeerIndex, &peer);
     ASSERT_FALSE(Dart_IsError(result));
     SemanticsUpdate* update = reinterpret_cast<SemanticsUpdate*>(peer);
-    SemanticsNodeUpdates nodes = update->takeNodes();
+    SemanticsNodeUpdates nodes = update->takeNodes().ToSemanticsNodeUpdates();
     ASSERT_EQ(nodes.size(), static_cast<size_t>(1));
     auto found = nodes.find(0);
     ASSERT_NE(found, nodes.end());
@@ -5,6 +5,9 @@
 #include "flutter/lib/ui/text/font_collection.h"
 
 #include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -50,6 +53,11 @@ void FontCollection::SetupDefaultFontManager(
   collection_->SetupDefaultFontManager(font_initialization_data);
 }
 
+void FontCollection::SetAssetPrefetchTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  asset_prefetch_task_runner_ = std::move(task_runner);
+}
+
 // Font manifest yaml format:
 //
 // flutter:
@@ -95,6 +103,7 @@ void FontCollection::RegisterFonts(
 
   auto font_provider =
       std::make_unique<AssetManagerFontProvider>(asset_manager);
+  std::vector<std::string> font_assets;
 
   for (const auto& family : document.GetArray()) {
     auto family_name = family.FindMember("family");
@@ -121,9 +130,15 @@ void FontCollection::RegisterFonts(
       // TODO(chinmaygarde): Handle weights and styles.
       font_provider->RegisterAsset(family_name->value.GetString(),
                                    font_asset->value.GetString());
+      font_assets.emplace_back(font_asset->value.GetString());
     }
   }
 
+  if (asset_prefetch_task_runner_) {
+    asset_manager->PrefetchAssets(std::move(font_assets),
+                                  asset_prefetch_task_runner_);
+  }
+
   collection_->SetAssetFontManager(
       sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
 }
@@ -11,6 +11,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 #include "txt/font_collection.h"
 
@@ -26,6 +27,17 @@ class FontCollection {
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner on which the font assets listed by the
+  ///             font manifest are prefetched when fonts are registered, so
+  ///             that loading a font on first use does not block on I/O.
+  ///             Fonts are not prefetched if it is not set.
+  ///
+  /// @see        `AssetManager::PrefetchAssets`
+  ///
+  void SetAssetPrefetchTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
   // Virtual for testing.
   virtual void RegisterFonts(
       const std::shared_ptr<AssetManager>& asset_manager);
@@ -39,6 +51,7 @@ class FontCollection {
  private:
   std::shared_ptr<txt::FontCollection> collection_;
   sk_sp<txt::DynamicFontManager> dynamic_font_manager_;
+  std::shared_ptr<fml::BasicTaskRunner> asset_prefetch_task_runner_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
@@ -17,7 +17,8 @@ PointerDataPacketConverter::PointerDataPacketConverter(const Delegate& delegate)
 PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
-    const PointerDataPacket& packet) {
+    const PointerDataPacket& packet,
+    bool coalesce_moves) {
   std::vector<PointerData> converted_pointers;
   // Converts each pointer data in the buffer and stores it in the
   // converted_pointers.
@@ -26,6 +27,10 @@ std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     ConvertPointerData(pointer_data, converted_pointers);
   }
 
+  if (coalesce_moves) {
+    CoalesceMoves(converted_pointers);
+  }
+
   // Writes converted_pointers into converted_packet.
   auto converted_packet =
       std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
@@ -37,6 +42,57 @@ std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
   return converted_packet;
 }
 
+namespace {
+
+bool IsCoalescible(const PointerData& pointer_data) {
+  return pointer_data.signal_kind == PointerData::SignalKind::kNone &&
+         (pointer_data.change == PointerData::Change::kMove ||
+          pointer_data.change == PointerData::Change::kHover);
+}
+
+bool CanCoalesce(const PointerData& previous, const PointerData& next) {
+  return previous.change == next.change && previous.kind == next.kind &&
+         previous.view_id == next.view_id &&
+         previous.pointer_identifier == next.pointer_identifier &&
+         previous.buttons == next.buttons;
+}
+
+}  // namespace
+
+// static
+void PointerDataPacketConverter::CoalesceMoves(
+    std::vector<PointerData>& pointers) {
+  // The index of the last kept move or hover event of each device since the
+  // last event that can't be merged.
+  std::map<int64_t, size_t> last_move_indices;
+  size_t count = 0;
+  for (size_t i = 0; i < pointers.size(); i++) {
+    const PointerData& pointer_data = pointers[i];
+    if (!IsCoalescible(pointer_data)) {
+      last_move_indices.clear();
+      pointers[count++] = pointer_data;
+      continue;
+    }
+
+    auto iter = last_move_indices.find(pointer_data.device);
+    if (iter != last_move_indices.end() &&
+        CanCoalesce(pointers[iter->second], pointer_data)) {
+      PointerData& merged = pointers[iter->second];
+      PointerData previous = merged;
+      merged = pointer_data;
+      merged.physical_delta_x += previous.physical_delta_x;
+      merged.physical_delta_y += previous.physical_delta_y;
+      // The merged event is only synthesized if all of its events were.
+      merged.synthesized = previous.synthesized && pointer_data.synthesized;
+      continue;
+    }
+
+    last_move_indices[pointer_data.device] = count;
+    pointers[count++] = pointer_data;
+  }
+  pointers.resize(count);
+}
+
 void PointerDataPacketConverter::ConvertPointerData(
     PointerData pointer_data,
     std::vector<PointerData>& converted_pointers) {
@@ -109,12 +109,33 @@ class PointerDataPacketConverter {
   ///
   /// @param[in]  packet                   The raw pointer packet sent from
   ///                                      embedding.
+  /// @param[in]  coalesce_moves           Whether to merge consecutive move
+  ///                                      and hover events of each pointer,
+  ///                                      see |CoalesceMoves|.
   ///
   /// @return     A full converted packet with all the required information
   ///             filled. It may contain synthetic pointer data as the result of
   ///             converter's attempt to correct illegal pointer transitions.
   ///
-  std::unique_ptr<PointerDataPacket> Convert(const PointerDataPacket& packet);
+  std::unique_ptr<PointerDataPacket> Convert(const PointerDataPacket& packet,
+                                             bool coalesce_moves = false);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Merges consecutive move events, and consecutive hover events,
+  ///             of the same pointer in converted pointer data.
+  ///
+  ///             High rate input devices can produce many move events per
+  ///             frame, which the framework resamples to the frame time
+  ///             anyway. The merged event has the position and other values
+  ///             of the last event, and the sum of the deltas of all merged
+  ///             events. Events that aren't moves or hovers, such as downs,
+  ///             ups and signals, are never merged or reordered, and no move
+  ///             is merged across them.
+  ///
+  /// @param[in]  pointers             The converted pointer data to coalesce
+  ///                                  in place.
+  ///
+  static void CoalesceMoves(std::vector<PointerData>& pointers);
 
  private:
   const Delegate& delegate_;
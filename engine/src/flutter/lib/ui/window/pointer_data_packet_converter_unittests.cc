@@ -881,5 +881,73 @@ TEST(PointerDataPacketConverterTest, CanConvertViewId) {
   ASSERT_EQ(result[1].view_id, 200);
 }
 
+TEST(PointerDataPacketConverterTest, CanCoalesceMoveEvents) {
+  TestDelegate delegate;
+  delegate.AddView(kImplicitViewId);
+  PointerDataPacketConverter converter(delegate);
+  auto packet = std::make_unique<PointerDataPacket>(11);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 1, 5.0, 5.0, 0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 1.0, 0.0, 1);
+  packet->SetPointerData(3, data);
+  // Hover events of another device in between don't prevent merging.
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 1, 7.0, 9.0, 0);
+  packet->SetPointerData(4, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 3.0, 1.0, 1);
+  packet->SetPointerData(5, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 6.0, 2.0, 1);
+  packet->SetPointerData(6, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 1, 8.0, 10.0,
+                             0);
+  packet->SetPointerData(7, data);
+  // The up event is preserved, and ends the merged events.
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 0, 6.0, 2.0, 0);
+  packet->SetPointerData(8, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 0, 8.0, 2.0, 0);
+  packet->SetPointerData(9, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 0, 9.0, 3.0, 0);
+  packet->SetPointerData(10, data);
+
+  auto converted_packet = converter.Convert(*packet, /*coalesce_moves=*/true);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result.size(), (size_t)7);
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[1].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[2].change, PointerData::Change::kDown);
+
+  ASSERT_EQ(result[3].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[3].device, 0);
+  ASSERT_EQ(result[3].pointer_identifier, 1);
+  ASSERT_EQ(result[3].synthesized, 0);
+  ASSERT_EQ(result[3].physical_x, 6.0);
+  ASSERT_EQ(result[3].physical_y, 2.0);
+  ASSERT_EQ(result[3].physical_delta_x, 6.0);
+  ASSERT_EQ(result[3].physical_delta_y, 2.0);
+
+  ASSERT_EQ(result[4].change, PointerData::Change::kHover);
+  ASSERT_EQ(result[4].device, 1);
+  ASSERT_EQ(result[4].physical_x, 8.0);
+  ASSERT_EQ(result[4].physical_y, 10.0);
+  ASSERT_EQ(result[4].physical_delta_x, 3.0);
+  ASSERT_EQ(result[4].physical_delta_y, 5.0);
+
+  ASSERT_EQ(result[5].change, PointerData::Change::kUp);
+  ASSERT_EQ(result[5].pointer_identifier, 1);
+
+  ASSERT_EQ(result[6].change, PointerData::Change::kHover);
+  ASSERT_EQ(result[6].device, 0);
+  ASSERT_EQ(result[6].physical_x, 9.0);
+  ASSERT_EQ(result[6].physical_delta_x, 3.0);
+  ASSERT_EQ(result[6].physical_delta_y, 1.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -360,11 +360,12 @@ bool RuntimeController::DispatchPlatformMessage(
 }
 
 bool RuntimeController::DispatchPointerDataPacket(
-    const PointerDataPacket& packet) {
+    const PointerDataPacket& packet,
+    bool coalesce_moves) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
     TRACE_EVENT0("flutter", "RuntimeController::DispatchPointerDataPacket");
     std::unique_ptr<PointerDataPacket> converted_packet =
-        pointer_data_packet_converter_.Convert(packet);
+        pointer_data_packet_converter_.Convert(packet, coalesce_moves);
     if (converted_packet->GetLength() != 0) {
       platform_configuration->DispatchPointerDataPacket(*converted_packet);
     }
@@ -469,12 +469,16 @@ class RuntimeController : public PlatformConfigurationClient,
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
   ///
-  /// @param[in]  packet  The pointer data message to dispatch to the isolate.
+  /// @param[in]  packet          The pointer data message to dispatch to the
+  ///                             isolate.
+  /// @param[in]  coalesce_moves  Whether to merge consecutive move and hover
+  ///                             events of each pointer in the packet.
   ///
   /// @return     If the pointer data message was dispatched. This may fail is
   ///             an isolate is not running.
   ///
-  bool DispatchPointerDataPacket(const PointerDataPacket& packet);
+  bool DispatchPointerDataPacket(const PointerDataPacket& packet,
+                                 bool coalesce_moves = false);
 
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the semantics action to the specified accessibility
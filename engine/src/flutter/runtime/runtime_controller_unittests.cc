@@ -16,7 +16,7 @@ using RuntimeControllerTest = ShellTest;
 class MockRuntimeDelegate : public RuntimeDelegate {
  public:
   FontCollection font;
-  std::vector<SemanticsNodeUpdates> updates;
+  std::vector<FlatSemanticsNodeUpdates> updates;
   std::vector<CustomAccessibilityActionUpdates> actions;
   std::string DefaultRouteName() override { return ""; }
   std::string locale;
@@ -30,7 +30,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
               float device_pixel_ratio) override {}
 
   void UpdateSemantics(int64_t view_id,
-                       SemanticsNodeUpdates update,
+                       FlatSemanticsNodeUpdates update,
                        CustomAccessibilityActionUpdates actions) override {
     this->updates.push_back(update);
     this->actions.push_back(actions);
@@ -11,7 +11,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
-#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/view_focus.h"
@@ -33,7 +33,7 @@ class RuntimeDelegate {
                       float device_pixel_ratio) = 0;
 
   virtual void UpdateSemantics(int64_t view_id,
-                               SemanticsNodeUpdates update,
+                               FlatSemanticsNodeUpdates update,
                                CustomAccessibilityActionUpdates actions) = 0;
 
   virtual void SetApplicationLocale(std::string locale) = 0;
@@ -57,6 +57,12 @@ Engine::Engine(
       task_runners_(task_runners),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  font_collection_->SetAssetPrefetchTaskRunner(image_decoder_task_runner);
+  if (settings_.coalesce_pointer_moves) {
+    pointer_data_dispatcher_ =
+        std::make_unique<CoalescingPointerDataDispatcher>(
+            *this, std::move(pointer_data_dispatcher_));
+  }
 }
 
 Engine::Engine(Delegate& delegate,
@@ -523,7 +529,7 @@ void Engine::Render(int64_t view_id,
 }
 
 void Engine::UpdateSemantics(int64_t view_id,
-                             SemanticsNodeUpdates update,
+                             FlatSemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
   delegate_.OnEngineUpdateSemantics(view_id, std::move(update),
                                     std::move(actions));
@@ -580,7 +586,8 @@ void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
   if (runtime_controller_) {
-    runtime_controller_->DispatchPointerDataPacket(*packet);
+    runtime_controller_->DispatchPointerDataPacket(
+        *packet, settings_.coalesce_pointer_moves);
   }
 }
 
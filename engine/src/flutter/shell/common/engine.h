@@ -16,6 +16,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -146,19 +147,19 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
     ///             platform task runner while the engine is running on the UI
     ///             task runner.
     ///
-    /// @see        `SemanticsNode`, `SemanticsNodeUpdates`,
+    /// @see        `SemanticsNode`, `FlatSemanticsNodeUpdates`,
     ///             `CustomAccessibilityActionUpdates`,
-    ///             `PlatformView::UpdateSemantics`
+    ///             `PlatformView::UpdateFlatSemantics`
     ///
     /// @param[in]  view_id  The ID of the view that this update is for
-    /// @param[in]  updates  A map with the stable semantics node identifier as
-    ///                      key and the node properties as the value.
+    /// @param[in]  updates  The updated semantics nodes, at most one per
+    ///                      stable semantics node identifier.
     /// @param[in]  actions  A map with the stable semantics node identifier as
     ///                      key and the custom node action as the value.
     ///
     virtual void OnEngineUpdateSemantics(
         int64_t view_id,
-        SemanticsNodeUpdates updates,
+        FlatSemanticsNodeUpdates updates,
         CustomAccessibilityActionUpdates actions) = 0;
 
     //--------------------------------------------------------------------------
@@ -1033,7 +1034,7 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   // |RuntimeDelegate|
   void UpdateSemantics(int64_t view_id,
-                       SemanticsNodeUpdates update,
+                       FlatSemanticsNodeUpdates update,
                        CustomAccessibilityActionUpdates actions) override;
 
   // |RuntimeDelegate|
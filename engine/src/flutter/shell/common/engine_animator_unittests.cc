@@ -55,7 +55,9 @@ class MockDelegate : public Engine::Delegate {
  public:
   MOCK_METHOD(void,
               OnEngineUpdateSemantics,
-              (int64_t, SemanticsNodeUpdates, CustomAccessibilityActionUpdates),
+              (int64_t,
+               FlatSemanticsNodeUpdates,
+               CustomAccessibilityActionUpdates),
               (override));
   MOCK_METHOD(void,
               OnEngineSetApplicationLocale,
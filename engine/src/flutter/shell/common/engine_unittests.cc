@@ -58,11 +58,67 @@ class FontManifestAssetResolver : public AssetResolver {
   }
 };
 
+// Serves a font manifest that lists one font, and counts the lookups of the
+// font.
+class FontAssetResolver : public AssetResolver {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  AssetResolver::AssetResolverType GetType() const override {
+    return AssetResolver::AssetResolverType::kApkAssetProvider;
+  }
+
+  mutable size_t font_call_count = 0u;
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    if (asset_name == "FontManifest.json") {
+      return std::make_unique<fml::DataMapping>(
+          R"([{"family":"Roboto","fonts":[{"asset":"fonts/Roboto.ttf"}]}])");
+    }
+    if (asset_name == "fonts/Roboto.ttf") {
+      font_call_count++;
+      return std::make_unique<fml::DataMapping>("font");
+    }
+    return nullptr;
+  }
+
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override {
+    return {};
+  };
+
+  bool operator==(const AssetResolver& other) const override {
+    return this == &other;
+  }
+};
+
+// Runs posted tasks only when asked to.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  void RunPendingTasks() {
+    std::vector<fml::closure> tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
 class MockDelegate : public Engine::Delegate {
  public:
   MOCK_METHOD(void,
               OnEngineUpdateSemantics,
-              (int64_t, SemanticsNodeUpdates, CustomAccessibilityActionUpdates),
+              (int64_t,
+               FlatSemanticsNodeUpdates,
+               CustomAccessibilityActionUpdates),
               (override));
   MOCK_METHOD(void,
               OnEngineSetApplicationLocale,
@@ -118,7 +174,9 @@ class MockRuntimeDelegate : public RuntimeDelegate {
               (override));
   MOCK_METHOD(void,
               UpdateSemantics,
-              (int64_t, SemanticsNodeUpdates, CustomAccessibilityActionUpdates),
+              (int64_t,
+               FlatSemanticsNodeUpdates,
+               CustomAccessibilityActionUpdates),
               (override));
   MOCK_METHOD(void, SetApplicationLocale, (const std::string), (override));
   MOCK_METHOD(void, SetSemanticsTreeEnabled, (bool), (override));
@@ -564,4 +622,23 @@ TEST_F(EngineTest, UpdateAssetManagerWithEqualManagers) {
   });
 }
 
+TEST_F(EngineTest, RegisteringFontsPrefetchesFontAssets) {
+  auto resolver = std::make_unique<FontAssetResolver>();
+  FontAssetResolver* font_resolver = resolver.get();
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::move(resolver));
+
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  FontCollection font_collection;
+  font_collection.SetAssetPrefetchTaskRunner(task_runner);
+  font_collection.RegisterFonts(asset_manager);
+  EXPECT_EQ(font_resolver->font_call_count, 0u);
+  task_runner->RunPendingTasks();
+  EXPECT_EQ(font_resolver->font_call_count, 1u);
+
+  // Loading the font hands over the prefetched mapping.
+  EXPECT_NE(asset_manager->GetAsMapping("fonts/Roboto.ttf"), nullptr);
+  EXPECT_EQ(font_resolver->font_call_count, 1u);
+}
+
 }  // namespace flutter
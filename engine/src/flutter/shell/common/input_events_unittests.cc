@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <map>
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -440,6 +443,75 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+namespace {
+
+// Records the packets dispatched to the engine, and the vsync callbacks.
+class RecordingDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callbacks[id] = callback;
+  }
+
+  void Vsync() {
+    auto callbacks = std::move(vsync_callbacks);
+    vsync_callbacks.clear();
+    for (const auto& callback : callbacks) {
+      callback.second();
+    }
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  std::map<uintptr_t, fml::closure> vsync_callbacks;
+};
+
+std::unique_ptr<PointerDataPacket> CreateSimulatedPacket(double x) {
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, x, 0.0);
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  packet->SetPointerData(0, data);
+  return packet;
+}
+
+}  // namespace
+
+TEST(CoalescingPointerDataDispatcherTest, BatchesPacketsUntilVsync) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  RecordingDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(
+      delegate, std::make_unique<DefaultPointerDataDispatcher>(delegate));
+
+  // The first packet of a frame is dispatched right away.
+  dispatcher.DispatchPacket(CreateSimulatedPacket(1.0), 0);
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  // Later packets are batched until the next vsync.
+  dispatcher.DispatchPacket(CreateSimulatedPacket(2.0), 0);
+  dispatcher.DispatchPacket(CreateSimulatedPacket(3.0), 0);
+  dispatcher.DispatchPacket(CreateSimulatedPacket(4.0), 0);
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  delegate.Vsync();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  ASSERT_EQ(delegate.packets[1]->GetLength(), 3u);
+  EXPECT_EQ(delegate.packets[1]->GetPointerData(0).physical_x, 2.0);
+  EXPECT_EQ(delegate.packets[1]->GetPointerData(2).physical_x, 4.0);
+
+  // A frame without new packets ends the batching.
+  delegate.Vsync();
+  delegate.Vsync();
+  dispatcher.DispatchPacket(CreateSimulatedPacket(5.0), 0);
+  ASSERT_EQ(delegate.packets.size(), 3u);
+  EXPECT_EQ(delegate.packets[2]->GetPointerData(0).physical_x, 5.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -130,6 +130,13 @@ void PlatformView::UpdateSemantics(
     // NOLINTNEXTLINE(performance-unnecessary-value-param)
     CustomAccessibilityActionUpdates actions) {}
 
+void PlatformView::UpdateFlatSemantics(
+    int64_t view_id,
+    const FlatSemanticsNodeUpdates& updates,
+    const CustomAccessibilityActionUpdates& actions) {
+  UpdateSemantics(view_id, updates.ToSemanticsNodeUpdates(), actions);
+}
+
 void PlatformView::SetApplicationLocale(
     std::string locale  // NOLINT(performance-unnecessary-value-param)
 ) {}
@@ -16,6 +16,7 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/window/key_data_packet.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -514,6 +515,26 @@ class PlatformView {
                                SemanticsNodeUpdates updates,
                                CustomAccessibilityActionUpdates actions);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to apply semantics node updates in the flat
+  ///             form produced by the framework. Platform views that can read
+  ///             the flat tables directly override this to avoid building a
+  ///             `SemanticsNode` per updated node. The default implementation
+  ///             converts the update and calls `UpdateSemantics`.
+  ///
+  /// @see        FlatSemanticsNodeUpdates, UpdateSemantics
+  ///
+  /// @param[in]  view_id  The ID of the view that this update is for
+  /// @param[in]  updates  The updated semantics nodes. Only valid for the
+  ///                      duration of the call.
+  /// @param[in]  actions  A map with the stable semantics node identifier as
+  ///                      key and the custom node action as the value.
+  ///
+  virtual void UpdateFlatSemantics(
+      int64_t view_id,
+      const FlatSemanticsNodeUpdates& updates,
+      const CustomAccessibilityActionUpdates& actions);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by the framework to set application locale in the
   ///             embedding
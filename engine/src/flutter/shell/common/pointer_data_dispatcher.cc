@@ -15,6 +15,14 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate,
+    std::unique_ptr<PointerDataDispatcher> dispatcher)
+    : delegate_(delegate),
+      dispatcher_(std::move(dispatcher)),
+      weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +80,55 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "CoalescingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (is_pointer_data_in_progress_) {
+    if (!pending_data_.empty()) {
+      // Only the flow of the last batched packet reaches the framework.
+      TRACE_FLOW_END("flutter", "PointerEvent", pending_trace_flow_id_);
+    }
+    const std::vector<uint8_t>& data = packet->data();
+    pending_data_.insert(pending_data_.end(), data.begin(), data.end());
+    pending_trace_flow_id_ = trace_flow_id;
+    return;
+  }
+
+  is_pointer_data_in_progress_ = true;
+  dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
+void CoalescingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (!dispatcher) {
+          return;
+        }
+        if (dispatcher->pending_data_.empty()) {
+          dispatcher->is_pointer_data_in_progress_ = false;
+        } else {
+          dispatcher->DispatchPendingPacket();
+        }
+      });
+}
+
+void CoalescingPointerDataDispatcher::DispatchPendingPacket() {
+  FML_DCHECK(!pending_data_.empty());
+  FML_DCHECK(is_pointer_data_in_progress_);
+  auto packet = std::make_unique<PointerDataPacket>(pending_data_.data(),
+                                                    pending_data_.size());
+  uint64_t trace_flow_id = pending_trace_flow_id_;
+  pending_data_.clear();
+  pending_trace_flow_id_ = 0;
+  dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
 }  // namespace flutter
@@ -164,6 +164,51 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that batches the packets received between two VSYNCs into one
+/// packet, and forwards it to another dispatcher.
+///
+/// Embedders usually deliver one event per packet, so a 1 kHz mouse or
+/// stylus delivers 16 packets per frame at 60 Hz. The first packet of a frame
+/// is forwarded right away, so idle input keeps its latency. Packets that
+/// arrive while that dispatch is in progress are appended to a pending packet,
+/// which is forwarded at the next VSYNC. The engine then merges the moves of
+/// each device in the batched packet, see
+/// `PointerDataPacketConverter::CoalesceMoves`.
+///
+/// The engine wraps the dispatcher created by the `PlatformView` in this one
+/// when `Settings::coalesce_pointer_moves` is set.
+class CoalescingPointerDataDispatcher : public PointerDataDispatcher {
+ public:
+  CoalescingPointerDataDispatcher(
+      Delegate& delegate,
+      std::unique_ptr<PointerDataDispatcher> dispatcher);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  void DispatchPendingPacket();
+  void ScheduleSecondaryVsyncCallback();
+
+  Delegate& delegate_;
+  std::unique_ptr<PointerDataDispatcher> dispatcher_;
+
+  // The pointer data of the packets received since the last dispatch, in the
+  // layout of |PointerDataPacket::data|.
+  std::vector<uint8_t> pending_data_;
+  uint64_t pending_trace_flow_id_ = 0;
+  bool is_pointer_data_in_progress_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::TaskRunnerAffineWeakPtrFactory<CoalescingPointerDataDispatcher>
+      weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <map>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/window/pointer_data_packet_converter.h"
+
+namespace flutter {
+
+namespace {
+
+// The number of frames of input dispatched per benchmark iteration.
+constexpr int kFrameCount = 60;
+
+// The number of input events per frame of a 1 kHz device at 60 Hz.
+constexpr int kEventsPerFrame = 16;
+
+// Converts packets like the engine does, and counts the converted events that
+// would be dispatched to the framework.
+class BenchmarkDispatcherDelegate : public PointerDataDispatcher::Delegate,
+                                    public PointerDataPacketConverter::Delegate {
+ public:
+  explicit BenchmarkDispatcherDelegate(bool coalesce_moves)
+      : coalesce_moves_(coalesce_moves), converter_(*this) {}
+
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    auto converted = converter_.Convert(*packet, coalesce_moves_);
+    dispatched_count_ += converted->GetLength();
+    benchmark::DoNotOptimize(converted->data().data());
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callbacks_[id] = callback;
+  }
+
+  // |PointerDataPacketConverter::Delegate|
+  bool ViewExists(int64_t view_id) const override { return true; }
+
+  size_t dispatched_count() const { return dispatched_count_; }
+
+  // Runs the callbacks scheduled for the next vsync.
+  void Vsync() {
+    std::map<uintptr_t, fml::closure> callbacks = std::move(vsync_callbacks_);
+    vsync_callbacks_.clear();
+    for (const auto& callback : callbacks) {
+      callback.second();
+    }
+  }
+
+ private:
+  bool coalesce_moves_;
+  PointerDataPacketConverter converter_;
+  std::map<uintptr_t, fml::closure> vsync_callbacks_;
+  size_t dispatched_count_ = 0;
+};
+
+PointerData MakePointerData(PointerData::Change change,
+                            int64_t device,
+                            double x,
+                            double y) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kStylus;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_y = y;
+  data.buttons = change == PointerData::Change::kHover ? 0 : 1;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> MakePacket(const PointerData& data) {
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  packet->SetPointerData(0, data);
+  return packet;
+}
+
+// Returns the packets of one drag gesture per device, one event per packet as
+// embedders deliver them, grouped by the frame in which a 1 kHz device
+// delivers them.
+std::vector<std::vector<std::unique_ptr<PointerDataPacket>>> MakeDragFrames(
+    int device_count) {
+  std::vector<std::vector<std::unique_ptr<PointerDataPacket>>> frames(
+      kFrameCount);
+  for (int device = 0; device < device_count; device++) {
+    frames.front().push_back(MakePacket(
+        MakePointerData(PointerData::Change::kAdd, device, 0.0, 0.0)));
+    frames.front().push_back(MakePacket(
+        MakePointerData(PointerData::Change::kDown, device, 0.0, 0.0)));
+  }
+  for (int frame = 0; frame < kFrameCount; frame++) {
+    for (int i = 0; i < kEventsPerFrame; i++) {
+      double position = frame * kEventsPerFrame + i + 1;
+      for (int device = 0; device < device_count; device++) {
+        frames[frame].push_back(
+            MakePacket(MakePointerData(PointerData::Change::kMove, device,
+                                       position, position * 0.5)));
+      }
+    }
+  }
+  double position = kFrameCount * kEventsPerFrame;
+  for (int device = 0; device < device_count; device++) {
+    frames.back().push_back(MakePacket(MakePointerData(
+        PointerData::Change::kUp, device, position, position * 0.5)));
+    frames.back().push_back(MakePacket(MakePointerData(
+        PointerData::Change::kRemove, device, position, position * 0.5)));
+  }
+  return frames;
+}
+
+}  // namespace
+
+static void BM_DispatchPointerPackets(benchmark::State& state,
+                                      bool coalesce_moves) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  const int device_count = state.range(0);
+  size_t dispatched_count = 0;
+  size_t event_count = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto frames = MakeDragFrames(device_count);
+    BenchmarkDispatcherDelegate delegate(coalesce_moves);
+    std::unique_ptr<PointerDataDispatcher> dispatcher =
+        std::make_unique<DefaultPointerDataDispatcher>(delegate);
+    if (coalesce_moves) {
+      dispatcher = std::make_unique<CoalescingPointerDataDispatcher>(
+          delegate, std::move(dispatcher));
+    }
+    for (const auto& frame : frames) {
+      event_count += frame.size();
+    }
+    state.ResumeTiming();
+
+    for (auto& frame : frames) {
+      for (auto& packet : frame) {
+        dispatcher->DispatchPacket(std::move(packet), /*trace_flow_id=*/0);
+      }
+      delegate.Vsync();
+    }
+    delegate.Vsync();
+    dispatched_count += delegate.dispatched_count();
+  }
+  state.SetItemsProcessed(event_count);
+  state.counters["DispatchedPerEvent"] =
+      static_cast<double>(dispatched_count) / event_count;
+}
+
+static void BM_DispatchPointerPacketsWithoutCoalescing(
+    benchmark::State& state) {
+  BM_DispatchPointerPackets(state, false);
+}
+BENCHMARK(BM_DispatchPointerPacketsWithoutCoalescing)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(5)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_DispatchPointerPacketsWithCoalescing(benchmark::State& state) {
+  BM_DispatchPointerPackets(state, true);
+}
+BENCHMARK(BM_DispatchPointerPacketsWithCoalescing)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(5)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -12,6 +12,7 @@
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
@@ -19,6 +20,7 @@
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "fml/closure.h"
 #include "fml/make_copyable.h"
+#include "fml/synchronization/count_down_latch.h"
 #include "fml/synchronization/waitable_event.h"
 #include "impeller/renderer/context.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -60,6 +62,8 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  NOT_SLIMPELLER(compositor_context_->raster_cache().SetByteBudget(
+      delegate.GetSettings().raster_cache_byte_budget));
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -657,18 +661,39 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
   // Second traverse: draw all layer trees.
+  std::vector<sk_sp<DisplayList>> recordings = RecordViewsConcurrently(tasks);
   std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks;
-  for (std::unique_ptr<LayerTreeTask>& task : tasks) {
+#if !SLIMPELLER
+  // Only the raster caches used this frame are reported. The views recorded
+  // concurrently use their own raster caches.
+  std::vector<const RasterCache*> raster_caches = {
+      &compositor_context_->raster_cache()};
+#endif  //  !SLIMPELLER
+  for (size_t i = 0; i < tasks.size(); i++) {
+    std::unique_ptr<LayerTreeTask>& task = tasks[i];
     int64_t view_id = task->view_id;
     std::unique_ptr<LayerTree> layer_tree = std::move(task->layer_tree);
     float device_pixel_ratio = task->device_pixel_ratio;
 
-    DrawSurfaceStatus status = DrawToSurfaceUnsafe(
-        view_id, *layer_tree, device_pixel_ratio, presentation_time);
+    DrawSurfaceStatus status =
+        recordings[i]
+            ? DrawRecordingToSurfaceUnsafe(view_id, *layer_tree,
+                                           device_pixel_ratio,
+                                           presentation_time, recordings[i])
+            : DrawToSurfaceUnsafe(view_id, *layer_tree, device_pixel_ratio,
+                                  presentation_time);
     FML_DCHECK(status != DrawSurfaceStatus::kDiscarded);
 
     auto& view_record = EnsureViewRecord(task->view_id);
     view_record.last_draw_status = status;
+    if (recordings[i]) {
+      NOT_SLIMPELLER(raster_caches.push_back(
+          &view_record.concurrent_compositor_context->raster_cache()));
+    } else {
+      // The view was drawn with the raster cache of the rasterizer, so its
+      // own raster cache was not pruned this frame and would go stale.
+      view_record.concurrent_compositor_context.reset();
+    }
     if (status == DrawSurfaceStatus::kSuccess) {
       view_record.last_successful_task = std::make_unique<LayerTreeTask>(
           view_id, std::move(layer_tree), device_pixel_ratio);
@@ -677,10 +702,11 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
           view_id, std::move(layer_tree), device_pixel_ratio));
     }
   }
-  // TODO(dkwingsmt): Pass in raster cache(s) for all views.
-  // See https://github.com/flutter/flutter/issues/135530, item 4.
-  frame_timings_recorder.RecordRasterEnd(
-      NOT_SLIMPELLER(&compositor_context_->raster_cache()));
+#if !SLIMPELLER
+  frame_timings_recorder.RecordRasterEnd(raster_caches);
+#else
+  frame_timings_recorder.RecordRasterEnd();
+#endif  //  !SLIMPELLER
 
   FireNextFrameCallbackIfPresent();
 
@@ -792,16 +818,7 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     }
 
     frame->set_submit_info(submit_info);
-
-    if (external_view_embedder_ &&
-        (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
-      FML_DCHECK(!frame->IsSubmitted());
-      external_view_embedder_->SubmitFlutterView(
-          view_id, surface_->GetContext(), surface_->GetAiksContext(),
-          std::move(frame));
-    } else {
-      frame->Submit();
-    }
+    SubmitSurfaceFrame(view_id, std::move(frame));
 
 #if !SLIMPELLER
     // Do not update raster cache metrics for kResubmit because that status
@@ -822,6 +839,178 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
   return DrawSurfaceStatus::kFailed;
 }
 
+// Whether the layer tree can be prerolled and painted without the external
+// view embedder and the texture registry of the rasterizer.
+static bool CanRecordConcurrently(const Layer* layer) {
+  if (layer->as_platform_view_layer() || layer->as_texture_layer()) {
+    return false;
+  }
+  if (const ContainerLayer* container = layer->as_container_layer()) {
+    for (const std::shared_ptr<Layer>& child : container->layers()) {
+      if (!CanRecordConcurrently(child.get())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static sk_sp<DisplayList> RecordView(CompositorContext& compositor_context,
+                                     LayerTree& layer_tree,
+                                     const DlMatrix& root_surface_transformation,
+                                     bool ignore_raster_cache) {
+  TRACE_EVENT0("flutter", "Rasterizer::RecordView");
+  DisplayListBuilder builder(DlRect::MakeSize(layer_tree.frame_size()));
+  auto compositor_frame = compositor_context.AcquireFrame(
+      nullptr,                      // skia GrContext
+      &builder,                     // root surface canvas
+      nullptr,                      // external view embedder
+      root_surface_transformation,  // root surface transformation
+      true,                         // instrumentation enabled
+      true,                         // surface supports pixel reads
+      nullptr,                      // thread merger
+      nullptr                       // aiks context
+  );
+  RasterStatus status =
+      compositor_frame->Raster(layer_tree, ignore_raster_cache, nullptr);
+  // Without an external view embedder, the frame is never resubmitted.
+  FML_DCHECK(status == RasterStatus::kSuccess);
+  return builder.Build();
+}
+
+std::vector<sk_sp<DisplayList>> Rasterizer::RecordViewsConcurrently(
+    const std::vector<std::unique_ptr<LayerTreeTask>>& tasks) {
+  std::vector<sk_sp<DisplayList>> recordings(tasks.size());
+  // Ganesh and Impeller contexts must only be used on the raster thread, and
+  // the thread merger may require the embedder to see every preroll.
+  if (!concurrent_view_task_runner_ || tasks.size() < 2 ||
+      raster_thread_merger_ || surface_->GetContext() ||
+      surface_->GetAiksContext()) {
+    return recordings;
+  }
+
+  std::vector<size_t> recorded_tasks;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    const LayerTree& layer_tree = *tasks[i]->layer_tree;
+    if (layer_tree.root_layer() &&
+        CanRecordConcurrently(layer_tree.root_layer())) {
+      recorded_tasks.push_back(i);
+    }
+  }
+  if (recorded_tasks.size() < 2) {
+    return recordings;
+  }
+
+  TRACE_EVENT0("flutter", "Rasterizer::RecordViewsConcurrently");
+  // With an external view embedder, the root surface transformation is
+  // applied when the recording is drawn, as in DrawToSurfaceUnsafe.
+  const DlMatrix root_surface_transformation =
+      external_view_embedder_ ? DlMatrix() : surface_->GetRootTransformation();
+  const bool ignore_raster_cache = !surface_->EnableRasterCache();
+
+  // The view records are created here, on the raster thread, so that the
+  // records are not modified while the views are being recorded. The frame
+  // budget is queried and the raster caches begin and end their frames here
+  // too, so that they are reported like the raster cache of the rasterizer.
+  concurrent_frame_budget_.Update(GetFrameBudget());
+  std::vector<CompositorContext*> compositor_contexts;
+  for (size_t i : recorded_tasks) {
+    ViewRecord& view_record = EnsureViewRecord(tasks[i]->view_id);
+    if (!view_record.concurrent_compositor_context) {
+      view_record.concurrent_compositor_context =
+          std::make_unique<flutter::CompositorContext>(
+              concurrent_frame_budget_);
+      NOT_SLIMPELLER(
+          view_record.concurrent_compositor_context->raster_cache()
+              .SetByteBudget(delegate_.GetSettings().raster_cache_byte_budget));
+    }
+    compositor_contexts.push_back(
+        view_record.concurrent_compositor_context.get());
+    NOT_SLIMPELLER(
+        view_record.concurrent_compositor_context->raster_cache().BeginFrame());
+  }
+
+  // The first view is recorded on the raster thread while the others are
+  // recorded on the task runner.
+  fml::CountDownLatch latch(recorded_tasks.size() - 1);
+  for (size_t j = 1; j < recorded_tasks.size(); j++) {
+    concurrent_view_task_runner_->PostTask([&, j]() {
+      size_t i = recorded_tasks[j];
+      recordings[i] =
+          RecordView(*compositor_contexts[j], *tasks[i]->layer_tree,
+                     root_surface_transformation, ignore_raster_cache);
+      latch.CountDown();
+    });
+  }
+  recordings[recorded_tasks[0]] =
+      RecordView(*compositor_contexts[0], *tasks[recorded_tasks[0]]->layer_tree,
+                 root_surface_transformation, ignore_raster_cache);
+  latch.Wait();
+#if !SLIMPELLER
+  for (CompositorContext* compositor_context : compositor_contexts) {
+    compositor_context->raster_cache().EndFrame();
+  }
+#endif  //  !SLIMPELLER
+  return recordings;
+}
+
+/// \see Rasterizer::DrawToSurfaces
+DrawSurfaceStatus Rasterizer::DrawRecordingToSurfaceUnsafe(
+    int64_t view_id,
+    const flutter::LayerTree& layer_tree,
+    float device_pixel_ratio,
+    std::optional<fml::TimePoint> presentation_time,
+    const sk_sp<DisplayList>& recording) {
+  FML_DCHECK(surface_);
+
+  DlCanvas* embedder_root_canvas = nullptr;
+  if (external_view_embedder_) {
+    external_view_embedder_->PrepareFlutterView(layer_tree.frame_size(),
+                                                device_pixel_ratio);
+    embedder_root_canvas = external_view_embedder_->GetRootCanvas();
+  }
+
+  auto frame = surface_->AcquireFrame(layer_tree.frame_size());
+  if (frame == nullptr) {
+    return DrawSurfaceStatus::kFailed;
+  }
+
+  DlCanvas* canvas =
+      embedder_root_canvas ? embedder_root_canvas : frame->Canvas();
+  if (canvas) {
+    DlAutoCanvasRestore restore(canvas, true);
+    if (external_view_embedder_ && !embedder_root_canvas) {
+      canvas->Transform(surface_->GetRootTransformation());
+    }
+    if (recording->root_has_backdrop_filter() &&
+        !frame->framebuffer_info().supports_readback) {
+      DlPaint paint;
+      paint.setBlendMode(DlBlendMode::kSrc);
+      canvas->SaveLayer(DlRect::MakeSize(layer_tree.frame_size()), &paint);
+    }
+    canvas->DrawDisplayList(recording);
+  }
+
+  SurfaceFrame::SubmitInfo submit_info;
+  submit_info.presentation_time = presentation_time;
+  frame->set_submit_info(submit_info);
+  SubmitSurfaceFrame(view_id, std::move(frame));
+  return DrawSurfaceStatus::kSuccess;
+}
+
+void Rasterizer::SubmitSurfaceFrame(int64_t view_id,
+                                    std::unique_ptr<SurfaceFrame> frame) {
+  if (external_view_embedder_ &&
+      (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
+    FML_DCHECK(!frame->IsSubmitted());
+    external_view_embedder_->SubmitFlutterView(
+        view_id, surface_->GetContext(), surface_->GetAiksContext(),
+        std::move(frame));
+  } else {
+    frame->Submit();
+  }
+}
+
 Rasterizer::ViewRecord& Rasterizer::EnsureViewRecord(int64_t view_id) {
   return view_records_[view_id];
 }
@@ -1094,6 +1283,20 @@ void Rasterizer::SetExternalViewEmbedder(
   external_view_embedder_ = view_embedder;
 }
 
+void Rasterizer::SetConcurrentViewRasterization(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  concurrent_view_task_runner_ = std::move(task_runner);
+}
+
+void Rasterizer::SetConcurrentRasterCacheRasterization(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+#if !SLIMPELLER
+  compositor_context_->raster_cache().SetConcurrentRasterization(
+      std::move(task_runner),
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
+#endif  //  !SLIMPELLER
+}
+
 void Rasterizer::SetSnapshotSurfaceProducer(
     std::unique_ptr<SnapshotSurfaceProducer> producer) {
   snapshot_surface_producer_ = std::move(producer);
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -23,6 +24,7 @@
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -496,6 +498,45 @@ class Rasterizer final : public SnapshotDelegate,
   void SetExternalViewEmbedder(
       const std::shared_ptr<ExternalViewEmbedder>& view_embedder);
 
+  //----------------------------------------------------------------------------
+  /// @brief Opt in to prerolling and recording the layer trees of multiple
+  ///        views concurrently on the given task runner, such as the task
+  ///        runner of a `fml::ConcurrentMessageLoop`. A null task runner
+  ///        turns the mode off again.
+  ///
+  ///        Each view is prerolled and painted into a display list with its
+  ///        own compositor frame and raster cache shard. The display lists
+  ///        are then drawn to their surface frames and submitted one view at
+  ///        a time on the raster task runner.
+  ///
+  ///        Only software surfaces without a raster thread merger are
+  ///        supported, and only layer trees without platform views or
+  ///        texture layers are recorded concurrently. The other layer trees
+  ///        are drawn as usual. Frame damage is not tracked for views that
+  ///        are recorded concurrently, so their frames are fully repainted.
+  ///
+  /// @param[in] task_runner The task runner to record the views on.
+  ///
+  void SetConcurrentViewRasterization(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief Opt in to rasterizing new display list entries of the raster
+  ///        cache on the given task runner, such as the task runner of a
+  ///        `fml::ConcurrentMessageLoop`. A null task runner turns the mode
+  ///        off again.
+  ///
+  ///        This only applies to the raster cache used on the raster thread.
+  ///        The views that are recorded concurrently already run on worker
+  ///        threads, so their raster caches rasterize on those threads.
+  ///
+  /// @see `RasterCache::SetConcurrentRasterization`
+  ///
+  /// @param[in] task_runner The task runner to rasterize cache entries on.
+  ///
+  void SetConcurrentRasterCacheRasterization(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
   //----------------------------------------------------------------------------
   /// @brief Set the snapshot surface producer. This is done on shell
   ///        initialization. This is non-null on platforms that support taking
@@ -636,6 +677,25 @@ class Rasterizer final : public SnapshotDelegate,
   struct ViewRecord {
     std::unique_ptr<LayerTreeTask> last_successful_task;
     std::optional<DrawSurfaceStatus> last_draw_status;
+    // The compositor context, and hence the raster cache shard, used to
+    // record the view concurrently with other views.
+    std::unique_ptr<flutter::CompositorContext> concurrent_compositor_context;
+  };
+
+  // The frame budget of the views recorded concurrently. The rasterizer's
+  // delegate must only be queried on the raster thread, so the budget is
+  // updated there before the views are recorded on other threads.
+  class ConcurrentFrameBudget : public Stopwatch::RefreshRateUpdater {
+   public:
+    void Update(fml::Milliseconds frame_budget) {
+      frame_budget_ = frame_budget;
+    }
+
+    // |Stopwatch::RefreshRateUpdater|
+    fml::Milliseconds GetFrameBudget() const override { return frame_budget_; }
+
+   private:
+    fml::Milliseconds frame_budget_ = fml::kDefaultFrameBudget;
   };
 
   // |SnapshotDelegate|
@@ -751,6 +811,30 @@ class Rasterizer final : public SnapshotDelegate,
       float device_pixel_ratio,
       std::optional<fml::TimePoint> presentation_time);
 
+  // Prerolls and paints the layer trees that can be recorded concurrently into
+  // display lists, in parallel on the concurrent view task runner.
+  //
+  // Returns one display list per task, which is null for the tasks that must
+  // be drawn with DrawToSurfaceUnsafe.
+  std::vector<sk_sp<DisplayList>> RecordViewsConcurrently(
+      const std::vector<std::unique_ptr<LayerTreeTask>>& tasks);
+
+  // Draws a display list recorded by RecordViewsConcurrently to the specified
+  // view and submits it.
+  //
+  // This method is not affiliated with the frame timing recorder, but must be
+  // included between the RasterStart and RasterEnd.
+  DrawSurfaceStatus DrawRecordingToSurfaceUnsafe(
+      int64_t view_id,
+      const flutter::LayerTree& layer_tree,
+      float device_pixel_ratio,
+      std::optional<fml::TimePoint> presentation_time,
+      const sk_sp<DisplayList>& recording);
+
+  // Submits the frame of a view, through the external view embedder if it is
+  // responsible for the view.
+  void SubmitSurfaceFrame(int64_t view_id, std::unique_ptr<SurfaceFrame> frame);
+
   ViewRecord& EnsureViewRecord(int64_t view_id);
 
   void FireNextFrameCallbackIfPresent();
@@ -765,12 +849,14 @@ class Rasterizer final : public SnapshotDelegate,
   std::unique_ptr<Surface> surface_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
+  ConcurrentFrameBudget concurrent_frame_budget_;
   std::unordered_map<int64_t, ViewRecord> view_records_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_ = false;
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<fml::BasicTaskRunner> concurrent_view_task_runner_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
 
   // WeakPtrFactory must be the last member.
@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/rasterizer.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/gpu/gpu_surface_software.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr DlISize kViewSize = DlISize(512, 512);
+
+class BenchmarkRasterizerDelegate : public Rasterizer::Delegate {
+ public:
+  explicit BenchmarkRasterizerDelegate(const TaskRunners& task_runners)
+      : task_runners_(task_runners),
+        is_gpu_disabled_sync_switch_(std::make_shared<fml::SyncSwitch>()) {}
+
+  void OnFrameRasterized(const FrameTiming& frame_timing) override {}
+
+  fml::Milliseconds GetFrameBudget() override {
+    return fml::Milliseconds(16);
+  }
+
+  fml::TimePoint GetLatestFrameTargetTime() const override {
+    return fml::TimePoint::Now();
+  }
+
+  const TaskRunners& GetTaskRunners() const override { return task_runners_; }
+
+  const fml::RefPtr<fml::RasterThreadMerger> GetParentRasterThreadMerger()
+      const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
+      const override {
+    return is_gpu_disabled_sync_switch_;
+  }
+
+  const Settings& GetSettings() const override { return settings_; }
+
+  bool ShouldDiscardLayerTree(int64_t view_id,
+                              const flutter::LayerTree& tree) override {
+    return false;
+  }
+
+ private:
+  const TaskRunners& task_runners_;
+  Settings settings_;
+  std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+};
+
+class BenchmarkSoftwareSurfaceDelegate : public GPUSurfaceSoftwareDelegate {
+ public:
+  sk_sp<SkSurface> AcquireBackingStore(const DlISize& size) override {
+    if (!surface_ || surface_->width() != size.width ||
+        surface_->height() != size.height) {
+      surface_ = SkSurfaces::Raster(
+          SkImageInfo::MakeN32Premul(size.width, size.height));
+    }
+    return surface_;
+  }
+
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override {
+    return true;
+  }
+
+ private:
+  sk_sp<SkSurface> surface_;
+};
+
+sk_sp<DisplayList> MakeViewContent(int64_t view_id) {
+  DisplayListBuilder builder;
+  DlPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < 400; i++) {
+    paint.setColor(DlColor(0xFF000000 | ((view_id * 0x3F + i * 0x9E3779) &
+                                         0x00FFFFFF)));
+    DlScalar x = (i * 37) % kViewSize.width;
+    DlScalar y = (i * 53) % kViewSize.height;
+    builder.DrawCircle(DlPoint(x, y), 24.0f + (i % 16), paint);
+    builder.DrawRoundRect(
+        DlRoundRect::MakeRectXY(DlRect::MakeXYWH(y, x, 64.0f, 48.0f), 8, 8),
+        paint);
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+static void BM_RasterizerDrawViews(benchmark::State& state, bool concurrent) {
+  const int64_t view_count = state.range(0);
+  ThreadHost thread_host("io.flutter.bench.",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners("bench",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto concurrent_loop = fml::ConcurrentMessageLoop::Create();
+
+  BenchmarkRasterizerDelegate delegate(task_runners);
+  BenchmarkSoftwareSurfaceDelegate surface_delegate;
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  if (concurrent) {
+    rasterizer->SetConcurrentViewRasterization(
+        concurrent_loop->GetTaskRunner());
+  }
+
+  std::vector<sk_sp<DisplayList>> view_contents;
+  for (int64_t view_id = 0; view_id < view_count; view_id++) {
+    view_contents.push_back(MakeViewContent(view_id));
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetRasterTaskRunner()->PostTask([&] {
+    rasterizer->Setup(std::make_unique<GPUSurfaceSoftware>(
+        &surface_delegate, /*render_to_surface=*/true));
+    latch.Signal();
+  });
+  latch.Wait();
+
+  auto pipeline = std::make_shared<FramePipeline>(/*depth=*/2);
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+    for (int64_t view_id = 0; view_id < view_count; view_id++) {
+      auto layer = std::make_shared<DisplayListLayer>(
+          DlPoint(), view_contents[view_id], /*is_complex=*/false,
+          /*will_change=*/true);
+      tasks.push_back(std::make_unique<LayerTreeTask>(
+          view_id, std::make_unique<LayerTree>(layer, kViewSize),
+          /*device_pixel_ratio=*/1.0f));
+    }
+    auto recorder = std::make_unique<FrameTimingsRecorder>();
+    const auto now = fml::TimePoint::Now();
+    recorder->RecordVsync(now, now);
+    recorder->RecordBuildStart(now);
+    recorder->RecordBuildEnd(now);
+    pipeline->Produce().Complete(
+        std::make_unique<FrameItem>(std::move(tasks), std::move(recorder)));
+
+    task_runners.GetRasterTaskRunner()->PostTask([&] {
+      rasterizer->Draw(pipeline);
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  task_runners.GetRasterTaskRunner()->PostTask([&] {
+    rasterizer->Teardown();
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+  concurrent_loop->Terminate();
+}
+
+static void BM_RasterizerDrawViewsSequentially(benchmark::State& state) {
+  BM_RasterizerDrawViews(state, false);
+}
+BENCHMARK(BM_RasterizerDrawViewsSequentially)
+    ->DenseRange(1, 8)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_RasterizerDrawViewsConcurrently(benchmark::State& state) {
+  BM_RasterizerDrawViews(state, true);
+}
+BENCHMARK(BM_RasterizerDrawViewsConcurrently)
+    ->DenseRange(1, 8)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
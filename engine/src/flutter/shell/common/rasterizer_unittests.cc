@@ -7,10 +7,17 @@
 #include "flow/surface_frame.h"
 #include "flutter/shell/common/rasterizer.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -125,6 +132,36 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
       (override));
   MOCK_METHOD(bool, SupportsDynamicThreadMerging, (), (override));
 };
+
+// Forwards tasks to another task runner, and records the threads that ran
+// them.
+class ThreadRecordingTaskRunner : public fml::BasicTaskRunner {
+ public:
+  explicit ThreadRecordingTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner)
+      : task_runner_(std::move(task_runner)) {}
+
+  // |fml::BasicTaskRunner|
+  void PostTask(const fml::closure& task) override {
+    task_runner_->PostTask([this, task]() {
+      {
+        std::scoped_lock lock(mutex_);
+        thread_ids_.push_back(std::this_thread::get_id());
+      }
+      task();
+    });
+  }
+
+  std::vector<std::thread::id> thread_ids() const {
+    std::scoped_lock lock(mutex_);
+    return thread_ids_;
+  }
+
+ private:
+  std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  mutable std::mutex mutex_;
+  std::vector<std::thread::id> thread_ids_;
+};
 }  // namespace
 
 TEST(RasterizerTest, create) {
@@ -135,6 +172,18 @@ TEST(RasterizerTest, create) {
   EXPECT_TRUE(rasterizer != nullptr);
 }
 
+#if !SLIMPELLER
+TEST(RasterizerTest, appliesRasterCacheByteBudgetFromSettings) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.raster_cache_byte_budget = 1024u * 1024u;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  EXPECT_EQ(rasterizer->compositor_context()->raster_cache().byte_budget(),
+            1024u * 1024u);
+}
+#endif  //  !SLIMPELLER
+
 TEST(RasterizerTest, isAiksContextInitialized) {
   NiceMock<MockDelegate> delegate;
   Settings settings;
@@ -755,6 +804,95 @@ TEST(RasterizerTest, drawMultipleViewsWithExternalViewEmbedder) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, drawMultipleViewsConcurrently) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto concurrent_loop = fml::ConcurrentMessageLoop::Create(2);
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  // The frame budget must only be queried on the raster thread, even by the
+  // views recorded on other threads.
+  ON_CALL(delegate, GetFrameBudget()).WillByDefault([&task_runners]() {
+    EXPECT_TRUE(task_runners.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+    return fml::kDefaultFrameBudget;
+  });
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto concurrent_task_runner = std::make_shared<ThreadRecordingTaskRunner>(
+      concurrent_loop->GetTaskRunner());
+  rasterizer->SetConcurrentViewRasterization(concurrent_task_runner);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(DlISize(100, 100))).Times(2);
+  std::atomic<size_t> submitted_frames = 0;
+  ON_CALL(*surface, AcquireFrame).WillByDefault([&](const DlISize& size) {
+    SurfaceFrame::FramebufferInfo framebuffer_info;
+    framebuffer_info.supports_readback = true;
+    return std::make_unique<SurfaceFrame>(
+        /*surface=*/
+        nullptr, framebuffer_info,
+        /*encode_callback=*/[](const SurfaceFrame&, DlCanvas*) { return true; },
+        /*submit_callback=*/
+        [&](const SurfaceFrame& frame) {
+          submitted_frames++;
+          return true;
+        },
+        /*frame_size=*/size, /*context_result=*/nullptr,
+        /*display_list_fallback=*/true);
+  });
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<FramePipeline>(/*depth=*/10);
+    std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+    for (int64_t view_id = 0; view_id < 2; view_id++) {
+      DisplayListBuilder builder;
+      builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+      auto layer = std::make_shared<DisplayListLayer>(
+          DlPoint(), builder.Build(), /*is_complex=*/false,
+          /*will_change=*/false);
+      tasks.push_back(std::make_unique<LayerTreeTask>(
+          view_id, std::make_unique<LayerTree>(layer, DlISize(100, 100)),
+          kDevicePixelRatio));
+    }
+    auto layer_tree_item = std::make_unique<FrameItem>(
+        std::move(tasks), CreateFinishedBuildRecorder());
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::move(layer_tree_item));
+    EXPECT_TRUE(result.success);
+    ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+    auto status = rasterizer->Draw(pipeline);
+    EXPECT_EQ(status, DrawStatus::kDone);
+    EXPECT_EQ(rasterizer->GetLastDrawStatus(0), DrawSurfaceStatus::kSuccess);
+    EXPECT_EQ(rasterizer->GetLastDrawStatus(1), DrawSurfaceStatus::kSuccess);
+    EXPECT_EQ(submitted_frames, 2u);
+
+    // The second view was recorded on another thread while the first view was
+    // recorded on the raster thread.
+    std::vector<std::thread::id> thread_ids =
+        concurrent_task_runner->thread_ids();
+    ASSERT_EQ(thread_ids.size(), 1u);
+    EXPECT_NE(thread_ids[0], std::this_thread::get_id());
+    latch.Signal();
+  });
+  latch.Wait();
+  concurrent_loop->Terminate();
+}
+
 TEST(RasterizerTest,
      drawWithGpuEnabledAndSurfaceAllowsDrawingWhenGpuDisabledDoesAcquireFrame) {
   std::string test_name =
@@ -17,6 +17,7 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/dl_storage.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
@@ -742,6 +743,9 @@ void Shell::NotifyLowMemoryWarning() const {
   // running.
   ::Dart_NotifyLowMemory();
 
+  // The pool is shared by all threads that build display lists.
+  DisplayListStoragePool::Instance().Purge();
+
   task_runners_.GetRasterTaskRunner()->PostTask(
       [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
         if (rasterizer) {
@@ -874,6 +878,14 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetExternalViewEmbedder(view_embedder);
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
+  if (settings_.enable_concurrent_view_rasterization) {
+    rasterizer_->SetConcurrentViewRasterization(
+        GetConcurrentWorkerTaskRunner());
+  }
+  if (settings_.enable_concurrent_raster_cache_rasterization) {
+    rasterizer_->SetConcurrentRasterCacheRasterization(
+        GetConcurrentWorkerTaskRunner());
+  }
 
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
@@ -1433,7 +1445,7 @@ void Shell::OnAnimatorDrawLastLayerTrees(
 
 // |Engine::Delegate|
 void Shell::OnEngineUpdateSemantics(int64_t view_id,
-                                    SemanticsNodeUpdates update,
+                                    FlatSemanticsNodeUpdates update,
                                     CustomAccessibilityActionUpdates actions) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
@@ -1443,7 +1455,7 @@ void Shell::OnEngineUpdateSemantics(int64_t view_id,
       [view = platform_view_->GetWeakPtr(), update = std::move(update),
        actions = std::move(actions), view_id = view_id] {
         if (view) {
-          view->UpdateSemantics(view_id, update, actions);
+          view->UpdateFlatSemantics(view_id, update, actions);
         }
       });
 }
@@ -27,6 +27,7 @@
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
@@ -672,7 +673,7 @@ class Shell final : public PlatformView::Delegate,
   // |Engine::Delegate|
   void OnEngineUpdateSemantics(
       int64_t view_id,
-      SemanticsNodeUpdates update,
+      FlatSemanticsNodeUpdates update,
       CustomAccessibilityActionUpdates actions) override;
 
   // |Engine::Delegate|
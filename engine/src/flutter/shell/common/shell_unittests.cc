@@ -19,6 +19,7 @@
 #include "assets/asset_resolver.h"
 #include "assets/directory_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
+#include "flutter/display_list/dl_storage.h"
 #include "flutter/display_list/effects/dl_image_filter.h"
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
@@ -461,6 +462,28 @@ TEST_F(ShellTest, InitializeWithDifferentThreads) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, LowMemoryWarningPurgesDisplayListStoragePool) {
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::kPlatform);
+  auto task_runner = thread_host.platform_thread->GetTaskRunner();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  auto shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  DisplayListStoragePool& pool = DisplayListStoragePool::Instance();
+  size_t size = 0;
+  uint8_t* block = pool.Acquire(DisplayListStoragePool::kPageSize, &size);
+  pool.Release(block, size);
+  ASSERT_GT(pool.GetStats().pooled_bytes, 0u);
+
+  shell->NotifyLowMemoryWarning();
+  EXPECT_EQ(pool.GetStats().pooled_bytes, 0u);
+
+  DestroyShell(std::move(shell), task_runners);
+}
+
 TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
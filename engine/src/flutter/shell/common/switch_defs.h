@@ -273,6 +273,23 @@ DEF_SWITCH(LeakVM,
 DEF_SWITCH(EnableEmbedderAPI,
            "enable-embedder-api",
            "Enable the embedder api. Defaults to false. iOS only.")
+DEF_SWITCH(CoalescePointerMoves,
+           "coalesce-pointer-moves",
+           "Batch the pointer events received between two vsyncs and merge "
+           "consecutive move and hover events of each pointer before "
+           "dispatching them to the framework.")
+DEF_SWITCH(EnableConcurrentViewRasterization,
+           "enable-concurrent-view-rasterization",
+           "Record the layer trees of multiple views concurrently on the "
+           "worker threads. Only software surfaces are supported.")
+DEF_SWITCH(RasterCacheByteBudget,
+           "raster-cache-byte-budget",
+           "The max bytes of the images in the raster cache of each view, or "
+           "0 for unlimited.")
+DEF_SWITCH(EnableConcurrentRasterCacheRasterization,
+           "enable-concurrent-raster-cache-rasterization",
+           "Rasterize new raster cache entries on the worker threads. Only "
+           "software surfaces are supported.")
 DEF_SWITCH(EnablePlatformIsolates,
            "enable-platform-isolates",
            "Enable support for isolates that run on the platform thread.")
@@ -297,6 +314,18 @@ DEF_SWITCH(ImpellerLazyShaderMode,
 DEF_SWITCH(ImpellerAntialiasLines,
            "impeller-antialias-lines",
            "Experimental flag to test drawing lines with antialiasing.")
+DEF_SWITCH(ImpellerGlyphAtlasMaxBytes,
+           "impeller-glyph-atlas-max-bytes",
+           "The maximum size in bytes of each Impeller glyph atlas. Once an "
+           "atlas reaches this size, least recently used glyphs are evicted "
+           "to make room for new ones. Defaults to 0, which only limits the "
+           "atlas to the maximum texture size of the device.")
+DEF_SWITCH(ImpellerGlyphAtlasMaxPages,
+           "impeller-glyph-atlas-max-pages",
+           "The maximum number of pages in each Impeller glyph atlas. Paged "
+           "atlases grow by allocating a new page instead of copying the "
+           "whole atlas into a larger texture. Defaults to 0, which keeps "
+           "each atlas in a single texture.")
 DEF_SWITCHES_END
 
 }  // namespace flutter
@@ -511,6 +511,23 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  settings.coalesce_pointer_moves =
+      command_line.HasOption(FlagForSwitch(Switch::CoalescePointerMoves));
+
+  settings.enable_concurrent_view_rasterization = command_line.HasOption(
+      FlagForSwitch(Switch::EnableConcurrentViewRasterization));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheByteBudget))) {
+    std::string raster_cache_byte_budget;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheByteBudget),
+                                &raster_cache_byte_budget);
+    settings.raster_cache_byte_budget = std::stoull(raster_cache_byte_budget);
+  }
+
+  settings.enable_concurrent_raster_cache_rasterization =
+      command_line.HasOption(
+          FlagForSwitch(Switch::EnableConcurrentRasterCacheRasterization));
+
   settings.enable_platform_isolates =
       command_line.HasOption(FlagForSwitch(Switch::EnablePlatformIsolates));
 
@@ -556,6 +573,24 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
       command_line.HasOption(FlagForSwitch(Switch::ImpellerLazyShaderMode));
   settings.impeller_antialiased_lines =
       command_line.HasOption(FlagForSwitch(Switch::ImpellerAntialiasLines));
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerGlyphAtlasMaxBytes))) {
+    if (!GetSwitchValue(command_line, Switch::ImpellerGlyphAtlasMaxBytes,
+                        &settings.impeller_glyph_atlas_max_bytes)) {
+      FML_LOG(INFO) << "Impeller glyph atlas max bytes specified was "
+                       "malformed. Will default to "
+                    << settings.impeller_glyph_atlas_max_bytes;
+    }
+  }
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerGlyphAtlasMaxPages))) {
+    if (!GetSwitchValue(command_line, Switch::ImpellerGlyphAtlasMaxPages,
+                        &settings.impeller_glyph_atlas_max_pages)) {
+      FML_LOG(INFO) << "Impeller glyph atlas max pages specified was "
+                       "malformed. Will default to "
+                    << settings.impeller_glyph_atlas_max_pages;
+    }
+  }
 
   return settings;
 }
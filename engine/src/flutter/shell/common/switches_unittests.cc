@@ -103,6 +103,73 @@ TEST(SwitchesTest, EnableEmbedderAPI) {
   }
 }
 
+TEST(SwitchesTest, CoalescePointerMoves) {
+  {
+    // enable
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--coalesce-pointer-moves"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.coalesce_pointer_moves, true);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.coalesce_pointer_moves, false);
+  }
+}
+
+TEST(SwitchesTest, EnableConcurrentViewRasterization) {
+  {
+    // enable
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-concurrent-view-rasterization"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.enable_concurrent_view_rasterization, true);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.enable_concurrent_view_rasterization, false);
+  }
+}
+
+TEST(SwitchesTest, RasterCacheByteBudget) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-cache-byte-budget=67108864"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_byte_budget, 67108864u);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.raster_cache_byte_budget, 0u);
+  }
+}
+
+TEST(SwitchesTest, EnableConcurrentRasterCacheRasterization) {
+  {
+    // enable
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--enable-concurrent-raster-cache-rasterization"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.enable_concurrent_raster_cache_rasterization, true);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.enable_concurrent_raster_cache_rasterization, false);
+  }
+}
+
 TEST(SwitchesTest, NoEnableImpeller) {
   {
     // enable
@@ -163,6 +230,35 @@ TEST(SwitchesTest, RequireMergedPlatformUIThread) {
 }
 #endif  // !OS_FUCHSIA
 
+TEST(SwitchesTest, ImpellerGlyphAtlasMaxBytes) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.impeller_glyph_atlas_max_bytes, 0u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-glyph-atlas-max-bytes=8388608"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.impeller_glyph_atlas_max_bytes, 8388608u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-glyph-atlas-max-bytes=lots"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.impeller_glyph_atlas_max_bytes, 0u);
+}
+
+TEST(SwitchesTest, ImpellerGlyphAtlasMaxPages) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.impeller_glyph_atlas_max_pages, 0u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-glyph-atlas-max-pages=4"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.impeller_glyph_atlas_max_pages, 4u);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
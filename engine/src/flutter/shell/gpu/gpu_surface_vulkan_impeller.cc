@@ -46,6 +46,21 @@ class WrappedTextureSourceVK : public impeller::TextureSourceVK {
   impeller::vk::ImageView image_view_;
 };
 
+// Returns the task runner of the Vulkan context's worker threads, which the
+// typographer uses to rasterize large batches of glyphs.
+static std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner(
+    GPUSurfaceVulkanDelegate* delegate,
+    const impeller::Context& context) {
+  // Without a delegate, the surface is given a surface context that owns the
+  // swapchain, as in AcquireFrame.
+  if (delegate == nullptr) {
+    return impeller::SurfaceContextVK::Cast(context)
+        .GetParent()
+        ->GetConcurrentWorkerTaskRunner();
+  }
+  return impeller::ContextVK::Cast(context).GetConcurrentWorkerTaskRunner();
+}
+
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     GPUSurfaceVulkanDelegate* delegate,
     std::shared_ptr<impeller::Context> context)
@@ -55,7 +70,8 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
   }
 
   auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+      context, impeller::TypographerContextSkia::Make(
+                   GetWorkerTaskRunner(delegate, *context)));
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -129,6 +129,10 @@ GetActualRenderingAPIForImpeller(
                   .lazy_shader_mode = settings.impeller_flags.lazy_shader_mode,
                   .antialiased_lines =
                       settings.impeller_flags.antialiased_lines,
+                  .glyph_atlas_max_bytes =
+                      settings.impeller_flags.glyph_atlas_max_bytes,
+                  .glyph_atlas_max_pages =
+                      settings.impeller_flags.glyph_atlas_max_pages,
               },
       });
   if (!vulkan_backend->IsValid()) {
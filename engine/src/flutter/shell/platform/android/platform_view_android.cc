@@ -63,6 +63,10 @@ AndroidContext::ContextSettings CreateContextSettings(
       p_settings.impeller_enable_lazy_shader_mode;
   settings.impeller_flags.antialiased_lines =
       p_settings.impeller_antialiased_lines;
+  settings.impeller_flags.glyph_atlas_max_bytes =
+      p_settings.impeller_glyph_atlas_max_bytes;
+  settings.impeller_flags.glyph_atlas_max_pages =
+      p_settings.impeller_glyph_atlas_max_pages;
   return settings;
 }
 }  // namespace
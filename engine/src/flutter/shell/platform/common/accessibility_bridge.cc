@@ -4,7 +4,9 @@
 
 #include "accessibility_bridge.h"
 
+#include <algorithm>
 #include <functional>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/third_party/accessibility/ax/ax_tree_manager_map.h"
@@ -19,6 +21,37 @@ constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollUp |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollDown;
 
+static bool FlagsEqual(const FlutterSemanticsFlags& a,
+                       const FlutterSemanticsFlags& b) {
+  return a.is_checked == b.is_checked && a.is_selected == b.is_selected &&
+         a.is_enabled == b.is_enabled && a.is_toggled == b.is_toggled &&
+         a.is_expanded == b.is_expanded && a.is_required == b.is_required &&
+         a.is_focused == b.is_focused && a.is_button == b.is_button &&
+         a.is_text_field == b.is_text_field &&
+         a.is_in_mutually_exclusive_group ==
+             b.is_in_mutually_exclusive_group &&
+         a.is_header == b.is_header && a.is_obscured == b.is_obscured &&
+         a.scopes_route == b.scopes_route && a.names_route == b.names_route &&
+         a.is_hidden == b.is_hidden && a.is_image == b.is_image &&
+         a.is_live_region == b.is_live_region &&
+         a.has_implicit_scrolling == b.has_implicit_scrolling &&
+         a.is_multiline == b.is_multiline && a.is_read_only == b.is_read_only &&
+         a.is_link == b.is_link && a.is_slider == b.is_slider &&
+         a.is_keyboard_key == b.is_keyboard_key;
+}
+
+static bool RectsEqual(const FlutterRect& a, const FlutterRect& b) {
+  return a.left == b.left && a.top == b.top && a.right == b.right &&
+         a.bottom == b.bottom;
+}
+
+static bool TransformationsEqual(const FlutterTransformation& a,
+                                 const FlutterTransformation& b) {
+  return a.scaleX == b.scaleX && a.skewX == b.skewX && a.transX == b.transX &&
+         a.skewY == b.skewY && a.scaleY == b.scaleY && a.transY == b.transY &&
+         a.pers0 == b.pers0 && a.pers1 == b.pers1 && a.pers2 == b.pers2;
+}
+
 // AccessibilityBridge
 AccessibilityBridge::AccessibilityBridge()
     : tree_(std::make_unique<ui::AXTree>()) {
@@ -47,7 +80,34 @@ void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
       FromFlutterSemanticsCustomAction(action);
 }
 
+void AccessibilityBridge::EnableUpdateBatching(
+    fml::TimeDelta min_commit_interval) {
+  update_batching_enabled_ = true;
+  min_commit_interval_ = min_commit_interval;
+}
+
+bool AccessibilityBridge::HasPendingUpdates() const {
+  return has_deferred_updates_ || !pending_semantics_node_updates_.empty() ||
+         !pending_semantics_custom_action_updates_.empty();
+}
+
+void AccessibilityBridge::ScheduleDeferredCommit(fml::TimeDelta delay) {}
+
 void AccessibilityBridge::CommitUpdates() {
+  const fml::TimePoint commit_start = fml::TimePoint::Now();
+  if (update_batching_enabled_ && commit_start < next_commit_time_) {
+    // The pending updates are merged with the ones of the next frames.
+    if (!has_deferred_updates_) {
+      has_deferred_updates_ = true;
+      ScheduleDeferredCommit(next_commit_time_ - commit_start);
+    }
+    return;
+  }
+  if (has_deferred_updates_) {
+    has_deferred_updates_ = false;
+    DropDetachedPendingUpdates();
+  }
+
   // AXTree cannot move a node in a single update.
   // This must be split across two updates:
   //
@@ -68,6 +128,17 @@ void AccessibilityBridge::CommitUpdates() {
     }
   }
 
+  // Skip the nodes that the pending updates would leave as they are. Nodes
+  // removed by the update above are in no tree anymore, and are always kept.
+  for (auto iter = pending_semantics_node_updates_.begin();
+       iter != pending_semantics_node_updates_.end();) {
+    if (IsUnchangedSinceLastCommit(iter->second)) {
+      iter = pending_semantics_node_updates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
   // Second, apply the pending node updates. This also moves reparented nodes to
   // their new parents if needed.
   ui::AXTreeUpdate update{.tree_data = tree_->data()};
@@ -112,8 +183,15 @@ void AccessibilityBridge::CommitUpdates() {
   std::string error = tree_->error();
   if (!error.empty()) {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+    // The tree no longer matches what was committed.
+    committed_semantics_nodes_.clear();
     return;
   }
+  for (std::vector<SemanticsNode>& sub_tree_list : results) {
+    for (SemanticsNode& node : sub_tree_list) {
+      committed_semantics_nodes_[node.id] = std::move(node);
+    }
+  }
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -125,6 +203,14 @@ void AccessibilityBridge::CommitUpdates() {
     OnAccessibilityEvent(targeted_event);
   }
   event_generator_.ClearEvents();
+
+  if (update_batching_enabled_) {
+    // Leave the platform at least as much time as the commit took before
+    // committing again.
+    const fml::TimePoint commit_end = fml::TimePoint::Now();
+    next_commit_time_ =
+        commit_end + std::max(min_commit_interval_, commit_end - commit_start);
+  }
 }
 
 std::weak_ptr<FlutterPlatformNodeDelegate>
@@ -189,6 +275,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -266,6 +353,88 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   return update;
 }
 
+bool AccessibilityBridge::IsUnchangedSinceLastCommit(
+    const SemanticsNode& node) const {
+  if (!tree_->GetFromId(node.id)) {
+    return false;
+  }
+  auto iter = committed_semantics_nodes_.find(node.id);
+  if (iter == committed_semantics_nodes_.end()) {
+    return false;
+  }
+  // The descriptions of custom actions come from the custom action updates.
+  if ((node.actions &
+       FlutterSemanticsAction::kFlutterSemanticsActionCustomAction) &&
+      !pending_semantics_custom_action_updates_.empty()) {
+    return false;
+  }
+  const SemanticsNode& committed = iter->second;
+  return FlagsEqual(node.flags, committed.flags) &&
+         node.actions == committed.actions &&
+         node.text_selection_base == committed.text_selection_base &&
+         node.text_selection_extent == committed.text_selection_extent &&
+         node.text_direction == committed.text_direction &&
+         RectsEqual(node.rect, committed.rect) &&
+         TransformationsEqual(node.transform, committed.transform) &&
+         node.label == committed.label && node.hint == committed.hint &&
+         node.value == committed.value && node.tooltip == committed.tooltip &&
+         node.children_in_traversal_order ==
+             committed.children_in_traversal_order &&
+         node.custom_accessibility_actions ==
+             committed.custom_accessibility_actions;
+}
+
+void AccessibilityBridge::DropDetachedPendingUpdates() {
+  // Before the first commit, there is no tree for updates to be detached from.
+  if (GetRootAsAXNode()->id() == ui::AXNode::kInvalidAXID) {
+    return;
+  }
+
+  std::unordered_set<int32_t> pending_children;
+  for (const auto& [id, node] : pending_semantics_node_updates_) {
+    pending_children.insert(node.children_in_traversal_order.begin(),
+                            node.children_in_traversal_order.end());
+  }
+
+  // Updates are attached if they are for the root or a node whose parent has
+  // no pending update, or for the pending children of attached updates.
+  std::vector<int32_t> attached_ids;
+  for (const auto& [id, node] : pending_semantics_node_updates_) {
+    if (pending_children.find(id) != pending_children.end()) {
+      continue;
+    }
+    ui::AXNode* ax_node = tree_->GetFromId(id);
+    if (ax_node && (!ax_node->parent() ||
+                    pending_semantics_node_updates_.find(
+                        ax_node->parent()->id()) ==
+                        pending_semantics_node_updates_.end())) {
+      attached_ids.push_back(id);
+    }
+  }
+  std::unordered_set<int32_t> attached;
+  while (!attached_ids.empty()) {
+    int32_t id = attached_ids.back();
+    attached_ids.pop_back();
+    auto iter = pending_semantics_node_updates_.find(id);
+    if (iter == pending_semantics_node_updates_.end() ||
+        !attached.insert(id).second) {
+      continue;
+    }
+    attached_ids.insert(attached_ids.end(),
+                        iter->second.children_in_traversal_order.begin(),
+                        iter->second.children_in_traversal_order.end());
+  }
+
+  for (auto iter = pending_semantics_node_updates_.begin();
+       iter != pending_semantics_node_updates_.end();) {
+    if (attached.find(iter->first) == attached.end()) {
+      iter = pending_semantics_node_updates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
 // Private method.
 void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
                                          std::vector<SemanticsNode>& result) {
@@ -311,8 +480,7 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
                                                    const SemanticsNode& node) {
-  const FlutterSemanticsFlags* flags = node.flags;
-  FML_DCHECK(flags) << "SemanticsNode::flags must not be null";
+  const FlutterSemanticsFlags* flags = &node.flags;
   if (flags->is_button) {
     node_data.role = ax::mojom::Role::kButton;
     return;
@@ -362,7 +530,7 @@ void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
 
 void AccessibilityBridge::SetStateFromFlutterUpdate(ui::AXNodeData& node_data,
                                                     const SemanticsNode& node) {
-  const FlutterSemanticsFlags* flags = node.flags;
+  const FlutterSemanticsFlags* flags = &node.flags;
   FlutterSemanticsAction actions = node.actions;
   if (flags->is_expanded == FlutterTristate::kFlutterTristateTrue) {
     node_data.AddState(ax::mojom::State::kExpanded);
@@ -432,7 +600,7 @@ void AccessibilityBridge::SetBooleanAttributesFromFlutterUpdate(
     ui::AXNodeData& node_data,
     const SemanticsNode& node) {
   FlutterSemanticsAction actions = node.actions;
-  const FlutterSemanticsFlags* flags = node.flags;
+  const FlutterSemanticsFlags* flags = &node.flags;
   node_data.AddBoolAttribute(ax::mojom::BoolAttribute::kScrollable,
                              actions & kHasScrollingAction);
   node_data.AddBoolAttribute(
@@ -456,7 +624,7 @@ void AccessibilityBridge::SetBooleanAttributesFromFlutterUpdate(
 void AccessibilityBridge::SetIntAttributesFromFlutterUpdate(
     ui::AXNodeData& node_data,
     const SemanticsNode& node) {
-  const FlutterSemanticsFlags* flags = node.flags;
+  const FlutterSemanticsFlags* flags = &node.flags;
   node_data.AddIntAttribute(ax::mojom::IntAttribute::kTextDirection,
                             node.text_direction);
 
@@ -541,7 +709,7 @@ void AccessibilityBridge::SetTooltipFromFlutterUpdate(
 
 void AccessibilityBridge::SetTreeData(const SemanticsNode& node,
                                       ui::AXTreeUpdate& tree_update) {
-  const FlutterSemanticsFlags* flags = node.flags;
+  const FlutterSemanticsFlags* flags = &node.flags;
   // Set selection of the focused node if:
   // 1. this text field has a valid selection
   // 2. this text field doesn't have a valid selection but had selection stored
@@ -582,7 +750,7 @@ AccessibilityBridge::FromFlutterSemanticsNode(
   FML_DCHECK(flutter_node.flags2)
       << "FlutterSemanticsNode2::flags2 must not be null";
 
-  result.flags = flutter_node.flags2;
+  result.flags = *flutter_node.flags2;
   result.actions = flutter_node.actions;
   result.heading_level = flutter_node.heading_level;
   result.text_selection_base = flutter_node.text_selection_base;
@@ -8,6 +8,8 @@
 #include <unordered_map>
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 
 #include "flutter/third_party/accessibility/ax/ax_event_generator.h"
@@ -75,8 +77,34 @@ class AccessibilityBridge
   ///             state. For example if a node reparents from A to B, callers
   ///             should only call this method when both removal from A and
   ///             addition to B are in the pending updates.
+  ///
+  ///             Node updates that are identical to what the node was last
+  ///             committed with are skipped.
+  ///
+  ///             If update batching is enabled and the previous commit was too
+  ///             recent, the pending updates are kept and merged with the
+  ///             following ones instead. See |EnableUpdateBatching|.
   void CommitUpdates();
 
+  //------------------------------------------------------------------------------
+  /// @brief      Lets |CommitUpdates| merge the updates of several frames when
+  ///             the platform accessibility services can't keep up with them.
+  ///
+  ///             Once enabled, a commit that follows the previous one sooner
+  ///             than `min_commit_interval`, or sooner than the previous
+  ///             commit took to apply and dispatch its events, is deferred.
+  ///             The first deferred commit calls |ScheduleDeferredCommit|, so
+  ///             subclasses that enable batching must override it.
+  ///
+  /// @param[in]  min_commit_interval  The shortest time between two commits.
+  void EnableUpdateBatching(
+      fml::TimeDelta min_commit_interval = fml::TimeDelta::Zero());
+
+  //------------------------------------------------------------------------------
+  /// @brief      Whether updates have been added or deferred since the last
+  ///             commit that applied them.
+  bool HasPendingUpdates() const;
+
   //------------------------------------------------------------------------------
   /// @brief      Get the flutter platform node delegate with the given id from
   ///             this accessibility bridge. Returns expired weak_ptr if the
@@ -157,11 +185,23 @@ class AccessibilityBridge
   virtual std::shared_ptr<FlutterPlatformNodeDelegate>
   CreateFlutterPlatformNodeDelegate() = 0;
 
+  //---------------------------------------------------------------------------
+  /// @brief      Called when update batching defers the pending updates.
+  ///             Subclasses that enable batching must call |CommitUpdates|
+  ///             once `delay` has passed, so that the updates of the last
+  ///             frames are applied even if no other frame follows. The
+  ///             default implementation does nothing.
+  ///
+  /// @param[in]  delay           How long until the deferred updates can be
+  ///                             committed.
+  virtual void ScheduleDeferredCommit(fml::TimeDelta delay);
+
  private:
   // See FlutterSemanticsNode in embedder.h
   typedef struct {
     int32_t id;
-    FlutterSemanticsFlags* flags;
+    // Copied so that updates can outlive the embedder's semantics update.
+    FlutterSemanticsFlags flags;
     FlutterSemanticsAction actions;
     int32_t text_selection_base;
     int32_t text_selection_extent;
@@ -200,7 +240,14 @@ class AccessibilityBridge
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
+  // The updates that the nodes in the tree were last committed with.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
+  bool update_batching_enabled_ = false;
+  fml::TimeDelta min_commit_interval_;
+  // The earliest time at which a batched commit applies the pending updates.
+  fml::TimePoint next_commit_time_;
+  bool has_deferred_updates_ = false;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
 
@@ -208,6 +255,14 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
+  // Whether committing the update would leave its node as it is. Only the
+  // fields that |ConvertFlutterUpdate| reads are compared.
+  bool IsUnchangedSinceLastCommit(const SemanticsNode& node) const;
+
+  // Drops the pending updates of nodes that a later frame in the same batch
+  // has removed from the tree, so that no update refers to a detached node.
+  void DropDetachedPendingUpdates();
+
   void GetSubTreeList(const SemanticsNode& target,
                       std::vector<SemanticsNode>& result);
   void ConvertFlutterUpdate(const SemanticsNode& node,
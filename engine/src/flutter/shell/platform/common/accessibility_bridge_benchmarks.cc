@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+FlutterSemanticsFlags kEmptyFlags = FlutterSemanticsFlags{};
+
+// A semantics tree of a root with a scrollable list of |item_count| items, as
+// sent by the framework for every frame of a scroll.
+class ListSemanticsTree {
+ public:
+  explicit ListSemanticsTree(size_t item_count) {
+    for (size_t i = 0; i < item_count; i++) {
+      item_ids_.push_back(static_cast<int32_t>(i + 2));
+      labels_.push_back("item " + std::to_string(i));
+    }
+    nodes_.push_back(CreateNode(0, "root", &root_children_));
+    nodes_.push_back(CreateNode(1, "list", &item_ids_));
+    for (size_t i = 0; i < item_count; i++) {
+      nodes_.push_back(CreateNode(item_ids_[i], labels_[i].c_str(), nullptr));
+    }
+  }
+
+  // Scrolls the list by one pixel, which moves all of its items.
+  void Scroll() { nodes_[1].transform.transY -= 1.0; }
+
+  // Changes the label of every item.
+  void Relabel(size_t frame) {
+    for (size_t i = 0; i < labels_.size(); i++) {
+      labels_[i] = "item " + std::to_string(i) + " " + std::to_string(frame);
+      nodes_[i + 2].label = labels_[i].c_str();
+    }
+  }
+
+  void AddTo(AccessibilityBridge& bridge) const {
+    for (const FlutterSemanticsNode2& node : nodes_) {
+      bridge.AddFlutterSemanticsNodeUpdate(node);
+    }
+  }
+
+ private:
+  std::vector<int32_t> root_children_ = {1};
+  std::vector<int32_t> item_ids_;
+  std::vector<std::string> labels_;
+  std::vector<FlutterSemanticsNode2> nodes_;
+
+  static FlutterSemanticsNode2 CreateNode(int32_t id,
+                                          const char* label,
+                                          const std::vector<int32_t>* children) {
+    return {
+        .id = id,
+        .text_selection_base = -1,
+        .text_selection_extent = -1,
+        .label = label,
+        .hint = "",
+        .value = "",
+        .increased_value = "",
+        .decreased_value = "",
+        .rect = {0, 0, 100, 20},
+        .transform = {1, 0, 0, 0, 1, 0, 0, 0, 1},
+        .child_count = children ? children->size() : 0,
+        .children_in_traversal_order = children ? children->data() : nullptr,
+        .tooltip = "",
+        .flags2 = &kEmptyFlags,
+    };
+  }
+};
+
+}  // namespace
+
+// Every frame of a scroll resends the whole tree, but only the list changes.
+static void BM_AccessibilityBridgeCommitScrollFrame(benchmark::State& state) {
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  ListSemanticsTree tree(state.range(0));
+  tree.AddTo(*bridge);
+  bridge->CommitUpdates();
+  for (auto _ : state) {
+    tree.Scroll();
+    tree.AddTo(*bridge);
+    bridge->CommitUpdates();
+    bridge->accessibility_events.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AccessibilityBridgeCommitScrollFrame)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+// Every item changes in every frame, so that no update can be skipped.
+static void BM_AccessibilityBridgeCommitChangedItems(benchmark::State& state) {
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  ListSemanticsTree tree(state.range(0));
+  tree.AddTo(*bridge);
+  bridge->CommitUpdates();
+  size_t frame = 0;
+  for (auto _ : state) {
+    tree.Relabel(frame++);
+    tree.AddTo(*bridge);
+    bridge->CommitUpdates();
+    bridge->accessibility_events.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AccessibilityBridgeCommitChangedItems)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -4,6 +4,9 @@
 
 #include "accessibility_bridge.h"
 
+#include <chrono>
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -561,6 +564,152 @@ TEST(AccessibilityBridgeTest, CanReparentNodeWithChild) {
               Contains(ui::AXEventGenerator::Event::ROLE_CHANGED).Times(1));
 }
 
+class NodeDataChangeRecorder : public ui::AXTreeObserver {
+ public:
+  void OnNodeDataChanged(ui::AXTree* tree,
+                         const ui::AXNodeData& old_node_data,
+                         const ui::AXNodeData& new_node_data) override {
+    changed_ids.push_back(new_node_data.id);
+  }
+
+  std::vector<int32_t> changed_ids;
+};
+
+TEST(AccessibilityBridgeTest, SkipsUnchangedNodes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  NodeDataChangeRecorder recorder;
+  bridge->GetTree()->AddObserver(&recorder);
+
+  // Only the label of child 2 changes. The flags are copied, so a new flags
+  // struct with the same contents doesn't count as a change.
+  FlutterSemanticsFlags flags = FlutterSemanticsFlags{};
+  child1.flags2 = &flags;
+  child2.label = "new child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(recorder.changed_ids, std::vector<int32_t>{2});
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(2).lock()->GetName(),
+            "new child 2");
+
+  // Changing the flags is a change.
+  recorder.changed_ids.clear();
+  flags.is_button = true;
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(recorder.changed_ids, std::vector<int32_t>{1});
+  EXPECT_EQ(
+      bridge->GetFlutterPlatformNodeDelegateFromID(1).lock()->GetData().role,
+      ax::mojom::Role::kButton);
+
+  bridge->GetTree()->RemoveObserver(&recorder);
+}
+
+TEST(AccessibilityBridgeTest, RecreatesRemovedNodesEvenIfUnchanged) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> root_children{1};
+  std::vector<int32_t> child_children{2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &root_children);
+  FlutterSemanticsNode2 child = CreateSemanticsNode(1, "child", &child_children);
+  FlutterSemanticsNode2 leaf = CreateSemanticsNode(2, "leaf");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child);
+  bridge->AddFlutterSemanticsNodeUpdate(leaf);
+  bridge->CommitUpdates();
+
+  // Remove the child and its leaf, then add them back unchanged.
+  root.child_count = 0;
+  root.children_in_traversal_order = nullptr;
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->CommitUpdates();
+  ASSERT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(2).expired());
+
+  root = CreateSemanticsNode(0, "root", &root_children);
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child);
+  bridge->AddFlutterSemanticsNodeUpdate(leaf);
+  bridge->CommitUpdates();
+
+  auto leaf_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  ASSERT_TRUE(leaf_node);
+  EXPECT_EQ(leaf_node->GetName(), "leaf");
+}
+
+TEST(AccessibilityBridgeTest, BatchesUpdatesWhileCommitsAreTooFrequent) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  bridge->EnableUpdateBatching(fml::TimeDelta::FromMilliseconds(10));
+
+  std::vector<int32_t> root_children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &root_children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  EXPECT_FALSE(bridge->HasPendingUpdates());
+
+  // Frame 2 renames child 1 and adds a child to child 2.
+  std::vector<int32_t> child2_children{3};
+  child1.label = "child 1 (frame 2)";
+  child2.child_count = child2_children.size();
+  child2.children_in_traversal_order = child2_children.data();
+  FlutterSemanticsNode2 child3 = CreateSemanticsNode(3, "child 3");
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->AddFlutterSemanticsNodeUpdate(child3);
+  bridge->CommitUpdates();
+
+  ASSERT_EQ(bridge->deferred_commit_delays.size(), 1u);
+  EXPECT_TRUE(bridge->HasPendingUpdates());
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(1).lock()->GetName(),
+            "child 1");
+
+  // Frame 3 renames child 1 again and removes the child it just added.
+  child1.label = "child 1 (frame 3)";
+  child2.child_count = 0;
+  child2.children_in_traversal_order = nullptr;
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  // The deferred commit was already scheduled.
+  ASSERT_EQ(bridge->deferred_commit_delays.size(), 1u);
+
+  std::this_thread::sleep_for(std::chrono::microseconds(
+      bridge->deferred_commit_delays.front().ToMicroseconds()));
+  bridge->CommitUpdates();
+
+  EXPECT_FALSE(bridge->HasPendingUpdates());
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(1).lock()->GetName(),
+            "child 1 (frame 3)");
+  EXPECT_EQ(
+      bridge->GetFlutterPlatformNodeDelegateFromID(2).lock()->GetChildCount(),
+      0);
+  EXPECT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(3).expired());
+  EXPECT_TRUE(bridge->GetTree()->error().empty());
+}
+
 TEST(AccessibilityBridgeTest, AXTreeManagerTest) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
@@ -44,6 +44,18 @@ class ByteBufferStreamReader : public ByteStreamReader {
     location_ += length;
   }
 
+  // |ByteStreamReader|
+  ReadInPlaceStatus ReadBytesInPlace(size_t length,
+                                     const uint8_t** bytes) override {
+    if (location_ + length > size_) {
+      std::cerr << "Invalid read in StandardCodecByteStreamReader" << std::endl;
+      return ReadInPlaceStatus::kOutOfBounds;
+    }
+    *bytes = &bytes_[location_];
+    location_ += length;
+    return ReadInPlaceStatus::kSuccess;
+  }
+
   // |ByteStreamReader|
   void ReadAlignment(uint8_t alignment) override {
     uint8_t mod = location_ % alignment;
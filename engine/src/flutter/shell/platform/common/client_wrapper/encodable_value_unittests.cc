@@ -4,8 +4,10 @@
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/encodable_value.h"
 
+#include <cstdint>
 #include <limits>
 
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/encodable_value_arena.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -330,4 +332,24 @@ TEST(EncodableValueTest, TypeIndexesCorrect) {
   EXPECT_EQ(EncodableValue(std::vector<float>()).index(), 13u);
 }  // namespace flutter
 
+TEST(EncodableValueArenaTest, AllocatesAlignedMemoryUntilReset) {
+  EncodableValueArena arena(64);
+  void* byte = arena.Allocate(1, 1);
+  void* number = arena.Allocate(sizeof(double), alignof(double));
+  EXPECT_NE(byte, number);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(number) % alignof(double), 0u);
+  EXPECT_EQ(arena.GetBlockCount(), 1u);
+
+  // Allocations that don't fit in the current block start a new one.
+  void* large = arena.Allocate(256, alignof(double));
+  EXPECT_NE(large, nullptr);
+  EXPECT_EQ(arena.GetBlockCount(), 2u);
+  EXPECT_EQ(arena.GetAllocatedBytes(), 1 + sizeof(double) + 256);
+
+  arena.Reset();
+  EXPECT_EQ(arena.GetBlockCount(), 1u);
+  EXPECT_EQ(arena.GetAllocatedBytes(), 0u);
+  EXPECT_EQ(arena.Allocate(1, 1), byte);
+}
+
 }  // namespace flutter
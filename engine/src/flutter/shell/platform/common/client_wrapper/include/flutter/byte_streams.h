@@ -26,6 +26,25 @@ class ByteStreamReader {
   // the start of the stream, unless it is already aligned.
   virtual void ReadAlignment(uint8_t alignment) = 0;
 
+  // The result of ReadBytesInPlace.
+  enum class ReadInPlaceStatus {
+    // |bytes| points to the requested bytes.
+    kSuccess,
+    // The stream doesn't provide direct access to its buffer, and nothing was
+    // read. The bytes can still be read with ReadBytes.
+    kUnsupported,
+    // The stream has fewer than the requested number of bytes left. The error
+    // has already been reported.
+    kOutOfBounds,
+  };
+
+  // Sets |bytes| to point to the next |length| bytes of the stream, which
+  // remain valid for as long as the underlying buffer, and advances past them.
+  virtual ReadInPlaceStatus ReadBytesInPlace(size_t length,
+                                             const uint8_t** bytes) {
+    return ReadInPlaceStatus::kUnsupported;
+  }
+
   // Reads and returns the next 32-bit integer from the stream.
   int32_t ReadInt32() {
     int32_t value = 0;
@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_ENCODABLE_VALUE_ARENA_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_ENCODABLE_VALUE_ARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace flutter {
+
+// A monotonic allocator for the lists and maps of decoded message trees.
+//
+// Decoding a large nested message normally performs one heap allocation for
+// each list and map in it. When decoded with an arena, they are instead
+// carved out of a few large blocks, which are all freed at once when the
+// arena is reset or destroyed. Memory is never reused before then, so an
+// arena should be used for a single message (or a bounded batch of messages)
+// at a time.
+//
+// Values allocated from an arena must not be used after the arena is reset or
+// destroyed. This class is not thread safe.
+class EncodableValueArena {
+ public:
+  // The size of the first block, unless another is given.
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  explicit EncodableValueArena(size_t block_size = kDefaultBlockSize)
+      : block_size_(std::max(block_size, sizeof(std::max_align_t))) {}
+
+  ~EncodableValueArena() = default;
+
+  // Prevent copying.
+  EncodableValueArena(EncodableValueArena const&) = delete;
+  EncodableValueArena& operator=(EncodableValueArena const&) = delete;
+
+  // Returns |size| bytes aligned to |alignment|, which must be a power of two
+  // no larger than alignof(std::max_align_t).
+  void* Allocate(size_t size, size_t alignment) {
+    size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+    if (blocks_.empty() || offset + size > current_block_size_) {
+      // Blocks double in size so that large messages need few of them.
+      size_t next_size = blocks_.empty() ? block_size_ : current_block_size_ * 2;
+      AddBlock(std::max(next_size, size));
+      offset = 0;
+    }
+    offset_ = offset + size;
+    allocated_bytes_ += size;
+    return blocks_.back().get() + offset;
+  }
+
+  // Frees all allocations at once. The first block is kept for reuse.
+  void Reset() {
+    if (blocks_.size() > 1) {
+      blocks_.erase(blocks_.begin() + 1, blocks_.end());
+      current_block_size_ = first_block_size_;
+    }
+    offset_ = 0;
+    allocated_bytes_ = 0;
+  }
+
+  // Returns the number of bytes allocated since the last reset.
+  size_t GetAllocatedBytes() const { return allocated_bytes_; }
+
+  // Returns the number of blocks currently held by the arena.
+  size_t GetBlockCount() const { return blocks_.size(); }
+
+ private:
+  void AddBlock(size_t size) {
+    // operator new[] returns memory aligned for any fundamental type.
+    blocks_.push_back(std::make_unique<uint8_t[]>(size));
+    if (blocks_.size() == 1) {
+      first_block_size_ = size;
+    }
+    current_block_size_ = size;
+  }
+
+  size_t block_size_;
+  size_t first_block_size_ = 0;
+  size_t current_block_size_ = 0;
+  size_t offset_ = 0;
+  size_t allocated_bytes_ = 0;
+  std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+};
+
+// A standard allocator that allocates from an EncodableValueArena, or from
+// the heap if it has no arena.
+template <typename T>
+class EncodableValueArenaAllocator {
+ public:
+  using value_type = T;
+
+  EncodableValueArenaAllocator() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  EncodableValueArenaAllocator(EncodableValueArena* arena) : arena_(arena) {}
+
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  EncodableValueArenaAllocator(const EncodableValueArenaAllocator<U>& other)
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t count) {
+    if (arena_) {
+      return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, size_t count) {
+    // Arena allocations are freed all at once by the arena.
+    if (!arena_) {
+      ::operator delete(pointer);
+    }
+  }
+
+  EncodableValueArena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const EncodableValueArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+
+  template <typename U>
+  bool operator!=(const EncodableValueArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+ private:
+  EncodableValueArena* arena_ = nullptr;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_ENCODABLE_VALUE_ARENA_H_
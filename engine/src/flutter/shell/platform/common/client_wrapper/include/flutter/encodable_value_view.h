@@ -0,0 +1,218 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_ENCODABLE_VALUE_VIEW_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_ENCODABLE_VALUE_VIEW_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "encodable_value.h"
+#include "encodable_value_arena.h"
+
+namespace flutter {
+
+// A read-only view of a contiguous array of values in a decoded message,
+// similar to std::span (which is not available in C++17).
+//
+// The view normally refers directly to the message buffer. If the values in
+// the buffer are not suitably aligned for |T|, the view instead owns a copy of
+// them, which it shares with copies of the view.
+template <typename T>
+class TypedDataView {
+ public:
+  using value_type = T;
+  using const_iterator = const T*;
+
+  TypedDataView() = default;
+
+  // Creates a view of the |size| values at |data|, which must remain valid
+  // for the lifetime of the view.
+  TypedDataView(const T* data, size_t size) : data_(data), size_(size) {}
+
+  // Creates a view that owns |values|.
+  explicit TypedDataView(std::vector<T> values)
+      : storage_(std::make_shared<const std::vector<T>>(std::move(values))),
+        data_(storage_->data()),
+        size_(storage_->size()) {}
+
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  const T& operator[](size_t index) const { return data_[index]; }
+
+  // Returns true if the view refers to memory that it does not own.
+  bool IsBorrowed() const { return !storage_ && size_ > 0; }
+
+  // Returns a copy of the values.
+  std::vector<T> ToVector() const { return std::vector<T>(begin(), end()); }
+
+ private:
+  std::shared_ptr<const std::vector<T>> storage_;
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+class EncodableValueView;
+
+// Convenience type aliases.
+//
+// The lists and maps of a view are allocated from the EncodableValueArena
+// passed to the decoder, if any.
+using EncodableListView =
+    std::vector<EncodableValueView,
+                EncodableValueArenaAllocator<EncodableValueView>>;
+using EncodableMapView = std::vector<
+    std::pair<EncodableValueView, EncodableValueView>,
+    EncodableValueArenaAllocator<
+        std::pair<EncodableValueView, EncodableValueView>>>;
+
+namespace internal {
+// The base class for EncodableValueView. Do not use this directly; it exists
+// only for EncodableValueView to inherit from.
+//
+// The indexes of the items here match those of EncodableValueVariant.
+using EncodableValueViewVariant = std::variant<std::monostate,
+                                               bool,
+                                               int32_t,
+                                               int64_t,
+                                               double,
+                                               std::string_view,
+                                               TypedDataView<uint8_t>,
+                                               TypedDataView<int32_t>,
+                                               TypedDataView<int64_t>,
+                                               TypedDataView<double>,
+                                               EncodableListView,
+                                               EncodableMapView,
+                                               EncodableValue,
+                                               TypedDataView<float>>;
+}  // namespace internal
+
+// A value decoded by StandardMessageCodec::DecodeMessageView, whose strings
+// and typed lists refer to the message buffer instead of copying it.
+//
+// This avoids copying large payloads, such as image or sensor data, out of
+// messages that are only inspected in the message handler. The view must not
+// be used after the message buffer is freed, which for a message received
+// from a BinaryMessenger is when the message handler returns. Call
+// ToEncodableValue to keep a copy of the value beyond that.
+//
+// The variant types correspond to those of EncodableValue, at the same
+// indexes:
+// std::monostate         -> std::monostate
+// bool                   -> bool
+// int32_t                -> int32_t
+// int64_t                -> int64_t
+// double                 -> double
+// std::string_view       -> std::string
+// TypedDataView<uint8_t> -> std::vector<uint8_t>
+// TypedDataView<int32_t> -> std::vector<int32_t>
+// TypedDataView<int64_t> -> std::vector<int64_t>
+// TypedDataView<double>  -> std::vector<double>
+// EncodableListView      -> EncodableList
+// EncodableMapView       -> EncodableMap
+// EncodableValue         -> CustomEncodableValue
+// TypedDataView<float>   -> std::vector<float>
+//
+// Values read by a codec extension can't be viewed, and are held as an owned
+// EncodableValue instead.
+class EncodableValueView : public internal::EncodableValueViewVariant {
+ public:
+  // Rely on std::variant for most of the constructors/operators.
+  using super = internal::EncodableValueViewVariant;
+  using super::super;
+  using super::operator=;
+
+  explicit EncodableValueView() = default;
+
+  // Creates a string view that owns |value|, for strings that can't be viewed
+  // in the message buffer. The storage is shared with copies of the view.
+  explicit EncodableValueView(std::string value)
+      : owned_string_(std::make_shared<const std::string>(std::move(value))) {
+    super::operator=(std::string_view(*owned_string_));
+  }
+
+  // Returns true if the value is null.
+  bool IsNull() const { return std::holds_alternative<std::monostate>(*this); }
+
+  // See EncodableValue::LongValue.
+  //
+  // Calling this method if the value doesn't contain either an int32_t or an
+  // int64_t will throw an exception.
+  int64_t LongValue() const {
+    if (std::holds_alternative<int32_t>(*this)) {
+      return std::get<int32_t>(*this);
+    }
+    return std::get<int64_t>(*this);
+  }
+
+  // Returns a copy of the value which does not refer to the message buffer.
+  EncodableValue ToEncodableValue() const {
+    switch (index()) {
+      case 0:
+        return EncodableValue();
+      case 1:
+        return EncodableValue(std::get<bool>(*this));
+      case 2:
+        return EncodableValue(std::get<int32_t>(*this));
+      case 3:
+        return EncodableValue(std::get<int64_t>(*this));
+      case 4:
+        return EncodableValue(std::get<double>(*this));
+      case 5:
+        return EncodableValue(std::string(std::get<std::string_view>(*this)));
+      case 6:
+        return EncodableValue(
+            std::get<TypedDataView<uint8_t>>(*this).ToVector());
+      case 7:
+        return EncodableValue(
+            std::get<TypedDataView<int32_t>>(*this).ToVector());
+      case 8:
+        return EncodableValue(
+            std::get<TypedDataView<int64_t>>(*this).ToVector());
+      case 9:
+        return EncodableValue(
+            std::get<TypedDataView<double>>(*this).ToVector());
+      case 10: {
+        const auto& list_view = std::get<EncodableListView>(*this);
+        EncodableList list;
+        list.reserve(list_view.size());
+        for (const auto& item : list_view) {
+          list.push_back(item.ToEncodableValue());
+        }
+        return EncodableValue(std::move(list));
+      }
+      case 11: {
+        EncodableMap map;
+        for (const auto& pair : std::get<EncodableMapView>(*this)) {
+          map.emplace(pair.first.ToEncodableValue(),
+                      pair.second.ToEncodableValue());
+        }
+        return EncodableValue(std::move(map));
+      }
+      case 12:
+        return std::get<EncodableValue>(*this);
+      case 13:
+        return EncodableValue(std::get<TypedDataView<float>>(*this).ToVector());
+    }
+    return EncodableValue();
+  }
+
+ private:
+  // The storage of the string, if the view owns it.
+  std::shared_ptr<const std::string> owned_string_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_ENCODABLE_VALUE_VIEW_H_
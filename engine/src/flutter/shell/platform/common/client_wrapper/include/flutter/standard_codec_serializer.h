@@ -7,6 +7,7 @@
 
 #include "byte_streams.h"
 #include "encodable_value.h"
+#include "encodable_value_view.h"
 
 namespace flutter {
 
@@ -29,6 +30,18 @@ class StandardCodecSerializer {
   // Reads and returns the next value from |stream|.
   EncodableValue ReadValue(ByteStreamReader* stream) const;
 
+  // Reads and returns the next value from |stream| as a view.
+  //
+  // If |stream| supports ReadBytesInPlace, strings and typed lists in the
+  // result refer to the buffer of |stream| instead of being copied, so the
+  // result must not be used after that buffer is freed. Values of types that
+  // are not part of the standard codec are read with ReadValueOfType.
+  //
+  // If |arena| is not null, the lists and maps of the result are allocated
+  // from it, and the result must not be used after it is reset or destroyed.
+  EncodableValueView ReadValueView(ByteStreamReader* stream,
+                                   EncodableValueArena* arena = nullptr) const;
+
   // Writes the encoding of |value| to |stream|, including the initial type
   // discrimination byte.
   //
@@ -65,6 +78,17 @@ class StandardCodecSerializer {
   template <typename T>
   EncodableValue ReadVector(ByteStreamReader* stream) const;
 
+  // Reads and returns the next value from |stream| as a view, whose
+  // discrimination byte was |type|.
+  EncodableValueView ReadValueViewOfType(uint8_t type,
+                                         ByteStreamReader* stream,
+                                         EncodableValueArena* arena) const;
+
+  // Reads a fixed-type list whose values are of type T from the current
+  // position in |stream|, and returns a view of it.
+  template <typename T>
+  EncodableValueView ReadVectorView(ByteStreamReader* stream) const;
+
   // Writes |vector| to |stream| as a fixed-type list. |T| must correspond to
   // one of the supported list value types of EncodableValue.
   template <typename T>
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "encodable_value.h"
+#include "encodable_value_view.h"
 #include "message_codec.h"
 #include "standard_codec_serializer.h"
 
@@ -35,6 +36,32 @@ class StandardMessageCodec : public MessageCodec<EncodableValue> {
   StandardMessageCodec(StandardMessageCodec const&) = delete;
   StandardMessageCodec& operator=(StandardMessageCodec const&) = delete;
 
+  // Returns a view of the message encoded in |binary_message|, whose strings
+  // and typed lists refer to |binary_message| instead of copying it.
+  //
+  // The result must not be used after |binary_message| is freed. For a
+  // message received by a BinaryMessageHandler, that is when the handler
+  // returns.
+  //
+  // If |arena| is not null, the lists and maps of the result are allocated
+  // from it rather than individually from the heap, and the result must not
+  // be used after the arena is reset or destroyed either.
+  EncodableValueView DecodeMessageView(
+      const uint8_t* binary_message,
+      size_t message_size,
+      EncodableValueArena* arena = nullptr) const;
+
+  // Returns a view of the message encoded in |binary_message|, which must
+  // outlive the result. See above.
+  EncodableValueView DecodeMessageView(
+      const std::vector<uint8_t>& binary_message,
+      EncodableValueArena* arena = nullptr) const;
+
+  // A temporary message would be freed before the view could be used.
+  EncodableValueView DecodeMessageView(
+      std::vector<uint8_t>&& binary_message,
+      EncodableValueArena* arena = nullptr) const = delete;
+
  protected:
   // |flutter::MessageCodec|
   std::unique_ptr<EncodableValue> DecodeMessageInternal(
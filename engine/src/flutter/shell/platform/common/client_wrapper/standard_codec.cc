@@ -8,10 +8,12 @@
 // that any client that needs one of these files needs all three.
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -95,6 +97,13 @@ EncodableValue StandardCodecSerializer::ReadValue(
   return ReadValueOfType(type, stream);
 }
 
+EncodableValueView StandardCodecSerializer::ReadValueView(
+    ByteStreamReader* stream,
+    EncodableValueArena* arena) const {
+  uint8_t type = stream->ReadByte();
+  return ReadValueViewOfType(type, stream, arena);
+}
+
 void StandardCodecSerializer::WriteValue(const EncodableValue& value,
                                          ByteStreamWriter* stream) const {
   stream->WriteByte(static_cast<uint8_t>(EncodedTypeForValue(value)));
@@ -226,6 +235,78 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
   return EncodableValue();
 }
 
+EncodableValueView StandardCodecSerializer::ReadValueViewOfType(
+    uint8_t type,
+    ByteStreamReader* stream,
+    EncodableValueArena* arena) const {
+  switch (static_cast<EncodedType>(type)) {
+    case EncodedType::kNull:
+      return EncodableValueView();
+    case EncodedType::kTrue:
+      return EncodableValueView(true);
+    case EncodedType::kFalse:
+      return EncodableValueView(false);
+    case EncodedType::kInt32:
+      return EncodableValueView(stream->ReadInt32());
+    case EncodedType::kInt64:
+      return EncodableValueView(stream->ReadInt64());
+    case EncodedType::kFloat64:
+      stream->ReadAlignment(8);
+      return EncodableValueView(stream->ReadDouble());
+    case EncodedType::kLargeInt:
+    case EncodedType::kString: {
+      size_t size = ReadSize(stream);
+      const uint8_t* bytes = nullptr;
+      switch (stream->ReadBytesInPlace(size, &bytes)) {
+        case ByteStreamReader::ReadInPlaceStatus::kSuccess:
+          return EncodableValueView(
+              std::string_view(reinterpret_cast<const char*>(bytes), size));
+        case ByteStreamReader::ReadInPlaceStatus::kOutOfBounds:
+          return EncodableValueView(std::string_view());
+        case ByteStreamReader::ReadInPlaceStatus::kUnsupported:
+          break;
+      }
+      std::string string_value;
+      string_value.resize(size);
+      stream->ReadBytes(reinterpret_cast<uint8_t*>(string_value.data()), size);
+      return EncodableValueView(std::move(string_value));
+    }
+    case EncodedType::kUInt8List:
+      return ReadVectorView<uint8_t>(stream);
+    case EncodedType::kInt32List:
+      return ReadVectorView<int32_t>(stream);
+    case EncodedType::kInt64List:
+      return ReadVectorView<int64_t>(stream);
+    case EncodedType::kFloat64List:
+      return ReadVectorView<double>(stream);
+    case EncodedType::kList: {
+      size_t length = ReadSize(stream);
+      EncodableListView list_view(arena);
+      list_view.reserve(length);
+      for (size_t i = 0; i < length; ++i) {
+        list_view.push_back(ReadValueView(stream, arena));
+      }
+      return EncodableValueView(std::move(list_view));
+    }
+    case EncodedType::kMap: {
+      size_t length = ReadSize(stream);
+      EncodableMapView map_view(arena);
+      map_view.reserve(length);
+      for (size_t i = 0; i < length; ++i) {
+        EncodableValueView key = ReadValueView(stream, arena);
+        EncodableValueView value = ReadValueView(stream, arena);
+        map_view.emplace_back(std::move(key), std::move(value));
+      }
+      return EncodableValueView(std::move(map_view));
+    }
+    case EncodedType::kFloat32List:
+      return ReadVectorView<float>(stream);
+  }
+  // Types that aren't part of the standard codec are read by the extension,
+  // if any.
+  return EncodableValueView(ReadValueOfType(type, stream));
+}
+
 size_t StandardCodecSerializer::ReadSize(ByteStreamReader* stream) const {
   uint8_t byte = stream->ReadByte();
   if (byte < 254) {
@@ -271,6 +352,37 @@ EncodableValue StandardCodecSerializer::ReadVector(
   return EncodableValue(vector);
 }
 
+template <typename T>
+EncodableValueView StandardCodecSerializer::ReadVectorView(
+    ByteStreamReader* stream) const {
+  size_t count = ReadSize(stream);
+  uint8_t type_size = static_cast<uint8_t>(sizeof(T));
+  if (type_size > 1) {
+    stream->ReadAlignment(type_size);
+  }
+  const uint8_t* bytes = nullptr;
+  auto status = stream->ReadBytesInPlace(count * type_size, &bytes);
+  if (status == ByteStreamReader::ReadInPlaceStatus::kOutOfBounds) {
+    return EncodableValueView(TypedDataView<T>());
+  }
+  // The list is aligned relative to the start of the message, so it can only
+  // be viewed in place if the message itself is suitably aligned.
+  if (status == ByteStreamReader::ReadInPlaceStatus::kSuccess &&
+      reinterpret_cast<uintptr_t>(bytes) % alignof(T) == 0) {
+    return EncodableValueView(
+        TypedDataView<T>(reinterpret_cast<const T*>(bytes), count));
+  }
+  std::vector<T> vector;
+  vector.resize(count);
+  if (status == ByteStreamReader::ReadInPlaceStatus::kSuccess) {
+    std::memcpy(vector.data(), bytes, count * type_size);
+  } else {
+    stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
+                      count * type_size);
+  }
+  return EncodableValueView(TypedDataView<T>(std::move(vector)));
+}
+
 template <typename T>
 void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
                                           ByteStreamWriter* stream) const {
@@ -326,6 +438,25 @@ std::unique_ptr<EncodableValue> StandardMessageCodec::DecodeMessageInternal(
   return std::make_unique<EncodableValue>(serializer_->ReadValue(&stream));
 }
 
+EncodableValueView StandardMessageCodec::DecodeMessageView(
+    const uint8_t* binary_message,
+    size_t message_size,
+    EncodableValueArena* arena) const {
+  if (!binary_message) {
+    return EncodableValueView();
+  }
+  ByteBufferStreamReader stream(binary_message, message_size);
+  return serializer_->ReadValueView(&stream, arena);
+}
+
+EncodableValueView StandardMessageCodec::DecodeMessageView(
+    const std::vector<uint8_t>& binary_message,
+    EncodableValueArena* arena) const {
+  size_t size = binary_message.size();
+  const uint8_t* data = size > 0 ? &binary_message[0] : nullptr;
+  return DecodeMessageView(data, size, arena);
+}
+
 std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+enum class PayloadType {
+  kUInt8List,
+  kFloat64List,
+};
+
+// Returns a message with the shape of a camera frame or a batch of sensor
+// samples whose list has |byte_size| bytes.
+std::unique_ptr<std::vector<uint8_t>> MakeMessage(PayloadType type,
+                                                  size_t byte_size) {
+  EncodableValue payload;
+  switch (type) {
+    case PayloadType::kUInt8List: {
+      std::vector<uint8_t> bytes(byte_size);
+      for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i);
+      }
+      payload = EncodableValue(std::move(bytes));
+      break;
+    }
+    case PayloadType::kFloat64List: {
+      std::vector<double> samples(byte_size / sizeof(double));
+      for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = i * 0.5;
+      }
+      payload = EncodableValue(std::move(samples));
+      break;
+    }
+  }
+  EncodableValue message(EncodableMap{
+      {EncodableValue("timestamp"), EncodableValue(int64_t{1234567890})},
+      {EncodableValue("payload"), std::move(payload)},
+  });
+  return StandardMessageCodec::GetInstance().EncodeMessage(message);
+}
+
+// Returns a message of |record_count| records, each of which is a map with
+// five entries, so that the message has about 10 nodes per record.
+std::unique_ptr<std::vector<uint8_t>> MakeNestedMessage(size_t record_count) {
+  EncodableList records;
+  records.reserve(record_count);
+  for (size_t i = 0; i < record_count; i++) {
+    records.push_back(EncodableValue(EncodableMap{
+        {EncodableValue("id"), EncodableValue(static_cast<int32_t>(i))},
+        {EncodableValue("name"), EncodableValue("record")},
+        {EncodableValue("x"), EncodableValue(i * 0.25)},
+        {EncodableValue("enabled"), EncodableValue(i % 2 == 0)},
+        {EncodableValue("tags"),
+         EncodableValue(EncodableList{EncodableValue(1), EncodableValue(2)})},
+    }));
+  }
+  return StandardMessageCodec::GetInstance().EncodeMessage(
+      EncodableValue(std::move(records)));
+}
+
+enum class NestedDecodeMode {
+  kCopy,
+  kView,
+  kViewWithArena,
+};
+
+}  // namespace
+
+static void BM_DecodeNestedMessage(benchmark::State& state,
+                                   NestedDecodeMode mode) {
+  auto message = MakeNestedMessage(state.range(0) / 10);
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  EncodableValueArena arena;
+  for (auto _ : state) {
+    switch (mode) {
+      case NestedDecodeMode::kCopy: {
+        auto decoded = codec.DecodeMessage(*message);
+        benchmark::DoNotOptimize(decoded);
+        break;
+      }
+      case NestedDecodeMode::kView: {
+        EncodableValueView decoded = codec.DecodeMessageView(*message);
+        benchmark::DoNotOptimize(decoded);
+        break;
+      }
+      case NestedDecodeMode::kViewWithArena: {
+        EncodableValueView decoded = codec.DecodeMessageView(*message, &arena);
+        benchmark::DoNotOptimize(decoded);
+        // Views must be destroyed before the arena is reset.
+        decoded = EncodableValueView();
+        arena.Reset();
+        break;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_DecodeNestedMessage, copy, NestedDecodeMode::kCopy)
+    ->Arg(1000)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_DecodeNestedMessage, view, NestedDecodeMode::kView)
+    ->Arg(1000)
+    ->Arg(10000);
+BENCHMARK_CAPTURE(BM_DecodeNestedMessage,
+                  view_with_arena,
+                  NestedDecodeMode::kViewWithArena)
+    ->Arg(1000)
+    ->Arg(10000);
+
+static void BM_DecodeMessage(benchmark::State& state,
+                             PayloadType type,
+                             bool view) {
+  auto message = MakeMessage(type, state.range(0));
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  for (auto _ : state) {
+    if (view) {
+      EncodableValueView decoded = codec.DecodeMessageView(*message);
+      benchmark::DoNotOptimize(decoded);
+    } else {
+      auto decoded = codec.DecodeMessage(*message);
+      benchmark::DoNotOptimize(decoded);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * message->size());
+}
+
+BENCHMARK_CAPTURE(BM_DecodeMessage,
+                  uint8_list_copy,
+                  PayloadType::kUInt8List,
+                  false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20);
+BENCHMARK_CAPTURE(BM_DecodeMessage,
+                  uint8_list_view,
+                  PayloadType::kUInt8List,
+                  true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20);
+BENCHMARK_CAPTURE(BM_DecodeMessage,
+                  float64_list_copy,
+                  PayloadType::kFloat64List,
+                  false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20);
+BENCHMARK_CAPTURE(BM_DecodeMessage,
+                  float64_list_view,
+                  PayloadType::kFloat64List,
+                  true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 8 << 20);
+
+}  // namespace flutter
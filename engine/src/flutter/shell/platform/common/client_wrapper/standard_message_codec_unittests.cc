@@ -4,7 +4,10 @@
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
 
+#include <algorithm>
 #include <map>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/testing/test_codec_extensions.h"
@@ -26,6 +29,35 @@ class MockStandardCodecSerializer : public StandardCodecSerializer {
               (uint8_t type, ByteStreamReader* stream),
               (const, override));
 };
+
+// Reads from a byte array without supporting ReadBytesInPlace.
+class CopyingByteStreamReader : public ByteStreamReader {
+ public:
+  explicit CopyingByteStreamReader(const std::vector<uint8_t>& bytes)
+      : bytes_(bytes) {}
+
+  // |ByteStreamReader|
+  uint8_t ReadByte() override { return bytes_[location_++]; }
+
+  // |ByteStreamReader|
+  void ReadBytes(uint8_t* buffer, size_t length) override {
+    std::copy(bytes_.begin() + location_, bytes_.begin() + location_ + length,
+              buffer);
+    location_ += length;
+  }
+
+  // |ByteStreamReader|
+  void ReadAlignment(uint8_t alignment) override {
+    uint8_t mod = location_ % alignment;
+    if (mod) {
+      location_ += alignment - mod;
+    }
+  }
+
+ private:
+  const std::vector<uint8_t>& bytes_;
+  size_t location_ = 0;
+};
 }  // namespace
 
 // Validates round-trip encoding and decoding of |value|, and checks that the
@@ -262,4 +294,174 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeVariableLengthCustomType) {
                     some_data_comparator);
 }
 
+TEST(StandardMessageCodec, CanDecodeMessageViewWithoutCopying) {
+  EncodableValue value(EncodableMap{
+      {EncodableValue("name"), EncodableValue("camera")},
+      {EncodableValue("frame"),
+       EncodableValue(std::vector<uint8_t>{0xba, 0x5e, 0xba, 0x11})},
+      {EncodableValue("samples"),
+       EncodableValue(std::vector<double>{3.14, 1000.0, -1.0})},
+      {EncodableValue("ids"), EncodableValue(EncodableList{
+                                  EncodableValue(std::vector<int32_t>{1, 2}),
+                                  EncodableValue(47),
+                              })},
+  });
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  EncodableValueView view = codec.DecodeMessageView(*encoded);
+  EXPECT_EQ(value, view.ToEncodableValue());
+
+  const uint8_t* begin = encoded->data();
+  const uint8_t* end = begin + encoded->size();
+  auto is_in_message = [begin, end](const void* pointer) {
+    const uint8_t* byte = static_cast<const uint8_t*>(pointer);
+    return byte >= begin && byte < end;
+  };
+  const auto& map_view = std::get<EncodableMapView>(view);
+  ASSERT_EQ(map_view.size(), 4u);
+  for (const auto& [key, entry] : map_view) {
+    EXPECT_TRUE(is_in_message(std::get<std::string_view>(key).data()));
+    if (std::holds_alternative<TypedDataView<uint8_t>>(entry)) {
+      const auto& frame = std::get<TypedDataView<uint8_t>>(entry);
+      EXPECT_TRUE(frame.IsBorrowed());
+      EXPECT_TRUE(is_in_message(frame.data()));
+    } else if (std::holds_alternative<TypedDataView<double>>(entry)) {
+      const auto& samples = std::get<TypedDataView<double>>(entry);
+      EXPECT_TRUE(samples.IsBorrowed());
+      EXPECT_TRUE(is_in_message(samples.data()));
+      ASSERT_EQ(samples.size(), 3u);
+      EXPECT_EQ(samples[1], 1000.0);
+    } else if (std::holds_alternative<EncodableListView>(entry)) {
+      const auto& ids = std::get<EncodableListView>(entry);
+      ASSERT_EQ(ids.size(), 2u);
+      EXPECT_TRUE(
+          is_in_message(std::get<TypedDataView<int32_t>>(ids[0]).data()));
+      EXPECT_EQ(ids[1].LongValue(), 47);
+    } else {
+      EXPECT_EQ(std::get<std::string_view>(entry), "camera");
+    }
+  }
+}
+
+TEST(StandardMessageCodec, DecodeMessageViewCopiesMisalignedLists) {
+  EncodableValue value(std::vector<double>{3.14, 1000.0});
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  // Offset the message by one byte, so the list can't be viewed in place.
+  std::vector<uint8_t> buffer(encoded->size() + 1);
+  std::copy(encoded->begin(), encoded->end(), buffer.begin() + 1);
+  EncodableValueView view =
+      codec.DecodeMessageView(buffer.data() + 1, encoded->size());
+
+  const auto& samples = std::get<TypedDataView<double>>(view);
+  EXPECT_FALSE(samples.IsBorrowed());
+  EXPECT_EQ(samples.ToVector(), std::get<std::vector<double>>(value));
+}
+
+TEST(StandardMessageCodec, DecodeMessageViewCopiesFromStreamsWithoutInPlace) {
+  EncodableValue value(EncodableList{
+      EncodableValue("camera"),
+      EncodableValue(std::vector<int32_t>{1, 2, 3}),
+  });
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  CopyingByteStreamReader stream(*encoded);
+  EncodableValueView view =
+      StandardCodecSerializer::GetInstance().ReadValueView(&stream);
+  EncodableValueView copy = view;
+  view = EncodableValueView();
+
+  const auto& list_view = std::get<EncodableListView>(copy);
+  ASSERT_EQ(list_view.size(), 2u);
+  // Strings that can't be viewed in place keep the string_view alternative.
+  EXPECT_EQ(std::get<std::string_view>(list_view[0]), "camera");
+  const auto& ids = std::get<TypedDataView<int32_t>>(list_view[1]);
+  EXPECT_FALSE(ids.IsBorrowed());
+  EXPECT_EQ(ids.ToVector(), (std::vector<int32_t>{1, 2, 3}));
+  EXPECT_EQ(value, copy.ToEncodableValue());
+}
+
+TEST(StandardMessageCodec, DecodeMessageViewReportsTruncatedStringsOnce) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(EncodableValue("truncated"));
+  ASSERT_TRUE(encoded);
+
+  testing::internal::CaptureStderr();
+  EncodableValueView view =
+      codec.DecodeMessageView(encoded->data(), encoded->size() - 4);
+  std::string errors = testing::internal::GetCapturedStderr();
+
+  EXPECT_EQ(std::get<std::string_view>(view), "");
+  size_t error_count = 0;
+  for (size_t position = errors.find("Invalid read");
+       position != std::string::npos;
+       position = errors.find("Invalid read", position + 1)) {
+    error_count++;
+  }
+  EXPECT_EQ(error_count, 1u);
+}
+
+TEST(StandardMessageCodec, DecodeMessageViewReadsCustomTypes) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance(
+      &PointExtensionSerializer::GetInstance());
+  EncodableValue value(EncodableList{
+      CustomEncodableValue(Point(9, 16)),
+      EncodableValue("point"),
+  });
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  EncodableValueView view = codec.DecodeMessageView(*encoded);
+  const auto& list_view = std::get<EncodableListView>(view);
+  ASSERT_EQ(list_view.size(), 2u);
+  const Point& point = std::any_cast<Point>(
+      std::get<CustomEncodableValue>(std::get<EncodableValue>(list_view[0])));
+  EXPECT_EQ(point, Point(9, 16));
+  EXPECT_EQ(std::get<std::string_view>(list_view[1]), "point");
+}
+
+TEST(StandardMessageCodec, DecodeMessageViewAllocatesFromArena) {
+  EncodableList records;
+  for (int32_t i = 0; i < 100; ++i) {
+    records.push_back(EncodableValue(EncodableMap{
+        {EncodableValue("id"), EncodableValue(i)},
+        {EncodableValue("tags"), EncodableValue(EncodableList{
+                                     EncodableValue("a"),
+                                     EncodableValue("b"),
+                                 })},
+    }));
+  }
+  EncodableValue value(records);
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+
+  EncodableValueArena arena;
+  {
+    EncodableValueView view = codec.DecodeMessageView(*encoded, &arena);
+    const auto& list_view = std::get<EncodableListView>(view);
+    EXPECT_EQ(list_view.get_allocator().arena(), &arena);
+    const auto& map_view = std::get<EncodableMapView>(list_view[0]);
+    EXPECT_EQ(map_view.get_allocator().arena(), &arena);
+    EXPECT_EQ(value, view.ToEncodableValue());
+  }
+  // One list of 100 records, each a map with two entries and a list of two.
+  EXPECT_GE(arena.GetAllocatedBytes(),
+            100 * (sizeof(EncodableValueView) +
+                   2 * sizeof(std::pair<EncodableValueView,
+                                        EncodableValueView>) +
+                   2 * sizeof(EncodableValueView)));
+  // Blocks double in size, so the whole tree fits in a few of them.
+  EXPECT_LE(arena.GetBlockCount(), 4u);
+
+  arena.Reset();
+  EXPECT_EQ(arena.GetAllocatedBytes(), 0u);
+}
+
 }  // namespace flutter
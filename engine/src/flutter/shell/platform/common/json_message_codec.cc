@@ -35,8 +35,24 @@ std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
 std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
     const uint8_t* binary_message,
     const size_t message_size) const {
+  return ParseMessage(binary_message, message_size,
+                      std::make_unique<rapidjson::Document>());
+}
+
+std::unique_ptr<rapidjson::Document>
+JsonMessageCodec::DecodeMessageWithAllocator(
+    const uint8_t* binary_message,
+    size_t message_size,
+    rapidjson::Document::AllocatorType* allocator) const {
+  return ParseMessage(binary_message, message_size,
+                      std::make_unique<rapidjson::Document>(allocator));
+}
+
+std::unique_ptr<rapidjson::Document> JsonMessageCodec::ParseMessage(
+    const uint8_t* binary_message,
+    size_t message_size,
+    std::unique_ptr<rapidjson::Document> json_message) {
   auto raw_message = reinterpret_cast<const char*>(binary_message);
-  auto json_message = std::make_unique<rapidjson::Document>();
   rapidjson::ParseResult result =
       json_message->Parse(raw_message, message_size);
   if (result.IsError()) {
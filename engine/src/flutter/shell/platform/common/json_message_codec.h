@@ -24,6 +24,20 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Returns the message encoded in |binary_message|, or nullptr if it cannot
+  // be decoded, with the values of the document allocated from |allocator|.
+  //
+  // The allocator is a memory pool which frees everything allocated from it
+  // at once when it is cleared or destroyed. A caller decoding large or
+  // frequent messages can reuse one allocator, optionally constructed over a
+  // preallocated buffer, to avoid allocating new chunks for every message.
+  // The returned document must not be used after |allocator| is cleared or
+  // destroyed.
+  std::unique_ptr<rapidjson::Document> DecodeMessageWithAllocator(
+      const uint8_t* binary_message,
+      size_t message_size,
+      rapidjson::Document::AllocatorType* allocator) const;
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
@@ -36,6 +50,13 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   // |flutter::MessageCodec|
   std::unique_ptr<std::vector<uint8_t>> EncodeMessageInternal(
       const rapidjson::Document& message) const override;
+
+ private:
+  // Parses |binary_message| into |json_message|, returning it on success.
+  static std::unique_ptr<rapidjson::Document> ParseMessage(
+      const uint8_t* binary_message,
+      size_t message_size,
+      std::unique_ptr<rapidjson::Document> json_message);
 };
 
 }  // namespace flutter
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/json_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns a JSON message of |record_count| records, each of which is an
+// object with five members, so that the message has about 10 nodes per
+// record.
+std::vector<uint8_t> MakeMessage(size_t record_count) {
+  std::string json = "[";
+  for (size_t i = 0; i < record_count; i++) {
+    if (i > 0) {
+      json += ",";
+    }
+    json += "{\"id\":" + std::to_string(i) +
+            ",\"name\":\"record\",\"x\":0.25,\"enabled\":true,"
+            "\"tags\":[1,2]}";
+  }
+  json += "]";
+  return std::vector<uint8_t>(json.begin(), json.end());
+}
+
+}  // namespace
+
+static void BM_JsonDecodeMessage(benchmark::State& state) {
+  std::vector<uint8_t> message = MakeMessage(state.range(0) / 10);
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  for (auto _ : state) {
+    auto decoded = codec.DecodeMessage(message);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_JsonDecodeMessage)->Arg(1000)->Arg(10000);
+
+static void BM_JsonDecodeMessageWithAllocator(benchmark::State& state) {
+  std::vector<uint8_t> message = MakeMessage(state.range(0) / 10);
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  // One buffer large enough for the whole document, reused every iteration.
+  std::vector<uint8_t> buffer(64 * state.range(0));
+  rapidjson::Document::AllocatorType allocator(buffer.data(), buffer.size());
+  for (auto _ : state) {
+    auto decoded = codec.DecodeMessageWithAllocator(
+        message.data(), message.size(), &allocator);
+    benchmark::DoNotOptimize(decoded);
+    decoded.reset();
+    allocator.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_JsonDecodeMessageWithAllocator)->Arg(1000)->Arg(10000);
+
+}  // namespace flutter
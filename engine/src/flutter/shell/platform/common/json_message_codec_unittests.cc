@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -44,4 +45,24 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that a message can be decoded into a caller-provided memory pool.
+TEST(JsonMessageCodec, DecodeWithAllocator) {
+  std::string json = R"([{"a":-7,"b":"string"},[true,null,3.14159]])";
+  std::vector<uint8_t> message(json.begin(), json.end());
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+
+  std::vector<uint8_t> buffer(4096);
+  rapidjson::Document::AllocatorType allocator(buffer.data(), buffer.size());
+  auto decoded = codec.DecodeMessageWithAllocator(message.data(),
+                                                  message.size(), &allocator);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(&decoded->GetAllocator(), &allocator);
+  EXPECT_GT(allocator.Size(), 0u);
+  EXPECT_EQ(*codec.DecodeMessage(message), *decoded);
+
+  decoded.reset();
+  allocator.Clear();
+  EXPECT_EQ(allocator.Size(), 0u);
+}
+
 }  // namespace flutter
@@ -16,6 +16,10 @@ void TestAccessibilityBridge::OnAccessibilityEvent(
   accessibility_events.push_back(targeted_event.event_params.event);
 }
 
+void TestAccessibilityBridge::ScheduleDeferredCommit(fml::TimeDelta delay) {
+  deferred_commit_delays.push_back(delay);
+}
+
 void TestAccessibilityBridge::DispatchAccessibilityAction(
     AccessibilityNodeId target,
     FlutterSemanticsAction action,
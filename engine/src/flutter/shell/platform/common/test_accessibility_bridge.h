@@ -19,6 +19,7 @@ class TestAccessibilityBridge : public AccessibilityBridge {
 
   std::vector<ui::AXEventGenerator::Event> accessibility_events;
   std::vector<FlutterSemanticsAction> performed_actions;
+  std::vector<fml::TimeDelta> deferred_commit_delays;
 
  protected:
   void OnAccessibilityEvent(
@@ -26,6 +27,8 @@ class TestAccessibilityBridge : public AccessibilityBridge {
 
   std::shared_ptr<FlutterPlatformNodeDelegate>
   CreateFlutterPlatformNodeDelegate() override;
+
+  void ScheduleDeferredCommit(fml::TimeDelta delay) override;
 };
 
 }  // namespace flutter
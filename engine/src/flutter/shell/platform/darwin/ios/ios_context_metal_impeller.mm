@@ -16,6 +16,8 @@ namespace {
 impeller::Flags SettingsToFlags(const Settings& settings) {
   return impeller::Flags{
       .antialiased_lines = settings.impeller_antialiased_lines,
+      .glyph_atlas_max_bytes = settings.impeller_glyph_atlas_max_bytes,
+      .glyph_atlas_max_pages = settings.impeller_glyph_atlas_max_pages,
   };
 }
 }  // namespace
@@ -1849,7 +1849,7 @@ CreateEmbedderSemanticsUpdateCallbackV1(
     void* user_data) {
   return [update_semantics_node_callback,
           update_semantics_custom_action_callback, user_data](
-             int64_t view_id, const flutter::SemanticsNodeUpdates& nodes,
+             int64_t view_id, const flutter::FlatSemanticsNodeUpdates& nodes,
              const flutter::CustomAccessibilityActionUpdates& actions) {
     flutter::EmbedderSemanticsUpdate update{nodes, actions};
     FlutterSemanticsUpdate* update_ptr = update.get();
@@ -1895,7 +1895,7 @@ CreateEmbedderSemanticsUpdateCallbackV2(
     FlutterUpdateSemanticsCallback update_semantics_callback,
     void* user_data) {
   return [update_semantics_callback, user_data](
-             int64_t view_id, const flutter::SemanticsNodeUpdates& nodes,
+             int64_t view_id, const flutter::FlatSemanticsNodeUpdates& nodes,
              const flutter::CustomAccessibilityActionUpdates& actions) {
     flutter::EmbedderSemanticsUpdate update{nodes, actions};
 
@@ -1910,7 +1910,7 @@ CreateEmbedderSemanticsUpdateCallbackV3(
     FlutterUpdateSemanticsCallback2 update_semantics_callback,
     void* user_data) {
   return [update_semantics_callback, user_data](
-             int64_t view_id, const flutter::SemanticsNodeUpdates& nodes,
+             int64_t view_id, const flutter::FlatSemanticsNodeUpdates& nodes,
              const flutter::CustomAccessibilityActionUpdates& actions) {
     flutter::EmbedderSemanticsUpdate2 update{view_id, nodes, actions};
 
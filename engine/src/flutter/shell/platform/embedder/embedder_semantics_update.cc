@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/embedder/embedder_semantics_update.h"
 
+#include "flutter/fml/logging.h"
+
 namespace {
 FlutterCheckState ToFlutterCheckState(flutter::SemanticsCheckState state) {
   switch (state) {
@@ -29,9 +31,9 @@ FlutterTristate ToFlutterTristate(flutter::SemanticsTristate state) {
   }
 }
 
-std::unique_ptr<FlutterSemanticsFlags> ConvertToFlutterSemanticsFlags(
+FlutterSemanticsFlags ConvertToFlutterSemanticsFlags(
     const flutter::SemanticsFlags& source) {
-  return std::make_unique<FlutterSemanticsFlags>(FlutterSemanticsFlags{
+  return FlutterSemanticsFlags{
       .is_checked = ToFlutterCheckState(source.isChecked),
       .is_selected = ToFlutterTristate(source.isSelected),
       .is_enabled = ToFlutterTristate(source.isEnabled),
@@ -55,7 +57,17 @@ std::unique_ptr<FlutterSemanticsFlags> ConvertToFlutterSemanticsFlags(
       .is_link = source.isLink,
       .is_slider = source.isSlider,
       .is_keyboard_key = source.isKeyboardKey,
-  });
+  };
+}
+
+FlutterTransformation ToFlutterTransformation(const SkM44& matrix) {
+  SkMatrix transform = matrix.asM33();
+  return FlutterTransformation{
+      transform.get(SkMatrix::kMScaleX), transform.get(SkMatrix::kMSkewX),
+      transform.get(SkMatrix::kMTransX), transform.get(SkMatrix::kMSkewY),
+      transform.get(SkMatrix::kMScaleY), transform.get(SkMatrix::kMTransY),
+      transform.get(SkMatrix::kMPersp0), transform.get(SkMatrix::kMPersp1),
+      transform.get(SkMatrix::kMPersp2)};
 }
 
 }  // namespace
@@ -63,10 +75,13 @@ std::unique_ptr<FlutterSemanticsFlags> ConvertToFlutterSemanticsFlags(
 namespace flutter {
 
 EmbedderSemanticsUpdate::EmbedderSemanticsUpdate(
-    const SemanticsNodeUpdates& nodes,
+    const FlatSemanticsNodeUpdates& nodes,
     const CustomAccessibilityActionUpdates& actions) {
-  for (const auto& value : nodes) {
-    AddNode(value.second);
+  nodes_.reserve(nodes.size());
+  actions_.reserve(actions.size());
+
+  for (const auto& node : nodes.records()) {
+    AddNode(nodes, node);
   }
 
   for (const auto& value : actions) {
@@ -185,15 +200,9 @@ FlutterSemanticsFlag SemanticsFlagsToInt(const SemanticsFlags& flags) {
   return static_cast<FlutterSemanticsFlag>(result);
 }
 
-void EmbedderSemanticsUpdate::AddNode(const SemanticsNode& node) {
-  SkMatrix transform = node.transform.asM33();
-  FlutterTransformation flutter_transform{
-      transform.get(SkMatrix::kMScaleX), transform.get(SkMatrix::kMSkewX),
-      transform.get(SkMatrix::kMTransX), transform.get(SkMatrix::kMSkewY),
-      transform.get(SkMatrix::kMScaleY), transform.get(SkMatrix::kMTransY),
-      transform.get(SkMatrix::kMPersp0), transform.get(SkMatrix::kMPersp1),
-      transform.get(SkMatrix::kMPersp2)};
-
+void EmbedderSemanticsUpdate::AddNode(
+    const FlatSemanticsNodeUpdates& nodes,
+    const FlatSemanticsNodeUpdates::Record& node) {
   // Do not add new members to FlutterSemanticsNode.
   // This would break the forward compatibility of FlutterSemanticsUpdate.
   // All new members must be added to FlutterSemanticsNode2 instead.
@@ -211,22 +220,22 @@ void EmbedderSemanticsUpdate::AddNode(const SemanticsNode& node) {
       node.scrollExtentMin,
       0.0,
       0.0,
-      node.label.c_str(),
-      node.hint.c_str(),
-      node.value.c_str(),
-      node.increasedValue.c_str(),
-      node.decreasedValue.c_str(),
+      nodes.GetCString(node.label),
+      nodes.GetCString(node.hint),
+      nodes.GetCString(node.value),
+      nodes.GetCString(node.increasedValue),
+      nodes.GetCString(node.decreasedValue),
       static_cast<FlutterTextDirection>(node.textDirection),
       FlutterRect{node.rect.fLeft, node.rect.fTop, node.rect.fRight,
                   node.rect.fBottom},
-      flutter_transform,
-      node.childrenInTraversalOrder.size(),
-      node.childrenInTraversalOrder.data(),
-      node.childrenInHitTestOrder.data(),
-      node.customAccessibilityActions.size(),
-      node.customAccessibilityActions.data(),
+      ToFlutterTransformation(node.transform),
+      node.childrenInTraversalOrder.count,
+      nodes.GetInt32s(node.childrenInTraversalOrder),
+      nodes.GetInt32s(node.childrenInHitTestOrder),
+      node.customAccessibilityActions.count,
+      nodes.GetInt32s(node.customAccessibilityActions),
       node.platformViewId,
-      node.tooltip.c_str(),
+      nodes.GetCString(node.tooltip),
   });
 }
 
@@ -248,16 +257,27 @@ EmbedderSemanticsUpdate::~EmbedderSemanticsUpdate() {}
 
 EmbedderSemanticsUpdate2::EmbedderSemanticsUpdate2(
     int64_t view_id,
-    const SemanticsNodeUpdates& nodes,
+    const FlatSemanticsNodeUpdates& nodes,
     const CustomAccessibilityActionUpdates& actions) {
+  size_t string_attribute_count = 0;
+  for (const auto& node : nodes.records()) {
+    string_attribute_count +=
+        node.labelAttributes.count + node.hintAttributes.count +
+        node.valueAttributes.count + node.increasedValueAttributes.count +
+        node.decreasedValueAttributes.count;
+  }
+
   nodes_.reserve(nodes.size());
   flags_.reserve(nodes.size());
   node_pointers_.reserve(nodes.size());
   actions_.reserve(actions.size());
   action_pointers_.reserve(actions.size());
+  string_attribute_pointers_.reserve(string_attribute_count);
+  string_attributes_.reserve(string_attribute_count);
+  locale_attributes_.reserve(string_attribute_count);
 
-  for (const auto& value : nodes) {
-    AddNode(value.second);
+  for (const auto& node : nodes.records()) {
+    AddNode(nodes, node);
   }
 
   for (const auto& value : actions) {
@@ -282,23 +302,18 @@ EmbedderSemanticsUpdate2::EmbedderSemanticsUpdate2(
 
 EmbedderSemanticsUpdate2::~EmbedderSemanticsUpdate2() {}
 
-void EmbedderSemanticsUpdate2::AddNode(const SemanticsNode& node) {
-  SkMatrix transform = node.transform.asM33();
-  FlutterTransformation flutter_transform{
-      transform.get(SkMatrix::kMScaleX), transform.get(SkMatrix::kMSkewX),
-      transform.get(SkMatrix::kMTransX), transform.get(SkMatrix::kMSkewY),
-      transform.get(SkMatrix::kMScaleY), transform.get(SkMatrix::kMTransY),
-      transform.get(SkMatrix::kMPersp0), transform.get(SkMatrix::kMPersp1),
-      transform.get(SkMatrix::kMPersp2)};
-
-  auto label_attributes = CreateStringAttributes(node.labelAttributes);
-  auto hint_attributes = CreateStringAttributes(node.hintAttributes);
-  auto value_attributes = CreateStringAttributes(node.valueAttributes);
+void EmbedderSemanticsUpdate2::AddNode(
+    const FlatSemanticsNodeUpdates& nodes,
+    const FlatSemanticsNodeUpdates::Record& node) {
+  auto label_attributes = CreateStringAttributes(nodes, node.labelAttributes);
+  auto hint_attributes = CreateStringAttributes(nodes, node.hintAttributes);
+  auto value_attributes = CreateStringAttributes(nodes, node.valueAttributes);
   auto increased_value_attributes =
-      CreateStringAttributes(node.increasedValueAttributes);
+      CreateStringAttributes(nodes, node.increasedValueAttributes);
   auto decreased_value_attributes =
-      CreateStringAttributes(node.decreasedValueAttributes);
-  flags_.emplace_back(ConvertToFlutterSemanticsFlags(node.flags));
+      CreateStringAttributes(nodes, node.decreasedValueAttributes);
+  FML_DCHECK(flags_.size() < flags_.capacity());
+  flags_.push_back(ConvertToFlutterSemanticsFlags(node.flags));
 
   nodes_.push_back({
       sizeof(FlutterSemanticsNode2),
@@ -314,22 +329,22 @@ void EmbedderSemanticsUpdate2::AddNode(const SemanticsNode& node) {
       node.scrollExtentMin,
       0.0,
       0.0,
-      node.label.c_str(),
-      node.hint.c_str(),
-      node.value.c_str(),
-      node.increasedValue.c_str(),
-      node.decreasedValue.c_str(),
+      nodes.GetCString(node.label),
+      nodes.GetCString(node.hint),
+      nodes.GetCString(node.value),
+      nodes.GetCString(node.increasedValue),
+      nodes.GetCString(node.decreasedValue),
       static_cast<FlutterTextDirection>(node.textDirection),
       FlutterRect{node.rect.fLeft, node.rect.fTop, node.rect.fRight,
                   node.rect.fBottom},
-      flutter_transform,
-      node.childrenInTraversalOrder.size(),
-      node.childrenInTraversalOrder.data(),
-      node.childrenInHitTestOrder.data(),
-      node.customAccessibilityActions.size(),
-      node.customAccessibilityActions.data(),
+      ToFlutterTransformation(node.transform),
+      node.childrenInTraversalOrder.count,
+      nodes.GetInt32s(node.childrenInTraversalOrder),
+      nodes.GetInt32s(node.childrenInHitTestOrder),
+      node.customAccessibilityActions.count,
+      nodes.GetInt32s(node.customAccessibilityActions),
       node.platformViewId,
-      node.tooltip.c_str(),
+      nodes.GetCString(node.tooltip),
       label_attributes.count,
       label_attributes.attributes,
       hint_attributes.count,
@@ -340,7 +355,7 @@ void EmbedderSemanticsUpdate2::AddNode(const SemanticsNode& node) {
       increased_value_attributes.attributes,
       decreased_value_attributes.count,
       decreased_value_attributes.attributes,
-      flags_.back().get(),
+      &flags_.back(),
   });
 }
 
@@ -357,66 +372,53 @@ void EmbedderSemanticsUpdate2::AddAction(
 
 EmbedderSemanticsUpdate2::EmbedderStringAttributes
 EmbedderSemanticsUpdate2::CreateStringAttributes(
-    const StringAttributes& attributes) {
-  // Minimize allocations if attributes are empty.
-  if (attributes.empty()) {
+    const FlatSemanticsNodeUpdates& nodes,
+    FlatSemanticsNodeUpdates::AttributeRange range) {
+  if (range.count == 0) {
     return {.count = 0, .attributes = nullptr};
   }
 
-  // Translate the engine attributes to embedder attributes.
-  // The result vector's data is returned by this method.
-  // The result vector will be owned by |node_string_attributes_|
-  // so that the embedder attributes are cleaned up at the end of the
-  // semantics update callback when when the |EmbedderSemanticsUpdate2|
-  // is destroyed.
-  auto result = std::make_unique<std::vector<const FlutterStringAttribute*>>();
-  result->reserve(attributes.size());
-
-  for (const auto& attribute : attributes) {
-    auto embedder_attribute = std::make_unique<FlutterStringAttribute>();
-    embedder_attribute->struct_size = sizeof(FlutterStringAttribute);
-    embedder_attribute->start = attribute->start;
-    embedder_attribute->end = attribute->end;
-
-    switch (attribute->type) {
+  // Translate the engine attributes to embedder attributes. The returned
+  // array is a run of |string_attribute_pointers_|, which was reserved for
+  // the attributes of all nodes, so it is not moved by later nodes.
+  FML_DCHECK(string_attribute_pointers_.size() + range.count <=
+             string_attribute_pointers_.capacity());
+  const size_t offset = string_attribute_pointers_.size();
+  const FlatSemanticsNodeUpdates::StringAttributeRecord* attributes =
+      nodes.GetStringAttributes(range);
+
+  for (size_t i = 0; i < range.count; i++) {
+    const auto& attribute = attributes[i];
+    FlutterStringAttribute embedder_attribute = {
+        .struct_size = sizeof(FlutterStringAttribute),
+        .start = static_cast<size_t>(attribute.start),
+        .end = static_cast<size_t>(attribute.end),
+    };
+
+    switch (attribute.type) {
       case StringAttributeType::kLocale: {
-        std::shared_ptr<flutter::LocaleStringAttribute> locale_attribute =
-            std::static_pointer_cast<flutter::LocaleStringAttribute>(attribute);
-
-        auto embedder_locale = std::make_unique<FlutterLocaleStringAttribute>();
-        embedder_locale->struct_size = sizeof(FlutterLocaleStringAttribute);
-        embedder_locale->locale = locale_attribute->locale.c_str();
-        locale_attributes_.push_back(std::move(embedder_locale));
-
-        embedder_attribute->type = FlutterStringAttributeType::kLocale;
-        embedder_attribute->locale = locale_attributes_.back().get();
+        locale_attributes_.push_back({
+            .struct_size = sizeof(FlutterLocaleStringAttribute),
+            .locale = nodes.GetCString(attribute.locale),
+        });
+        embedder_attribute.type = FlutterStringAttributeType::kLocale;
+        embedder_attribute.locale = &locale_attributes_.back();
         break;
       }
-      case flutter::StringAttributeType::kSpellOut: {
-        // All spell out attributes are identical and share a lazily created
-        // instance.
-        if (!spell_out_attribute_) {
-          auto spell_out_attribute_ =
-              std::make_unique<FlutterSpellOutStringAttribute>();
-          spell_out_attribute_->struct_size =
-              sizeof(FlutterSpellOutStringAttribute);
-        }
-
-        embedder_attribute->type = FlutterStringAttributeType::kSpellOut;
-        embedder_attribute->spell_out = spell_out_attribute_.get();
+      case StringAttributeType::kSpellOut: {
+        embedder_attribute.type = FlutterStringAttributeType::kSpellOut;
+        embedder_attribute.spell_out = &spell_out_attribute_;
         break;
       }
     }
 
-    string_attributes_.push_back(std::move(embedder_attribute));
-    result->push_back(string_attributes_.back().get());
+    string_attributes_.push_back(embedder_attribute);
+    string_attribute_pointers_.push_back(&string_attributes_.back());
   }
 
-  node_string_attributes_.push_back(std::move(result));
-
   return {
-      .count = node_string_attributes_.back()->size(),
-      .attributes = node_string_attributes_.back()->data(),
+      .count = range.count,
+      .attributes = string_attribute_pointers_.data() + offset,
   };
 }
 
@@ -6,7 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SEMANTICS_UPDATE_H_
 
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
-#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/flat_semantics_node_updates.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 
 namespace flutter {
@@ -15,13 +15,14 @@ namespace flutter {
 // callbacks.
 class EmbedderSemanticsUpdate {
  public:
-  EmbedderSemanticsUpdate(const SemanticsNodeUpdates& nodes,
+  EmbedderSemanticsUpdate(const FlatSemanticsNodeUpdates& nodes,
                           const CustomAccessibilityActionUpdates& actions);
 
   ~EmbedderSemanticsUpdate();
 
   // Get the semantic update. The pointer is only valid while
-  // |EmbedderSemanticsUpdate| exists.
+  // |EmbedderSemanticsUpdate| and the engine's update it was created from
+  // exist.
   FlutterSemanticsUpdate* get() { return &update_; }
 
  private:
@@ -29,8 +30,10 @@ class EmbedderSemanticsUpdate {
   std::vector<FlutterSemanticsNode> nodes_;
   std::vector<FlutterSemanticsCustomAction> actions_;
 
-  // Translates engine semantic nodes to embedder semantic nodes.
-  void AddNode(const SemanticsNode& node);
+  // Translates engine semantic nodes to embedder semantic nodes. Strings and
+  // child lists point into the tables of |nodes|.
+  void AddNode(const FlatSemanticsNodeUpdates& nodes,
+               const FlatSemanticsNodeUpdates::Record& node);
 
   // Translates engine semantic custom actions to embedder semantic custom
   // actions.
@@ -45,16 +48,21 @@ class EmbedderSemanticsUpdate {
 // the engine's internal representation and passed back to the semantics
 // update callback. Once the callback finishes, this object is destroyed
 // and the temporary embedder-specific objects are automatically cleaned up.
+//
+// Strings, child lists and locales are not copied. They point into the
+// tables of the engine's |FlatSemanticsNodeUpdates|, which outlives the
+// callback.
 class EmbedderSemanticsUpdate2 {
  public:
   EmbedderSemanticsUpdate2(int64_t view_id,
-                           const SemanticsNodeUpdates& nodes,
+                           const FlatSemanticsNodeUpdates& nodes,
                            const CustomAccessibilityActionUpdates& actions);
 
   ~EmbedderSemanticsUpdate2();
 
   // Get the semantic update. The pointer is only valid while
-  // |EmbedderSemanticsUpdate2| exists.
+  // |EmbedderSemanticsUpdate2| and the engine's update it was created from
+  // exist.
   FlutterSemanticsUpdate2* get() { return &update_; }
 
  private:
@@ -67,16 +75,20 @@ class EmbedderSemanticsUpdate2 {
   std::vector<FlutterSemanticsNode2*> node_pointers_;
   std::vector<FlutterSemanticsCustomAction2> actions_;
   std::vector<FlutterSemanticsCustomAction2*> action_pointers_;
-  std::vector<std::unique_ptr<FlutterSemanticsFlags>> flags_;
-
-  std::vector<std::unique_ptr<std::vector<const FlutterStringAttribute*>>>
-      node_string_attributes_;
-  std::vector<std::unique_ptr<FlutterStringAttribute>> string_attributes_;
-  std::vector<std::unique_ptr<FlutterLocaleStringAttribute>> locale_attributes_;
-  std::unique_ptr<FlutterSpellOutStringAttribute> spell_out_attribute_;
+  // The vectors below are reserved up front and never grow beyond that, so
+  // that the nodes can point at their elements.
+  std::vector<FlutterSemanticsFlags> flags_;
+  std::vector<const FlutterStringAttribute*> string_attribute_pointers_;
+  std::vector<FlutterStringAttribute> string_attributes_;
+  std::vector<FlutterLocaleStringAttribute> locale_attributes_;
+  // All spell out attributes are identical and share this instance.
+  FlutterSpellOutStringAttribute spell_out_attribute_ = {
+      .struct_size = sizeof(FlutterSpellOutStringAttribute),
+  };
 
   // Translates engine semantic nodes to embedder semantic nodes.
-  void AddNode(const SemanticsNode& node);
+  void AddNode(const FlatSemanticsNodeUpdates& nodes,
+               const FlatSemanticsNodeUpdates::Record& node);
 
   // Translates engine semantic custom actions to embedder semantic custom
   // actions.
@@ -92,7 +104,8 @@ class EmbedderSemanticsUpdate2 {
 
   // Translates engine string attributes to embedder string attributes.
   EmbedderStringAttributes CreateStringAttributes(
-      const StringAttributes& attribute);
+      const FlatSemanticsNodeUpdates& nodes,
+      FlatSemanticsNodeUpdates::AttributeRange range);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSemanticsUpdate2);
 };
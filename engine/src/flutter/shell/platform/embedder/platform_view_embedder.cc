@@ -117,8 +117,25 @@ void PlatformViewEmbedder::UpdateSemantics(
     flutter::SemanticsNodeUpdates update,
     flutter::CustomAccessibilityActionUpdates actions) {
   if (platform_dispatch_table_.update_semantics_callback != nullptr) {
-    platform_dispatch_table_.update_semantics_callback(
-        view_id, std::move(update), std::move(actions));
+    flutter::FlatSemanticsNodeUpdates flat_update;
+    for (const auto& value : update) {
+      flat_update.Add(value.second);
+    }
+    // The callback must stay synchronous. The FlutterSemanticsNode and
+    // FlutterSemanticsNode2 structs it hands to the embedder point into
+    // |flat_update|, which is destroyed when this method returns.
+    platform_dispatch_table_.update_semantics_callback(view_id, flat_update,
+                                                       actions);
+  }
+}
+
+void PlatformViewEmbedder::UpdateFlatSemantics(
+    int64_t view_id,
+    const flutter::FlatSemanticsNodeUpdates& update,
+    const flutter::CustomAccessibilityActionUpdates& actions) {
+  if (platform_dispatch_table_.update_semantics_callback != nullptr) {
+    platform_dispatch_table_.update_semantics_callback(view_id, update,
+                                                       actions);
   }
 }
 
@@ -35,10 +35,13 @@ namespace flutter {
 
 class PlatformViewEmbedder final : public PlatformView {
  public:
+  // Must consume |update| before it returns. The embedder API structs that
+  // are built from it point into its tables.
   using UpdateSemanticsCallback =
-      std::function<void(int64_t view_id,
-                         flutter::SemanticsNodeUpdates update,
-                         flutter::CustomAccessibilityActionUpdates actions)>;
+      std::function<void(
+          int64_t view_id,
+          const flutter::FlatSemanticsNodeUpdates& update,
+          const flutter::CustomAccessibilityActionUpdates& actions)>;
   using PlatformMessageResponseCallback =
       std::function<void(std::unique_ptr<PlatformMessage>)>;
   using ComputePlatformResolvedLocaleCallback =
@@ -109,6 +112,12 @@ class PlatformViewEmbedder final : public PlatformView {
       flutter::SemanticsNodeUpdates update,
       flutter::CustomAccessibilityActionUpdates actions) override;
 
+  // |PlatformView|
+  void UpdateFlatSemantics(
+      int64_t view_id,
+      const flutter::FlatSemanticsNodeUpdates& update,
+      const flutter::CustomAccessibilityActionUpdates& actions) override;
+
   // |PlatformView|
   void HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) override;
 
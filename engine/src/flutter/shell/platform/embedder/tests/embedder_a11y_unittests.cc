@@ -318,6 +318,9 @@ TEST_F(EmbedderA11yTest, A11yStringAttributes) {
           ASSERT_EQ(node->label_attributes[1]->end, size_t(1));
           ASSERT_EQ(node->label_attributes[1]->type,
                     FlutterStringAttributeType::kSpellOut);
+          ASSERT_NE(node->label_attributes[1]->spell_out, nullptr);
+          ASSERT_EQ(node->label_attributes[1]->spell_out->struct_size,
+                    sizeof(FlutterSpellOutStringAttribute));
         }
 
         // Verify hint
@@ -362,11 +365,17 @@ TEST_F(EmbedderA11yTest, A11yStringAttributes) {
           ASSERT_EQ(node->increased_value_attributes[0]->end, size_t(1));
           ASSERT_EQ(node->increased_value_attributes[0]->type,
                     FlutterStringAttributeType::kSpellOut);
+          ASSERT_NE(node->increased_value_attributes[0]->spell_out, nullptr);
+          ASSERT_EQ(node->increased_value_attributes[0]->spell_out->struct_size,
+                    sizeof(FlutterSpellOutStringAttribute));
 
           ASSERT_EQ(node->increased_value_attributes[1]->start, size_t(1));
           ASSERT_EQ(node->increased_value_attributes[1]->end, size_t(2));
           ASSERT_EQ(node->increased_value_attributes[1]->type,
                     FlutterStringAttributeType::kSpellOut);
+          ASSERT_NE(node->increased_value_attributes[1]->spell_out, nullptr);
+          ASSERT_EQ(node->increased_value_attributes[1]->spell_out->struct_size,
+                    sizeof(FlutterSpellOutStringAttribute));
         }
 
         // Verify decreased value
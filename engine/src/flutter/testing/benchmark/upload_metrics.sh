@@ -59,7 +59,11 @@ cd "$SCRIPT_DIR"
   --json $ENGINE_PATH/src/out/${VARIANT}/display_list_builder_benchmarks.json "$@"
 "$DART" bin/parse_and_send.dart \
   --json $ENGINE_PATH/src/out/${VARIANT}/display_list_region_benchmarks.json "$@"
+"$DART" bin/parse_and_send.dart \
+  --json $ENGINE_PATH/src/out/${VARIANT}/display_list_rtree_benchmarks.json "$@"
 "$DART" bin/parse_and_send.dart \
   --json $ENGINE_PATH/src/out/${VARIANT}/display_list_transform_benchmarks.json "$@"
 "$DART" bin/parse_and_send.dart \
   --json $ENGINE_PATH/src/out/${VARIANT}/geometry_benchmarks.json "$@"
+"$DART" bin/parse_and_send.dart \
+  --json $ENGINE_PATH/src/out/${VARIANT}/typographer_benchmarks.json "$@"
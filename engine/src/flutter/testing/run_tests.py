@@ -596,6 +596,8 @@ def run_engine_benchmarks(build_dir, executable_filter):
 
   run_engine_executable(build_dir, 'shell_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(build_dir, 'assets_benchmarks', executable_filter, icu_flags)
+
   run_engine_executable(build_dir, 'fml_benchmarks', executable_filter, icu_flags)
 
   run_engine_executable(build_dir, 'ui_benchmarks', executable_filter, icu_flags)